@@ -0,0 +1,84 @@
+#ifndef ACTUATOR_PATTERN_H
+#define ACTUATOR_PATTERN_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 执行器模式播放配置（软件定时器按节拍推进各通道，调用方立即返回）
+#define ACTUATOR_TICK_MS            10          // 定时器节拍，步骤时长按节拍向上取整
+#define ACTUATOR_MAX_STEPS          16          // 单个模式的最大步骤数（播放时复制，调用方可使用临时数组）
+#define ACTUATOR_REPEAT_FOREVER     0           // 循环播放直到被停止或抢占
+
+// 模式优先级：高优先级模式可抢占正在播放的同级或低级模式，低优先级请求被拒绝
+#define ACTUATOR_PRIO_MANUAL        0           // 云端命令、测试
+#define ACTUATOR_PRIO_RISK_BASE     1           // 风险报警：ACTUATOR_PRIO_RISK_BASE + 风险等级 - 1
+
+// 执行器通道
+typedef enum {
+    ACTUATOR_BUZZER = 0,            // 输出量为频率 (Hz)，0为静音
+    ACTUATOR_MOTOR,                 // 输出量为占空比 (%)，0为停止
+    ACTUATOR_ALARM_LIGHT,           // 输出量非0为点亮
+    ACTUATOR_COUNT
+} ActuatorChannel;
+
+// 模式步骤：以输出量保持duration_ms
+typedef struct {
+    uint32_t duration_ms;
+    uint16_t level;
+} ActuatorStep;
+
+// 通道输出函数（在定时器任务中调用，不得阻塞）
+typedef void (*ActuatorOutputFunc)(uint16_t level);
+
+/**
+ * @brief 初始化模式播放（创建软件定时器）
+ * @return 0: 成功, -1: 失败
+ */
+int Actuator_Init(void);
+
+/**
+ * @brief 反初始化模式播放（停止所有通道）
+ */
+void Actuator_Deinit(void);
+
+/**
+ * @brief 设置通道输出函数
+ * @param channel 通道
+ * @param output 输出函数（NULL表示该通道不播放）
+ */
+void Actuator_SetOutput(ActuatorChannel channel, ActuatorOutputFunc output);
+
+/**
+ * @brief 播放模式（立即输出第一步后返回，之后由定时器推进）
+ * @param channel 通道
+ * @param steps 步骤数组（播放时复制）
+ * @param step_count 步骤数 (1~ACTUATOR_MAX_STEPS)
+ * @param repeat 播放次数（ACTUATOR_REPEAT_FOREVER为循环）
+ * @param priority 优先级
+ * @return 0: 开始播放, -1: 参数错误或未初始化, -2: 正在播放更高优先级的模式
+ */
+int Actuator_Play(ActuatorChannel channel, const ActuatorStep *steps, uint8_t step_count, uint8_t repeat,
+                  uint8_t priority);
+
+/**
+ * @brief 停止通道（输出0）
+ * @param channel 通道
+ */
+void Actuator_Stop(ActuatorChannel channel);
+
+/**
+ * @brief 通道是否正在播放
+ * @param channel 通道
+ * @return true: 播放中, false: 空闲
+ */
+bool Actuator_IsActive(ActuatorChannel channel);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ACTUATOR_PATTERN_H
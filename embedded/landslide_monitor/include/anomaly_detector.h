@@ -0,0 +1,82 @@
+#ifndef ANOMALY_DETECTOR_H
+#define ANOMALY_DETECTOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 多传感器异常检测配置（块平均特征向量的指数遗忘均值/协方差 + 马氏距离，O(1)时间和内存）
+#define ANOMALY_BLOCK_MS            (60 * 1000)     // 特征先按块平均（抑制单样本噪声和阵风等短时扰动），每块评估并学习一次
+#define ANOMALY_MAX_GAP_MS          (10 * 60 * 1000)    // 相邻块间隔上限，更长的中断按该值计算遗忘系数
+#define ANOMALY_TAU_MS              (72.0 * 3600.0 * 1000.0)    // 均值/协方差遗忘时间常数（覆盖数个日周期，缓慢形变不会很快被当作正常）
+#define ANOMALY_WARMUP_MS           (60 * 60 * 1000)    // 预热时长，期间只学习不输出
+#define ANOMALY_GATE_SCORE          4.0f        // 超过该分数的块视为异常，学习时偏差截断到该分数对应的距离
+                                                // （影响有界，持续的新状态约需数天才被接受为正常）
+
+// 特征向量
+typedef enum {
+    ANOMALY_FEATURE_TILT = 0,       // 倾角幅值 (°)
+    ANOMALY_FEATURE_VIBRATION,      // 振动强度 (°/s)
+    ANOMALY_FEATURE_HUMIDITY,       // 相对湿度 (%)
+    ANOMALY_FEATURE_HUMIDITY_TREND, // 湿度变化趋势 (%/标称周期)
+    ANOMALY_FEATURE_TEMPERATURE,    // 温度 (°C)，使湿度的昼夜变化可由温度解释
+    ANOMALY_FEATURES
+} AnomalyFeature;
+
+// 单个样本的检测结果
+typedef struct {
+    float score;                    // 异常分数：马氏距离平方按卡方分布换算的等效正态分位数（正常数据约N(0,1)）
+    float distance2;                // 马氏距离平方
+    uint8_t dominant;               // 标准化偏差最大的特征 (AnomalyFeature)
+    bool diagonal;                  // 协方差分解失败，按各特征独立方差计算
+    bool ready;                     // 预热已完成（未完成时score为0）
+} AnomalyResult;
+
+// 检测统计信息
+typedef struct {
+    uint32_t samples;               // 输入样本数
+    uint32_t blocks;                // 已评估/学习的块数
+    uint32_t anomalies;             // 分数超过ANOMALY_GATE_SCORE的块数
+    uint32_t factor_failures;       // 协方差Cholesky分解失败次数
+    float last_score;               // 最近一次分数
+    float max_score;                // 最大分数
+    float mean[ANOMALY_FEATURES];   // 当前均值
+    float std[ANOMALY_FEATURES];    // 当前标准差
+    bool ready;                     // 预热已完成
+} AnomalyStats;
+
+/**
+ * @brief 初始化异常检测
+ * @return 0: 成功, -1: 失败
+ */
+int Anomaly_Init(void);
+
+/**
+ * @brief 反初始化异常检测
+ */
+void Anomaly_Deinit(void);
+
+/**
+ * @brief 输入一个特征向量：块结束时先按当前均值/协方差计算块平均的马氏距离，再更新均值/协方差
+ * @param features 特征向量（按AnomalyFeature下标）
+ * @param timestamp 采样时间 (ms)，遗忘系数按相邻块间隔计算
+ * @param result 检测结果（最近一个完成块的结果，块内保持不变）
+ * @return 0: 成功, -1: 参数错误或未初始化
+ */
+int Anomaly_Update(const float features[ANOMALY_FEATURES], uint32_t timestamp, AnomalyResult *result);
+
+/**
+ * @brief 获取检测统计信息
+ * @param stats 统计信息
+ * @return 0: 成功, -1: 参数错误或未初始化
+ */
+int Anomaly_GetStats(AnomalyStats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ANOMALY_DETECTOR_H
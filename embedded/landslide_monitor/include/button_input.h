@@ -0,0 +1,71 @@
+#ifndef BUTTON_INPUT_H
+#define BUTTON_INPUT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "output_devices.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 按键事件检测配置（软件定时器周期采样ADC，按键事件入队由控制任务处理）
+// 按下到事件入队的延迟：短按为释放后消抖时间（启用双击的按键再加双击间隔），长按为达到长按时间后消抖时间
+#define BUTTON_SAMPLE_MS            10          // ADC采样周期
+#define BUTTON_DEBOUNCE_SAMPLES     3           // 连续相同读数次数，达到后才确认按下/释放
+#define BUTTON_LONG_PRESS_MS        2000        // 长按时间（按住期间到时立即产生事件）
+#define BUTTON_DOUBLE_GAP_MS        300         // 双击间隔：释放后在此时间内再次按下同一按键
+#define BUTTON_EVENT_QUEUE_LENGTH   8
+
+#define BUTTON_KEY_MASK(key)        (1u << (key))   // 启用双击的按键掩码
+
+// 按键事件类型
+typedef enum {
+    BUTTON_EVENT_SHORT = 0,         // 短按（释放时产生）
+    BUTTON_EVENT_LONG,              // 长按
+    BUTTON_EVENT_DOUBLE             // 双击（仅启用双击的按键）
+} ButtonEventType;
+
+// 按键事件
+typedef struct {
+    ButtonState key;                // 按键（BUTTON_STATE_K3_PRESSED ~ BUTTON_STATE_K6_PRESSED）
+    ButtonEventType type;
+    uint32_t press_time;            // 确认按下的时间 (ms)
+    uint32_t event_time;            // 事件产生时间 (ms)
+} ButtonEvent;
+
+// 事件通知函数（在定时器任务中调用，不得阻塞）
+typedef void (*ButtonNotifyFunc)(void);
+
+/**
+ * @brief 初始化按键事件检测（按键ADC需已初始化）
+ * @param double_press_mask 启用双击的按键掩码（BUTTON_KEY_MASK组合），未启用的按键短按在释放时立即产生
+ * @param notify 事件入队后的通知函数（可为NULL）
+ * @return 0: 成功, -1: 失败
+ */
+int ButtonInput_Init(uint32_t double_press_mask, ButtonNotifyFunc notify);
+
+/**
+ * @brief 停止采样并删除事件队列
+ */
+void ButtonInput_Deinit(void);
+
+/**
+ * @brief 读取按键事件
+ * @param event 事件
+ * @param timeout_ms 等待时间（0为不等待）
+ * @return 0: 成功, -1: 无事件或未初始化
+ */
+int ButtonInput_ReadEvent(ButtonEvent *event, uint32_t timeout_ms);
+
+/**
+ * @brief 获取队列满丢弃的事件数
+ * @return 丢弃数
+ */
+uint32_t ButtonInput_GetDropped(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BUTTON_INPUT_H
@@ -0,0 +1,42 @@
+#ifndef CRC32_H
+#define CRC32_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// CRC-32 (IEEE 802.3, 多项式0x04C11DB7反射形式，与zlib/以太网一致)
+// 供Flash记录、缓存持久化及二进制上报帧共用
+#define CRC32_CHECK_VALUE           0xCBF43926  // "123456789"的标准校验值
+
+/**
+ * @brief 计算数据的CRC32
+ * @param data 数据
+ * @param size 数据长度
+ * @return CRC32值
+ */
+uint32_t Crc32_Calculate(const void *data, size_t size);
+
+/**
+ * @brief 分段计算CRC32（首段传入crc=0，后续传入上一段的返回值）
+ * @param crc 上一段的CRC32值
+ * @param data 数据
+ * @param size 数据长度
+ * @return 累计CRC32值
+ */
+uint32_t Crc32_Update(uint32_t crc, const void *data, size_t size);
+
+/**
+ * @brief 使用标准测试向量自检
+ * @return 0: 通过, 其他: 失败
+ */
+int Crc32_SelfTest(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CRC32_H
@@ -0,0 +1,153 @@
+#ifndef DATA_ARCHIVE_H
+#define DATA_ARCHIVE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "landslide_monitor.h"
+#include "data_storage.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 多分辨率归档Flash分区（紧跟在上传缓存队列区之后，均按扇区对齐）
+// 磨损预算：原始层每槽36字节、每扇区113条，1Hz写入约每2分钟擦除一个扇区，8扇区轮转每扇区每天擦除约95次，
+// 按10万次擦写寿命约2.9年；分钟层每扇区每天约1.2次。原始层寿命与ARCHIVE_RAW_INTERVAL_S和扇区数成正比
+#define ARCHIVE_FLASH_BASE_ADDR     0x208000    // 归档区起始地址
+#define ARCHIVE_RAW_SECTORS         8           // 原始层扇区数（904条，1Hz约15分钟）
+#define ARCHIVE_MINUTE_SECTORS      24          // 分钟层扇区数（约20小时）
+#define ARCHIVE_HOUR_SECTORS        16          // 小时层扇区数（约34天）
+#define ARCHIVE_RAW_ADDR            ARCHIVE_FLASH_BASE_ADDR
+#define ARCHIVE_MINUTE_ADDR         (ARCHIVE_RAW_ADDR + ARCHIVE_RAW_SECTORS * STORAGE_SECTOR_SIZE)
+#define ARCHIVE_HOUR_ADDR           (ARCHIVE_MINUTE_ADDR + ARCHIVE_MINUTE_SECTORS * STORAGE_SECTOR_SIZE)
+#define ARCHIVE_FLASH_END_ADDR      (ARCHIVE_HOUR_ADDR + ARCHIVE_HOUR_SECTORS * STORAGE_SECTOR_SIZE)
+
+// 归档参数
+#define ARCHIVE_RAW_INTERVAL_S      1           // 原始层写入间隔（秒），限制Flash磨损
+#define ARCHIVE_MINUTE_PERIOD_S     60          // 分钟层汇总周期
+#define ARCHIVE_HOUR_PERIOD_S       3600        // 小时层汇总周期
+#define ARCHIVE_RAW_PENDING         16          // 待写入原始记录队列长度
+#define ARCHIVE_ROLLUP_PENDING      4           // 待写入汇总记录队列长度
+
+// 归档分层
+typedef enum {
+    ARCHIVE_TIER_RAW = 0,       // 原始采样（按ARCHIVE_RAW_INTERVAL_S抽取）
+    ARCHIVE_TIER_MINUTE,        // 1分钟汇总
+    ARCHIVE_TIER_HOUR,          // 1小时汇总
+    ARCHIVE_TIER_COUNT
+} ArchiveTier;
+
+// 归档通道
+typedef enum {
+    ARCHIVE_CH_ANGLE_X = 0,     // X轴倾角 (°)
+    ARCHIVE_CH_ANGLE_Y,         // Y轴倾角 (°)
+    ARCHIVE_CH_ACCEL_MAG,       // 加速度模值 (g)
+    ARCHIVE_CH_GYRO_MAG,        // 角速度模值 (°/s)
+    ARCHIVE_CH_TEMPERATURE,     // 环境温度 (°C)
+    ARCHIVE_CH_HUMIDITY,        // 湿度 (%)
+    ARCHIVE_CH_LIGHT,           // 光照强度 (lux)
+    ARCHIVE_CHANNEL_COUNT
+} ArchiveChannel;
+
+// 原始层Flash记录（定点存储）
+typedef struct {
+    uint32_t time;                              // 归档时间 (秒)
+    int16_t value[ARCHIVE_CHANNEL_COUNT];       // 各通道定点值
+    uint16_t reserved;
+} ArchiveRawRecord;
+
+// 汇总层Flash记录（定点存储）
+typedef struct {
+    uint32_t start_time;                        // 窗口起始时间 (秒)
+    uint16_t sample_count;                      // 窗口内样本数
+    uint16_t reserved;
+    int16_t min[ARCHIVE_CHANNEL_COUNT];         // 最小值
+    int16_t max[ARCHIVE_CHANNEL_COUNT];         // 最大值
+    int16_t mean[ARCHIVE_CHANNEL_COUNT];        // 平均值
+    int16_t last[ARCHIVE_CHANNEL_COUNT];        // 窗口内最后一个值
+} ArchiveRollupRecord;
+
+// 查询结果（已还原为工程单位，原始层min/max/mean/last相同）
+typedef struct {
+    ArchiveTier tier;
+    uint32_t time;                              // 采样时间或窗口起始时间 (秒)
+    uint16_t sample_count;                      // 样本数
+    float min[ARCHIVE_CHANNEL_COUNT];
+    float max[ARCHIVE_CHANNEL_COUNT];
+    float mean[ARCHIVE_CHANNEL_COUNT];
+    float last[ARCHIVE_CHANNEL_COUNT];
+} ArchiveSample;
+
+// 归档统计信息
+typedef struct {
+    uint32_t record_count[ARCHIVE_TIER_COUNT];  // 各层Flash记录数
+    uint32_t capacity[ARCHIVE_TIER_COUNT];      // 各层容量
+    uint32_t oldest_time[ARCHIVE_TIER_COUNT];   // 各层最旧记录时间
+    uint32_t written[ARCHIVE_TIER_COUNT];       // 本次启动写入记录数
+    uint32_t dropped;                           // 队列溢出丢弃数
+    uint32_t write_errors;                      // 写入失败数
+    uint32_t now;                               // 当前归档时间 (秒)
+} ArchiveStats;
+
+/**
+ * @brief 查询回调
+ * @param sample 查询到的记录
+ * @param user_data 用户数据
+ * @return 0: 继续, 其他: 停止查询
+ */
+typedef int (*ArchiveQueryCallback)(const ArchiveSample *sample, void *user_data);
+
+/**
+ * @brief 初始化多分辨率归档（需在DataStorage_Init之后调用）
+ * @return 0: 成功, 其他: 失败
+ */
+int DataArchive_Init(void);
+
+/**
+ * @brief 添加一个传感器样本（仅更新内存汇总，不访问Flash）
+ * @param data 传感器数据
+ */
+void DataArchive_AddSample(const SensorData *data);
+
+/**
+ * @brief 将待写入记录写入Flash（在低优先级任务中周期调用）
+ * @return 写入的记录数
+ */
+int DataArchive_Flush(void);
+
+/**
+ * @brief 按时间范围查询归档记录
+ * @param tier 归档层
+ * @param start_time 起始时间 (秒，含)
+ * @param end_time 结束时间 (秒，含)
+ * @param callback 查询回调
+ * @param user_data 用户数据
+ * @return 回调的记录数, 负数: 失败
+ */
+int DataArchive_Query(ArchiveTier tier, uint32_t start_time, uint32_t end_time,
+                      ArchiveQueryCallback callback, void *user_data);
+
+/**
+ * @brief 获取当前归档时间（跨重启单调递增）
+ * @return 归档时间 (秒)
+ */
+uint32_t DataArchive_GetTime(void);
+
+/**
+ * @brief 获取归档统计信息
+ * @param stats 统计信息
+ * @return 0: 成功, 其他: 失败
+ */
+int DataArchive_GetStats(ArchiveStats *stats);
+
+/**
+ * @brief 清空全部归档数据
+ * @return 0: 成功, 其他: 失败
+ */
+int DataArchive_Clear(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DATA_ARCHIVE_H
@@ -0,0 +1,115 @@
+#ifndef DATA_CACHE_H
+#define DATA_CACHE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "iot_cloud.h"
+#include "data_storage.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 上传缓存队列配置：内存只保留少量最新数据，其余按顺序溢出到Flash日志
+#ifndef DATA_CACHE_RAM_SIZE
+#define DATA_CACHE_RAM_SIZE         8           // 内存队列条数（可按RAM预算调整）
+#endif
+#define DATA_CACHE_FLASH_ADDR       STORAGE_FLASH_BASE_ADDR  // Flash日志起始地址
+#define DATA_CACHE_FLASH_SECTORS    8           // Flash日志扇区数（约330条）
+#define DATA_CACHE_SPILL_AGE_MS     30000       // 内存数据超过该时长即写入Flash，限制掉电丢失量
+#define DATA_CACHE_MAX_RETRY        3           // 单条数据最大发送重试次数
+#define DATA_CACHE_SEND_BATCH       10          // 单次补发最大条数
+
+// Flash日志记录标志
+#define DATA_CACHE_FLAG_CONSUMED    0x00000001  // 已发送（清零表示已消费）
+
+// 缓存数据项（内存与Flash共用同一格式）
+typedef struct {
+    uint32_t id;                        // 入队序号（全局递增）
+    uint32_t timestamp;                 // 入队时间 (tick)
+    LandslideIotData data;              // 待上传数据
+} DataCacheItem;
+
+// 缓存统计信息
+typedef struct {
+    uint32_t ram_count;                 // 内存中待发送条数
+    uint32_t flash_count;               // Flash中待发送条数
+    uint32_t ram_capacity;              // 内存容量
+    uint32_t flash_capacity;            // Flash容量
+    uint32_t total_cached;              // 总入队数
+    uint32_t total_sent;                // 补发成功数
+    uint32_t total_failed;              // 重试超限丢弃数
+    uint32_t total_spilled;             // 溢出到Flash的条数
+    uint32_t total_dropped;             // Flash写满被覆盖的未发送条数
+    bool flash_available;               // Flash日志是否可用
+} DataCacheStats;
+
+/**
+ * @brief 发送回调
+ * @param item 待发送数据
+ * @return 0: 发送成功, 其他: 发送失败
+ */
+typedef int (*DataCacheSendCallback)(const DataCacheItem *item);
+
+/**
+ * @brief 初始化上传缓存队列，恢复Flash中未发送的数据
+ * @return 0: 成功, 其他: 失败（Flash不可用时仍可使用内存队列）
+ */
+int DataCache_Init(void);
+
+/**
+ * @brief 数据入队（内存满时最旧数据溢出到Flash）
+ * @param data 待上传数据
+ * @return 0: 成功, 其他: 失败
+ */
+int DataCache_Add(const LandslideIotData *data);
+
+/**
+ * @brief 按入队顺序补发缓存数据
+ * @param send 发送回调
+ * @param max_items 本次最多发送条数
+ * @return 发送成功的数据条数
+ */
+int DataCache_SendPending(DataCacheSendCallback send, int max_items);
+
+/**
+ * @brief 将内存数据写入Flash
+ * @param all true: 全部写入（重启前调用）, false: 只写入超过DATA_CACHE_SPILL_AGE_MS的数据
+ * @return 写入的条数
+ */
+int DataCache_Spill(bool all);
+
+/**
+ * @brief 获取待发送数据总数（内存+Flash）
+ * @return 数据条数
+ */
+uint32_t DataCache_GetCount(void);
+
+/**
+ * @brief 获取队列总容量（内存+Flash）
+ * @return 容量
+ */
+uint32_t DataCache_GetCapacity(void);
+
+/**
+ * @brief 获取缓存统计信息
+ * @param stats 统计信息
+ * @return 0: 成功, 其他: 失败
+ */
+int DataCache_GetStats(DataCacheStats *stats);
+
+/**
+ * @brief 清空全部缓存数据（内存和Flash）
+ */
+void DataCache_Clear(void);
+
+/**
+ * @brief 打印缓存统计信息
+ */
+void DataCache_PrintStats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DATA_CACHE_H
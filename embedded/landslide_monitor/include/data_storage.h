@@ -3,7 +3,6 @@
 
 #include <stdint.h>
 #include <stdbool.h>
-#include "iot_cloud.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -12,41 +11,39 @@ extern "C" {
 // Flash存储配置
 #define STORAGE_FLASH_BASE_ADDR     0x200000    // Flash存储起始地址
 #define STORAGE_SECTOR_SIZE         4096        // 扇区大小 4KB
-#define STORAGE_MAX_RECORDS         100         // 最大存储记录数
-#define STORAGE_RECORD_SIZE         256         // 每条记录大小
-#define STORAGE_TOTAL_SIZE          (STORAGE_MAX_RECORDS * STORAGE_RECORD_SIZE)
 
-// 存储记录头部
-typedef struct {
-    uint32_t magic;             // 魔数 0x12345678
-    uint32_t timestamp;         // 时间戳
-    uint16_t data_size;         // 数据大小
-    uint16_t checksum;          // 校验和
-} StorageHeader;
+// Flash分区规划（各模块在自己的头文件中定义具体地址）
+//   0x200000 - 0x207FFF  上传缓存队列（data_cache.h）
+//   0x208000 - 0x237FFF  多分辨率归档（data_archive.h）
+//   0x238000 - 0x239FFF  键值存储（kv_store.h）
+
+// Flash环形区配置（供缓存队列、归档等模块复用）
+#define STORAGE_RING_MAGIC          0xA55B      // 环形区记录魔数（0xA55A为旧版字节和校验格式，不再识别）
+#define STORAGE_RING_MIN_SECTORS    2           // 环形区最少扇区数（保证擦除时仍有历史数据）
+#define STORAGE_RING_FLAGS_ERASED   0xFFFFFFFF  // 记录标志初始值（NOR Flash只能将位从1写为0）
 
-// 存储记录结构
+// 环形区记录头部（写入顺序：先载荷后头部，头部有效即记录完整）
 typedef struct {
-    StorageHeader header;
-    LandslideIotData data;
-    uint8_t reserved[64];       // 预留空间
-} StorageRecord;
-
-// 存储状态
-typedef enum {
-    STORAGE_STATE_UNINITIALIZED = 0,
-    STORAGE_STATE_READY,
-    STORAGE_STATE_FULL,
-    STORAGE_STATE_ERROR
-} StorageState;
-
-// 存储统计信息
+    uint16_t magic;             // 魔数 STORAGE_RING_MAGIC
+    uint16_t length;            // 载荷长度
+    uint32_t sequence;          // 递增序号（重启后用于定位写指针）
+    uint32_t checksum;          // CRC32（覆盖magic/length/sequence和载荷）
+    uint32_t flags;             // 记录标志（不参与校验，可原地清位）
+} StorageRingHeader;
+
+// Flash环形区描述（按扇区整体擦除，写满后覆盖最旧扇区）
 typedef struct {
-    uint32_t total_records;     // 总记录数
-    uint32_t stored_records;    // 已存储记录数
-    uint32_t uploaded_records;  // 已上传记录数
-    uint32_t failed_records;    // 失败记录数
-    StorageState state;         // 存储状态
-} StorageStats;
+    uint32_t base_addr;         // 区域起始地址（扇区对齐）
+    uint16_t sector_count;      // 扇区数量
+    uint16_t payload_size;      // 单条记录载荷大小
+    uint16_t slot_size;         // 单条记录槽大小（头部+载荷）
+    uint16_t slots_per_sector;  // 每扇区槽数
+    uint32_t total_slots;       // 总槽数
+    uint32_t write_slot;        // 下一次写入槽位
+    uint32_t oldest_slot;       // 最旧记录槽位
+    uint32_t count;             // 有效记录数
+    uint32_t next_sequence;     // 下一条记录序号
+} StorageRing;
 
 /**
  * @brief 初始化数据存储
@@ -60,64 +57,74 @@ int DataStorage_Init(void);
 void DataStorage_Deinit(void);
 
 /**
- * @brief 存储数据到Flash
- * @param data 要存储的数据
+ * @brief 初始化Flash环形区并扫描已有记录，恢复写指针
+ * @param ring 环形区描述
+ * @param base_addr 区域起始地址（须扇区对齐）
+ * @param sector_count 扇区数量（不少于STORAGE_RING_MIN_SECTORS）
+ * @param payload_size 单条记录载荷大小
  * @return 0: 成功, 其他: 失败
  */
-int DataStorage_Store(const LandslideIotData *data);
+int DataStorage_RingInit(StorageRing *ring, uint32_t base_addr, uint16_t sector_count, uint16_t payload_size);
 
 /**
- * @brief 从Flash读取数据
- * @param index 记录索引
- * @param data 读取的数据
+ * @brief 追加一条记录到环形区（空间不足时覆盖最旧扇区）
+ * @param ring 环形区描述
+ * @param payload 记录载荷
+ * @param size 载荷大小（须等于初始化时的payload_size）
  * @return 0: 成功, 其他: 失败
  */
-int DataStorage_Read(uint32_t index, LandslideIotData *data);
-
-/**
- * @brief 获取存储的记录数量
- * @return 记录数量
- */
-uint32_t DataStorage_GetRecordCount(void);
+int DataStorage_RingAppend(StorageRing *ring, const void *payload, uint16_t size);
 
 /**
- * @brief 清空所有存储的数据
- * @return 0: 成功, 其他: 失败
+ * @brief 按时间顺序读取环形区记录
+ * @param ring 环形区描述
+ * @param index 记录序号（0为最旧记录）
+ * @param payload 读取的载荷
+ * @param size 载荷缓冲区大小
+ * @return 0: 成功, 其他: 失败（记录不存在或校验失败）
  */
-int DataStorage_Clear(void);
+int DataStorage_RingRead(const StorageRing *ring, uint32_t index, void *payload, uint16_t size);
 
 /**
- * @brief 获取存储统计信息
- * @param stats 统计信息
- * @return 0: 成功, 其他: 失败
+ * @brief 读取最新的一条有效记录（跳过写入失败或掉电残缺的槽位）
+ * @param ring 环形区描述
+ * @param payload 读取的载荷
+ * @param size 载荷缓冲区大小
+ * @return 0: 成功, 其他: 无有效记录
  */
-int DataStorage_GetStats(StorageStats *stats);
+int DataStorage_RingReadLatest(const StorageRing *ring, void *payload, uint16_t size);
 
 /**
- * @brief 处理Flash中的缓存数据
- * @param callback 回调函数，用于处理每条数据
- * @return 处理的数据条数
+ * @brief 获取环形区有效记录数
+ * @param ring 环形区描述
+ * @return 记录数量
  */
-int DataStorage_ProcessCached(int (*callback)(const LandslideIotData *data));
+uint32_t DataStorage_RingCount(const StorageRing *ring);
 
 /**
- * @brief 上传所有缓存的数据（已弃用）
- * @deprecated 建议使用DataStorage_ProcessCached配合内存缓存系统
- * @return 上传成功的记录数
+ * @brief 读取记录标志
+ * @param ring 环形区描述
+ * @param index 记录序号（0为最旧记录）
+ * @param flags 读取的标志
+ * @return 0: 成功, 其他: 失败
  */
-int DataStorage_UploadCached(void);
+int DataStorage_RingGetFlags(const StorageRing *ring, uint32_t index, uint32_t *flags);
 
 /**
- * @brief 检查存储空间是否已满
- * @return true: 已满, false: 未满
+ * @brief 原地清除记录标志位（无需擦除扇区）
+ * @param ring 环形区描述
+ * @param index 记录序号（0为最旧记录）
+ * @param mask 要清除的标志位
+ * @return 0: 成功, 其他: 失败
  */
-bool DataStorage_IsFull(void);
+int DataStorage_RingClearFlags(StorageRing *ring, uint32_t index, uint32_t mask);
 
 /**
- * @brief 获取最旧的记录索引（用于循环覆盖）
- * @return 记录索引
+ * @brief 擦除环形区全部记录
+ * @param ring 环形区描述
+ * @return 0: 成功, 其他: 失败
  */
-uint32_t DataStorage_GetOldestIndex(void);
+int DataStorage_RingClear(StorageRing *ring);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,111 @@
+#ifndef FAILURE_FORECAST_H
+#define FAILURE_FORECAST_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 失稳时间预测配置（Fukuzono反速度法：加速蠕变阶段1/v随时间近似线性下降，外推到0即为失稳时刻）
+#define FORECAST_WINDOW             16          // 每个数据源参与拟合的最近反速度点数
+#define FORECAST_MIN_SAMPLES        6           // 输出预测的最少点数
+#define FORECAST_MAX_GAP            3           // 连续速度不显著的点数超过该值时清空序列
+#define FORECAST_MAX_HORIZON_H      720.0f      // 超过该剩余时间 (小时) 的预测视为无预测
+#define FORECAST_MIN_CONFIDENCE     0.6f        // 参与风险升级的最低置信度
+#define FORECAST_CRITICAL_H         24.0f       // 剩余时间下限低于该值 (小时) 时风险升至危急
+#define FORECAST_HIGH_H             72.0f       // 剩余时间下限低于该值 (小时) 时风险升至高
+#define FORECAST_MEDIUM_H           168.0f      // 剩余时间下限低于该值 (小时) 时风险升至中
+#define FORECAST_TILT_BLOCK_MS      (60 * 60 * 1000)    // 倾角分块平均时长
+#define FORECAST_TILT_RATE_BLOCKS   24          // 倾斜速率取当前块与24块前的均值差分，日周期温漂相互抵消
+#define FORECAST_TILT_MIN_FILL      0.5f        // 块内样本数少于按当前采样间隔应有样本数的该比例时，视为数据中断丢弃该块
+#define FORECAST_TILT_MAX_INTERVAL_MS 10000     // 相邻样本间隔超过该值视为数据中断，不参与采样间隔估计
+#define FORECAST_TILT_RESOLUTION    0.002f      // 倾角块均值标准误差下限 (°)
+
+// 反速度序列的数据源
+typedef enum {
+    FORECAST_SOURCE_GNSS = 0,       // GPS形变速度 (米/小时)
+    FORECAST_SOURCE_TILT,           // 倾斜速率 (°/小时)
+    FORECAST_SOURCE_COUNT
+} ForecastSource;
+
+// 预测结果
+typedef struct {
+    float time_to_failure_h;        // 预测剩余时间 (小时)
+    float time_to_failure_lower_h;  // 剩余时间95%下限 (小时)，用于风险升级；<0表示下限不确定（反速度置信区间含0）
+    float confidence;               // 置信度 (0.0-1.0)，反速度线性拟合的R²，斜率不显著时为0
+    float inverse_velocity;         // 最新拟合反速度 (小时/单位位移)
+    float inverse_velocity_slope;   // 反速度斜率 (每小时)
+    float velocity;                 // 最新输入速度
+    uint32_t timestamp;             // 剩余时间的起算时刻 (ms)，即最近一次输入的时间
+    uint16_t samples;               // 参与拟合的点数
+    uint8_t source;                 // ForecastSource
+    bool valid;                     // 反速度下降趋势成立且剩余时间在预测范围内
+} FailureForecast;
+
+// 风险升级等级（数值与RiskLevel一致）
+typedef enum {
+    FORECAST_LEVEL_NONE = 0,
+    FORECAST_LEVEL_MEDIUM = 2,
+    FORECAST_LEVEL_HIGH = 3,
+    FORECAST_LEVEL_CRITICAL = 4
+} ForecastLevel;
+
+/**
+ * @brief 初始化失稳时间预测
+ * @return 0: 成功, -1: 失败
+ */
+int Forecast_Init(void);
+
+/**
+ * @brief 反初始化失稳时间预测
+ */
+void Forecast_Deinit(void);
+
+/**
+ * @brief 输入一个速度观测（每次更新O(1)，窗口满时移出最旧点）
+ * @param source 数据源
+ * @param timestamp 时间戳 (ms)
+ * @param velocity 速度（非负）
+ * @param velocity_ci 速度95%置信区间半宽，velocity不超过该值时视为静止，不进入反速度序列
+ * @param lag_ms 速度估计的滞后 (ms)，窗口拟合速度对应窗口中点，反速度点记在timestamp - lag_ms
+ */
+void Forecast_AddVelocity(ForecastSource source, uint32_t timestamp, float velocity, float velocity_ci,
+                          uint32_t lag_ms);
+
+/**
+ * @brief 输入一个倾角样本（按FORECAST_TILT_BLOCK_MS分块平均，块结束时以跨FORECAST_TILT_RATE_BLOCKS块的
+ *        均值差分作为倾斜速率输入，倾斜方向反转时清空倾斜序列，避免往复变化被当作加速）
+ * @param timestamp 时间戳 (ms)
+ * @param angle 总倾斜角度 (°)
+ */
+void Forecast_AddTiltSample(uint32_t timestamp, float angle);
+
+/**
+ * @brief 获取指定数据源的预测
+ * @param source 数据源
+ * @param forecast 预测结果
+ * @return 0: 成功, -1: 参数错误或未初始化
+ */
+int Forecast_Get(ForecastSource source, FailureForecast *forecast);
+
+/**
+ * @brief 获取最紧迫的预测（置信度达标的数据源中升级等级最高、同级时剩余时间最短者）
+ * @param forecast 预测结果（无有效预测时valid为false）
+ * @return 0: 成功, -1: 参数错误或未初始化
+ */
+int Forecast_GetMostUrgent(FailureForecast *forecast);
+
+/**
+ * @brief 根据预测结果给出风险升级等级（按剩余时间下限；下限不确定时最多升至中风险）
+ * @param forecast 预测结果
+ * @return 风险升级等级
+ */
+ForecastLevel Forecast_GetLevel(const FailureForecast *forecast);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FAILURE_FORECAST_H
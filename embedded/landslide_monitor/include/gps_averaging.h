@@ -0,0 +1,94 @@
+#ifndef GPS_AVERAGING_H
+#define GPS_AVERAGING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "gps_enu.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 静态历元平均配置
+#define GPS_AVG_SESSION_MS          (30 * 60 * 1000)    // 默认平均时段长度（每时段输出一个测站坐标）
+#define GPS_AVG_MIN_SESSION_MS      (60 * 1000)         // 最短平均时段
+#define GPS_AVG_MAX_SESSION_MS      (24 * 3600 * 1000)  // 最长平均时段
+#define GPS_AVG_MAX_EPOCHS          300                 // 每时段最多保存的历元数（超出后按2倍抽稀）
+#define GPS_AVG_MIN_EPOCHS          30                  // 时段内有效历元少于该值时不输出坐标
+#define GPS_AVG_MAX_OFFSET_M        30.0f               // 相对时段首历元的最大偏移，超出视为粗差
+#define GPS_AVG_OUTLIER_K           3.0f                // 粗差门限：中位数 ± K × 1.4826 × MAD
+#define GPS_AVG_OUTLIER_FLOOR_MM    50                  // 粗差门限下限 (毫米)，避免MAD过小误剔
+#define GPS_AVG_CORRELATION_S       120                 // 定位误差相关时间 (秒)，用于估计独立样本数
+
+// 时段内单个历元（相对时段首历元的东/北/天偏移，毫米）
+typedef struct {
+    int16_t east;
+    int16_t north;
+    int16_t up;
+} GpsAvgEpoch;
+
+// 时段平均测站坐标
+typedef struct {
+    double latitude;                // 纬度
+    double longitude;               // 经度
+    float altitude;                 // 海拔高度 (米)
+    float sigma_h;                  // 水平坐标标准误差 (米)
+    float sigma_v;                  // 垂直坐标标准误差 (米)
+    float median_offset;            // 中位数与均值的水平偏差 (米)，较大说明时段内存在多路径等偏态误差
+    uint16_t epochs_used;           // 剔除粗差后参与平均的历元数
+    uint32_t epochs_total;          // 时段内接收的历元数
+    uint32_t start_time;            // 时段开始时间 (ms)
+    uint32_t end_time;              // 时段结束时间 (ms)
+    bool valid;
+} GpsAvgSolution;
+
+// 平均器状态（调用者持有，内存固定）
+typedef struct {
+    GpsAvgEpoch epochs[GPS_AVG_MAX_EPOCHS];
+    int32_t scratch[GPS_AVG_MAX_EPOCHS];    // 排序求中位数用（绝对偏差可达2×GPS_AVG_MAX_OFFSET_M，超出int16范围）
+    GpsEnuFrame frame;              // 以时段首历元为原点的站心坐标系
+    uint32_t session_ms;            // 时段长度
+    uint32_t start_time;
+    uint32_t last_time;
+    uint32_t last_input_time;       // 上一个输入历元的时间戳（同一定位结果重复输入时相同）
+    uint16_t count;                 // 已保存历元数
+    uint32_t received;              // 时段内接收的历元数
+    uint16_t stride;                // 抽稀步长（每stride个历元保存一个）
+    bool active;
+    uint32_t sessions;              // 输出的测站坐标数
+    uint32_t discarded_sessions;    // 历元不足被丢弃的时段数
+    uint32_t outliers;              // 剔除的粗差历元数
+    uint32_t duplicates;            // 时间戳与上一历元相同而忽略的输入数
+} GpsAverager;
+
+/**
+ * @brief 初始化平均器
+ * @param avg 平均器
+ * @param session_ms 平均时段长度 (ms)
+ */
+void GpsAvg_Init(GpsAverager *avg, uint32_t session_ms);
+
+/**
+ * @brief 丢弃当前时段
+ * @param avg 平均器
+ */
+void GpsAvg_Reset(GpsAverager *avg);
+
+/**
+ * @brief 输入一个已通过质量检查的历元
+ * @param avg 平均器
+ * @param latitude 纬度
+ * @param longitude 经度
+ * @param altitude 海拔高度 (米)
+ * @param timestamp 定位结果的更新时间 (ms)，与上一输入相同时视为同一历元的重复输入
+ * @param solution 时段结束时输出的测站坐标
+ * @return 1: 时段结束且solution有效, 0: 历元已累加, -1: 历元偏移过大被剔除, -2: 重复历元被忽略
+ */
+int GpsAvg_AddEpoch(GpsAverager *avg, double latitude, double longitude, float altitude,
+                    uint32_t timestamp, GpsAvgSolution *solution);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // GPS_AVERAGING_H
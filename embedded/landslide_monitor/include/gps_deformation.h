@@ -4,6 +4,9 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "gps_module.h"
+#include "gps_averaging.h"
+#include "gps_enu.h"
+#include "gps_trend.h"
 
 #ifndef size_t
 typedef unsigned int size_t;
@@ -14,11 +17,14 @@ extern "C" {
 #endif
 
 // GPS形变监测配置
-#define GPS_DEFORM_HISTORY_SIZE     50      // 历史位置记录数量
+#define GPS_DEFORM_HISTORY_SIZE     50      // 历史位置记录数量（时段平均坐标）
 #define GPS_DEFORM_MIN_ACCURACY     20.0f   // 最小精度要求 (米)
-#define GPS_DEFORM_ALERT_DISTANCE   2.0f    // 位移警报阈值 (米)
-#define GPS_DEFORM_CRITICAL_DISTANCE 5.0f   // 位移危险阈值 (米)
-#define GPS_DEFORM_VELOCITY_WINDOW  10      // 速度计算窗口 (数据点)
+#define GPS_DEFORM_MIN_SATELLITES   5       // 最少参与定位卫星数
+#define GPS_DEFORM_MAX_PDOP         6.0f    // 最大位置精度因子
+#define GPS_DEFORM_ALERT_DISTANCE   2.0f    // 位移警报阈值默认值 (米)
+#define GPS_DEFORM_CRITICAL_DISTANCE 5.0f   // 位移危险阈值默认值 (米)
+#define GPS_DEFORM_PERSIST_SIZE     24      // 保存到Flash的最近时段平均坐标数（覆盖趋势拟合长窗口）
+#define GPS_DEFORM_RESTORE_MAX_AGE_S (7 * 24 * 3600)   // 重启后早于该时长的已保存坐标不参与速度拟合
 
 // 地质形变类型
 typedef enum {
@@ -46,10 +52,14 @@ typedef struct {
     float accuracy;                 // 定位精度
     uint32_t timestamp;             // 时间戳
     bool valid;                     // 数据有效性
+    bool differential;              // 差分改正后的坐标（占用原填充字节，旧版本保存的基准为单点定位）
 } GPSPositionRecord;
 
-// 位移向量
+// 位移向量（基准站心坐标系）
 typedef struct {
+    float east;                     // 东向位移 (米)
+    float north;                    // 北向位移 (米)
+    float up;                       // 垂直位移 (米)
     float distance_2d;              // 2D位移距离 (米)
     float distance_3d;              // 3D位移距离 (米)
     float horizontal_distance;      // 水平位移距离 (米)
@@ -59,13 +69,17 @@ typedef struct {
     uint32_t time_span;             // 时间跨度 (秒)
 } DisplacementVector;
 
-// 形变速度
+// 形变速度（时段平均坐标最小二乘拟合）
 typedef struct {
     float horizontal_velocity;      // 水平速度 (米/小时)
     float vertical_velocity;        // 垂直速度 (米/小时)
     float total_velocity;           // 总速度 (米/小时)
-    float acceleration;             // 加速度 (米/小时²)
-    bool is_accelerating;           // 是否在加速
+    float acceleration;             // 沿运动方向的加速度 (米/小时²)
+    bool is_accelerating;           // 加速度显著大于0（下限超过0）
+    float velocity_ci;              // 总速度95%置信区间半宽 (米/小时)
+    float acceleration_ci;          // 加速度95%置信区间半宽 (米/小时²)
+    GpsTrendFit short_term;         // 短窗口各分量拟合（速度取自此窗口）
+    GpsTrendFit long_term;          // 长窗口各分量拟合（加速度优先取自此窗口）
 } DeformationVelocity;
 
 // 形变统计信息
@@ -75,10 +89,49 @@ typedef struct {
     float avg_velocity;             // 平均速度 (米/小时)
     float max_velocity;             // 最大速度 (米/小时)
     uint32_t alert_count;           // 警报次数
+    uint32_t rejected_epochs;       // 定位质量不足被剔除的历元数
+    uint32_t outlier_epochs;        // 时段平均中剔除的粗差历元数
+    uint32_t solutions;             // 时段平均坐标数
+    uint32_t discarded_sessions;    // 有效历元不足被丢弃的时段数
+    uint32_t restored_solutions;    // 启动时从Flash恢复的时段平均坐标数
+    uint32_t mode_changes;          // 单点/差分模式切换次数（每次切换丢弃当前时段）
+    uint32_t mode_skipped;          // 与基准模式不同而未参与形变分析的时段坐标数
     uint32_t monitoring_duration;   // 监测时长 (秒)
     DeformationType dominant_type;  // 主要形变类型
 } DeformationStats;
 
+// 形变历史导出格式
+typedef enum {
+    GPS_EXPORT_FORMAT_BINARY = 0,   // GpsExportRecord按内存布局（小端）连续输出
+    GPS_EXPORT_FORMAT_CSV           // 首块带表头，每条记录一行
+} GpsExportFormat;
+
+#define GPS_EXPORT_FLAG_RESTORED    0x0001  // 启动时从Flash恢复的记录
+#define GPS_EXPORT_FLAG_DIFFERENTIAL 0x0002 // 差分改正后的坐标
+#define GPS_EXPORT_CSV_HEADER       "seq,utc,east_mm,north_mm,up_mm,sigma_h_mm,flags\n"
+
+// 形变历史导出记录（二进制格式每条24字节）
+typedef struct {
+    uint32_t sequence;              // 时段坐标序号（本次启动内单调递增）
+    uint32_t utc_seconds;           // 时段结束UTC时间（2000-01-01起秒数，0表示未知）
+    int32_t east;                   // 东向位移 (mm)
+    int32_t north;                  // 北向位移 (mm)
+    int32_t up;                     // 垂直位移 (mm)
+    uint16_t sigma_h;               // 水平标准误差 (mm)
+    uint16_t flags;                 // GPS_EXPORT_FLAG_*
+} GpsExportRecord;
+
+// 导出游标（由调用者保存，可分多次、多块导出，中断后从next_sequence继续）
+typedef struct {
+    uint32_t next_sequence;         // 下一条待导出记录的序号
+    uint32_t start_utc;             // 起始UTC时间（含，0表示不限）
+    uint32_t end_utc;               // 结束UTC时间（含，0表示不限）
+    uint32_t exported;              // 已导出记录数
+    uint32_t skipped;               // 导出前已被历史缓冲覆盖的记录数
+    uint8_t format;                 // GpsExportFormat
+    bool header_sent;               // CSV表头已输出
+} GpsExportCursor;
+
 // GPS形变分析结果
 typedef struct {
     // 基准位置
@@ -116,18 +169,27 @@ int GPS_Deformation_Init(void);
 void GPS_Deformation_Deinit(void);
 
 /**
- * @brief 设置基准位置
- * @param gps_data GPS数据
+ * @brief 添加GPS位置数据进行形变分析（单历元参与时段平均，时段结束时用平均坐标计算形变）
+ * @note 单点/差分模式切换时丢弃当前时段；基准为单点定位时首个差分时段坐标自动重建基准，
+ *       基准为差分时参考站中断期间的单点时段坐标不参与分析
+ * @param gps_data GPS数据（differential标记所属模式）
  * @return 0: 成功, 其他: 失败
  */
-int GPS_Deformation_SetBaseline(const GPSData *gps_data);
+int GPS_Deformation_AddPosition(const GPSData *gps_data);
 
 /**
- * @brief 添加GPS位置数据进行形变分析
- * @param gps_data GPS数据
- * @return 0: 成功, 其他: 失败
+ * @brief 设置时段平均长度（定位误差相关时间越长，需要的平均时段越长）
+ * @param period_ms 时段长度 (ms)，范围GPS_AVG_MIN_SESSION_MS ~ GPS_AVG_MAX_SESSION_MS
+ * @return 0: 成功, 其他: 参数无效
  */
-int GPS_Deformation_AddPosition(const GPSData *gps_data);
+int GPS_Deformation_SetAveragingPeriod(uint32_t period_ms);
+
+/**
+ * @brief 获取最近一个时段平均坐标
+ * @param solution 测站坐标
+ * @return 0: 成功, -2: 尚无平均坐标, 其他: 失败
+ */
+int GPS_Deformation_GetLastSolution(GpsAvgSolution *solution);
 
 /**
  * @brief 获取形变分析结果
@@ -149,10 +211,19 @@ bool GPS_Deformation_HasAlert(void);
 DeformationRisk GPS_Deformation_GetRiskLevel(void);
 
 /**
- * @brief 重置形变监测数据
+ * @brief 重置形变监测数据，删除已保存的基准位置和历史坐标，下一个时段平均坐标成为新基准
+ * @note 基准和历史在重启后自动恢复，只有显式命令才调用此函数重新建立基准
  */
 void GPS_Deformation_Reset(void);
 
+/**
+ * @brief 设置位移报警阈值（默认GPS_DEFORM_ALERT_DISTANCE/GPS_DEFORM_CRITICAL_DISTANCE）
+ * @param alert_distance 警报阈值 (米)
+ * @param critical_distance 危险阈值 (米)，须大于警报阈值
+ * @return 0: 成功, 其他: 参数无效
+ */
+int GPS_Deformation_SetThresholds(float alert_distance, float critical_distance);
+
 /**
  * @brief 计算两点间距离
  * @param lat1 点1纬度
@@ -185,12 +256,24 @@ void GPS_Deformation_GetStats(DeformationStats *stats);
 void GPS_Deformation_PrintDebugInfo(void);
 
 /**
- * @brief 导出形变历史数据
+ * @brief 开始导出形变历史（从当前最旧的历史记录开始）
+ * @param cursor 导出游标
+ * @param start_utc 起始UTC时间（含，0表示不限）
+ * @param end_utc 结束UTC时间（含，0表示不限）；设置任一时间范围时跳过UTC未知的记录
+ * @param format 导出格式
+ * @return 0: 成功, -1: 参数错误或未初始化
+ */
+int GPS_Deformation_ExportBegin(GpsExportCursor *cursor, uint32_t start_utc, uint32_t end_utc,
+                                GpsExportFormat format);
+
+/**
+ * @brief 按游标导出下一块形变历史（只写入完整记录，发送失败时恢复调用前的游标即可重发）
+ * @param cursor 导出游标
  * @param buffer 输出缓冲区
  * @param buffer_size 缓冲区大小
- * @return 实际写入的字节数
+ * @return 写入的字节数, 0: 已无更多记录（之后新增的记录可继续导出）, -1: 参数错误, -2: 缓冲区放不下一条记录
  */
-int GPS_Deformation_ExportHistory(char *buffer, size_t buffer_size);
+int GPS_Deformation_ExportNext(GpsExportCursor *cursor, uint8_t *buffer, size_t buffer_size);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,94 @@
+#ifndef GPS_DIFFERENTIAL_H
+#define GPS_DIFFERENTIAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "landslide_monitor.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 位置域差分配置（参考站与本站相距数公里以内、接收机型号相近时，两站单点定位误差大部分相同）
+#define GPS_DIFF_REF_SLOTS          32          // 参考站历元环形缓冲（按当日UTC秒索引，覆盖32秒链路延迟）
+#define GPS_DIFF_ROVER_QUEUE        32          // 等待配对的本站历元队列长度（1Hz历元覆盖最长等待时间）
+#define GPS_DIFF_MAX_WAIT_MS        30000       // 本站历元等待参考站同一历元的最长时间（不超过参考站缓冲覆盖时长）
+#define GPS_DIFF_REF_TIMEOUT_MS     (5 * 60 * 1000)     // 参考站数据中断超过该时长时退回单点定位
+#define GPS_DIFF_REF_INIT_EPOCHS    600         // 未设置参考站已知坐标时，以最初600个历元的均值作为已知坐标
+
+// 差分统计信息
+typedef struct {
+    uint32_t reference_epochs;      // 接收的参考站整秒历元数
+    uint32_t rover_epochs;          // 进入配对队列的本站历元数
+    uint32_t corrected;             // 配对成功并改正的历元数
+    uint32_t unmatched;             // 等待超时未配对而丢弃的历元数
+    uint32_t passthrough;           // 参考站中断期间按单点定位输出的历元数
+    uint32_t overflows;             // 队列满丢弃的历元数
+    float last_correction_h;        // 最近一次水平改正量 (米)
+    float last_correction_v;        // 最近一次垂直改正量 (米)
+    bool reference_known;           // 参考站已知坐标已建立
+    bool active;                    // 差分模式生效（参考站数据未中断）
+} GpsDiffStats;
+
+/**
+ * @brief 初始化位置域差分（恢复已保存的参考站已知坐标）
+ * @return 0: 成功, -1: 失败
+ */
+int GpsDiff_Init(void);
+
+/**
+ * @brief 反初始化位置域差分
+ */
+void GpsDiff_Deinit(void);
+
+/**
+ * @brief 设置参考站已知坐标（保存到Flash）
+ * @param latitude 纬度 (°)
+ * @param longitude 经度 (°)
+ * @param altitude 海拔 (米)
+ * @return 0: 成功, -1: 参数错误或未初始化
+ */
+int GpsDiff_SetReferencePosition(double latitude, double longitude, float altitude);
+
+/**
+ * @brief 输入参考站NMEA数据流（可来自MQTT、其他节点或回放文件，可按任意长度分块输入）
+ * @note 只使用GGA中整秒、定位有效的历元；差分模式在首个参考历元到达后启用，形变分析随后以差分坐标自动重建基准
+ * @param data NMEA字节流
+ * @param length 字节数
+ * @return 新增的参考站历元数, -1: 未初始化
+ */
+int GpsDiff_FeedReference(const char *data, uint32_t length);
+
+/**
+ * @brief 输入本站历元（同一UTC秒只取第一个历元）
+ * @param rover 本站GPS数据，需带UTC时间
+ * @return 0: 已入队, -2: 重复或无UTC时间, -1: 未初始化
+ */
+int GpsDiff_AddRover(const GPSData *rover);
+
+/**
+ * @brief 取出下一个可用于形变分析的本站历元（按时间顺序）
+ * @note 与参考站同一历元配对时减去参考站的观测误差；参考站中断时原样输出；等待超时的历元丢弃
+ * @param output 输出历元（raw_data为空；differential标记是否已改正，形变分析据此区分模式）
+ * @return 0: 有输出, -2: 暂无可输出的历元, -1: 未初始化
+ */
+int GpsDiff_GetCorrected(GPSData *output);
+
+/**
+ * @brief 差分模式是否生效
+ * @return true: 参考站数据在GPS_DIFF_REF_TIMEOUT_MS内有更新且已知坐标已建立
+ */
+bool GpsDiff_IsActive(void);
+
+/**
+ * @brief 获取差分统计信息
+ * @param stats 统计信息
+ * @return 0: 成功, -1: 参数错误或未初始化
+ */
+int GpsDiff_GetStats(GpsDiffStats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // GPS_DIFFERENTIAL_H
@@ -0,0 +1,68 @@
+#ifndef GPS_ENU_H
+#define GPS_ENU_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// WGS84椭球参数
+#define GPS_ENU_WGS84_A             6378137.0           // 长半轴 (米)
+#define GPS_ENU_WGS84_E2            6.69437999014e-3    // 第一偏心率平方
+
+// 站心坐标 (米)
+typedef struct {
+    float east;
+    float north;
+    float up;
+} GpsEnuVector;
+
+// 站心坐标系：在原点处预先计算经纬度到米的比例，之后每次投影只需几次乘加
+// 一阶近似：水平误差约为 距离² × tan(纬度) / 地球半径，距原点100m、纬度45°时约1.6mm；
+// 天向为椭球高差，未扣除地球曲率下降 距离² / (2 × 地球半径)（100m约0.8mm）
+typedef struct {
+    double latitude;                // 原点纬度
+    double longitude;               // 原点经度
+    float altitude;                 // 原点海拔 (米)
+    double east_per_degree;         // 经度1度对应的东向距离 (米)
+    double north_per_degree;        // 纬度1度对应的北向距离 (米)
+} GpsEnuFrame;
+
+/**
+ * @brief 以指定位置为原点建立站心坐标系（含三角函数，只在原点变化时调用）
+ * @param frame 坐标系
+ * @param latitude 原点纬度
+ * @param longitude 原点经度
+ * @param altitude 原点海拔 (米)
+ */
+void GpsEnu_InitFrame(GpsEnuFrame *frame, double latitude, double longitude, float altitude);
+
+/**
+ * @brief 经纬度转换为站心坐标
+ * @param frame 坐标系
+ * @param latitude 纬度
+ * @param longitude 经度
+ * @param altitude 海拔 (米)
+ * @param enu 站心坐标输出
+ */
+void GpsEnu_FromGeodetic(const GpsEnuFrame *frame, double latitude, double longitude, float altitude,
+                         GpsEnuVector *enu);
+
+/**
+ * @brief 站心坐标转换为经纬度
+ * @param frame 坐标系
+ * @param enu 站心坐标
+ * @param latitude 纬度输出
+ * @param longitude 经度输出
+ * @param altitude 海拔输出 (米)
+ */
+void GpsEnu_ToGeodetic(const GpsEnuFrame *frame, const GpsEnuVector *enu,
+                       double *latitude, double *longitude, float *altitude);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // GPS_ENU_H
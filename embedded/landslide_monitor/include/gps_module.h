@@ -4,6 +4,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "landslide_monitor.h"
+#include "nmea_parser.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -14,23 +15,29 @@ extern "C" {
 #define GPS_UART_RX                 GPIO0_PB6       // RX引脚
 #define GPS_UART_TX                 GPIO0_PB7       // TX引脚
 #define GPS_UART_BAUDRATE           9600            // GPS模块波特率
-#define GPS_RECV_BUF_SIZE           512             // 接收缓冲区大小
-#define GPS_MAX_SENTENCE_LEN        256             // NMEA语句最大长度
+#define GPS_UART_FIFO_SIZE          64              // UART硬件接收FIFO深度
+
+// 接收环形缓冲区：接收任务搬运UART数据，收到完整语句后才唤醒解析任务
+#define GPS_RX_RING_SIZE            2048            // 环形缓冲区大小（2的幂，9600波特率下约2.1秒数据，解析任务可滞后约两个1Hz输出周期；改用115200波特率时仅约180ms）
+#define GPS_RX_LINE_SLOTS           32              // 行结束时间戳槽位（2的幂，用于行延迟统计）
+#define GPS_RX_WAIT_MS              1000            // 解析任务最长等待时间（用于数据超时检测）
+// 接收轮询周期取硬件FIFO填满时间的一半（9600波特率33ms，115200波特率2ms）
+#define GPS_RX_POLL_MS              ((GPS_UART_FIFO_SIZE * 10 * 1000 / GPS_UART_BAUDRATE / 2) > 0 ? \
+                                     (GPS_UART_FIFO_SIZE * 10 * 1000 / GPS_UART_BAUDRATE / 2) : 1)
 
 // GPS数据更新间隔
 #define GPS_UPDATE_INTERVAL_MS      1000            // GPS数据更新间隔 1秒
 #define GPS_TIMEOUT_MS              5000            // GPS数据超时时间 5秒
 #define GPS_VALID_THRESHOLD         3               // 连续有效数据次数阈值
+#define GPS_LOG_INTERVAL_MS         10000           // 定位日志打印间隔（10Hz输出时避免刷屏）
 
-// NMEA语句类型
-typedef enum {
-    NMEA_TYPE_UNKNOWN = 0,
-    NMEA_TYPE_GGA,                  // 全球定位系统定位数据
-    NMEA_TYPE_RMC,                  // 推荐最小定位信息
-    NMEA_TYPE_GSA,                  // 当前卫星信息
-    NMEA_TYPE_GSV,                  // 可见卫星信息
-    NMEA_TYPE_VTG                   // 地面速度信息
-} NmeaType;
+// 等效测距误差UERE（米），精度估计 = DOP × UERE
+#define GPS_UERE_SINGLE             4.0f            // 单点定位
+#define GPS_UERE_DGPS               1.0f            // 差分定位
+#define GPS_UERE_RTK_FLOAT          0.5f            // RTK浮点解
+#define GPS_UERE_RTK_FIXED          0.05f           // RTK固定解
+#define GPS_ACCURACY_UNKNOWN        99.9f       // 无DOP信息时的精度 (米)
+#define GPS_WEAK_CN0                30              // 平均载噪比低于该值 (dB-Hz) 时精度估计放大1.5倍
 
 // GPS状态
 typedef enum {
@@ -43,28 +50,48 @@ typedef enum {
 
 // GPS统计信息
 typedef struct {
-    uint32_t total_sentences;       // 接收到的NMEA语句总数
-    uint32_t valid_sentences;       // 有效NMEA语句数
+    uint32_t total_sentences;       // 接收到的NMEA语句总数（含校验失败）
+    uint32_t valid_sentences;       // 有效定位次数
     uint32_t gga_count;             // GGA语句计数
     uint32_t rmc_count;             // RMC语句计数
-    uint32_t parse_errors;          // 解析错误次数
+    uint32_t gsa_count;             // GSA语句计数
+    uint32_t gsv_count;             // GSV语句计数
+    uint32_t vtg_count;             // VTG语句计数
+    uint32_t parse_errors;          // 解析错误次数（校验和错误+格式错误）
+    uint32_t rx_bytes;              // 接收字节数
+    uint32_t rx_overruns;           // 环形缓冲区满丢弃的字节数
+    uint32_t rx_lines;              // 接收完整语句行数
+    uint32_t rx_wakeups;            // 解析任务唤醒次数
+    uint32_t line_latency_avg_ms;   // 语句接收完成到解析的平均延迟
+    uint32_t line_latency_max_ms;   // 语句接收完成到解析的最大延迟
     uint32_t last_update_time;      // 最后更新时间
     GpsStatus status;               // GPS状态
 } GpsStats;
 
-// GPS模块内部数据结构
+// GNSS定位质量（由GGA/RMC/GSA/GSV/VTG按历元汇总）
 typedef struct {
-    char raw_sentence[GPS_MAX_SENTENCE_LEN];    // 原始NMEA语句
-    char latitude_str[16];                      // 纬度字符串
-    char longitude_str[16];                     // 经度字符串
-    char ns_indicator;                          // 南北半球指示符
-    char ew_indicator;                          // 东西半球指示符
-    char quality_indicator;                     // 定位质量指示符
-    uint8_t satellite_count;                    // 卫星数量
-    float hdop;                                 // 水平精度因子
-    float altitude;                             // 海拔高度
-    char altitude_unit;                         // 海拔单位
-} GpsRawData;
+    uint32_t utc_time_ms;                           // UTC时间（当日毫秒）
+    uint16_t utc_year;                              // UTC日期（来自RMC，0表示未知）
+    uint8_t utc_month;
+    uint8_t utc_day;
+    uint8_t fix_quality;                            // GGA定位质量
+    uint8_t fix_type;                               // GSA定位类型 (0=未知, 1=无, 2=2D, 3=3D)
+    uint8_t satellites_used;                        // 参与定位卫星数
+    uint8_t satellites_in_view;                     // 可见卫星数
+    uint8_t used_by_system[NMEA_SYSTEM_COUNT];      // 各系统参与定位卫星数
+    uint8_t in_view_by_system[NMEA_SYSTEM_COUNT];   // 各系统可见卫星数
+    uint16_t pdop;                                  // 精度因子 (0.01，0表示未知)
+    uint16_t hdop;
+    uint16_t vdop;
+    uint8_t cn0_mean;                               // 已跟踪卫星平均载噪比 (dB-Hz)
+    uint8_t cn0_max;                                // 最大载噪比 (dB-Hz)
+    uint8_t tracked;                                // 有载噪比的卫星数
+    uint32_t speed;                                 // 地面速度 (mm/s)
+    uint16_t course;                                // 航向 (0.01°)
+    float horizontal_accuracy;                      // 水平精度估计 (米)
+    float vertical_accuracy;                        // 垂直精度估计 (米)
+    uint32_t update_time;                           // 最后更新时间 (系统tick)
+} GpsQuality;
 
 /**
  * @brief 初始化GPS模块
@@ -108,38 +135,23 @@ void GPS_GetStats(GpsStats *stats);
 void GPS_ResetStats(void);
 
 /**
- * @brief GPS任务函数（内部使用）
- * @param arg 任务参数
- */
-void GPS_Task(void *arg);
-
-/**
- * @brief 解析GGA语句（内部使用）
- * @param sentence NMEA语句
+ * @brief 获取GNSS定位质量
+ * @param quality 定位质量结构指针
  * @return 0: 成功, 其他: 失败
  */
-int GPS_ParseGGA(const char *sentence);
+int GPS_GetQuality(GpsQuality *quality);
 
 /**
- * @brief 解析RMC语句（内部使用）
- * @param sentence NMEA语句
- * @return 0: 成功, 其他: 失败
- */
-int GPS_ParseRMC(const char *sentence);
-
-/**
- * @brief 转换坐标格式（内部使用）
- * @param coord_str 坐标字符串
- * @return 转换后的坐标值
+ * @brief GPS解析任务函数（内部使用）
+ * @param arg 任务参数
  */
-double GPS_ConvertCoordinate(const char *coord_str);
+void GPS_Task(void *arg);
 
 /**
- * @brief 验证NMEA校验和（内部使用）
- * @param sentence NMEA语句
- * @return true: 校验成功, false: 校验失败
+ * @brief GPS串口接收任务函数（内部使用）
+ * @param arg 任务参数
  */
-bool GPS_VerifyChecksum(const char *sentence);
+void GPS_RxTask(void *arg);
 
 /**
  * @brief 打印GPS调试信息
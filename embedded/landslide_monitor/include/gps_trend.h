@@ -0,0 +1,88 @@
+#ifndef GPS_TREND_H
+#define GPS_TREND_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "gps_enu.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 形变趋势拟合配置（样本为时段平均坐标）
+#define GPS_TREND_CAPACITY          24          // 保存的最近位置数（不小于最长窗口）
+#define GPS_TREND_SHORT_WINDOW      6           // 短窗口样本数（默认30分钟时段约3小时）
+#define GPS_TREND_LONG_WINDOW       24          // 长窗口样本数（默认30分钟时段约12小时）
+#define GPS_TREND_MIN_LINEAR        3           // 拟合速度的最少样本数
+#define GPS_TREND_MIN_QUADRATIC     5           // 拟合加速度的最少样本数
+
+// 拟合窗口
+typedef enum {
+    GPS_TREND_SHORT = 0,
+    GPS_TREND_LONG,
+    GPS_TREND_WINDOW_COUNT
+} GpsTrendWindowId;
+
+// 单个窗口的拟合结果（东/北/天三个分量，置信区间为95%半宽）
+typedef struct {
+    float velocity[3];              // 速度 (米/小时)，线性拟合
+    float velocity_ci[3];
+    float acceleration[3];          // 加速度 (米/小时²)，二次拟合
+    float acceleration_ci[3];
+    float span_hours;               // 窗口时间跨度 (小时)
+    uint16_t samples;               // 参与拟合的样本数
+    bool valid;                     // 速度有效
+    bool acceleration_valid;        // 加速度有效
+} GpsTrendFit;
+
+// 窗口累加和（以ref_ms为时间零点，单位小时）
+typedef struct {
+    uint16_t size;                  // 窗口长度
+    uint16_t count;                 // 当前样本数
+    double st[5];                   // Σt^k (k=0..4)
+    double sx[3][3];                // 各分量 Σx, Σt·x, Σt²·x
+    double sxx[3];                  // 各分量 Σx²
+} GpsTrendWindow;
+
+typedef struct {
+    uint32_t timestamp;             // 时间戳 (ms)
+    GpsEnuVector position;          // 基准站心坐标
+} GpsTrendSample;
+
+// 趋势估计器（调用者持有，内存固定，每次更新O(1)）
+typedef struct {
+    GpsTrendSample samples[GPS_TREND_CAPACITY];
+    GpsTrendWindow windows[GPS_TREND_WINDOW_COUNT];
+    uint32_t total;                 // 累计输入样本数
+    uint32_t ref_ms;                // 时间零点
+    uint32_t ref_index;             // 时间零点对应的样本序号
+} GpsTrend;
+
+/**
+ * @brief 初始化趋势估计器
+ * @param trend 估计器
+ */
+void GpsTrend_Init(GpsTrend *trend);
+
+/**
+ * @brief 输入一个位置样本（所有窗口的累加和增量更新）
+ * @param trend 估计器
+ * @param timestamp 时间戳 (ms)，须单调递增
+ * @param position 基准站心坐标
+ */
+void GpsTrend_Add(GpsTrend *trend, uint32_t timestamp, const GpsEnuVector *position);
+
+/**
+ * @brief 计算窗口拟合结果（速度为线性拟合斜率，加速度为二次拟合二次项系数的2倍）
+ * @param trend 估计器
+ * @param window 窗口
+ * @param fit 拟合结果
+ * @return 0: 成功, -1: 样本不足
+ */
+int GpsTrend_GetFit(const GpsTrend *trend, GpsTrendWindowId window, GpsTrendFit *fit);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // GPS_TREND_H
@@ -36,111 +36,63 @@ extern "C" {
 #define PUBLISH_TOPIC "$oc/devices/" DEVICE_ID "/sys/properties/report"
 #define SUBSCRIBE_TOPIC "$oc/devices/" DEVICE_ID "/sys/commands/+"
 #define RESPONSE_TOPIC "$oc/devices/" DEVICE_ID "/sys/commands/response"
+#define EXPORT_TOPIC "$oc/devices/" DEVICE_ID "/user/deformation_history"   // 形变历史分块导出
+#define PROFILE_TOPIC "$oc/devices/" DEVICE_ID "/user/task_profile"         // 任务统计定期上报（命令开启）
 
 // WiFi配置（基于用户偏好设置）
 #define WIFI_SSID "188"
 #define WIFI_PASSWORD "88888888"
 
-// 兼容性数据结构（原有的LandslideIotData）
-typedef struct {
-    // 基础传感器数据
-    float temperature;      // 温度 (°C)
-    float humidity;         // 湿度 (%)
-    float light;           // 光照强度 (lux)
-
-    // MPU6050 数据
-    float accel_x;         // X轴加速度 (g)
-    float accel_y;         // Y轴加速度 (g)
-    float accel_z;         // Z轴加速度 (g)
-    float gyro_x;          // X轴陀螺仪 (°/s)
-    float gyro_y;          // Y轴陀螺仪 (°/s)
-    float gyro_z;          // Z轴陀螺仪 (°/s)
-    float angle_x;         // X轴倾斜角度 (°)
-    float angle_y;         // Y轴倾斜角度 (°)
-    float angle_z;         // Z轴倾斜角度 (°)
-    float vibration;       // 振动强度
-
-    // 系统状态
-    int risk_level;        // 风险等级 (0-4)
-    bool alarm_active;     // 报警状态
-    uint32_t uptime;       // 系统运行时间 (秒)
+// 上报数据定点缩放系数
+#define IOT_DEFORM_DISTANCE_SCALE   1000.0f     // 形变位移 mm、形变速度 mm/h、加速度 mm/h²
+#define IOT_DEFORM_CONFIDENCE_SCALE 1000.0f     // 形变置信度、预测置信度 0.001
 
-    // GPS定位数据
-    double gps_latitude;   // GPS纬度
-    double gps_longitude;  // GPS经度
-    float gps_altitude;    // GPS海拔高度 (米)
-    bool gps_valid;        // GPS数据有效性
-
-    // GPS形变分析数据
-    float deformation_distance_3d;      // 3D总位移距离 (米)
-    float deformation_horizontal;       // 水平位移距离 (米)
-    float deformation_vertical;         // 垂直位移距离 (米)
-    float deformation_velocity;         // 形变速度 (米/小时)
-    int deformation_risk_level;         // 形变风险等级 (0-4)
-    int deformation_type;               // 形变类型 (0-4)
-    float deformation_confidence;       // 形变分析置信度 (0.0-1.0)
-    bool baseline_established;          // 基准位置是否建立
-
-    // 扩展字段
-    bool rgb_enabled;      // RGB LED使能
-    bool buzzer_enabled;   // 蜂鸣器使能
-    bool motor_enabled;    // 电机使能
-    bool voice_enabled;    // 语音使能
-} LandslideIotData;
+// 上报数据状态位
+#define IOT_DATA_FLAG_ALARM_ACTIVE  0x01        // 报警激活
+#define IOT_DATA_FLAG_BASELINE      0x02        // GPS形变基准已建立
 
-// 华为云IoT平台数据结构（完全匹配云端字段定义）
+// 上报数据记录：内嵌采集任务生成的规范采样记录，只追加系统状态和形变分析字段
+// 缓存队列与Flash日志直接保存此结构，上报时由send_msg_to_mqtt按云端字段定义序列化
+// （总倾斜角度、振动强度等派生值由Sample_Get*读取视图计算，不重复存储）
 typedef struct {
-    // 基础环境传感器数据（decimal类型）
-    double temperature;        // 温度 (°C) - decimal
-    double illumination;       // 光照强度 (lux) - decimal
-    double humidity;          // 湿度 (%) - decimal
-
-    // MPU6050加速度数据（long类型 - 云端单位：g）
-    long acceleration_x;      // X轴加速度(g×1000) - 云端除以1000显示为g
-    long acceleration_y;      // Y轴加速度(g×1000) - 云端除以1000显示为g
-    long acceleration_z;      // Z轴加速度(g×1000) - 云端除以1000显示为g
-
-    // MPU6050陀螺仪数据（long类型 - 云端单位：°/s）
-    long gyroscope_x;         // X轴陀螺仪(°/s×100) - 云端除以100显示为°/s
-    long gyroscope_y;         // Y轴陀螺仪(°/s×100) - 云端除以100显示为°/s
-    long gyroscope_z;         // Z轴陀螺仪(°/s×100) - 云端除以100显示为°/s
-
-    // MPU6050温度（decimal类型）
-    double mpu_temperature;   // MPU6050温度 - decimal
-
-    // GPS定位数据（decimal类型）
-    double latitude;          // 纬度 - decimal
-    double longitude;         // 经度 - decimal
+    SampleRecord sample;                // 规范采样记录
 
-    // 振动传感器数据（decimal类型）
-    double vibration;         // 振动传感器数值 - decimal
-
-    // 滑坡监测专用数据
-    int risk_level;           // 山体滑坡风险等级 (0安全,1低风险,2中风险,3高风险,4极高风险) - int
-    bool alarm_active;        // 当前报警状态 (true=激活) - boolean
-    long uptime;              // 系统运行时间 (秒) - long
-
-    // 倾角数据（decimal类型）
-    double angle_x;           // X轴倾角 (°) - decimal
-    double angle_y;           // Y轴倾角 (°) - decimal
-    double angle_z;           // 总倾斜角度（基于X、Y轴计算） - decimal
+    // 系统状态
+    uint32_t uptime;                    // 系统运行时间 (秒)
 
     // GPS形变分析数据
-    double deformation_distance_3d;      // 3D总位移距离 (米) - decimal
-    double deformation_horizontal;       // 水平位移距离 (米) - decimal
-    double deformation_vertical;         // 垂直位移距离 (米) - decimal
-    double deformation_velocity;         // 形变速度 (米/小时) - decimal
-    int deformation_risk_level;          // 形变风险等级 (0-4) - int
-    int deformation_type;                // 形变类型 (0-4) - int
-    double deformation_confidence;       // 形变分析置信度 (0.0-1.0) - decimal
-    bool baseline_established;           // 基准位置是否建立 - boolean
-} e_iot_data;
+    int32_t deformation_distance_3d;    // 3D总位移距离 (mm)
+    int32_t deformation_horizontal;     // 水平位移距离 (mm)
+    int32_t deformation_vertical;       // 垂直位移距离 (mm)
+    int32_t deformation_velocity;       // 形变速度 (mm/h)
+    int32_t deformation_east;           // 东向位移 (mm)
+    int32_t deformation_north;          // 北向位移 (mm)
+    int32_t deformation_velocity_ci;    // 形变速度95%置信区间半宽 (mm/h)
+    int32_t deformation_acceleration;   // 沿运动方向的加速度 (mm/h²)
+    int32_t forecast_time_to_failure;   // 预测失稳剩余时间 (分钟，-1表示无预测)
+    uint16_t deformation_confidence;    // 形变分析置信度 (0.001)
+    uint16_t forecast_confidence;       // 失稳预测置信度 (0.001)
+    uint16_t sample_rate_requested;     // 请求采样频率 (0.1Hz)
+    uint16_t sample_rate_achieved;      // 实测采样频率 (0.1Hz)
+    uint16_t alarm_latency;             // 采样到报警输出的平均延迟 (ms)
+    uint16_t alarm_latency_max;         // 采样到报警输出的最大延迟 (ms)
+    int16_t anomaly_score;              // 多传感器异常分数 (0.01)
+    uint16_t moisture_index;            // 前期湿润综合指数 (0.001)
+    uint16_t infiltration_index;        // 短时间尺度湿润指数 (0.001)
+    uint16_t tilt_creep;                // 倾斜蠕变统计量 (0.01，>=100为报警)
+    uint8_t deformation_risk_level;     // 形变风险等级 (0-4)
+    uint8_t deformation_type;           // 形变类型 (0-4)
+
+    uint8_t risk_level;                 // 风险等级 (0-4)
+    uint8_t flags;                      // 状态位 IOT_DATA_FLAG_*
+    uint16_t reserved;
+} LandslideIotData;
 
 // MQTT 核心功能（基于成熟版本）
 void mqtt_init(void);
 int wait_message(void);
 unsigned int mqtt_is_connected(void);
-void send_msg_to_mqtt(e_iot_data *iot_data);
+void send_msg_to_mqtt(const LandslideIotData *iot_data);
 
 // 扩展功能
 int IoTCloud_Init(void);
@@ -165,33 +117,11 @@ void IoTCloud_HandleVoiceCommand(bool enable);
 void IoTCloud_HandleSystemRebootCommand(void);
 void IoTCloud_HandleConfigUpdateCommand(const char *config_json);
 void IoTCloud_HandleCalibrationCommand(void);
+void IoTCloud_HandleRebaselineCommand(void);
+void IoTCloud_HandleExportCommand(uint32_t start_utc, uint32_t end_utc, bool binary);
+void IoTCloud_HandleReferenceCommand(const char *payload);
 void IoTCloud_HandleTestModeCommand(bool enable);
-
-// 数据缓存和重发配置
-#define MAX_CACHE_SIZE 100              // 最大缓存数据条数
-#define CACHE_FILE_PATH "/data/iot_cache.dat"  // 缓存文件路径
-#define MAX_RETRY_COUNT 3               // 最大重试次数
-#define RETRY_INTERVAL_MS 5000          // 重试间隔(毫秒)
-
-// 缓存数据项结构
-typedef struct {
-    e_iot_data data;                    // IoT数据
-    uint32_t timestamp;                 // 时间戳
-    uint8_t retry_count;                // 重试次数
-    bool is_valid;                      // 数据有效标志
-} CachedDataItem;
-
-// 数据缓存管理结构
-typedef struct {
-    CachedDataItem items[MAX_CACHE_SIZE];  // 缓存数据数组
-    uint16_t head;                      // 队列头指针
-    uint16_t tail;                      // 队列尾指针
-    uint16_t count;                     // 当前缓存数量
-    bool is_full;                       // 缓存满标志
-    uint32_t total_cached;              // 总缓存数量统计
-    uint32_t total_sent;                // 总发送成功数量统计
-    uint32_t total_failed;              // 总发送失败数量统计
-} DataCache;
+void IoTCloud_HandleTaskProfileCommand(uint32_t interval_s);
 
 // 连接状态和统计信息
 typedef struct {
@@ -202,17 +132,10 @@ typedef struct {
     uint32_t reconnect_count;           // 重连次数
     uint32_t last_data_send_time;       // 上次数据发送时间
     uint32_t network_error_count;       // 网络错误次数
+    uint32_t data_sent_count;           // 数据上传成功次数（含缓存补发）
 } ConnectionStatus;
 
-// 数据缓存和重发功能
-int DataCache_Init(void);
-int DataCache_Add(const e_iot_data *data);
-int DataCache_SendPending(void);
-int DataCache_SaveToFile(void);
-int DataCache_LoadFromFile(void);
-int DataCache_LoadFromFlash(void);  // 从Flash加载数据到内存缓存
-void DataCache_Clear(void);
-void DataCache_PrintStats(void);
+// 数据缓存功能见data_cache.h
 
 // 连接状态管理
 void ConnectionStatus_Update(void);
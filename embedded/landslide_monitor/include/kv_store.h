@@ -0,0 +1,92 @@
+#ifndef KV_STORE_H
+#define KV_STORE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "data_storage.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// KV存储Flash分区：两个扇区轮换，活动扇区顺序追加，写满后把各键最新值压缩到另一扇区
+#define KV_FLASH_ADDR               0x238000    // 起始地址（紧跟归档区）
+#define KV_FLASH_SECTORS            2           // 扇区数（固定为2，轮换使用）
+#define KV_SECTOR_MAGIC             0x3153564B  // 扇区头魔数 "KVS1"
+#define KV_MAX_KEYS                 32          // 键ID范围 1 ~ KV_MAX_KEYS-1
+#define KV_MAX_VALUE_SIZE           512         // 单个值最大长度
+
+// 键ID分配（只能追加，已废弃的ID不再复用）
+typedef enum {
+    KV_KEY_RUNTIME_CONFIG = 1,      // 运行配置（云端下发）
+    KV_KEY_GYRO_CALIBRATION = 2,    // 陀螺仪零偏校准
+    KV_KEY_GPS_BASELINE = 3,        // GPS形变基准位置
+    KV_KEY_GPS_HISTORY = 4,         // GPS形变最近时段平均坐标（相对基准）
+    KV_KEY_GPS_REFERENCE = 5,       // 差分参考站已知坐标
+    KV_KEY_SAMPLE_RATE = 6,         // 传感器请求采样频率（云端下发）
+    KV_KEY_RISK_RULES = 7,          // 风险规则表（云端下发）
+    KV_KEY_MOISTURE_INDEX = 8,      // 前期湿润指数
+    KV_KEY_TILT_CREEP_CONFIG = 9,   // 倾斜蠕变检测参数（云端下发）
+} KvKey;
+
+// KV存储统计信息
+typedef struct {
+    uint32_t active_addr;           // 活动扇区地址
+    uint32_t generation;            // 活动扇区代数（每次压缩加1）
+    uint32_t key_count;             // 有效键数量
+    uint32_t used_bytes;            // 活动扇区已用字节
+    uint32_t live_bytes;            // 有效数据字节（压缩后占用）
+    uint32_t writes;                // 本次启动写入次数
+    uint32_t compactions;           // 本次启动压缩次数
+} KvStoreStats;
+
+/**
+ * @brief 初始化KV存储并建立内存索引（需在DataStorage_Init之后调用）
+ * @return 0: 成功, 其他: 失败
+ */
+int KvStore_Init(void);
+
+/**
+ * @brief 读取键值（通过内存索引直接定位）
+ * @param key 键ID
+ * @param value 输出缓冲区
+ * @param size 期望长度（须与存储长度一致，防止结构体变更后误用旧数据）
+ * @return 0: 成功, -1: 键不存在, 其他: 长度不符或读取失败
+ */
+int KvStore_Get(uint16_t key, void *value, uint16_t size);
+
+/**
+ * @brief 写入键值（新值完整写入并校验后才生效，掉电时保留旧值）
+ * @param key 键ID
+ * @param value 值
+ * @param size 值长度
+ * @return 0: 成功, 其他: 失败
+ */
+int KvStore_Set(uint16_t key, const void *value, uint16_t size);
+
+/**
+ * @brief 删除键
+ * @param key 键ID
+ * @return 0: 成功, 其他: 失败
+ */
+int KvStore_Delete(uint16_t key);
+
+/**
+ * @brief 检查键是否存在
+ * @param key 键ID
+ * @return true: 存在, false: 不存在
+ */
+bool KvStore_Exists(uint16_t key);
+
+/**
+ * @brief 获取KV存储统计信息
+ * @param stats 统计信息
+ * @return 0: 成功, 其他: 失败
+ */
+int KvStore_GetStats(KvStoreStats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // KV_STORE_H
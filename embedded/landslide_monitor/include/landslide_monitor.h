@@ -18,6 +18,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "sample_record.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -25,10 +26,19 @@ extern "C" {
 
 // 系统配置参数（优化响应速度）
 #ifndef SENSOR_SAMPLE_RATE_HZ
-#define SENSOR_SAMPLE_RATE_HZ       15      // 传感器采样频率 15Hz
+#define SENSOR_SAMPLE_RATE_HZ       15      // 传感器采样频率 15Hz（默认值，可由云端调整）
 #endif
+#define SENSOR_SAMPLE_RATE_MIN_HZ   1       // 最低采样频率
+#define SENSOR_SAMPLE_RATE_MAX_HZ   50      // 最高采样频率（100kHz I2C读取MPU6050约2ms，另受MPU6050低通带宽限制）
+#define SENSOR_ENV_INTERVAL_MS      500     // 温湿度/光照读取间隔（SHT30每次测量等待20ms，不随采样频率提高）
+#define SENSOR_BUS_MARGIN           1.25f   // 采样周期至少为平均读取耗时的该倍数
+#define SENSOR_RATE_WINDOW_MS       5000    // 实测采样频率统计窗口
+#define VIBRATION_FILTER_TAU_MS     190.0f  // 振动强度低通滤波时间常数（15Hz时系数约0.3）
 #define DATA_BUFFER_SIZE           100      // 数据缓冲区大小
-#define RISK_EVAL_INTERVAL_MS      200      // 风险评估间隔 200ms
+#define PIPELINE_QUEUE_LENGTH      8        // 采集→处理、处理→风险评估消息队列长度（满时丢弃新消息并计数）
+#define PIPELINE_WAIT_MS           1000     // 处理任务等待新样本的最长时间（超时后检查系统状态）
+#define RISK_EVAL_IDLE_MS          200      // 无新处理结果时风险评估任务检查手动复位的间隔
+#define ALARM_TASK_INTERVAL_MS     200      // 无新评估结果时报警任务的轮询间隔（语音、上传、按键）
 #define LCD_UPDATE_INTERVAL_MS     2000     // LCD更新间隔 2秒
 #define LCD_DATA_CHANGE_THRESHOLD  0.3f    // 数据变化阈值（更敏感）
 #define VOICE_REPORT_INTERVAL_S    15       // 语音播报间隔 15秒
@@ -43,35 +53,8 @@ extern "C" {
 // 线程栈大小
 #define THREAD_STACK_SIZE          4096     // 线程栈大小 4KB
 
-// 传感器数据结构
-typedef struct {
-    // MPU6050数据
-    float accel_x;              // X轴加速度 (g)
-    float accel_y;              // Y轴加速度 (g) 
-    float accel_z;              // Z轴加速度 (g)
-    float gyro_x;               // X轴角速度 (°/s)
-    float gyro_y;               // Y轴角速度 (°/s)
-    float gyro_z;               // Z轴角速度 (°/s)
-    float angle_x;              // X轴倾角 (度)
-    float angle_y;              // Y轴倾角 (度)
-    float mpu_temperature;      // MPU6050温度 (°C)
-    
-    // SHT30数据
-    float sht_temperature;      // SHT30温度 (°C)
-    float humidity;             // 湿度 (%)
-    
-    // BH1750数据
-    float light_intensity;      // 光照强度 (lux)
-
-    // GPS定位数据
-    double gps_latitude;        // GPS纬度
-    double gps_longitude;       // GPS经度
-    float gps_altitude;         // GPS海拔高度 (米)
-    bool gps_valid;             // GPS数据有效性
-
-    uint32_t timestamp;         // 时间戳 (ms)
-    bool data_valid;            // 数据有效标志
-} SensorData;
+// 传感器数据：采集任务生成的规范采样记录（定点存储，通过Sample_Get*读取）
+typedef SampleRecord SensorData;
 
 // 处理后的数据结构
 typedef struct {
@@ -82,7 +65,16 @@ typedef struct {
     float humidity_trend;       // 湿度变化趋势
     float light_change_rate;    // 光照变化率
     float vibration_intensity;  // 振动强度
-    uint32_t timestamp;         // 时间戳
+    uint32_t timestamp;         // 时间戳（所处理样本的采样时间）
+    uint32_t sequence;          // 所处理样本的采样序号
+    float anomaly_score;        // 多传感器异常分数（等效正态分位数，预热期间为0）
+    float moisture_index;       // 前期湿润综合指数 (0.0-1.0)
+    float infiltration_index;   // 短时间尺度湿润指数 (0.0-1.0)，降雨入渗代理量
+    float tilt_creep;           // 倾斜蠕变CUSUM统计量（与报警阈值之比，>=1为报警）
+    uint32_t creep_onset;       // 估计的蠕变起始时刻 (ms)，无时为0
+    float humidity;             // 所处理样本的湿度 (%)
+    float temperature;          // 所处理样本的温度 (°C)
+    float data_quality;         // 所处理样本的数据质量 (0.0-0.9)：有效性、传感器合理性和一致性
 } ProcessedData;
 
 // GPS定位数据
@@ -90,8 +82,15 @@ typedef struct {
     double latitude;                // 纬度
     double longitude;               // 经度
     float altitude;                 // 海拔高度 (米)
-    float accuracy;                 // 定位精度 (米)
+    float accuracy;                 // 水平精度估计 (米，HDOP×等效测距误差)
+    float vertical_accuracy;        // 垂直精度估计 (米)
+    float pdop;                     // 位置精度因子 (0表示未知)
+    uint8_t fix_quality;            // 定位质量 (1=单点, 2=差分, 4=RTK固定, 5=RTK浮点)
+    uint8_t fix_type;               // 定位类型 (0=未知, 2=2D, 3=3D)
+    uint8_t satellites_used;        // 参与定位卫星数
+    uint32_t utc_seconds;           // UTC时间 (2000-01-01起秒数，GGA历元时间+RMC日期，0表示未知)
     bool valid;                     // 定位数据是否有效
+    bool differential;              // 已按参考站做位置域差分改正（与单点定位存在米级系统差，不能混用）
     char raw_data[128];             // 原始NMEA数据
     uint32_t last_update_time;      // 最后更新时间
 } GPSData;
@@ -112,6 +111,8 @@ typedef struct {
     uint32_t duration_ms;       // 持续时间 (ms)
     char description[64];       // 风险描述
     uint32_t timestamp;         // 评估时间戳
+    uint32_t sample_timestamp;  // 评估所用样本的采样时间
+    uint32_t sequence;          // 评估所用样本的采样序号
     
     // 各项风险因子
     float tilt_risk;            // 倾斜风险
@@ -119,6 +120,13 @@ typedef struct {
     float humidity_risk;        // 湿度风险
     float light_risk;           // 光照风险
     float gps_deform_risk;      // GPS形变风险
+    float anomaly_risk;         // 多传感器组合异常风险
+    float moisture_risk;        // 前期累积湿润风险
+
+    // 失稳时间预测（反速度法）
+    RiskLevel forecast_level;   // 预测给出的风险下限
+    float forecast_ttf_h;       // 预测剩余时间 (小时，<0表示无预测)
+    float forecast_confidence;  // 预测置信度 (0.0-1.0)
 } RiskAssessment;
 
 // 系统状态枚举
@@ -148,6 +156,36 @@ typedef struct {
     LcdDisplayMode lcd_mode;    // 当前LCD显示模式
 } SystemStats;
 
+// 运行配置（云端下发，保存在KV存储中，重启后恢复）
+typedef struct {
+    uint32_t upload_interval_ms[RISK_LEVEL_CRITICAL + 1];  // 各风险等级的上传间隔 (ms)
+    float deform_alert_distance;        // GPS位移警报阈值 (米)
+    float deform_critical_distance;     // GPS位移危险阈值 (米)
+} RuntimeConfig;
+
+// 采样引擎状态
+typedef struct {
+    uint32_t requested_hz;          // 请求采样频率 (Hz)
+    uint32_t interval_ms;           // 实际调度周期 (ms)，受总线读取耗时限制
+    float achieved_hz;              // 最近统计窗口的实测采样频率 (Hz)
+    float read_time_ms;             // 平均单次读取耗时 (ms)
+    uint32_t overruns;              // 读取耗时超过采样周期的次数
+    bool bus_limited;               // 请求频率超过总线可持续的频率，已降频
+} SamplingStatus;
+
+// 处理链路统计（采集→处理→风险评估→报警，消息按采样序号传递）
+typedef struct {
+    uint32_t samples;               // 采集任务发出的样本数
+    uint32_t processed;             // 数据处理任务处理的样本数
+    uint32_t evaluated;             // 风险评估次数（每个处理结果恰好一次）
+    uint32_t dropped;               // 队列满被丢弃的样本和处理结果数
+    uint32_t actuated;              // 报警任务按新评估结果驱动输出的次数
+    uint32_t last_sequence;         // 最近一次驱动输出所对应的采样序号
+    float risk_latency_ms;          // 采样到风险评估完成的延迟 (ms，指数平均)
+    float alarm_latency_ms;         // 采样到报警输出的延迟 (ms，指数平均)
+    uint32_t alarm_latency_max_ms;  // 采样到报警输出的最大延迟 (ms)
+} PipelineStats;
+
 // 全局函数声明
 
 // 系统初始化和控制
@@ -161,6 +199,7 @@ int GetLatestSensorData(SensorData *data);
 int GetLatestProcessedData(ProcessedData *data);
 int GetLatestRiskAssessment(RiskAssessment *assessment);
 int GetSystemStats(SystemStats *stats);
+int GetPipelineStats(PipelineStats *stats);
 
 // 系统状态管理
 SystemState GetSystemState(void);
@@ -176,8 +215,13 @@ bool IsAlarmMuted(void);
 
 // 配置接口
 int SetSensorSampleRate(uint32_t rate_hz);
+int GetSamplingStatus(SamplingStatus *status);
 int SetRiskThresholds(float tilt_threshold, float vibration_threshold, 
                       float humidity_threshold, float light_threshold);
+int GetRuntimeConfig(RuntimeConfig *config);
+int SetRuntimeConfig(const RuntimeConfig *config);
+void RequestGyroCalibration(void);
+void RequestGpsRebaseline(void);
 
 // 错误处理
 const char* GetLastErrorMessage(void);
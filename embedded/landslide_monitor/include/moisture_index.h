@@ -0,0 +1,70 @@
+#ifndef MOISTURE_INDEX_H
+#define MOISTURE_INDEX_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 前期湿润指数配置（湿润度的指数衰减积分，多个时间尺度，每个样本O(1)）
+#define MOISTURE_SCALES             3           // 时间尺度数
+#define MOISTURE_TAU_SHORT_H        6.0f        // 短时间尺度 (小时)，近似降雨入渗锋面
+#define MOISTURE_TAU_MEDIUM_H       24.0f       // 中时间尺度 (小时)
+#define MOISTURE_TAU_LONG_H         72.0f       // 长时间尺度 (小时)，近似土体前期含水
+#define MOISTURE_BLOCK_MS           (60 * 1000)     // 湿润度先按块平均再更新各尺度（逐样本更新小时级时间常数时float精度不足）
+#define MOISTURE_MAX_GAP_MS         (10 * 60 * 1000)    // 相邻样本间隔上限，更长的中断按该值计入
+#define MOISTURE_SAVE_BLOCKS        30          // 每累计该数量的块保存一次到Flash
+#define MOISTURE_RH_DRY             60.0f       // 相对湿度低于该值 (%) 时湿度项为0
+#define MOISTURE_DEW_SPREAD_C       4.0f        // 露点差低于该值 (°C) 时开始计入凝结项，为0时（饱和、降雨）凝结项为1
+
+// 时间尺度
+typedef enum {
+    MOISTURE_SCALE_SHORT = 0,
+    MOISTURE_SCALE_MEDIUM,
+    MOISTURE_SCALE_LONG,
+} MoistureScale;
+
+// 前期湿润指数
+typedef struct {
+    float wetness;                      // 当前样本湿润度 (0.0~1.0)，湿度项与凝结项各占一半
+    float dew_point;                    // 当前露点 (°C)
+    float scales[MOISTURE_SCALES];      // 各时间尺度指数 (0.0~1.0)，即衰减积分除以时间常数，持续饱和时趋近1
+    float index;                        // 综合指数 (0.0~1.0)，各尺度加权平均
+    bool restored;                      // 指数由Flash恢复（停机期间按无衰减处理）
+} MoistureIndex;
+
+/**
+ * @brief 初始化前期湿润指数（从Flash恢复各尺度指数）
+ * @return 0: 成功, -1: 失败
+ */
+int Moisture_Init(void);
+
+/**
+ * @brief 反初始化前期湿润指数（保存当前指数）
+ */
+void Moisture_Deinit(void);
+
+/**
+ * @brief 输入一个温湿度样本
+ * @param humidity 相对湿度 (%)
+ * @param temperature 温度 (°C)
+ * @param timestamp 采样时间 (ms)
+ * @param index 输出当前指数（可为NULL）
+ * @return 0: 成功（无效样本不计入，仍输出当前指数）, -1: 未初始化
+ */
+int Moisture_Update(float humidity, float temperature, uint32_t timestamp, MoistureIndex *index);
+
+/**
+ * @brief 获取当前指数
+ * @param index 指数
+ * @return 0: 成功, -1: 参数错误或未初始化
+ */
+int Moisture_Get(MoistureIndex *index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MOISTURE_INDEX_H
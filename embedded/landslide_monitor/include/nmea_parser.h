@@ -0,0 +1,185 @@
+#ifndef NMEA_PARSER_H
+#define NMEA_PARSER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// NMEA解析配置
+#define NMEA_MAX_SENTENCE_LEN       96          // 语句最大长度（标准82字节，留余量兼容厂商扩展）
+#define NMEA_ADDRESS_LEN            6           // 地址字段最大长度（如GNGGA）
+#define NMEA_MAX_FRAC_DIGITS        7           // 数值小数部分最多保留位数
+#define NMEA_GSA_MAX_SATELLITES     12          // GSA语句最多列出的卫星数
+#define NMEA_GSV_SATS_PER_MSG       4           // 每条GSV语句最多4颗卫星
+
+// NMEA语句类型
+typedef enum {
+    NMEA_TYPE_UNKNOWN = 0,
+    NMEA_TYPE_GGA,                  // 全球定位系统定位数据
+    NMEA_TYPE_RMC,                  // 推荐最小定位信息
+    NMEA_TYPE_GSA,                  // 当前卫星信息
+    NMEA_TYPE_GSV,                  // 可见卫星信息
+    NMEA_TYPE_VTG                   // 地面速度信息
+} NmeaType;
+
+// 卫星系统（按NMEA 4.10系统ID顺序）
+typedef enum {
+    NMEA_SYSTEM_GPS = 0,
+    NMEA_SYSTEM_GLONASS,
+    NMEA_SYSTEM_GALILEO,
+    NMEA_SYSTEM_BEIDOU,
+    NMEA_SYSTEM_QZSS,
+    NMEA_SYSTEM_COUNT,
+    NMEA_SYSTEM_UNKNOWN = NMEA_SYSTEM_COUNT
+} NmeaSystem;
+
+// 单个字段的增量解析结果（逐字节累加数值，不保存字段字符串）
+typedef struct {
+    int64_t mantissa;               // 去掉小数点后的数字
+    uint8_t frac_digits;            // 小数位数
+    uint8_t digits;                 // 数字个数
+    uint8_t length;                 // 字段字符数（0表示空字段）
+    bool negative;                  // 负号
+    bool has_dot;                   // 已出现小数点
+    bool numeric;                   // 字段只包含数字/小数点/前导负号
+    char first;                     // 首字符（N/S/E/W等标志字段）
+} NmeaField;
+
+// GGA字段存在标志
+#define NMEA_GGA_HAS_TIME           0x01
+#define NMEA_GGA_HAS_LATITUDE       0x02
+#define NMEA_GGA_HAS_LONGITUDE      0x04
+#define NMEA_GGA_HAS_ALTITUDE       0x08
+#define NMEA_GGA_HAS_HDOP           0x10
+#define NMEA_GGA_HAS_POSITION       (NMEA_GGA_HAS_LATITUDE | NMEA_GGA_HAS_LONGITUDE)
+
+// GGA定位数据（定点格式，空字段对应的标志位为0）
+typedef struct {
+    uint32_t utc_time_ms;           // UTC时间（当日毫秒）
+    int32_t latitude;               // 纬度 (1e-7°，南纬为负)
+    int32_t longitude;              // 经度 (1e-7°，西经为负)
+    int32_t altitude;               // 海拔 (cm)
+    uint16_t hdop;                  // 水平精度因子 (0.01)
+    uint8_t quality;                // 定位质量 (0=无效, 1=单点, 2=差分, 4=RTK固定, 5=RTK浮点)
+    uint8_t satellites;             // 参与定位卫星数
+    uint8_t present;                // 字段存在标志 NMEA_GGA_HAS_*
+} NmeaGga;
+
+// RMC字段存在标志
+#define NMEA_RMC_HAS_TIME           0x01
+#define NMEA_RMC_HAS_DATE           0x02
+#define NMEA_RMC_HAS_POSITION       0x04
+#define NMEA_RMC_HAS_SPEED          0x08
+#define NMEA_RMC_HAS_COURSE         0x10
+
+// RMC推荐最小定位信息
+typedef struct {
+    uint32_t utc_time_ms;           // UTC时间（当日毫秒）
+    int32_t latitude;               // 纬度 (1e-7°)
+    int32_t longitude;              // 经度 (1e-7°)
+    uint32_t speed;                 // 地面速度 (mm/s)
+    uint16_t course;                // 真北航向 (0.01°)
+    uint8_t day;                    // UTC日期
+    uint8_t month;
+    uint16_t year;
+    char status;                    // 'A'=有效, 'V'=无效
+    char mode;                      // 模式指示 (A=自主, D=差分, E=推算, N=无效)
+    uint8_t present;                // 字段存在标志 NMEA_RMC_HAS_*
+} NmeaRmc;
+
+// GSA精度因子与参与定位卫星（多系统接收机每个历元每个系统一条）
+typedef struct {
+    uint16_t prn[NMEA_GSA_MAX_SATELLITES];  // 参与定位卫星PRN
+    uint16_t pdop;                  // 位置精度因子 (0.01，0表示未知)
+    uint16_t hdop;                  // 水平精度因子 (0.01)
+    uint16_t vdop;                  // 垂直精度因子 (0.01)
+    uint8_t used_count;             // 参与定位卫星数
+    uint8_t fix_type;               // 1=未定位, 2=2D, 3=3D
+    uint8_t system;                 // NmeaSystem
+    char mode;                      // 'A'=自动, 'M'=手动
+} NmeaGsa;
+
+// GSV单颗卫星
+typedef struct {
+    uint16_t prn;
+    uint16_t azimuth;               // 方位角 (°)
+    int8_t elevation;               // 仰角 (°)
+    uint8_t cn0;                    // 载噪比 (dB-Hz，0表示未跟踪)
+} NmeaSatellite;
+
+// GSV可见卫星（一个系统的可见卫星分多条语句发送）
+typedef struct {
+    NmeaSatellite sats[NMEA_GSV_SATS_PER_MSG];
+    uint8_t count;                  // 本条语句中的卫星数
+    uint8_t total_messages;         // 本组语句总数
+    uint8_t message_number;         // 本条语句序号（从1开始）
+    uint8_t in_view;                // 该系统可见卫星总数
+    uint8_t system;                 // NmeaSystem
+    uint8_t signal_id;              // 信号ID（NMEA 4.10+，0表示未提供）
+} NmeaGsv;
+
+// VTG地面速度
+typedef struct {
+    uint32_t speed;                 // 地面速度 (mm/s)
+    uint16_t course;                // 真北航向 (0.01°)
+    bool has_speed;
+    bool has_course;
+    char mode;                      // 模式指示
+} NmeaVtg;
+
+// 解析统计
+typedef struct {
+    uint32_t sentences;             // 校验通过的语句数
+    uint32_t checksum_errors;       // 校验和错误
+    uint32_t format_errors;         // 格式错误（超长、缺少校验和、非法字符）
+} NmeaStats;
+
+// 解析器状态（调用者持有，无动态内存）
+typedef struct {
+    uint8_t state;
+    uint8_t checksum;               // 已接收字符的异或校验
+    uint8_t received_checksum;      // 语句携带的校验和
+    uint8_t length;                 // 当前语句长度
+    uint8_t field_index;            // 当前字段序号（0为地址字段）
+    uint8_t address_len;
+    bool collect;                   // 当前字段是否需要解析
+    char address[NMEA_ADDRESS_LEN];
+    NmeaType type;
+    NmeaField field;                // 当前字段
+    union {                         // 解析中的语句，校验通过后才复制到对应结果
+        NmeaGga gga;
+        NmeaRmc rmc;
+        NmeaGsa gsa;
+        NmeaGsv gsv;
+        NmeaVtg vtg;
+    } pending;
+    NmeaGga gga;                    // 最近一条有效语句（按类型）
+    NmeaRmc rmc;
+    NmeaGsa gsa;
+    NmeaGsv gsv;
+    NmeaVtg vtg;
+    NmeaStats stats;
+} NmeaParser;
+
+/**
+ * @brief 初始化解析器
+ * @param parser 解析器
+ */
+void Nmea_Init(NmeaParser *parser);
+
+/**
+ * @brief 输入一个字节（字段边解析边转换为定点值，语句校验通过时才提交结果）
+ * @param parser 解析器
+ * @param c 接收到的字节
+ * @return 语句结束且校验通过时返回语句类型（结果在parser->gga/rmc/gsa/gsv/vtg中），否则返回NMEA_TYPE_UNKNOWN
+ */
+NmeaType Nmea_Feed(NmeaParser *parser, char c);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NMEA_PARSER_H
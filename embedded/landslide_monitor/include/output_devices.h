@@ -133,12 +133,13 @@ void RGB_SetBrightness(uint8_t brightness);  // 0-100%
 void RGB_Blink(RGB_Color color, uint32_t interval_ms);
 void RGB_Off(void);
 
-// 蜂鸣器控制
+// 蜂鸣器控制（响铃、振动、闪烁均由模式播放定时器推进，调用立即返回）
 int Buzzer_Init(void);
 void Buzzer_SetMode(BuzzerMode mode);
 void Buzzer_SetFrequency(uint32_t freq_hz);
 void Buzzer_Beep(uint32_t duration_ms);
 void Buzzer_BeepWithFreq(uint32_t duration_ms, uint32_t frequency_hz);
+void Buzzer_BeepRepeat(uint32_t on_ms, uint32_t off_ms, uint32_t frequency_hz, uint8_t count);
 void Buzzer_Start(uint32_t frequency_hz);
 void Buzzer_BeepByRisk(RiskLevel risk_level);
 void Buzzer_Off(void);
@@ -150,8 +151,7 @@ void Motor_Vibrate(uint32_t duration_ms);
 void Motor_VibrateByRisk(RiskLevel risk_level);
 void Motor_Off(void);
 void Motor_SetDirection(MotorDirection direction);
-void Motor_Run(uint8_t speed, MotorDirection direction, uint32_t duration_ms);
-void Motor_CheckAutoStop(void);  // 检查马达自动停止（非阻塞）
+void Motor_Run(uint8_t speed, MotorDirection direction, uint32_t duration_ms);  // 定时运行由模式播放定时器停止
 
 // 报警灯控制
 int AlarmLight_Init(void);
@@ -162,6 +162,7 @@ void AlarmLight_Off(void);
 
 // 按键控制
 int Button_Init(void);
+ButtonState Button_ReadKey(void);
 ButtonState Button_GetState(void);
 bool Button_IsPressed(void);
 void Button_SetCallback(void (*callback)(ButtonState state));
@@ -0,0 +1,164 @@
+#ifndef RISK_RULES_H
+#define RISK_RULES_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 风险规则表配置（整表保存到Flash，须不超过KV_MAX_VALUE_SIZE）
+#define RISK_RULES_MAX              12          // 规则数上限（每条规则把一个输入经折线映射后累加到一个风险因子）
+#define RISK_RULE_POINTS_MAX        48          // 所有规则共用的折线点池大小
+#define RISK_FACTOR_MAX             8           // 权重数组长度（不少于RISK_FACTOR_COUNT，预留扩展）
+#define RISK_RULE_CUTOFFS           4           // 等级分界数（依次为低/中/高/危急的归一化分数下限）
+
+// 规则输入量
+typedef enum {
+    RISK_INPUT_TILT = 0,            // 倾角幅值 (°)
+    RISK_INPUT_VIBRATION,           // 振动强度
+    RISK_INPUT_HUMIDITY,            // 相对湿度 (%)
+    RISK_INPUT_HUMIDITY_TREND,      // 湿度变化趋势 (%/标称周期)
+    RISK_INPUT_LIGHT_CHANGE,        // 光照变化率 (lux/标称周期)
+    RISK_INPUT_GPS_DEFORM,          // GPS形变风险等级 (0~4)
+    RISK_INPUT_ANOMALY,             // 多传感器异常分数（等效正态分位数）
+    RISK_INPUT_MOISTURE,            // 前期湿润综合指数 (0~1)
+    RISK_INPUT_INFILTRATION,        // 短时间尺度湿润指数 (0~1)，降雨入渗代理量
+    RISK_INPUT_TILT_CREEP,          // 倾斜蠕变CUSUM统计量（与报警阈值之比，>=1为报警）
+    RISK_INPUT_COUNT
+} RiskInput;
+
+// 风险因子（同一因子的各规则输出相加后限制在0~1）
+typedef enum {
+    RISK_FACTOR_TILT = 0,
+    RISK_FACTOR_VIBRATION,
+    RISK_FACTOR_HUMIDITY,
+    RISK_FACTOR_LIGHT,
+    RISK_FACTOR_GPS_DEFORM,
+    RISK_FACTOR_ANOMALY,
+    RISK_FACTOR_MOISTURE,
+    RISK_FACTOR_COUNT
+} RiskFactor;
+
+// 折线点（x非递减；相邻两点x相同表示阶跃，输入大于该x时取后一点的y）
+typedef struct {
+    float x;
+    float y;                        // 0.0~1.0
+} RiskCurvePoint;
+
+// 单条规则：输入低于首点取首点y，高于末点取末点y，之间线性插值
+typedef struct {
+    uint8_t input;                  // RiskInput
+    uint8_t factor;                 // RiskFactor
+    uint8_t first_point;            // 在点池中的起始下标
+    uint8_t point_count;            // 折线点数 (>=2)
+} RiskRule;
+
+// 风险规则集（云端下发、Flash保存的格式）
+typedef struct {
+    uint16_t version;               // 规则集版本（由下发方指定，便于核对设备上生效的规则）
+    uint8_t rule_count;
+    uint8_t point_count;
+    RiskRule rules[RISK_RULES_MAX];
+    RiskCurvePoint points[RISK_RULE_POINTS_MAX];
+    float weights[RISK_FACTOR_MAX];             // 各因子权重（相对值，生效时归一化为和为1）
+    float cutoffs[RISK_RULE_CUTOFFS];           // 等级分界（归一化分数，严格递增，0~1）
+} RiskRuleSet;
+
+// 规则评估结果
+typedef struct {
+    float factors[RISK_FACTOR_COUNT];           // 各因子风险 (0.0~1.0)
+    float score;                                // 归一化综合分数 (0.0~1.0)
+    uint8_t level;                              // 分数达到的分界数，数值与RiskLevel一致
+    uint16_t version;                           // 评估使用的规则集版本
+} RiskRuleResult;
+
+/**
+ * @brief 初始化风险规则（恢复已保存的规则集，没有或无效时使用默认规则）
+ * @return 0: 成功, -1: 失败
+ */
+int RiskRules_Init(void);
+
+/**
+ * @brief 反初始化风险规则
+ */
+void RiskRules_Deinit(void);
+
+/**
+ * @brief 获取默认规则集（与原固定阈值分段评估的等级一致）
+ * @param set 规则集
+ */
+void RiskRules_GetDefault(RiskRuleSet *set);
+
+/**
+ * @brief 检查规则集是否有效
+ * @param set 规则集
+ * @return 0: 有效, -1: 无效
+ */
+int RiskRules_Validate(const RiskRuleSet *set);
+
+/**
+ * @brief 整表替换生效的规则集（编译完成后一次性切换，评估不会看到新旧混合的规则）并保存到Flash
+ * @param set 规则集
+ * @return 0: 成功, -1: 参数无效或未初始化, -2: 已生效但保存失败
+ */
+int RiskRules_Set(const RiskRuleSet *set);
+
+/**
+ * @brief 获取生效的规则集
+ * @param set 规则集
+ * @return 0: 成功, -1: 参数错误或未初始化
+ */
+int RiskRules_Get(RiskRuleSet *set);
+
+/**
+ * @brief 恢复默认规则集并删除已保存的规则集
+ */
+void RiskRules_Reset(void);
+
+/**
+ * @brief 按新的起始阈值等比缩放某个输入的全部折线（起始阈值为该输入各规则首点x的最小值）
+ * @param set 规则集（原地修改，不生效）
+ * @param input 输入量
+ * @param threshold 新的起始阈值 (>0)
+ * @return 0: 成功, -1: 参数无效或该输入没有起始阈值为正的规则
+ */
+int RiskRules_ScaleInput(RiskRuleSet *set, RiskInput input, float threshold);
+
+/**
+ * @brief 用生效的规则集评估一组输入
+ * @param inputs 输入量（按RiskInput下标，非有限值NaN/±inf只取各曲线起点，不产生风险）
+ * @param result 评估结果
+ * @return 0: 成功, -1: 参数错误或未初始化
+ */
+int RiskRules_Evaluate(const float inputs[RISK_INPUT_COUNT], RiskRuleResult *result);
+
+/**
+ * @brief 用指定规则集评估一组输入（不生效、不访问系统资源，可在主机上对记录数据回放校验规则集）
+ * @param set 规则集
+ * @param inputs 输入量（非有限值处理同RiskRules_Evaluate）
+ * @param result 评估结果
+ * @return 0: 成功, -1: 参数错误或规则集无效
+ */
+int RiskRules_EvaluateSet(const RiskRuleSet *set, const float inputs[RISK_INPUT_COUNT], RiskRuleResult *result);
+
+/**
+ * @brief 获取输入量名称（云端规则下发使用）
+ * @param input 输入量
+ * @return 名称，无效时返回NULL
+ */
+const char *RiskRules_GetInputName(RiskInput input);
+
+/**
+ * @brief 获取风险因子名称（云端规则下发使用）
+ * @param factor 风险因子
+ * @return 名称，无效时返回NULL
+ */
+const char *RiskRules_GetFactorName(RiskFactor factor);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // RISK_RULES_H
@@ -0,0 +1,201 @@
+#ifndef SAMPLE_RECORD_H
+#define SAMPLE_RECORD_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 定点缩放系数（工程值 × 系数 = 存储值，加速度/角速度与云端上报单位一致）
+#define SAMPLE_ACCEL_SCALE          1000.0f     // 加速度 mg
+#define SAMPLE_GYRO_SCALE           100.0f      // 角速度 0.01°/s
+#define SAMPLE_ANGLE_SCALE          100.0f      // 倾角 0.01°
+#define SAMPLE_TEMP_SCALE           100.0f      // 温度 0.01°C
+#define SAMPLE_HUMIDITY_SCALE       100.0f      // 湿度 0.01%
+#define SAMPLE_LIGHT_SCALE          100.0f      // 光照 0.01lux
+#define SAMPLE_COORD_SCALE          1e7         // 经纬度 1e-7°
+#define SAMPLE_ALTITUDE_SCALE       100.0f      // 海拔 cm
+
+// 数据有效位
+#define SAMPLE_VALID_MPU            0x0001      // MPU6050（加速度/角速度/倾角/芯片温度）
+#define SAMPLE_VALID_SHT            0x0002      // SHT30（温湿度）
+#define SAMPLE_VALID_LIGHT          0x0004      // BH1750（光照）
+#define SAMPLE_VALID_GPS            0x0008      // GPS定位
+#define SAMPLE_VALID_SENSORS        (SAMPLE_VALID_MPU | SAMPLE_VALID_SHT | SAMPLE_VALID_LIGHT)
+
+// 坐标轴索引
+typedef enum {
+    SAMPLE_AXIS_X = 0,
+    SAMPLE_AXIS_Y,
+    SAMPLE_AXIS_Z
+} SampleAxis;
+
+// 规范采样记录：采集任务生成一次，显示、风险评估、归档、缓存、Flash和上报均直接读取
+// 字段按宽度降序排列，无填充字节（44字节）
+typedef struct {
+    uint32_t timestamp;         // 采样时间 (ms)
+    int32_t latitude;           // GPS纬度 (1e-7°)
+    int32_t longitude;          // GPS经度 (1e-7°)
+    int32_t altitude;           // GPS海拔 (cm)
+    uint32_t light;             // 光照强度 (0.01lux)
+    int16_t accel[3];           // 加速度 (mg)
+    int16_t gyro[3];            // 角速度 (0.01°/s)
+    int16_t angle[2];           // X/Y轴倾角 (0.01°)
+    int16_t mpu_temperature;    // MPU6050温度 (0.01°C)
+    int16_t temperature;        // SHT30温度 (0.01°C)
+    uint16_t humidity;          // 湿度 (0.01%)
+    uint16_t valid;             // 有效位 SAMPLE_VALID_*
+} SampleRecord;
+
+/**
+ * @brief 工程值转16位定点值（四舍五入并饱和）
+ */
+static inline int16_t Sample_ToFixed16(float value, float scale)
+{
+    float scaled = value * scale;
+    if (scaled >= 32767.0f) {
+        return INT16_MAX;
+    }
+    if (scaled <= -32768.0f) {
+        return INT16_MIN;
+    }
+    return (int16_t)lroundf(scaled);
+}
+
+/**
+ * @brief 检查记录是否包含指定的全部有效位
+ */
+static inline bool Sample_IsValid(const SampleRecord *s, uint16_t mask)
+{
+    return (s->valid & mask) == mask;
+}
+
+// ==================== 写入（采集任务使用） ====================
+
+/**
+ * @brief 写入MPU6050数据（加速度g、角速度°/s、倾角°、温度°C）
+ */
+static inline void Sample_SetMotion(SampleRecord *s, const float accel[3], const float gyro[3],
+                                    float angle_x, float angle_y, float mpu_temperature)
+{
+    for (int i = 0; i < 3; i++) {
+        s->accel[i] = Sample_ToFixed16(accel[i], SAMPLE_ACCEL_SCALE);
+        s->gyro[i] = Sample_ToFixed16(gyro[i], SAMPLE_GYRO_SCALE);
+    }
+    s->angle[SAMPLE_AXIS_X] = Sample_ToFixed16(angle_x, SAMPLE_ANGLE_SCALE);
+    s->angle[SAMPLE_AXIS_Y] = Sample_ToFixed16(angle_y, SAMPLE_ANGLE_SCALE);
+    s->mpu_temperature = Sample_ToFixed16(mpu_temperature, SAMPLE_TEMP_SCALE);
+}
+
+/**
+ * @brief 写入环境数据（温度°C、湿度%、光照lux）
+ */
+static inline void Sample_SetEnvironment(SampleRecord *s, float temperature, float humidity, float light)
+{
+    s->temperature = Sample_ToFixed16(temperature, SAMPLE_TEMP_SCALE);
+    s->humidity = (humidity <= 0.0f) ? 0 : (uint16_t)lroundf(humidity * SAMPLE_HUMIDITY_SCALE);
+    s->light = (light <= 0.0f) ? 0 : (uint32_t)lroundf(light * SAMPLE_LIGHT_SCALE);
+}
+
+/**
+ * @brief 写入GPS位置（经纬度°、海拔m）
+ */
+static inline void Sample_SetPosition(SampleRecord *s, double latitude, double longitude, float altitude)
+{
+    s->latitude = (int32_t)lround(latitude * SAMPLE_COORD_SCALE);
+    s->longitude = (int32_t)lround(longitude * SAMPLE_COORD_SCALE);
+    s->altitude = (int32_t)lroundf(altitude * SAMPLE_ALTITUDE_SCALE);
+}
+
+// ==================== 读取视图（返回工程单位） ====================
+
+static inline float Sample_GetAccel(const SampleRecord *s, SampleAxis axis)
+{
+    return s->accel[axis] / SAMPLE_ACCEL_SCALE;
+}
+
+static inline float Sample_GetGyro(const SampleRecord *s, SampleAxis axis)
+{
+    return s->gyro[axis] / SAMPLE_GYRO_SCALE;
+}
+
+static inline float Sample_GetAngle(const SampleRecord *s, SampleAxis axis)
+{
+    return s->angle[axis] / SAMPLE_ANGLE_SCALE;
+}
+
+static inline float Sample_GetMpuTemperature(const SampleRecord *s)
+{
+    return s->mpu_temperature / SAMPLE_TEMP_SCALE;
+}
+
+static inline float Sample_GetTemperature(const SampleRecord *s)
+{
+    return s->temperature / SAMPLE_TEMP_SCALE;
+}
+
+static inline float Sample_GetHumidity(const SampleRecord *s)
+{
+    return s->humidity / SAMPLE_HUMIDITY_SCALE;
+}
+
+static inline float Sample_GetLight(const SampleRecord *s)
+{
+    return s->light / SAMPLE_LIGHT_SCALE;
+}
+
+static inline double Sample_GetLatitude(const SampleRecord *s)
+{
+    return s->latitude / SAMPLE_COORD_SCALE;
+}
+
+static inline double Sample_GetLongitude(const SampleRecord *s)
+{
+    return s->longitude / SAMPLE_COORD_SCALE;
+}
+
+static inline float Sample_GetAltitude(const SampleRecord *s)
+{
+    return s->altitude / SAMPLE_ALTITUDE_SCALE;
+}
+
+/**
+ * @brief 加速度模值 (g)
+ */
+static inline float Sample_GetAccelMagnitude(const SampleRecord *s)
+{
+    float x = Sample_GetAccel(s, SAMPLE_AXIS_X);
+    float y = Sample_GetAccel(s, SAMPLE_AXIS_Y);
+    float z = Sample_GetAccel(s, SAMPLE_AXIS_Z);
+    return sqrtf(x * x + y * y + z * z);
+}
+
+/**
+ * @brief 角速度模值 (°/s)
+ */
+static inline float Sample_GetGyroMagnitude(const SampleRecord *s)
+{
+    float x = Sample_GetGyro(s, SAMPLE_AXIS_X);
+    float y = Sample_GetGyro(s, SAMPLE_AXIS_Y);
+    float z = Sample_GetGyro(s, SAMPLE_AXIS_Z);
+    return sqrtf(x * x + y * y + z * z);
+}
+
+/**
+ * @brief 总倾斜角度（X/Y轴倾角合成）(°)
+ */
+static inline float Sample_GetTiltMagnitude(const SampleRecord *s)
+{
+    float x = Sample_GetAngle(s, SAMPLE_AXIS_X);
+    float y = Sample_GetAngle(s, SAMPLE_AXIS_Y);
+    return sqrtf(x * x + y * y);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SAMPLE_RECORD_H
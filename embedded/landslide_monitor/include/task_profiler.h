@@ -0,0 +1,81 @@
+#ifndef TASK_PROFILER_H
+#define TASK_PROFILER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 任务性能统计配置（任务在循环开始/结束处打点，首次打点时自动登记；循环内的阻塞等待另行打点排除）
+#define PROFILER_MAX_TASKS          12
+#define PROFILER_NAME_LEN           16
+#define PROFILER_WINDOW_MS          10000       // CPU占用统计窗口
+#define PROFILER_STACK_WARN_PERCENT 80          // 栈水位超过此比例时报告告警
+
+// 单个任务的统计信息
+typedef struct {
+    char name[PROFILER_NAME_LEN];
+    uint32_t task_id;
+    uint32_t loops;                 // 已统计的循环次数
+    float load_percent;             // 最近完整窗口内活动时间占比 (%)，含被高优先级任务抢占的时间，不含循环内阻塞等待
+    uint32_t run_avg_us;            // 单次循环活动时间（指数平均，不含WaitBegin/WaitEnd之间的时间）
+    uint32_t run_max_us;
+    uint32_t wake_late_avg_us;      // 定时唤醒相对预期时刻的延迟（指数平均）
+    uint32_t wake_late_max_us;
+    uint32_t stack_size;            // 栈大小（字节）
+    uint32_t stack_peak;            // 栈使用峰值（字节，内核栈水位）
+} TaskProfile;
+
+/**
+ * @brief 初始化任务性能统计（需在创建被统计任务之前调用）
+ * @return 0: 成功, -1: 失败
+ */
+int Profiler_Init(void);
+
+/**
+ * @brief 反初始化任务性能统计
+ */
+void Profiler_Deinit(void);
+
+/**
+ * @brief 当前任务循环开始（唤醒后调用）
+ */
+void Profiler_LoopBegin(void);
+
+/**
+ * @brief 当前任务循环结束（休眠前调用）
+ * @param wait_ms 接下来的休眠/等待超时时长，超时唤醒时据此统计唤醒延迟；0表示不统计
+ */
+void Profiler_LoopEnd(uint32_t wait_ms);
+
+/**
+ * @brief 当前任务循环内开始阻塞等待（网络收包、延时等），等待时间不计入活动时间
+ */
+void Profiler_WaitBegin(void);
+
+/**
+ * @brief 当前任务循环内阻塞等待结束
+ */
+void Profiler_WaitEnd(void);
+
+/**
+ * @brief 获取各任务统计信息（同时读取内核栈水位）
+ * @param profiles 输出数组
+ * @param max_count 数组长度
+ * @return 任务数
+ */
+int Profiler_GetStats(TaskProfile *profiles, int max_count);
+
+/**
+ * @brief 打印各任务统计信息
+ * @return 栈水位超过告警比例的任务数
+ */
+int Profiler_PrintReport(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TASK_PROFILER_H
@@ -0,0 +1,88 @@
+#ifndef TILT_CREEP_H
+#define TILT_CREEP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 倾斜蠕变检测配置（各轴倾角分块平均后做双侧CUSUM，状态O(1)）
+#define CREEP_AXES                  2           // X/Y两轴融合倾角
+#define CREEP_BLOCK_MS              (60 * 1000) // 倾角分块平均时长，块均值噪声远小于单样本
+#define CREEP_REF_BLOCKS            10          // 启动或复位后取前若干块均值作为参考倾角
+#define CREEP_REF_TAU_H             6.0f        // 两侧累积量均为0时参考倾角缓慢跟踪的时间常数 (小时)，吸收季节性漂移
+#define CREEP_DEFAULT_DRIFT         0.01f       // 默认允许偏差 (°)，块均值偏离参考不超过该值不累积
+#define CREEP_DEFAULT_THRESHOLD     0.02f       // 默认报警阈值 (°·小时)，累积超限量达到该值时报警
+
+// 检测参数（云端下发，保存在KV存储中）
+typedef struct {
+    float drift;                    // 允许偏差 (°)，应覆盖温漂等正常慢变化的幅度
+    float threshold;                // 报警阈值 (°·小时)，越大误报越少、检测越慢
+} CreepConfig;
+
+// 检测状态
+typedef struct {
+    float statistic;                // 各轴各方向累积量与报警阈值之比的最大值（>=1时报警）
+    float deviation;                // 报警轴（未报警时为统计量最大轴）最近块均值相对参考的偏差 (°)
+    uint32_t onset_time;            // 估计的变化起始时刻 (ms)，即累积量最后一次离开0的块起点，无时为0
+    uint32_t alarm_time;            // 报警时刻 (ms)，未报警时为0
+    uint8_t axis;                   // 统计量最大的轴 (0: X, 1: Y)
+    int8_t direction;               // 偏移方向 (1: 正向, -1: 负向, 0: 无)
+    bool alarm;                     // 报警已锁存（需TiltCreep_Rearm解除）
+    bool ready;                     // 参考倾角已建立
+} CreepStatus;
+
+/**
+ * @brief 初始化倾斜蠕变检测（恢复已保存的检测参数）
+ * @return 0: 成功, -1: 失败
+ */
+int TiltCreep_Init(void);
+
+/**
+ * @brief 反初始化倾斜蠕变检测
+ */
+void TiltCreep_Deinit(void);
+
+/**
+ * @brief 输入一个融合倾角样本（块结束时更新累积量）
+ * @param angle_x X轴倾角 (°)
+ * @param angle_y Y轴倾角 (°)
+ * @param timestamp 采样时间 (ms)
+ * @param status 输出当前状态（可为NULL）
+ * @return 0: 成功, -1: 未初始化
+ */
+int TiltCreep_Update(float angle_x, float angle_y, uint32_t timestamp, CreepStatus *status);
+
+/**
+ * @brief 解除报警并以之后的倾角重新建立参考（操作员确认后调用）
+ */
+void TiltCreep_Rearm(void);
+
+/**
+ * @brief 获取当前状态
+ * @param status 状态
+ * @return 0: 成功, -1: 参数错误或未初始化
+ */
+int TiltCreep_GetStatus(CreepStatus *status);
+
+/**
+ * @brief 设置检测参数并保存到Flash（累积量保留，按新参数继续判断）
+ * @param config 检测参数
+ * @return 0: 成功, -1: 参数无效或未初始化, -2: 已生效但保存失败
+ */
+int TiltCreep_SetConfig(const CreepConfig *config);
+
+/**
+ * @brief 获取检测参数
+ * @param config 检测参数
+ * @return 0: 成功, -1: 参数错误或未初始化
+ */
+int TiltCreep_GetConfig(CreepConfig *config);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TILT_CREEP_H
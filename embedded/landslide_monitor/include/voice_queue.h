@@ -0,0 +1,84 @@
+#ifndef VOICE_QUEUE_H
+#define VOICE_QUEUE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 语音播报队列配置（独立任务独占语音串口，调用方只入队不等待）
+#define VOICE_QUEUE_LENGTH          6           // 待播报消息数上限
+#define VOICE_TEXT_MAX              96          // 单条消息最大长度（含结束符）
+#define VOICE_TASK_PRIO             24          // 语音任务优先级（低于采集/处理/报警任务）
+#define VOICE_TASK_STACK_SIZE       2048
+#define VOICE_POLL_MS               50          // 无新消息时检查模块应答的间隔
+#define VOICE_ACK_TIMEOUT_MS        500         // 发送后等待模块接收应答的时间，超时视为模块不回传状态
+#define VOICE_MS_PER_CHAR           120         // 模块不回传状态时按字符数估算播报时长
+#define VOICE_MAX_PLAY_MS           15000       // 播报时长上限，超时未收到空闲应答视为结束
+
+// 语音模块状态回传字节（SYN6288语音合成模块，文本按其合成命令帧发送）
+#define VOICE_RESP_ACCEPTED         0x41        // 命令已接收，开始播报
+#define VOICE_RESP_ERROR            0x45        // 命令错误
+#define VOICE_RESP_IDLE             0x4F        // 播报结束，模块空闲
+
+// 播报优先级：先播高优先级，同级按入队顺序；危急消息打断正在播报的低优先级消息
+typedef enum {
+    VOICE_PRIO_LOW = 0,             // 安全状态等例行播报
+    VOICE_PRIO_NORMAL,              // 系统消息、自定义文本
+    VOICE_PRIO_HIGH,                // 中/高风险
+    VOICE_PRIO_CRITICAL,            // 危急风险
+} VoicePriority;
+
+// 队列统计信息
+typedef struct {
+    uint32_t posted;                // 入队请求数
+    uint32_t merged;                // 与待播报或正在播报的相同消息合并的请求数
+    uint32_t dropped;               // 队列满被丢弃的消息数
+    uint32_t preempted;             // 被危急消息打断的播报数
+    uint32_t played;                // 已发送到模块的消息数
+    uint32_t timeouts;              // 未收到空闲应答、按超时结束的播报数
+    uint8_t pending;                // 当前待播报消息数
+    bool busy;                      // 模块正在播报
+    bool module_responds;           // 模块回传过状态（否则按估算时长判断播报结束）
+} VoiceQueueStats;
+
+/**
+ * @brief 初始化语音队列并启动语音任务（语音串口需已初始化）
+ * @param uart_bus 语音模块串口号
+ * @return 0: 成功, -1: 失败
+ */
+int VoiceQueue_Init(uint32_t uart_bus);
+
+/**
+ * @brief 停止语音任务并清空队列
+ */
+void VoiceQueue_Deinit(void);
+
+/**
+ * @brief 消息入队（立即返回）
+ * @param text 播报文本
+ * @param priority 优先级
+ * @return 0: 已入队或已合并, -1: 参数错误或未初始化, -2: 队列已满且优先级不高于队列中任何消息
+ */
+int VoiceQueue_Post(const char *text, VoicePriority priority);
+
+/**
+ * @brief 语音是否忙（正在播报或有待播报消息）
+ * @return true: 忙, false: 空闲
+ */
+bool VoiceQueue_IsBusy(void);
+
+/**
+ * @brief 获取队列统计信息
+ * @param stats 统计信息
+ * @return 0: 成功, -1: 参数错误或未初始化
+ */
+int VoiceQueue_GetStats(VoiceQueueStats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // VOICE_QUEUE_H
@@ -21,6 +21,8 @@
 #include "los_task.h"
 #include "los_sem.h"
 #include "los_mux.h"
+#include "los_queue.h"
+#include "los_event.h"
 #include "cmsis_os.h"
 #include "ohos_init.h"
 #include "landslide_monitor.h"
@@ -29,9 +31,20 @@
 #include "lcd.h"  // 添加LCD头文件以使用颜色定义
 #include "iot_cloud.h"  // 华为云IoT功能
 #include "data_storage.h"  // Flash数据存储功能
+#include "data_archive.h"  // 多分辨率数据归档
+#include "data_cache.h"  // 上传缓存队列
+#include "kv_store.h"  // Flash键值存储（配置/校准/基准持久化）
 #include "reset.h"  // 系统重启功能
 #include "gps_module.h"  // GPS模块功能
 #include "gps_deformation.h"  // GPS形变分析功能
+#include "gps_differential.h"  // 参考站位置域差分
+#include "failure_forecast.h"  // 反速度法失稳时间预测
+#include "risk_rules.h"  // 数据驱动的风险规则表
+#include "anomaly_detector.h"  // 多传感器流式异常检测
+#include "moisture_index.h"  // 多时间尺度前期湿润指数
+#include "tilt_creep.h"  // 倾斜蠕变CUSUM变点检测
+#include "button_input.h"  // 定时器采样按键事件检测
+#include "task_profiler.h"  // 任务CPU占用、唤醒延迟和栈水位统计
 
 // 全局变量
 static SystemState g_system_state = SYSTEM_STATE_INIT;
@@ -73,7 +86,20 @@ static UINT32 g_alarm_thread_id = 0;
 
 // 同步对象
 static UINT32 g_data_mutex = 0;
-static UINT32 g_sensor_sem = 0;
+static UINT32 g_sample_queue = 0;       // 采集→处理：SampleMessage
+static UINT32 g_processed_queue = 0;    // 处理→风险评估：ProcessedData
+static EVENT_CB_S g_risk_event;         // 风险评估/按键→报警：RISK_EVENT_UPDATED、BUTTON_EVENT_QUEUED
+
+#define RISK_EVENT_UPDATED          0x01    // 有新的风险评估结果
+#define BUTTON_EVENT_QUEUED         0x02    // 有新的按键事件
+
+// 采集→处理消息（样本随采样序号一起传递，处理任务不再读取可能已被下一样本覆盖的全局数据）
+typedef struct {
+    uint32_t sequence;
+    SensorData sample;
+} SampleMessage;
+
+static PipelineStats g_pipeline_stats = {0};
 
 // 数据缓冲区
 static SensorData g_sensor_buffer[DATA_BUFFER_SIZE];
@@ -83,6 +109,28 @@ static bool g_buffer_full = false;
 // 错误信息
 static char g_error_message[128] = {0};
 
+// 运行配置（默认值即出厂上传间隔和形变阈值）
+static RuntimeConfig g_runtime_config = {
+    .upload_interval_ms = {30000, 15000, 5000, 3000, 1000},  // 安全/低/中/高/危急
+    .deform_alert_distance = GPS_DEFORM_ALERT_DISTANCE,
+    .deform_critical_distance = GPS_DEFORM_CRITICAL_DISTANCE,
+};
+
+// 陀螺仪零偏校准（保存在KV存储中，重启后直接使用，无需重新静置校准）
+#define GYRO_CALIBRATION_SAMPLES    100     // 校准样本数
+typedef struct {
+    float bias[3];              // 零偏 (°/s)
+} GyroCalibration;
+
+static GyroCalibration g_gyro_calibration = {0};
+static bool g_gyro_calibrated = false;
+static volatile bool g_gyro_calibration_requested = false;
+static volatile bool g_gps_rebaseline_requested = false;
+
+// 采样引擎（采集任务每个周期检查请求频率，修改后无需重启任务）
+static volatile uint32_t g_requested_sample_rate = SENSOR_SAMPLE_RATE_HZ;
+static SamplingStatus g_sampling_status = {0};
+
 // 内部函数声明
 static void SensorCollectionTask(void);
 static void DataProcessingTask(void);
@@ -93,9 +141,13 @@ static int InitializeHardware(void);
 static int CreateTasks(void);
 static void UpdateSystemStats(void);
 static void AddSensorDataToBuffer(const SensorData *data);
-static void ProcessSensorData(ProcessedData *processed);
+static void ProcessSensorData(const SensorData *sample, ProcessedData *processed);
+static float EvaluateSampleQuality(const SensorData *sample);
 static void EvaluateRisk(const ProcessedData *processed, RiskAssessment *assessment);
-static void ButtonEventHandler(ButtonState state);
+static void ButtonEventHandler(const ButtonEvent *event);
+static void NotifyButtonEvent(void);
+static bool IsRuntimeConfigValid(const RuntimeConfig *config);
+static void LoadPersistentSettings(void);
 
 /**
  * @brief 初始化山体滑坡监测系统
@@ -120,11 +172,23 @@ int LandslideMonitorInit(void)
         snprintf(g_error_message, sizeof(g_error_message), "Failed to create mutex: %d", ret);
         return -1;
     }
+
+    // 任务统计需在创建任务（含GPS、网络任务）之前初始化，失败时不影响监测
+    if (Profiler_Init() != 0) {
+        printf("Task profiler unavailable\n");
+    }
     
-    // 创建信号量
-    ret = LOS_SemCreate(0, &g_sensor_sem);
+    // 创建处理链路的消息队列和事件（每个样本依次驱动处理、风险评估和报警）
+    memset(&g_pipeline_stats, 0, sizeof(g_pipeline_stats));
+    ret = LOS_QueueCreate("SampleQueue", PIPELINE_QUEUE_LENGTH, &g_sample_queue, 0, sizeof(SampleMessage));
+    if (ret == LOS_OK) {
+        ret = LOS_QueueCreate("ProcQueue", PIPELINE_QUEUE_LENGTH, &g_processed_queue, 0, sizeof(ProcessedData));
+    }
+    if (ret == LOS_OK) {
+        ret = LOS_EventInit(&g_risk_event);
+    }
     if (ret != LOS_OK) {
-        snprintf(g_error_message, sizeof(g_error_message), "Failed to create semaphore: %d", ret);
+        snprintf(g_error_message, sizeof(g_error_message), "Failed to create pipeline queues: %d", ret);
         return -2;
     }
     
@@ -170,8 +234,10 @@ int LandslideMonitorStart(void)
     // 播放启动语音
     Voice_PlayMessage(VOICE_MSG_SYSTEM_START);
     
-    // 设置按键回调
-    Button_SetCallback(ButtonEventHandler);
+    // 按键事件由定时器采样检测，报警任务处理；K3双击确认报警
+    if (ButtonInput_Init(BUTTON_KEY_MASK(BUTTON_STATE_K3_PRESSED), NotifyButtonEvent) != 0) {
+        printf("Button input unavailable, continuing without buttons\n");
+    }
     
     printf("Landslide monitoring system started successfully\n");
     return 0;
@@ -226,19 +292,32 @@ void LandslideMonitorShutdown(void)
     
     // 反初始化硬件
     Sensors_Deinit();
+    ButtonInput_Deinit();
     OutputDevices_Deinit();
     GPS_Deinit();
     GPS_Deformation_Deinit();
+    GpsDiff_Deinit();
+    Forecast_Deinit();
+    RiskRules_Deinit();
+    Anomaly_Deinit();
+    Moisture_Deinit();
+    TiltCreep_Deinit();
+    Profiler_Deinit();
     
     // 删除同步对象
     if (g_data_mutex != 0) {
         LOS_MuxDelete(g_data_mutex);
         g_data_mutex = 0;
     }
-    if (g_sensor_sem != 0) {
-        LOS_SemDelete(g_sensor_sem);
-        g_sensor_sem = 0;
+    if (g_sample_queue != 0) {
+        LOS_QueueDelete(g_sample_queue);
+        g_sample_queue = 0;
     }
+    if (g_processed_queue != 0) {
+        LOS_QueueDelete(g_processed_queue);
+        g_processed_queue = 0;
+    }
+    LOS_EventDestroy(&g_risk_event);
     
     g_system_state = SYSTEM_STATE_SHUTDOWN;
     printf("Landslide monitoring system shutdown complete\n");
@@ -317,6 +396,24 @@ int GetSystemStats(SystemStats *stats)
     return 0;
 }
 
+/**
+ * @brief 获取处理链路统计（各级处理次数、丢弃数和采样到报警输出的延迟）
+ * @param stats 统计信息
+ * @return 0: 成功, 其他: 失败
+ */
+int GetPipelineStats(PipelineStats *stats)
+{
+    if (stats == NULL) {
+        return -1;
+    }
+
+    LOS_MuxPend(g_data_mutex, LOS_WAIT_FOREVER);
+    *stats = g_pipeline_stats;
+    LOS_MuxPost(g_data_mutex);
+
+    return 0;
+}
+
 /**
  * @brief 获取系统状态
  * @return 系统状态
@@ -438,6 +535,139 @@ void ClearErrorMessage(void)
     memset(g_error_message, 0, sizeof(g_error_message));
 }
 
+/**
+ * @brief 获取运行配置
+ * @param config 配置结构指针
+ * @return 0: 成功, 其他: 失败
+ */
+int GetRuntimeConfig(RuntimeConfig *config)
+{
+    if (config == NULL) {
+        return -1;
+    }
+
+    LOS_MuxPend(g_data_mutex, LOS_WAIT_FOREVER);
+    *config = g_runtime_config;
+    LOS_MuxPost(g_data_mutex);
+
+    return 0;
+}
+
+/**
+ * @brief 设置运行配置（立即生效并保存到Flash）
+ * @param config 配置结构指针
+ * @return 0: 成功, -1: 参数无效, -2: 已生效但保存失败
+ */
+int SetRuntimeConfig(const RuntimeConfig *config)
+{
+    if (config == NULL || !IsRuntimeConfigValid(config)) {
+        printf("Invalid runtime config rejected\n");
+        return -1;
+    }
+
+    LOS_MuxPend(g_data_mutex, LOS_WAIT_FOREVER);
+    g_runtime_config = *config;
+    LOS_MuxPost(g_data_mutex);
+
+    GPS_Deformation_SetThresholds(config->deform_alert_distance, config->deform_critical_distance);
+
+    if (KvStore_Set(KV_KEY_RUNTIME_CONFIG, config, sizeof(RuntimeConfig)) != 0) {
+        printf("Failed to save runtime config\n");
+        return -2;
+    }
+
+    printf("Runtime config updated\n");
+    return 0;
+}
+
+/**
+ * @brief 请求重新校准陀螺仪零偏（设备需保持静止，校准完成后自动保存）
+ */
+void RequestGyroCalibration(void)
+{
+    g_gyro_calibration_requested = true;
+    printf("Gyro calibration requested\n");
+}
+
+/**
+ * @brief 请求重新建立GPS形变基准（清除已保存的基准和历史，下一个时段平均坐标成为新基准）
+ */
+void RequestGpsRebaseline(void)
+{
+    g_gps_rebaseline_requested = true;
+    printf("GPS rebaseline requested\n");
+}
+
+/**
+ * @brief 设置传感器采样频率（下一个采样周期生效并保存到Flash）
+ * @param rate_hz 请求频率，超出SENSOR_SAMPLE_RATE_MIN_HZ~SENSOR_SAMPLE_RATE_MAX_HZ时取边界值
+ * @return 0: 成功, -1: 参数无效, -2: 已生效但保存失败
+ */
+int SetSensorSampleRate(uint32_t rate_hz)
+{
+    if (rate_hz == 0) {
+        return -1;
+    }
+    if (rate_hz < SENSOR_SAMPLE_RATE_MIN_HZ) {
+        rate_hz = SENSOR_SAMPLE_RATE_MIN_HZ;
+    } else if (rate_hz > SENSOR_SAMPLE_RATE_MAX_HZ) {
+        rate_hz = SENSOR_SAMPLE_RATE_MAX_HZ;
+    }
+
+    g_requested_sample_rate = rate_hz;
+    printf("Sensor sample rate set to %uHz\n", rate_hz);
+
+    if (KvStore_Set(KV_KEY_SAMPLE_RATE, &rate_hz, sizeof(rate_hz)) != 0) {
+        printf("Failed to save sample rate\n");
+        return -2;
+    }
+    return 0;
+}
+
+/**
+ * @brief 获取采样引擎状态（请求频率、实际调度周期与实测频率）
+ * @param status 状态结构指针
+ * @return 0: 成功, 其他: 失败
+ */
+int GetSamplingStatus(SamplingStatus *status)
+{
+    if (status == NULL) {
+        return -1;
+    }
+
+    LOS_MuxPend(g_data_mutex, LOS_WAIT_FOREVER);
+    *status = g_sampling_status;
+    LOS_MuxPost(g_data_mutex);
+    return 0;
+}
+
+/**
+ * @brief 设置风险起始阈值（按新阈值等比缩放对应输入的规则折线，整表生效并保存到Flash）
+ * @param tilt_threshold 倾角起始阈值 (°)
+ * @param vibration_threshold 振动强度起始阈值
+ * @param humidity_threshold 湿度起始阈值 (%)
+ * @param light_threshold 光照变化率起始阈值
+ * @return 0: 成功, -1: 参数无效, -2: 已生效但保存失败
+ */
+int SetRiskThresholds(float tilt_threshold, float vibration_threshold,
+                      float humidity_threshold, float light_threshold)
+{
+    static RiskRuleSet rules;   // 只由云端命令处理调用，用静态变量节省栈
+
+    if (RiskRules_Get(&rules) != 0 ||
+        RiskRules_ScaleInput(&rules, RISK_INPUT_TILT, tilt_threshold) != 0 ||
+        RiskRules_ScaleInput(&rules, RISK_INPUT_VIBRATION, vibration_threshold) != 0 ||
+        RiskRules_ScaleInput(&rules, RISK_INPUT_HUMIDITY, humidity_threshold) != 0 ||
+        RiskRules_ScaleInput(&rules, RISK_INPUT_LIGHT_CHANGE, light_threshold) != 0) {
+        printf("Invalid risk thresholds rejected\n");
+        return -1;
+    }
+
+    printf("Risk thresholds set: tilt %.1f, vibration %.1f, humidity %.1f, light %.1f\n",
+           tilt_threshold, vibration_threshold, humidity_threshold, light_threshold);
+    return RiskRules_Set(&rules);
+}
+
 // ========== 内部函数实现 ==========
 
 /**
@@ -473,6 +703,18 @@ static int InitializeHardware(void)
         // 存储失败不影响系统运行
     } else {
         printf("Data storage initialized successfully\n");
+
+        // 初始化多分辨率归档（依赖Flash存储）
+        ret = DataArchive_Init();
+        if (ret != 0) {
+            printf("Data archive initialization failed: %d (continuing without archive)\n", ret);
+        }
+
+        // 初始化KV存储（配置、校准和GPS基准需在各模块初始化前可读）
+        ret = KvStore_Init();
+        if (ret != 0) {
+            printf("KV store initialization failed: %d (continuing with defaults)\n", ret);
+        }
     }
 
     // 初始化IoT云平台连接
@@ -502,6 +744,46 @@ static int InitializeHardware(void)
         printf("GPS deformation analysis initialized successfully\n");
     }
 
+    // 初始化参考站差分（无参考站数据时形变分析使用单点定位）
+    ret = GpsDiff_Init();
+    if (ret != 0) {
+        printf("GPS differential initialization failed: %d (continuing with single point positions)\n", ret);
+    }
+
+    // 初始化失稳时间预测
+    ret = Forecast_Init();
+    if (ret != 0) {
+        printf("Failure forecast initialization failed: %d (continuing without forecast)\n", ret);
+    }
+
+    // 初始化多传感器异常检测
+    ret = Anomaly_Init();
+    if (ret != 0) {
+        printf("Anomaly detector initialization failed: %d (continuing without anomaly factor)\n", ret);
+    }
+
+    // 初始化前期湿润指数（恢复停机前的累积值）
+    ret = Moisture_Init();
+    if (ret != 0) {
+        printf("Moisture index initialization failed: %d (continuing without moisture factor)\n", ret);
+    }
+
+    // 初始化倾斜蠕变检测（恢复云端下发的检测参数）
+    ret = TiltCreep_Init();
+    if (ret != 0) {
+        printf("Tilt creep detector initialization failed: %d (continuing without creep detection)\n", ret);
+    }
+
+    // 初始化风险规则表（恢复云端下发的规则集）
+    ret = RiskRules_Init();
+    if (ret != 0) {
+        printf("Risk rules initialization failed: %d\n", ret);
+        return -3;
+    }
+
+    // 恢复已保存的运行配置和传感器校准
+    LoadPersistentSettings();
+
     printf("Hardware initialization completed\n");
     return 0;
 }
@@ -593,57 +875,77 @@ static int CreateTasks(void)
  */
 static void SensorCollectionTask(void)
 {
-    SensorData sensor_data;
+    SensorData sensor_data = {0};
+    SampleMessage message;
     MPU6050_Data mpu_data;
     SHT30_Data sht_data;
     BH1750_Data bh_data;
     GPSData gps_data;
     int ret;
-    uint32_t sample_interval_ms = 1000 / SENSOR_SAMPLE_RATE_HZ;
-
+    uint32_t requested_hz = 0;
+    uint32_t interval_ms = 1000 / SENSOR_SAMPLE_RATE_HZ;
+    uint32_t next_sample = LOS_TickCountGet();
+    uint32_t last_env_read = 0;
+    bool env_valid = false;
+    float read_time_ms = 0.0f;
+    uint32_t window_start = next_sample;
+    uint32_t window_samples = 0;
+
+    memset(&sht_data, 0, sizeof(sht_data));
+    memset(&bh_data, 0, sizeof(bh_data));
     printf("Sensor collection task started\n");
 
     while (g_system_state == SYSTEM_STATE_RUNNING || g_system_state == SYSTEM_STATE_WARNING) {
-        // 读取所有传感器数据
-        ret = Sensors_ReadAll(&mpu_data, &sht_data, &bh_data);
+        Profiler_LoopBegin();
+        uint32_t read_start = LOS_TickCountGet();
+
+        // 温湿度/光照变化缓慢且SHT30测量需等待20ms，按固定间隔读取，其余周期沿用上次值
+        bool read_env = !env_valid || read_start - last_env_read >= SENSOR_ENV_INTERVAL_MS;
+        ret = Sensors_ReadAll(&mpu_data, read_env ? &sht_data : NULL, read_env ? &bh_data : NULL);
+        if (read_env && ret == 0) {
+            last_env_read = read_start;
+            env_valid = true;
+        }
 
         if (ret == 0) {
-            // 组装传感器数据
-            sensor_data.accel_x = mpu_data.accel_x;
-            sensor_data.accel_y = mpu_data.accel_y;
-            sensor_data.accel_z = mpu_data.accel_z;
-            sensor_data.gyro_x = mpu_data.gyro_x;
-            sensor_data.gyro_y = mpu_data.gyro_y;
-            sensor_data.gyro_z = mpu_data.gyro_z;
-            sensor_data.angle_x = mpu_data.angle_x;
-            sensor_data.angle_y = mpu_data.angle_y;
-            sensor_data.mpu_temperature = mpu_data.temperature;
-
-            sensor_data.sht_temperature = sht_data.temperature;
-            sensor_data.humidity = sht_data.humidity;
-
-            sensor_data.light_intensity = bh_data.light_intensity;
+            // 一次性生成规范采样记录，后续各模块直接读取
+            const float accel[3] = {mpu_data.accel_x, mpu_data.accel_y, mpu_data.accel_z};
+            const float gyro[3] = {mpu_data.gyro_x, mpu_data.gyro_y, mpu_data.gyro_z};
+            Sample_SetMotion(&sensor_data, accel, gyro, mpu_data.angle_x, mpu_data.angle_y,
+                             mpu_data.temperature);
+            Sample_SetEnvironment(&sensor_data, sht_data.temperature, sht_data.humidity,
+                                  bh_data.light_intensity);
+            sensor_data.valid = SAMPLE_VALID_SENSORS;
 
             // 读取GPS数据
-            if (GPS_GetData(&gps_data) == 0) {
-                sensor_data.gps_latitude = gps_data.latitude;
-                sensor_data.gps_longitude = gps_data.longitude;
-                sensor_data.gps_altitude = gps_data.altitude;
-                sensor_data.gps_valid = gps_data.valid;
-
-                // 添加GPS数据到形变分析
-                if (gps_data.valid) {
+            if (GPS_GetData(&gps_data) == 0 && gps_data.valid) {
+                Sample_SetPosition(&sensor_data, gps_data.latitude, gps_data.longitude,
+                                   gps_data.altitude);
+                sensor_data.valid |= SAMPLE_VALID_GPS;
+
+                // 添加GPS数据到形变分析（基准只在显式命令时重建，重启后沿用已保存的基准）
+                if (g_gps_rebaseline_requested) {
+                    g_gps_rebaseline_requested = false;
+                    GPS_Deformation_Reset();
+                }
+
+                // 本站历元按UTC秒与参考站历元配对后再做形变分析；无UTC时间且差分未生效时直接使用
+                if (GpsDiff_AddRover(&gps_data) == -2 && gps_data.utc_seconds == 0 && !GpsDiff_IsActive()) {
                     GPS_Deformation_AddPosition(&gps_data);
                 }
-            } else {
-                sensor_data.gps_valid = false;
+            }
+
+            // 参考站历元可能晚于本站到达，每个周期取出已配对或等待超时的历元
+            GPSData corrected_gps;
+            while (GpsDiff_GetCorrected(&corrected_gps) == 0) {
+                GPS_Deformation_AddPosition(&corrected_gps);
             }
 
             sensor_data.timestamp = LOS_TickCountGet();
-            sensor_data.data_valid = true;
         } else {
             printf("Failed to read sensor data, errors: %d\n", ret);
-            sensor_data.data_valid = false;
+            sensor_data.valid = 0;
+            sensor_data.timestamp = LOS_TickCountGet();
             g_system_stats.sensor_errors++;
         }
 
@@ -652,16 +954,67 @@ static void SensorCollectionTask(void)
         g_latest_sensor_data = sensor_data;
         AddSensorDataToBuffer(&sensor_data);
         g_system_stats.data_samples++;
+        message.sequence = ++g_pipeline_stats.samples;
         LOS_MuxPost(g_data_mutex);
 
-        // 通知数据处理任务
-        LOS_SemPost(g_sensor_sem);
+        // 更新归档汇总（仅内存操作，Flash写入在主循环中完成）
+        DataArchive_AddSample(&sensor_data);
+
+        // 样本交给数据处理任务（不阻塞采集，处理积压时丢弃并计数）
+        message.sample = sensor_data;
+        if (LOS_QueueWriteCopy(g_sample_queue, &message, sizeof(message), 0) != LOS_OK) {
+            LOS_MuxPend(g_data_mutex, LOS_WAIT_FOREVER);
+            g_pipeline_stats.dropped++;
+            LOS_MuxPost(g_data_mutex);
+        }
+
+        // 采样周期取请求周期与总线可持续周期的较大者（读取耗时按指数平均）
+        uint32_t now = LOS_TickCountGet();
+        float elapsed_ms = (float)(now - read_start);
+        read_time_ms = (read_time_ms == 0.0f) ? elapsed_ms : 0.9f * read_time_ms + 0.1f * elapsed_ms;
+        uint32_t bus_interval_ms = (uint32_t)ceilf(read_time_ms * SENSOR_BUS_MARGIN);
+        if (g_requested_sample_rate != requested_hz) {
+            requested_hz = g_requested_sample_rate;
+            printf("Sampling at %uHz requested\n", requested_hz);
+        }
+        interval_ms = 1000 / requested_hz;
+        bool bus_limited = bus_interval_ms > interval_ms;
+        if (bus_limited) {
+            interval_ms = bus_interval_ms;
+        }
+
+        window_samples++;
+        bool window_done = now - window_start >= SENSOR_RATE_WINDOW_MS;
+
+        // 按绝对时间调度，读取耗时不累积到采样周期；超时则从当前时刻重新计时
+        next_sample += interval_ms;
+        bool overrun = (int32_t)(next_sample - now) <= 0;
+        if (overrun) {
+            next_sample = now;
+        }
+
+        LOS_MuxPend(g_data_mutex, LOS_WAIT_FOREVER);
+        g_sampling_status.requested_hz = requested_hz;
+        g_sampling_status.interval_ms = interval_ms;
+        g_sampling_status.read_time_ms = read_time_ms;
+        g_sampling_status.bus_limited = bus_limited;
+        if (overrun) {
+            g_sampling_status.overruns++;
+        }
+        if (window_done) {
+            g_sampling_status.achieved_hz = window_samples * 1000.0f / (now - window_start);
+        }
+        LOS_MuxPost(g_data_mutex);
 
-        // 检查马达自动停止（非阻塞）
-        Motor_CheckAutoStop();
+        if (window_done) {
+            window_start = now;
+            window_samples = 0;
+        }
 
-        // 等待下次采样
-        LOS_Msleep(sample_interval_ms);
+        // 超时时仍短暂休眠，让出CPU给低优先级任务
+        uint32_t sleep_ms = overrun ? 1 : next_sample - now;
+        Profiler_LoopEnd(sleep_ms);
+        LOS_Msleep(sleep_ms);
     }
 
     printf("Sensor collection task stopped\n");
@@ -672,25 +1025,37 @@ static void SensorCollectionTask(void)
  */
 static void DataProcessingTask(void)
 {
+    SampleMessage message;
     ProcessedData processed_data;
 
     printf("Data processing task started\n");
 
     while (g_system_state == SYSTEM_STATE_RUNNING || g_system_state == SYSTEM_STATE_WARNING) {
-        // 等待传感器数据
-        LOS_SemPend(g_sensor_sem, LOS_WAIT_FOREVER);
-
-        if (g_system_state != SYSTEM_STATE_RUNNING) {
-            break;
+        // 等待传感器数据（超时后重新检查系统状态）
+        UINT32 size = sizeof(message);
+        if (LOS_QueueReadCopy(g_sample_queue, &message, &size, PIPELINE_WAIT_MS) != LOS_OK) {
+            continue;
         }
+        Profiler_LoopBegin();
 
         // 处理传感器数据
-        ProcessSensorData(&processed_data);
+        ProcessSensorData(&message.sample, &processed_data);
+        processed_data.timestamp = message.sample.timestamp;
+        processed_data.sequence = message.sequence;
 
         // 更新全局处理数据
         LOS_MuxPend(g_data_mutex, LOS_WAIT_FOREVER);
         g_latest_processed_data = processed_data;
+        g_pipeline_stats.processed++;
         LOS_MuxPost(g_data_mutex);
+
+        // 每个处理结果交给风险评估任务恰好评估一次
+        if (LOS_QueueWriteCopy(g_processed_queue, &processed_data, sizeof(processed_data), 0) != LOS_OK) {
+            LOS_MuxPend(g_data_mutex, LOS_WAIT_FOREVER);
+            g_pipeline_stats.dropped++;
+            LOS_MuxPost(g_data_mutex);
+        }
+        Profiler_LoopEnd(0);
     }
 
     printf("Data processing task stopped\n");
@@ -703,58 +1068,55 @@ static void RiskEvaluationTask(void)
 {
     RiskAssessment assessment;
     ProcessedData processed_data;
-    uint32_t last_eval_time = 0;
+    bool has_data = false;
 
     printf("Risk evaluation task started\n");
 
     while (g_system_state == SYSTEM_STATE_RUNNING || g_system_state == SYSTEM_STATE_WARNING) {
-        uint32_t current_time = LOS_TickCountGet();
-
-        // 优先检查重置标志（每次循环都检查）
-        if (g_alarm_acknowledged) {
+        // 每个新处理结果评估一次；无新数据时仍定期检查手动复位，用最近一次处理结果重新评估
+        UINT32 size = sizeof(processed_data);
+        bool fresh = LOS_QueueReadCopy(g_processed_queue, &processed_data, &size, RISK_EVAL_IDLE_MS) == LOS_OK;
+        if (fresh) {
+            has_data = true;
+        } else if (g_alarm_acknowledged && has_data) {
             printf("RiskEvalTask: Processing manual reset request...\n");
-            // 立即处理重置逻辑
-            LOS_MuxPend(g_data_mutex, LOS_WAIT_FOREVER);
-            ProcessedData temp_data = g_latest_processed_data;
-            LOS_MuxPost(g_data_mutex);
-
-            RiskAssessment temp_assessment;
-            EvaluateRisk(&temp_data, &temp_assessment);  // 这会处理重置逻辑
-
-            LOS_MuxPend(g_data_mutex, LOS_WAIT_FOREVER);
-            g_latest_risk_assessment = temp_assessment;
-            LOS_MuxPost(g_data_mutex);
+        } else {
+            continue;
         }
+        Profiler_LoopBegin();
 
-        // 检查是否到了评估时间
-        if (current_time - last_eval_time >= RISK_EVAL_INTERVAL_MS) {
-            // 获取处理后的数据
-            LOS_MuxPend(g_data_mutex, LOS_WAIT_FOREVER);
-            processed_data = g_latest_processed_data;
-            LOS_MuxPost(g_data_mutex);
-
-            // 进行风险评估
-            EvaluateRisk(&processed_data, &assessment);
+        // 进行风险评估
+        EvaluateRisk(&processed_data, &assessment);
+        assessment.sample_timestamp = processed_data.timestamp;
+        assessment.sequence = processed_data.sequence;
+        uint32_t latency_ms = LOS_TickCountGet() - processed_data.timestamp;
 
-            // 更新全局风险评估
-            LOS_MuxPend(g_data_mutex, LOS_WAIT_FOREVER);
-            g_latest_risk_assessment = assessment;
+        // 更新全局风险评估
+        LOS_MuxPend(g_data_mutex, LOS_WAIT_FOREVER);
+        RiskLevel previous_level = g_latest_risk_assessment.level;
+        g_latest_risk_assessment = assessment;
 
-            // 更新系统状态
-            if (assessment.level >= RISK_LEVEL_HIGH) {
-                g_system_state = SYSTEM_STATE_WARNING;
+        // 更新系统状态（评估随采样频率进行，警报次数按进入高风险计）
+        if (assessment.level >= RISK_LEVEL_HIGH) {
+            if (previous_level < RISK_LEVEL_HIGH) {
                 g_system_stats.risk_alerts++;
-            } else if (g_system_state == SYSTEM_STATE_WARNING &&
-                      assessment.level < RISK_LEVEL_MEDIUM) {
-                g_system_state = SYSTEM_STATE_RUNNING;
             }
+            g_system_state = SYSTEM_STATE_WARNING;
+        } else if (g_system_state == SYSTEM_STATE_WARNING &&
+                  assessment.level < RISK_LEVEL_MEDIUM) {
+            g_system_state = SYSTEM_STATE_RUNNING;
+        }
 
-            LOS_MuxPost(g_data_mutex);
-
-            last_eval_time = current_time;
+        if (fresh) {
+            g_pipeline_stats.evaluated++;
+            g_pipeline_stats.risk_latency_ms = (g_pipeline_stats.evaluated == 1) ? (float)latency_ms :
+                0.9f * g_pipeline_stats.risk_latency_ms + 0.1f * latency_ms;
         }
+        LOS_MuxPost(g_data_mutex);
 
-        LOS_Msleep(50);   // 50ms检查间隔
+        // 通知报警任务立即输出
+        LOS_EventWrite(&g_risk_event, RISK_EVENT_UPDATED);
+        Profiler_LoopEnd(0);
     }
 
     printf("Risk evaluation task stopped\n");
@@ -791,11 +1153,9 @@ static void DisplayTask(void)
     g_static_layout_initialized = false;
 
     while (g_system_state == SYSTEM_STATE_RUNNING || g_system_state == SYSTEM_STATE_WARNING) {
+        Profiler_LoopBegin();
         uint32_t current_time = LOS_TickCountGet();
 
-        // 检查按键状态
-        Button_GetState();
-
         // 获取最新数据
         GetLatestSensorData(&sensor_data);
         GetLatestRiskAssessment(&assessment);
@@ -811,10 +1171,13 @@ static void DisplayTask(void)
         }
 
         // 数据变化更新条件：关键数据有显著变化
-        if (!need_update && sensor_data.data_valid) {
-            float angle_change = fabsf(sensor_data.angle_x - last_sensor_data.angle_x) +
-                                fabsf(sensor_data.angle_y - last_sensor_data.angle_y);
-            float temp_change = fabsf(sensor_data.sht_temperature - last_sensor_data.sht_temperature);
+        if (!need_update && Sample_IsValid(&sensor_data, SAMPLE_VALID_SENSORS)) {
+            float angle_change = fabsf(Sample_GetAngle(&sensor_data, SAMPLE_AXIS_X) -
+                                       Sample_GetAngle(&last_sensor_data, SAMPLE_AXIS_X)) +
+                                 fabsf(Sample_GetAngle(&sensor_data, SAMPLE_AXIS_Y) -
+                                       Sample_GetAngle(&last_sensor_data, SAMPLE_AXIS_Y));
+            float temp_change = fabsf(Sample_GetTemperature(&sensor_data) -
+                                      Sample_GetTemperature(&last_sensor_data));
 
             if (angle_change > LCD_DATA_CHANGE_THRESHOLD ||  // 倾斜角度变化超过0.5度
                 temp_change > 2.0f ||                        // 温度变化超过2度
@@ -831,9 +1194,11 @@ static void DisplayTask(void)
                     case LCD_MODE_REALTIME:
                         // 模式0：实时数据模式
                         LCD_Clear(LCD_WHITE);  // 清成白色
+                        Profiler_WaitBegin();
                         LOS_Msleep(50);
+                        Profiler_WaitEnd();
                         LCD_InitStaticLayout();
-                        if (sensor_data.data_valid) {
+                        if (Sample_IsValid(&sensor_data, SAMPLE_VALID_SENSORS)) {
                             LCD_UpdateStatusOnly(&sensor_data);
                             LCD_UpdateDataOnly(&sensor_data);
                         }
@@ -842,7 +1207,9 @@ static void DisplayTask(void)
                     case LCD_MODE_RISK_STATUS:
                         // 模式1：风险状态模式
                         LCD_Clear(LCD_WHITE);  // 清成白色
+                        Profiler_WaitBegin();
                         LOS_Msleep(50);
+                        Profiler_WaitEnd();
                         LCD_InitRiskStatusLayout();
                         // 立即显示数据
                         if (assessment.level >= 0) {
@@ -863,13 +1230,15 @@ static void DisplayTask(void)
             else if (need_update && (current_time - last_update_time >= 500)) {  // 最小0.5秒更新间隔
                 switch (g_lcd_mode) {
                     case LCD_MODE_REALTIME:
-                        if (sensor_data.data_valid) {
+                        if (Sample_IsValid(&sensor_data, SAMPLE_VALID_SENSORS)) {
                             // 只更新变化的数据，不重绘整个屏幕
                             LCD_UpdateDataOnly(&sensor_data);
 
                             // 如果风险等级可能变化，更新状态
-                            float angle_change = fabsf(sensor_data.angle_x - last_sensor_data.angle_x) +
-                                                fabsf(sensor_data.angle_y - last_sensor_data.angle_y);
+                            float angle_change = fabsf(Sample_GetAngle(&sensor_data, SAMPLE_AXIS_X) -
+                                                       Sample_GetAngle(&last_sensor_data, SAMPLE_AXIS_X)) +
+                                                 fabsf(Sample_GetAngle(&sensor_data, SAMPLE_AXIS_Y) -
+                                                       Sample_GetAngle(&last_sensor_data, SAMPLE_AXIS_Y));
                             if (angle_change > 1.0f) {  // 角度变化较大时更新状态
                                 LCD_UpdateStatusOnly(&sensor_data);
                             }
@@ -909,15 +1278,16 @@ static void DisplayTask(void)
         }
 
         // LCD未初始化时使用串口输出 (独立的逻辑块)
-        if (!LCD_IsInitialized() && sensor_data.data_valid && need_update) {
+        if (!LCD_IsInitialized() && Sample_IsValid(&sensor_data, SAMPLE_VALID_SENSORS) && need_update) {
             printf("=== SENSOR DATA ===\n");
             printf("Angle: X=%.1f Y=%.1f deg\n",
-                   sensor_data.angle_x, sensor_data.angle_y);
+                   Sample_GetAngle(&sensor_data, SAMPLE_AXIS_X), Sample_GetAngle(&sensor_data, SAMPLE_AXIS_Y));
             printf("Temp: %.1f C, Humidity: %.1f%%\n",
-                   sensor_data.sht_temperature, sensor_data.humidity);
+                   Sample_GetTemperature(&sensor_data), Sample_GetHumidity(&sensor_data));
             printf("Risk Level: %d\n", assessment.level);
         }
 
+        Profiler_LoopEnd(100);
         LOS_Msleep(100);  // 100ms检查间隔
     }
 
@@ -932,12 +1302,24 @@ static void AlarmTask(void)
     RiskAssessment assessment;
     uint32_t last_alarm_time = 0;
     uint32_t last_voice_time = 0;
+    uint32_t last_sequence = 0;
+    RiskLevel last_voice_level = RISK_LEVEL_SAFE;
 
     printf("Alarm task started\n");
 
     while (g_system_state == SYSTEM_STATE_RUNNING || g_system_state == SYSTEM_STATE_WARNING) {
+        // 等待新的风险评估结果，超时后照常处理语音、上传和按键（是否有新结果以采样序号判断）
+        LOS_EventRead(&g_risk_event, RISK_EVENT_UPDATED | BUTTON_EVENT_QUEUED, LOS_WAITMODE_OR | LOS_WAITMODE_CLR,
+                      ALARM_TASK_INTERVAL_MS);
+        Profiler_LoopBegin();
         uint32_t current_time = LOS_TickCountGet();
 
+        // 处理按键事件（按键事件入队即唤醒本任务，不受LCD刷新影响）
+        ButtonEvent button_event;
+        while (ButtonInput_ReadEvent(&button_event, 0) == 0) {
+            ButtonEventHandler(&button_event);
+        }
+
         // 获取最新风险评估
         GetLatestRiskAssessment(&assessment);
 
@@ -947,7 +1329,7 @@ static void AlarmTask(void)
         // 设置报警灯
         AlarmLight_SetByRisk(assessment.level);
 
-        // 检查是否需要声音/振动报警
+        // 检查是否需要声音/振动报警（模式由定时器播放，调用立即返回；等级升高时新模式抢占正在播放的模式）
         if (assessment.level >= RISK_LEVEL_MEDIUM &&
             current_time - last_alarm_time >= 5000) {  // 5秒间隔
 
@@ -957,40 +1339,47 @@ static void AlarmTask(void)
             last_alarm_time = current_time;
         }
 
-        // 检查是否需要语音播报
-        if (current_time - last_voice_time >= VOICE_REPORT_INTERVAL_S * 1000) {
+        // 统计采样到报警输出的延迟（每个新评估结果计一次）
+        if (assessment.sequence != last_sequence) {
+            uint32_t latency_ms = LOS_TickCountGet() - assessment.sample_timestamp;
+            last_sequence = assessment.sequence;
+
+            LOS_MuxPend(g_data_mutex, LOS_WAIT_FOREVER);
+            g_pipeline_stats.actuated++;
+            g_pipeline_stats.last_sequence = assessment.sequence;
+            g_pipeline_stats.alarm_latency_ms = (g_pipeline_stats.actuated == 1) ? (float)latency_ms :
+                0.9f * g_pipeline_stats.alarm_latency_ms + 0.1f * latency_ms;
+            if (latency_ms > g_pipeline_stats.alarm_latency_max_ms) {
+                g_pipeline_stats.alarm_latency_max_ms = latency_ms;
+            }
+            LOS_MuxPost(g_data_mutex);
+        }
+
+        // 语音播报（只入队，由语音任务播放）：等级变化时立即播报，有风险时定期提醒，安全状态只在恢复时播报一次
+        if (assessment.level != last_voice_level ||
+            (assessment.level >= RISK_LEVEL_LOW &&
+             current_time - last_voice_time >= VOICE_REPORT_INTERVAL_S * 1000)) {
             if (assessment.level >= RISK_LEVEL_LOW) {
                 Voice_PlayMessage(VOICE_MSG_LOW_RISK + (assessment.level - RISK_LEVEL_LOW));
             } else {
                 Voice_PlayMessage(VOICE_MSG_SAFE);
             }
 
+            last_voice_level = assessment.level;
             last_voice_time = current_time;
         }
 
         // 动态上传频率：根据风险等级调整上传间隔
         static uint32_t last_iot_upload = 0;
-        uint32_t upload_interval = 30000;  // 默认30秒
         RiskAssessment current_risk;
+        RuntimeConfig config;
         GetLatestRiskAssessment(&current_risk);
+        GetRuntimeConfig(&config);
 
-        // 根据风险等级调整上传频率（缩短间隔）
-        switch (current_risk.level) {
-            case RISK_LEVEL_SAFE:
-                upload_interval = 30000;    // 安全：30秒
-                break;
-            case RISK_LEVEL_LOW:
-                upload_interval = 15000;    // 低风险：15秒
-                break;
-            case RISK_LEVEL_MEDIUM:
-                upload_interval = 5000;     // 中风险：5秒
-                break;
-            case RISK_LEVEL_HIGH:
-                upload_interval = 3000;     // 高风险：3秒
-                break;
-            case RISK_LEVEL_CRITICAL:
-                upload_interval = 1000;     // 危急：1秒
-                break;
+        // 根据风险等级调整上传频率（风险越高间隔越短，间隔可由云端配置）
+        uint32_t upload_interval = config.upload_interval_ms[RISK_LEVEL_SAFE];
+        if (current_risk.level >= RISK_LEVEL_SAFE && current_risk.level <= RISK_LEVEL_CRITICAL) {
+            upload_interval = config.upload_interval_ms[current_risk.level];
         }
 
         // 上传数据到华为云IoT平台 (动态频率)
@@ -998,70 +1387,69 @@ static void AlarmTask(void)
             SensorData sensor_data;
             GetLatestSensorData(&sensor_data);
 
-            if (sensor_data.data_valid) {
+            if (Sample_IsValid(&sensor_data, SAMPLE_VALID_SENSORS)) {
                 LandslideIotData iot_data = {0};
 
-                // 填充传感器数据
-                iot_data.temperature = sensor_data.sht_temperature;
-                iot_data.humidity = sensor_data.humidity;
-                iot_data.light = sensor_data.light_intensity;
-
-                // 填充MPU6050真实数据
-                iot_data.accel_x = sensor_data.accel_x;
-                iot_data.accel_y = sensor_data.accel_y;
-                iot_data.accel_z = sensor_data.accel_z;
-                iot_data.gyro_x = sensor_data.gyro_x;
-                iot_data.gyro_y = sensor_data.gyro_y;
-                iot_data.gyro_z = sensor_data.gyro_z;
-                iot_data.angle_x = sensor_data.angle_x;
-                iot_data.angle_y = sensor_data.angle_y;
-                // 注意：Z轴倾角在物理上没有明确定义，这里计算的是总倾斜角度
-                // 更准确的名称应该是 tilt_magnitude（倾斜幅值）
-                iot_data.angle_z = sqrtf(sensor_data.angle_x * sensor_data.angle_x +
-                                       sensor_data.angle_y * sensor_data.angle_y);
-                iot_data.vibration = sqrtf(sensor_data.accel_x * sensor_data.accel_x +
-                                         sensor_data.accel_y * sensor_data.accel_y +
-                                         sensor_data.accel_z * sensor_data.accel_z);
-
-                // 填充GPS数据
-                iot_data.gps_latitude = sensor_data.gps_latitude;
-                iot_data.gps_longitude = sensor_data.gps_longitude;
-                iot_data.gps_altitude = sensor_data.gps_altitude;
-                iot_data.gps_valid = sensor_data.gps_valid;
-
-                // 填充GPS形变分析数据
+                // 直接内嵌规范采样记录，不再逐字段转换
+                iot_data.sample = sensor_data;
+
+                // 填充GPS形变分析数据（分析无效时保持为0）
                 GPSDeformationAnalysis deform_analysis;
                 if (GPS_Deformation_GetAnalysis(&deform_analysis) == 0) {
-                    iot_data.deformation_distance_3d = deform_analysis.displacement.distance_3d;
-                    iot_data.deformation_horizontal = deform_analysis.displacement.horizontal_distance;
-                    iot_data.deformation_vertical = deform_analysis.displacement.vertical_distance;
-                    iot_data.deformation_velocity = deform_analysis.velocity.total_velocity;
-                    iot_data.deformation_risk_level = (int)deform_analysis.risk_level;
-                    iot_data.deformation_type = (int)deform_analysis.deform_type;
-                    iot_data.deformation_confidence = deform_analysis.confidence;
-                    iot_data.baseline_established = deform_analysis.baseline_established;
-                } else {
-                    // GPS形变分析无效时的默认值
-                    iot_data.deformation_distance_3d = 0.0f;
-                    iot_data.deformation_horizontal = 0.0f;
-                    iot_data.deformation_vertical = 0.0f;
-                    iot_data.deformation_velocity = 0.0f;
-                    iot_data.deformation_risk_level = 0;
-                    iot_data.deformation_type = 0;
-                    iot_data.deformation_confidence = 0.0f;
-                    iot_data.baseline_established = false;
+                    iot_data.deformation_distance_3d =
+                        (int32_t)lroundf(deform_analysis.displacement.distance_3d * IOT_DEFORM_DISTANCE_SCALE);
+                    iot_data.deformation_horizontal =
+                        (int32_t)lroundf(deform_analysis.displacement.horizontal_distance * IOT_DEFORM_DISTANCE_SCALE);
+                    iot_data.deformation_vertical =
+                        (int32_t)lroundf(deform_analysis.displacement.vertical_distance * IOT_DEFORM_DISTANCE_SCALE);
+                    iot_data.deformation_velocity =
+                        (int32_t)lroundf(deform_analysis.velocity.total_velocity * IOT_DEFORM_DISTANCE_SCALE);
+                    iot_data.deformation_east =
+                        (int32_t)lroundf(deform_analysis.displacement.east * IOT_DEFORM_DISTANCE_SCALE);
+                    iot_data.deformation_north =
+                        (int32_t)lroundf(deform_analysis.displacement.north * IOT_DEFORM_DISTANCE_SCALE);
+                    iot_data.deformation_velocity_ci =
+                        (int32_t)lroundf(deform_analysis.velocity.velocity_ci * IOT_DEFORM_DISTANCE_SCALE);
+                    iot_data.deformation_acceleration =
+                        (int32_t)lroundf(deform_analysis.velocity.acceleration * IOT_DEFORM_DISTANCE_SCALE);
+                    iot_data.deformation_risk_level = (uint8_t)deform_analysis.risk_level;
+                    iot_data.deformation_type = (uint8_t)deform_analysis.deform_type;
+                    iot_data.deformation_confidence =
+                        (uint16_t)lroundf(deform_analysis.confidence * IOT_DEFORM_CONFIDENCE_SCALE);
+                    if (deform_analysis.baseline_established) {
+                        iot_data.flags |= IOT_DATA_FLAG_BASELINE;
+                    }
+                }
+
+                // 填充失稳时间预测
+                iot_data.forecast_time_to_failure = -1;
+                if (assessment.forecast_ttf_h >= 0) {
+                    iot_data.forecast_time_to_failure = (int32_t)lroundf(assessment.forecast_ttf_h * 60.0f);
+                    iot_data.forecast_confidence =
+                        (uint16_t)lroundf(assessment.forecast_confidence * IOT_DEFORM_CONFIDENCE_SCALE);
                 }
 
                 // 填充系统状态
-                iot_data.risk_level = assessment.level;
-                iot_data.alarm_active = (assessment.level >= RISK_LEVEL_MEDIUM);
+                iot_data.risk_level = (uint8_t)assessment.level;
+                if (assessment.level >= RISK_LEVEL_MEDIUM) {
+                    iot_data.flags |= IOT_DATA_FLAG_ALARM_ACTIVE;
+                }
                 iot_data.uptime = g_system_stats.uptime_seconds;
-
-                // 填充设备状态
-                iot_data.rgb_enabled = true;
-                iot_data.buzzer_enabled = true;
-                iot_data.motor_enabled = true;
-                iot_data.voice_enabled = true;
+                SamplingStatus sampling;
+                GetSamplingStatus(&sampling);
+                iot_data.sample_rate_requested = (uint16_t)(sampling.requested_hz * 10);
+                iot_data.sample_rate_achieved = (uint16_t)lroundf(sampling.achieved_hz * 10.0f);
+                PipelineStats pipeline;
+                GetPipelineStats(&pipeline);
+                iot_data.alarm_latency = (uint16_t)lroundf(fminf(pipeline.alarm_latency_ms, UINT16_MAX));
+                iot_data.alarm_latency_max = (uint16_t)(pipeline.alarm_latency_max_ms < UINT16_MAX ?
+                                                        pipeline.alarm_latency_max_ms : UINT16_MAX);
+                ProcessedData processed;
+                GetLatestProcessedData(&processed);
+                iot_data.anomaly_score = (int16_t)lroundf(fminf(fmaxf(processed.anomaly_score, -300.0f), 300.0f) * 100.0f);
+                iot_data.moisture_index = (uint16_t)lroundf(processed.moisture_index * 1000.0f);
+                iot_data.infiltration_index = (uint16_t)lroundf(processed.infiltration_index * 1000.0f);
+                iot_data.tilt_creep = (uint16_t)lroundf(fminf(processed.tilt_creep, 600.0f) * 100.0f);
 
                 // 统一使用IoTCloud_SendData处理所有上传和缓存逻辑
                 if (IoTCloud_SendData(&iot_data) == 0) {
@@ -1072,9 +1460,6 @@ static void AlarmTask(void)
             }
         }
 
-        // 检查按键状态
-        Button_GetState();  // 按键检测会自动处理重置逻辑
-
         // 检查云端重置命令
         if (g_alarm_acknowledged) {
             printf("Processing reset command...\n");
@@ -1083,6 +1468,9 @@ static void AlarmTask(void)
             printf("Current confirmed_level=%d, max_triggered_level=%d\n",
                    confirmed_level, max_triggered_level);
 
+            // 倾斜蠕变报警随操作员确认解除，以当前倾角重新建立参考
+            TiltCreep_Rearm();
+
             // 强制重置逻辑（无论当前状态如何）
             if (manual_reset_required || max_triggered_level > RISK_LEVEL_LOW) {
                 confirmed_level = RISK_LEVEL_SAFE;
@@ -1096,7 +1484,7 @@ static void AlarmTask(void)
             g_alarm_acknowledged = false;  // 重置标志
         }
 
-        LOS_Msleep(200);  // 200ms检查间隔
+        Profiler_LoopEnd(ALARM_TASK_INTERVAL_MS);
     }
 
     printf("Alarm task stopped\n");
@@ -1136,66 +1524,83 @@ static void AddSensorDataToBuffer(const SensorData *data)
 
 /**
  * @brief 处理传感器数据
+ * @param sample 采集任务发来的样本
  * @param processed 处理后的数据
  */
-static void ProcessSensorData(ProcessedData *processed)
+static void ProcessSensorData(const SensorData *sample, ProcessedData *processed)
 {
-    if (processed == NULL) {
+    if (sample == NULL || processed == NULL) {
         return;
     }
 
-    // 获取最新传感器数据
-    SensorData current_data = g_latest_sensor_data;
+    SensorData current_data = *sample;
 
-    if (!current_data.data_valid) {
+    if (!Sample_IsValid(&current_data, SAMPLE_VALID_SENSORS)) {
         memset(processed, 0, sizeof(ProcessedData));
         return;
     }
 
     // 计算加速度幅值
-    processed->accel_magnitude = sqrtf(current_data.accel_x * current_data.accel_x +
-                                      current_data.accel_y * current_data.accel_y +
-                                      current_data.accel_z * current_data.accel_z);
+    processed->accel_magnitude = Sample_GetAccelMagnitude(&current_data);
 
     // 计算倾角幅值
-    processed->angle_magnitude = sqrtf(current_data.angle_x * current_data.angle_x +
-                                      current_data.angle_y * current_data.angle_y);
+    processed->angle_magnitude = Sample_GetTiltMagnitude(&current_data);
+
+    // 与上一样本的间隔（采样频率可在运行中调整，滤波和变化率按实际间隔换算）
+    static uint32_t last_timestamp = 0;
+    float dt_ms = (last_timestamp != 0 && current_data.timestamp != last_timestamp) ?
+                  (float)(current_data.timestamp - last_timestamp) : 1000.0f / SENSOR_SAMPLE_RATE_HZ;
+    last_timestamp = current_data.timestamp;
 
     // 计算振动强度 (改进版：基于陀螺仪数据，加入滤波和校准)
-    static float gyro_baseline_x = 0.0f, gyro_baseline_y = 0.0f, gyro_baseline_z = 0.0f;
-    static bool baseline_initialized = false;
-    static int baseline_samples = 0;
-
-    // 初始化基线（前100个样本的平均值作为静态偏移）
-    if (!baseline_initialized) {
-        if (baseline_samples < 100) {
-            gyro_baseline_x += current_data.gyro_x;
-            gyro_baseline_y += current_data.gyro_y;
-            gyro_baseline_z += current_data.gyro_z;
-            baseline_samples++;
+    static float gyro_sum[3] = {0.0f, 0.0f, 0.0f};
+    static int calibration_samples = 0;
+    float gyro_x = Sample_GetGyro(&current_data, SAMPLE_AXIS_X);
+    float gyro_y = Sample_GetGyro(&current_data, SAMPLE_AXIS_Y);
+    float gyro_z = Sample_GetGyro(&current_data, SAMPLE_AXIS_Z);
+
+    // 收到云端校准命令时丢弃当前零偏，重新采集
+    if (g_gyro_calibration_requested) {
+        g_gyro_calibration_requested = false;
+        g_gyro_calibrated = false;
+        memset(gyro_sum, 0, sizeof(gyro_sum));
+        calibration_samples = 0;
+    }
+
+    // 校准零偏（前100个样本的平均值作为静态偏移，已保存时直接使用）
+    if (!g_gyro_calibrated) {
+        if (calibration_samples < GYRO_CALIBRATION_SAMPLES) {
+            gyro_sum[0] += gyro_x;
+            gyro_sum[1] += gyro_y;
+            gyro_sum[2] += gyro_z;
+            calibration_samples++;
             processed->vibration_intensity = 0.0f; // 校准期间振动强度为0
         } else {
-            gyro_baseline_x /= 100.0f;
-            gyro_baseline_y /= 100.0f;
-            gyro_baseline_z /= 100.0f;
-            baseline_initialized = true;
+            for (int i = 0; i < 3; i++) {
+                g_gyro_calibration.bias[i] = gyro_sum[i] / GYRO_CALIBRATION_SAMPLES;
+            }
+            g_gyro_calibrated = true;
             printf("Gyro baseline calibrated: X=%.2f, Y=%.2f, Z=%.2f\n",
-                   gyro_baseline_x, gyro_baseline_y, gyro_baseline_z);
+                   g_gyro_calibration.bias[0], g_gyro_calibration.bias[1], g_gyro_calibration.bias[2]);
+            if (KvStore_Set(KV_KEY_GYRO_CALIBRATION, &g_gyro_calibration, sizeof(g_gyro_calibration)) != 0) {
+                printf("Failed to save gyro calibration\n");
+            }
         }
     } else {
         // 去除基线偏移
-        float filtered_gyro_x = current_data.gyro_x - gyro_baseline_x;
-        float filtered_gyro_y = current_data.gyro_y - gyro_baseline_y;
-        float filtered_gyro_z = current_data.gyro_z - gyro_baseline_z;
+        float filtered_gyro_x = gyro_x - g_gyro_calibration.bias[0];
+        float filtered_gyro_y = gyro_y - g_gyro_calibration.bias[1];
+        float filtered_gyro_z = gyro_z - g_gyro_calibration.bias[2];
 
         // 计算振动强度（角速度幅值）
         float raw_intensity = sqrtf(filtered_gyro_x * filtered_gyro_x +
                                    filtered_gyro_y * filtered_gyro_y +
                                    filtered_gyro_z * filtered_gyro_z);
 
-        // 简单低通滤波（平滑处理）
+        // 一阶低通滤波，系数按实际采样间隔计算，改变采样频率时平滑时间不变
         static float last_intensity = 0.0f;
-        processed->vibration_intensity = 0.7f * last_intensity + 0.3f * raw_intensity;
+        float alpha = 1.0f - expf(-dt_ms / VIBRATION_FILTER_TAU_MS);
+        processed->vibration_intensity = (1.0f - alpha) * last_intensity + alpha * raw_intensity;
         last_intensity = processed->vibration_intensity;
     }
 
@@ -1205,18 +1610,208 @@ static void ProcessSensorData(ProcessedData *processed)
     static float last_humidity = 0.0f;
     static float last_light = 0.0f;
 
-    processed->accel_change_rate = fabsf(processed->accel_magnitude - last_accel_mag);
-    processed->angle_change_rate = fabsf(processed->angle_magnitude - last_angle_mag);
-    processed->humidity_trend = current_data.humidity - last_humidity;
-    processed->light_change_rate = fabsf(current_data.light_intensity - last_light);
+    // 变化量换算到默认采样周期（1/SENSOR_SAMPLE_RATE_HZ秒），各风险阈值含义不随采样频率改变
+    const float nominal_ms = 1000.0f / SENSOR_SAMPLE_RATE_HZ;
+    processed->accel_change_rate = fabsf(processed->accel_magnitude - last_accel_mag) * nominal_ms / dt_ms;
+    processed->angle_change_rate = fabsf(processed->angle_magnitude - last_angle_mag) * nominal_ms / dt_ms;
+
+    // 温湿度/光照按SENSOR_ENV_INTERVAL_MS读取，变化率按读取间隔计算，间隔内保持上次结果
+    static uint32_t last_env_time = 0;
+    static float humidity_trend = 0.0f;
+    static float light_change_rate = 0.0f;
+    float humidity = Sample_GetHumidity(&current_data);
+    float light = Sample_GetLight(&current_data);
+    uint32_t env_elapsed = current_data.timestamp - last_env_time;
+    if (last_env_time == 0) {
+        last_env_time = current_data.timestamp;
+        last_humidity = humidity;
+        last_light = light;
+    } else if (env_elapsed >= SENSOR_ENV_INTERVAL_MS) {
+        humidity_trend = (humidity - last_humidity) * nominal_ms / env_elapsed;
+        light_change_rate = fabsf(light - last_light) * nominal_ms / env_elapsed;
+        last_env_time = current_data.timestamp;
+        last_humidity = humidity;
+        last_light = light;
+    }
+    processed->humidity_trend = humidity_trend;
+    processed->light_change_rate = light_change_rate;
+
+    // 前期湿润指数：湿度和露点差的多时间尺度衰减积分
+    MoistureIndex moisture;
+    processed->moisture_index = 0.0f;
+    processed->infiltration_index = 0.0f;
+    if (Moisture_Update(humidity, Sample_GetTemperature(&current_data), current_data.timestamp, &moisture) == 0) {
+        processed->moisture_index = moisture.index;
+        processed->infiltration_index = moisture.scales[MOISTURE_SCALE_SHORT];
+    }
 
     // 更新历史值
     last_accel_mag = processed->accel_magnitude;
     last_angle_mag = processed->angle_magnitude;
-    last_humidity = current_data.humidity;
-    last_light = current_data.light_intensity;
 
     processed->timestamp = current_data.timestamp;
+    processed->humidity = humidity;
+    processed->temperature = Sample_GetTemperature(&current_data);
+    processed->data_quality = EvaluateSampleQuality(&current_data);
+
+    // 倾角进入反速度失稳预测（内部分块平均）
+    Forecast_AddTiltSample(current_data.timestamp, processed->angle_magnitude);
+
+    // 倾斜蠕变和多传感器异常检测（陀螺仪校准期间不学习）
+    processed->anomaly_score = 0.0f;
+    processed->tilt_creep = 0.0f;
+    processed->creep_onset = 0;
+    if (g_gyro_calibrated) {
+        // 各轴融合倾角的慢速蠕变：逐样本倾角变化率被噪声淹没，分块平均后做CUSUM
+        CreepStatus creep;
+        if (TiltCreep_Update(Sample_GetAngle(&current_data, SAMPLE_AXIS_X), Sample_GetAngle(&current_data, SAMPLE_AXIS_Y),
+                             current_data.timestamp, &creep) == 0 && creep.ready) {
+            processed->tilt_creep = creep.statistic;
+            processed->creep_onset = creep.onset_time;
+        }
+
+        // 多传感器组合异常：各自低于阈值的倾斜蠕变、湿度上升、微振动同时出现时分数升高
+        float features[ANOMALY_FEATURES];
+        AnomalyResult anomaly;
+        features[ANOMALY_FEATURE_TILT] = processed->angle_magnitude;
+        features[ANOMALY_FEATURE_VIBRATION] = processed->vibration_intensity;
+        features[ANOMALY_FEATURE_HUMIDITY] = humidity;
+        features[ANOMALY_FEATURE_HUMIDITY_TREND] = processed->humidity_trend;
+        features[ANOMALY_FEATURE_TEMPERATURE] = Sample_GetTemperature(&current_data);
+        if (Anomaly_Update(features, current_data.timestamp, &anomaly) == 0 && anomaly.ready) {
+            processed->anomaly_score = anomaly.score;
+        }
+    }
+}
+
+/**
+ * @brief 检查运行配置是否合理
+ * @param config 配置结构指针
+ * @return true: 有效, false: 无效
+ */
+static bool IsRuntimeConfigValid(const RuntimeConfig *config)
+{
+    for (int i = RISK_LEVEL_SAFE; i <= RISK_LEVEL_CRITICAL; i++) {
+        // 上传间隔1秒~1小时，风险越高间隔不应越长
+        if (config->upload_interval_ms[i] < 1000 || config->upload_interval_ms[i] > 3600000) {
+            return false;
+        }
+        if (i > RISK_LEVEL_SAFE && config->upload_interval_ms[i] > config->upload_interval_ms[i - 1]) {
+            return false;
+        }
+    }
+
+    return config->deform_alert_distance > 0.0f &&
+           config->deform_critical_distance > config->deform_alert_distance &&
+           config->deform_critical_distance <= 100.0f;
+}
+
+/**
+ * @brief 从KV存储恢复运行配置和陀螺仪校准（不存在或无效时使用默认值）
+ */
+static void LoadPersistentSettings(void)
+{
+    RuntimeConfig config;
+    if (KvStore_Get(KV_KEY_RUNTIME_CONFIG, &config, sizeof(config)) == 0) {
+        if (IsRuntimeConfigValid(&config)) {
+            LOS_MuxPend(g_data_mutex, LOS_WAIT_FOREVER);
+            g_runtime_config = config;
+            LOS_MuxPost(g_data_mutex);
+            GPS_Deformation_SetThresholds(config.deform_alert_distance, config.deform_critical_distance);
+            printf("Runtime config restored\n");
+        } else {
+            printf("Stored runtime config invalid, using defaults\n");
+        }
+    }
+
+    if (KvStore_Get(KV_KEY_GYRO_CALIBRATION, &g_gyro_calibration, sizeof(g_gyro_calibration)) == 0) {
+        g_gyro_calibrated = true;
+        printf("Gyro calibration restored: X=%.2f, Y=%.2f, Z=%.2f\n",
+               g_gyro_calibration.bias[0], g_gyro_calibration.bias[1], g_gyro_calibration.bias[2]);
+    } else {
+        memset(&g_gyro_calibration, 0, sizeof(g_gyro_calibration));
+    }
+
+    uint32_t rate_hz;
+    if (KvStore_Get(KV_KEY_SAMPLE_RATE, &rate_hz, sizeof(rate_hz)) == 0 &&
+        rate_hz >= SENSOR_SAMPLE_RATE_MIN_HZ && rate_hz <= SENSOR_SAMPLE_RATE_MAX_HZ) {
+        g_requested_sample_rate = rate_hz;
+        printf("Sensor sample rate restored: %uHz\n", rate_hz);
+    }
+}
+
+/**
+ * @brief 评估样本数据质量（风险评估置信度中与样本相关的部分）
+ * @param sample 采样记录
+ * @return 数据质量 (0.0-0.9)
+ */
+static float EvaluateSampleQuality(const SensorData *sample)
+{
+    float confidence = 0.0f;
+
+    // 1. 基础数据有效性 (30%)
+    if (Sample_IsValid(sample, SAMPLE_VALID_SENSORS)) {
+        confidence += 0.3f;
+    }
+
+    // 2. 传感器数据合理性检查 (40%) - 检测真正的传感器异常
+    int sensor_ok_count = 0;
+
+    float temperature = Sample_GetTemperature(sample);
+    float humidity = Sample_GetHumidity(sample);
+
+    // 温度传感器检查：正常环境温度范围
+    if (temperature >= -40.0f && temperature <= 80.0f) {
+        sensor_ok_count++;
+    }
+
+    // 湿度传感器检查：物理可能范围
+    if (humidity >= 0.0f && humidity <= 100.0f) {
+        sensor_ok_count++;
+    }
+
+    // 光照传感器检查：非负值且不超过强阳光
+    float light = Sample_GetLight(sample);
+    if (light >= 0.0f && light <= 100000.0f) {
+        sensor_ok_count++;
+    }
+
+    // MPU6050传感器检查：加速度在合理范围内（不超过10g）
+    float accel_magnitude = Sample_GetAccelMagnitude(sample);
+    if (accel_magnitude >= 0.5f && accel_magnitude <= 10.0f) {
+        sensor_ok_count++;
+    }
+
+    // 陀螺仪检查：角速度在合理范围内（不超过2000°/s）
+    if (fabsf(Sample_GetGyro(sample, SAMPLE_AXIS_X)) <= 2000.0f &&
+        fabsf(Sample_GetGyro(sample, SAMPLE_AXIS_Y)) <= 2000.0f &&
+        fabsf(Sample_GetGyro(sample, SAMPLE_AXIS_Z)) <= 2000.0f) {
+        sensor_ok_count++;
+    }
+
+    // 传感器可靠性得分
+    float sensor_score = (sensor_ok_count / 5.0f) * 0.4f;
+    confidence += sensor_score;
+
+    // 3. 数据一致性验证 (20%) - 多传感器交叉验证
+    float consistency_score = 0.0f;
+
+    // 倾斜角度与加速度一致性检查
+    float angle_magnitude = Sample_GetTiltMagnitude(sample);
+    if (angle_magnitude < 45.0f) {  // 合理的倾斜角度范围
+        consistency_score += 0.5f;
+    }
+
+    // 温湿度相关性检查（高温通常对应低湿度）
+    if ((temperature > 30.0f && humidity < 80.0f) ||
+        (temperature <= 30.0f)) {
+        consistency_score += 0.5f;
+    }
+
+    float consistency_points = consistency_score * 0.2f;
+    confidence += consistency_points;
+
+    return confidence;
 }
 
 /**
@@ -1230,96 +1825,58 @@ static void EvaluateRisk(const ProcessedData *processed, RiskAssessment *assessm
         return;
     }
 
-    float total_risk_score = 0.0f;
-
-    // 1. 倾斜风险评估 (权重: 40%)
-    assessment->tilt_risk = 0.0f;
-    if (processed->angle_magnitude > 20.0f) {
-        assessment->tilt_risk = 1.0f;
-    } else if (processed->angle_magnitude > 15.0f) {
-        assessment->tilt_risk = 0.8f;
-    } else if (processed->angle_magnitude > 10.0f) {
-        assessment->tilt_risk = 0.6f;
-    } else if (processed->angle_magnitude > 5.0f) {
-        assessment->tilt_risk = 0.3f;
-    }
-    total_risk_score += assessment->tilt_risk * 0.4f;
-
-    // 2. 振动风险评估 (权重: 30%)
-    assessment->vibration_risk = 0.0f;
-    if (processed->vibration_intensity > 100.0f) {
-        assessment->vibration_risk = 1.0f;
-    } else if (processed->vibration_intensity > 50.0f) {
-        assessment->vibration_risk = 0.7f;
-    } else if (processed->vibration_intensity > 20.0f) {
-        assessment->vibration_risk = 0.4f;
-    } else if (processed->vibration_intensity > 10.0f) {
-        assessment->vibration_risk = 0.2f;
-    }
-    total_risk_score += assessment->vibration_risk * 0.3f;
-
-    // 3. 湿度风险评估 (权重: 20%)
-    SensorData sensor_data = g_latest_sensor_data;
-    assessment->humidity_risk = 0.0f;
-    if (sensor_data.humidity > 90.0f) {
-        assessment->humidity_risk = 0.8f;
-    } else if (sensor_data.humidity > 80.0f) {
-        assessment->humidity_risk = 0.6f;
-    } else if (sensor_data.humidity > 70.0f) {
-        assessment->humidity_risk = 0.3f;
-    }
-    // 湿度快速上升也是风险
-    if (processed->humidity_trend > 10.0f) {
-        assessment->humidity_risk += 0.3f;
-    }
-    if (assessment->humidity_risk > 1.0f) assessment->humidity_risk = 1.0f;
-    total_risk_score += assessment->humidity_risk * 0.2f;
-
-    // 4. 光照风险评估 (权重: 5%)
-    assessment->light_risk = 0.0f;
-    if (processed->light_change_rate > 1000.0f) {
-        assessment->light_risk = 0.5f;  // 光照剧烈变化可能表示遮挡
-    }
-    total_risk_score += assessment->light_risk * 0.05f;
-
-    // 5. GPS形变风险评估 (权重: 25%)
-    assessment->gps_deform_risk = 0.0f;
-    DeformationRisk deform_risk = GPS_Deformation_GetRiskLevel();
-    switch (deform_risk) {
-        case DEFORM_RISK_CRITICAL:
-            assessment->gps_deform_risk = 1.0f;
-            break;
-        case DEFORM_RISK_HIGH:
-            assessment->gps_deform_risk = 0.8f;
-            break;
-        case DEFORM_RISK_MEDIUM:
-            assessment->gps_deform_risk = 0.6f;
-            break;
-        case DEFORM_RISK_LOW:
-            assessment->gps_deform_risk = 0.3f;
-            break;
-        default:
-            assessment->gps_deform_risk = 0.0f;
-            break;
-    }
-    total_risk_score += assessment->gps_deform_risk * 0.25f;
+    // 1~7. 按规则表评估倾斜、振动、湿度、光照、GPS形变、多传感器异常和前期湿润风险因子，加权得到综合分数
+    float inputs[RISK_INPUT_COUNT];
+    inputs[RISK_INPUT_TILT] = processed->angle_magnitude;
+    inputs[RISK_INPUT_VIBRATION] = processed->vibration_intensity;
+    inputs[RISK_INPUT_HUMIDITY] = processed->humidity;
+    inputs[RISK_INPUT_HUMIDITY_TREND] = processed->humidity_trend;
+    inputs[RISK_INPUT_LIGHT_CHANGE] = processed->light_change_rate;
+    inputs[RISK_INPUT_GPS_DEFORM] = (float)GPS_Deformation_GetRiskLevel();
+    inputs[RISK_INPUT_ANOMALY] = processed->anomaly_score;
+    inputs[RISK_INPUT_MOISTURE] = processed->moisture_index;
+    inputs[RISK_INPUT_INFILTRATION] = processed->infiltration_index;
+    inputs[RISK_INPUT_TILT_CREEP] = processed->tilt_creep;
+
+    RiskRuleResult rule_result;
+    if (RiskRules_Evaluate(inputs, &rule_result) != 0) {
+        memset(&rule_result, 0, sizeof(rule_result));
+    }
+    assessment->tilt_risk = rule_result.factors[RISK_FACTOR_TILT];
+    assessment->vibration_risk = rule_result.factors[RISK_FACTOR_VIBRATION];
+    assessment->humidity_risk = rule_result.factors[RISK_FACTOR_HUMIDITY];
+    assessment->light_risk = rule_result.factors[RISK_FACTOR_LIGHT];
+    assessment->gps_deform_risk = rule_result.factors[RISK_FACTOR_GPS_DEFORM];
+    assessment->anomaly_risk = rule_result.factors[RISK_FACTOR_ANOMALY];
+    assessment->moisture_risk = rule_result.factors[RISK_FACTOR_MOISTURE];
 
     // 滑坡监测安全逻辑：一旦触发中等以上风险，只能手动解除
     static RiskLevel raw_level = RISK_LEVEL_SAFE;
     static uint32_t level_start_time = 0;
     // 使用全局的报警确认状态和风险状态变量（已在文件顶部声明）
 
-    // 根据分数确定原始风险等级
-    if (total_risk_score >= 0.8f) {
-        raw_level = RISK_LEVEL_CRITICAL;
-    } else if (total_risk_score >= 0.6f) {
-        raw_level = RISK_LEVEL_HIGH;
-    } else if (total_risk_score >= 0.4f) {
-        raw_level = RISK_LEVEL_MEDIUM;
-    } else if (total_risk_score >= 0.2f) {
-        raw_level = RISK_LEVEL_LOW;
-    } else {
-        raw_level = RISK_LEVEL_SAFE;
+    // 根据规则表分界确定原始风险等级
+    raw_level = (RiskLevel)rule_result.level;
+
+    // 6. 失稳时间预测：剩余时间下限足够短时提前升级风险，不必等到阈值被越过
+    FailureForecast forecast;
+    assessment->forecast_level = RISK_LEVEL_SAFE;
+    assessment->forecast_ttf_h = -1.0f;
+    assessment->forecast_confidence = 0.0f;
+    if (Forecast_GetMostUrgent(&forecast) == 0 && forecast.valid) {
+        assessment->forecast_level = (RiskLevel)Forecast_GetLevel(&forecast);
+        assessment->forecast_ttf_h = forecast.time_to_failure_h;
+        assessment->forecast_confidence = forecast.confidence;
+        if (assessment->forecast_level > raw_level) {
+            static uint32_t last_forecast_log = 0;
+            if (LOS_TickCountGet() - last_forecast_log >= 60000) {
+                printf("FORECAST: source %d predicts failure in %.1fh (>=%.1fh, R2 %.2f), risk raised to %d\n",
+                       forecast.source, forecast.time_to_failure_h, forecast.time_to_failure_lower_h,
+                       forecast.confidence, assessment->forecast_level);
+                last_forecast_log = LOS_TickCountGet();
+            }
+            raw_level = assessment->forecast_level;
+        }
     }
 
     uint32_t current_time = LOS_TickCountGet();
@@ -1343,12 +1900,17 @@ static void EvaluateRisk(const ProcessedData *processed, RiskAssessment *assessm
             max_triggered_level = RISK_LEVEL_SAFE;
             manual_reset_required = false;
             g_alarm_acknowledged = false;
+            TiltCreep_Rearm();
             printf("MANUAL RESET: Risk status cleared by operator. Resuming normal monitoring.\n");
         } else {
-            // 保持最后的风险等级，等待手动确认
+            // 保持最后的风险等级，等待手动确认（评估随每个样本进行，提示限频）
             confirmed_level = max_triggered_level;
-            printf("WAITING FOR RESET: Current reading safe, but manual confirmation required (triggered level: %d)\n",
-                   max_triggered_level);
+            static uint32_t last_waiting_log = 0;
+            if (LOS_TickCountGet() - last_waiting_log >= 5000) {
+                printf("WAITING FOR RESET: Current reading safe, but manual confirmation required (triggered level: %d)\n",
+                       max_triggered_level);
+                last_waiting_log = LOS_TickCountGet();
+            }
         }
     } else {
         // 正常监测状态，低风险可以自动变化
@@ -1388,69 +1950,8 @@ static void EvaluateRisk(const ProcessedData *processed, RiskAssessment *assessm
             break;
     }
 
-    // 计算置信度：基于传感器可靠性和数据一致性，而不是风险高低
-    float confidence = 0.0f;
-
-    // 1. 基础数据有效性 (30%)
-    if (sensor_data.data_valid) {
-        confidence += 0.3f;
-    }
-
-    // 2. 传感器数据合理性检查 (40%) - 检测真正的传感器异常
-    int sensor_ok_count = 0;
-
-    // 温度传感器检查：正常环境温度范围
-    if (sensor_data.sht_temperature >= -40.0f && sensor_data.sht_temperature <= 80.0f) {
-        sensor_ok_count++;
-    }
-
-    // 湿度传感器检查：物理可能范围
-    if (sensor_data.humidity >= 0.0f && sensor_data.humidity <= 100.0f) {
-        sensor_ok_count++;
-    }
-
-    // 光照传感器检查：非负值且不超过强阳光
-    if (sensor_data.light_intensity >= 0.0f && sensor_data.light_intensity <= 100000.0f) {
-        sensor_ok_count++;
-    }
-
-    // MPU6050传感器检查：加速度在合理范围内（不超过10g）
-    float accel_magnitude = sqrtf(sensor_data.accel_x * sensor_data.accel_x +
-                                 sensor_data.accel_y * sensor_data.accel_y +
-                                 sensor_data.accel_z * sensor_data.accel_z);
-    if (accel_magnitude >= 0.5f && accel_magnitude <= 10.0f) {
-        sensor_ok_count++;
-    }
-
-    // 陀螺仪检查：角速度在合理范围内（不超过2000°/s）
-    if (fabsf(sensor_data.gyro_x) <= 2000.0f &&
-        fabsf(sensor_data.gyro_y) <= 2000.0f &&
-        fabsf(sensor_data.gyro_z) <= 2000.0f) {
-        sensor_ok_count++;
-    }
-
-    // 传感器可靠性得分
-    float sensor_score = (sensor_ok_count / 5.0f) * 0.4f;
-    confidence += sensor_score;
-
-    // 3. 数据一致性验证 (20%) - 多传感器交叉验证
-    float consistency_score = 0.0f;
-
-    // 倾斜角度与加速度一致性检查
-    float angle_magnitude = sqrtf(sensor_data.angle_x * sensor_data.angle_x +
-                                 sensor_data.angle_y * sensor_data.angle_y);
-    if (angle_magnitude < 45.0f) {  // 合理的倾斜角度范围
-        consistency_score += 0.5f;
-    }
-
-    // 温湿度相关性检查（高温通常对应低湿度）
-    if ((sensor_data.sht_temperature > 30.0f && sensor_data.humidity < 80.0f) ||
-        (sensor_data.sht_temperature <= 30.0f)) {
-        consistency_score += 0.5f;
-    }
-
-    float consistency_points = consistency_score * 0.2f;
-    confidence += consistency_points;
+    // 计算置信度：基于所评估样本的传感器可靠性、数据一致性和系统稳定性，而不是风险高低
+    float confidence = processed->data_quality;
 
     // 4. 系统稳定性 (10%) - 运行时间和历史稳定性
     uint32_t uptime_seconds = current_time / 1000;
@@ -1470,21 +1971,38 @@ static void EvaluateRisk(const ProcessedData *processed, RiskAssessment *assessm
 }
 
 /**
- * @brief 按键事件处理函数
- * @param state 按键状态
+ * @brief 按键事件通知（按键定时器中调用）
  */
+static void NotifyButtonEvent(void)
+{
+    LOS_EventWrite(&g_risk_event, BUTTON_EVENT_QUEUED);
+}
 
-static void ButtonEventHandler(ButtonState state)
+/**
+ * @brief 按键事件处理函数（报警任务中调用）
+ * @param event 按键事件
+ */
+static void ButtonEventHandler(const ButtonEvent *event)
 {
     static bool muted = false;
-    static uint32_t press_start_time = 0;
-    static bool long_press_handled = false;
-    uint32_t current_time = LOS_TickCountGet();
 
-    switch (state) {
+    uint32_t latency_ms = (uint32_t)LOS_TickCountGet() - event->event_time;
+    printf("Button event: key=%d type=%d (action latency %u ms)\n", event->key, event->type, latency_ms);
+
+    switch (event->key) {
         case BUTTON_STATE_K3_PRESSED:
-            // K3(UP)按键：专门用于系统重启（长按检测在Button_GetState中处理）
-            printf("K3(UP) button pressed - Hold for 2s to reboot\n");
+            // K3(UP)按键：长按重启系统，双击确认报警
+            if (event->type == BUTTON_EVENT_LONG) {
+                printf("=== K3 LONG PRESS DETECTED ===\n");
+                printf("K3 held for >2s: Rebooting system immediately...\n");
+                printf("===============================\n");
+                RebootDevice(0);
+            } else if (event->type == BUTTON_EVENT_DOUBLE) {
+                printf("K3(UP) double press - Alarm acknowledged locally\n");
+                g_alarm_acknowledged = true;
+            } else {
+                printf("K3(UP) button pressed - Hold for 2s to reboot, double press to acknowledge alarm\n");
+            }
             break;
 
         case BUTTON_STATE_K4_PRESSED:
@@ -1509,27 +2027,6 @@ static void ButtonEventHandler(ButtonState state)
             printf("Alarm muted: %s\n", IsAlarmMuted() ? "YES" : "NO");
             break;
 
-        case BUTTON_STATE_RELEASED:
-            // 按键释放处理（K3长按重启已在Button_GetState中处理）
-            printf("Button released\n");
-            break;
-
-        case BUTTON_STATE_SHORT_PRESS:
-            // 兼容原有短按逻辑 - 切换LCD模式
-            SwitchLcdMode();
-            printf("Button short press: LCD mode switched\n");
-            break;
-
-        case BUTTON_STATE_LONG_PRESS:
-            // 兼容原有长按逻辑 - 静音功能
-            if (!long_press_handled) {
-                muted = !muted;
-                SetAlarmMute(muted);
-                printf("Button long press: Alarm %s\n", muted ? "muted" : "unmuted");
-                long_press_handled = true;
-            }
-            break;
-
         default:
             break;
     }
@@ -1569,6 +2066,7 @@ void LandslideMonitorExample(void)
     printf("System is now monitoring for landslide risks...\n");
     printf("Button Controls:\n");
     printf("  K3(UP): Long press (>2s) = SYSTEM REBOOT - Restart device\n");
+    printf("  K3(UP): Double press = Acknowledge alarm\n");
     printf("  K4(DOWN): Press = Switch LCD display mode (3 modes)\n");
     printf("  K5(LEFT): Press = Mute/unmute alarm\n");
     printf("  K6(RIGHT): Press = Show system status\n");
@@ -1591,10 +2089,22 @@ void LandslideMonitorExample(void)
             printf("Risk alerts: %u\n", stats.risk_alerts);
             printf("LCD mode: %d\n", stats.lcd_mode);
             printf("System state: %d\n", stats.current_state);
+            ArchiveStats archive_stats;
+            if (DataArchive_GetStats(&archive_stats) == 0) {
+                printf("Archive: raw %u/%u, minute %u/%u, hour %u/%u (dropped %u)\n",
+                       archive_stats.record_count[ARCHIVE_TIER_RAW], archive_stats.capacity[ARCHIVE_TIER_RAW],
+                       archive_stats.record_count[ARCHIVE_TIER_MINUTE], archive_stats.capacity[ARCHIVE_TIER_MINUTE],
+                       archive_stats.record_count[ARCHIVE_TIER_HOUR], archive_stats.capacity[ARCHIVE_TIER_HOUR],
+                       archive_stats.dropped);
+            }
             printf("====================\n\n");
             last_status_time = current_time;
         }
 
+        // 低优先级主循环负责归档数据落盘，并将滞留过久的待上传数据写入Flash
+        DataArchive_Flush();
+        DataCache_Spill(false);
+
         LOS_Msleep(500);   // 500ms检查间隔
     }
 
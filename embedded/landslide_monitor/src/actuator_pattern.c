@@ -0,0 +1,217 @@
+#include "actuator_pattern.h"
+#include "los_mux.h"
+#include "los_swtmr.h"
+#include <stdio.h>
+#include <string.h>
+
+// 单个通道的播放状态
+typedef struct {
+    ActuatorStep steps[ACTUATOR_MAX_STEPS];
+    uint32_t remaining_ms;          // 当前步骤剩余时间
+    uint8_t step_count;
+    uint8_t step;                   // 当前步骤
+    uint8_t repeat;                 // 播放次数（0为循环）
+    uint8_t played;                 // 已完成次数
+    uint8_t priority;
+    bool active;
+} ChannelState;
+
+static bool g_actuator_initialized = false;
+static uint32_t g_actuator_mutex = 0;
+static uint32_t g_actuator_timer = 0;
+static bool g_timer_running = false;
+static ChannelState g_channels[ACTUATOR_COUNT];
+static ActuatorOutputFunc g_outputs[ACTUATOR_COUNT];
+
+/**
+ * @brief 输出通道电平（持锁调用，保证输出顺序与状态一致）
+ */
+static void ApplyLevel(ActuatorChannel channel, uint16_t level)
+{
+    if (g_outputs[channel] != NULL) {
+        g_outputs[channel](level);
+    }
+}
+
+/**
+ * @brief 定时器节拍：推进各通道，全部空闲时停止定时器
+ */
+static void ActuatorTick(UINT32 arg)
+{
+    (void)arg;
+    bool any_active = false;
+
+    LOS_MuxPend(g_actuator_mutex, LOS_WAIT_FOREVER);
+    for (int i = 0; i < ACTUATOR_COUNT; i++) {
+        ChannelState *ch = &g_channels[i];
+        if (!ch->active) {
+            continue;
+        }
+
+        if (ch->remaining_ms > ACTUATOR_TICK_MS) {
+            ch->remaining_ms -= ACTUATOR_TICK_MS;
+            any_active = true;
+            continue;
+        }
+
+        // 当前步骤结束，进入下一步或下一次播放
+        if (++ch->step >= ch->step_count) {
+            ch->step = 0;
+            ch->played++;
+            if (ch->repeat != ACTUATOR_REPEAT_FOREVER && ch->played >= ch->repeat) {
+                ch->active = false;
+                ApplyLevel((ActuatorChannel)i, 0);
+                continue;
+            }
+        }
+        ch->remaining_ms = ch->steps[ch->step].duration_ms;
+        ApplyLevel((ActuatorChannel)i, ch->steps[ch->step].level);
+        any_active = true;
+    }
+
+    if (!any_active && g_timer_running) {
+        LOS_SwtmrStop(g_actuator_timer);
+        g_timer_running = false;
+    }
+    LOS_MuxPost(g_actuator_mutex);
+}
+
+/**
+ * @brief 初始化模式播放
+ */
+int Actuator_Init(void)
+{
+    if (g_actuator_initialized) {
+        return 0;
+    }
+
+    if (LOS_MuxCreate(&g_actuator_mutex) != LOS_OK) {
+        printf("Failed to create actuator mutex\n");
+        return -1;
+    }
+
+    if (LOS_SwtmrCreate(ACTUATOR_TICK_MS, LOS_SWTMR_MODE_PERIOD, ActuatorTick, &g_actuator_timer, 0) != LOS_OK) {
+        printf("Failed to create actuator timer\n");
+        LOS_MuxDelete(g_actuator_mutex);
+        g_actuator_mutex = 0;
+        return -1;
+    }
+
+    memset(g_channels, 0, sizeof(g_channels));
+    g_timer_running = false;
+    g_actuator_initialized = true;
+    printf("Actuator sequencer initialized (tick %dms)\n", ACTUATOR_TICK_MS);
+    return 0;
+}
+
+/**
+ * @brief 反初始化模式播放
+ */
+void Actuator_Deinit(void)
+{
+    if (!g_actuator_initialized) {
+        return;
+    }
+
+    LOS_MuxPend(g_actuator_mutex, LOS_WAIT_FOREVER);
+    for (int i = 0; i < ACTUATOR_COUNT; i++) {
+        if (g_channels[i].active) {
+            g_channels[i].active = false;
+            ApplyLevel((ActuatorChannel)i, 0);
+        }
+    }
+    if (g_timer_running) {
+        LOS_SwtmrStop(g_actuator_timer);
+        g_timer_running = false;
+    }
+    g_actuator_initialized = false;
+    LOS_MuxPost(g_actuator_mutex);
+
+    LOS_SwtmrDelete(g_actuator_timer);
+    LOS_MuxDelete(g_actuator_mutex);
+    g_actuator_mutex = 0;
+}
+
+/**
+ * @brief 设置通道输出函数
+ */
+void Actuator_SetOutput(ActuatorChannel channel, ActuatorOutputFunc output)
+{
+    if (channel < ACTUATOR_COUNT) {
+        g_outputs[channel] = output;
+    }
+}
+
+/**
+ * @brief 播放模式
+ */
+int Actuator_Play(ActuatorChannel channel, const ActuatorStep *steps, uint8_t step_count, uint8_t repeat,
+                  uint8_t priority)
+{
+    if (!g_actuator_initialized || channel >= ACTUATOR_COUNT || steps == NULL ||
+        step_count == 0 || step_count > ACTUATOR_MAX_STEPS) {
+        return -1;
+    }
+
+    LOS_MuxPend(g_actuator_mutex, LOS_WAIT_FOREVER);
+    ChannelState *ch = &g_channels[channel];
+    if (ch->active && ch->priority > priority) {
+        LOS_MuxPost(g_actuator_mutex);
+        return -2;
+    }
+
+    memcpy(ch->steps, steps, step_count * sizeof(ActuatorStep));
+    ch->step_count = step_count;
+    ch->step = 0;
+    ch->repeat = repeat;
+    ch->played = 0;
+    ch->priority = priority;
+    ch->remaining_ms = steps[0].duration_ms;
+    ch->active = true;
+    ApplyLevel(channel, steps[0].level);
+
+    if (!g_timer_running) {
+        if (LOS_SwtmrStart(g_actuator_timer) == LOS_OK) {
+            g_timer_running = true;
+        } else {
+            // 定时器无法启动时不保持输出，避免执行器常开
+            ch->active = false;
+            ApplyLevel(channel, 0);
+            LOS_MuxPost(g_actuator_mutex);
+            printf("Failed to start actuator timer\n");
+            return -1;
+        }
+    }
+    LOS_MuxPost(g_actuator_mutex);
+    return 0;
+}
+
+/**
+ * @brief 停止通道
+ */
+void Actuator_Stop(ActuatorChannel channel)
+{
+    if (!g_actuator_initialized || channel >= ACTUATOR_COUNT) {
+        return;
+    }
+
+    LOS_MuxPend(g_actuator_mutex, LOS_WAIT_FOREVER);
+    g_channels[channel].active = false;
+    ApplyLevel(channel, 0);
+    LOS_MuxPost(g_actuator_mutex);
+}
+
+/**
+ * @brief 通道是否正在播放
+ */
+bool Actuator_IsActive(ActuatorChannel channel)
+{
+    if (!g_actuator_initialized || channel >= ACTUATOR_COUNT) {
+        return false;
+    }
+
+    LOS_MuxPend(g_actuator_mutex, LOS_WAIT_FOREVER);
+    bool active = g_channels[channel].active;
+    LOS_MuxPost(g_actuator_mutex);
+    return active;
+}
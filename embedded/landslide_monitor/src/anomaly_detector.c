@@ -0,0 +1,301 @@
+#include "anomaly_detector.h"
+#include "los_mux.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+// 各特征标准差下限（传感器分辨率量级），避免静止不变的特征使协方差奇异
+static const float g_std_floor[ANOMALY_FEATURES] = {
+    0.02f,      // 倾角 (°)
+    0.05f,      // 振动强度 (°/s)
+    0.2f,       // 湿度 (%)
+    0.02f,      // 湿度趋势
+    0.1f,       // 温度 (°C)
+};
+
+// 检测器状态：块累计量、均值和协方差（双精度，遗忘系数约1e-4量级时单精度更新会丢失有效位）
+typedef struct {
+    double block_sum[ANOMALY_FEATURES];     // 当前块特征累计
+    uint32_t block_samples;                 // 当前块样本数
+    uint32_t block_ms;                      // 当前块已累计时长
+    double mean[ANOMALY_FEATURES];
+    double cov[ANOMALY_FEATURES][ANOMALY_FEATURES];
+    uint32_t start_ms;              // 首个样本时间
+    uint32_t last_ms;               // 上一样本时间
+    uint32_t samples;               // 样本数
+    uint32_t blocks;                // 参与学习的块数
+    bool ready;
+    AnomalyResult result;           // 最近一个完成块的结果
+} AnomalyState;
+
+static bool g_anomaly_initialized = false;
+static uint32_t g_anomaly_mutex = 0;
+static AnomalyState g_state;
+static AnomalyStats g_anomaly_stats;
+
+/**
+ * @brief 计算马氏距离平方（协方差加下限后Cholesky分解，前代求解）
+ * @return 马氏距离平方, <0: 分解失败
+ */
+static double MahalanobisDistance2(const double diff[ANOMALY_FEATURES])
+{
+    double l[ANOMALY_FEATURES][ANOMALY_FEATURES];
+    double y[ANOMALY_FEATURES];
+    double d2 = 0.0;
+
+    for (int i = 0; i < ANOMALY_FEATURES; i++) {
+        for (int j = 0; j <= i; j++) {
+            double sum = g_state.cov[j][i];
+            if (i == j) {
+                sum += (double)g_std_floor[i] * g_std_floor[i];
+            }
+            for (int k = 0; k < j; k++) {
+                sum -= l[i][k] * l[j][k];
+            }
+            if (i == j) {
+                if (!(sum > 0.0)) {
+                    return -1.0;
+                }
+                l[i][i] = sqrt(sum);
+            } else {
+                l[i][j] = sum / l[j][j];
+            }
+        }
+    }
+
+    for (int i = 0; i < ANOMALY_FEATURES; i++) {
+        double sum = diff[i];
+        for (int k = 0; k < i; k++) {
+            sum -= l[i][k] * y[k];
+        }
+        y[i] = sum / l[i][i];
+        d2 += y[i] * y[i];
+    }
+    return d2;
+}
+
+/**
+ * @brief 忽略相关性的距离平方（分解失败时的后备）
+ */
+static double DiagonalDistance2(const double diff[ANOMALY_FEATURES])
+{
+    double d2 = 0.0;
+    for (int i = 0; i < ANOMALY_FEATURES; i++) {
+        d2 += diff[i] * diff[i] / (g_state.cov[i][i] + (double)g_std_floor[i] * g_std_floor[i]);
+    }
+    return d2;
+}
+
+/**
+ * @brief 马氏距离平方（自由度ANOMALY_FEATURES的卡方分布）换算为等效正态分位数（Wilson-Hilferty近似）
+ */
+static float ChiSquareToScore(float d2)
+{
+    const float k = (float)ANOMALY_FEATURES;
+    const float v = 2.0f / (9.0f * k);
+    return (cbrtf(d2 / k) - (1.0f - v)) / sqrtf(v);
+}
+
+/**
+ * @brief 等效正态分位数换算为马氏距离平方（ChiSquareToScore的逆）
+ */
+static double ScoreToChiSquare(float score)
+{
+    const double k = (double)ANOMALY_FEATURES;
+    const double v = 2.0 / (9.0 * k);
+    double root = score * sqrt(v) + (1.0 - v);
+    return k * root * root * root;
+}
+
+/**
+ * @brief 评估一个块平均特征向量，再按块时长更新均值/协方差（持锁调用）
+ */
+static void ProcessBlock(const double block[ANOMALY_FEATURES], uint32_t block_ms)
+{
+    AnomalyResult *result = &g_state.result;
+    double diff[ANOMALY_FEATURES];
+
+    for (int i = 0; i < ANOMALY_FEATURES; i++) {
+        diff[i] = block[i] - g_state.mean[i];
+    }
+    if (g_state.blocks == 0) {
+        memcpy(g_state.mean, block, sizeof(g_state.mean));
+        memset(diff, 0, sizeof(diff));
+    }
+
+    // 用学习前的均值/协方差评估当前块
+    double scale = 1.0;
+    memset(result, 0, sizeof(AnomalyResult));
+    if (g_state.ready) {
+        double d2 = MahalanobisDistance2(diff);
+        if (d2 < 0.0) {
+            // 分解失败仍输出分数，计数并定期报告
+            g_anomaly_stats.factor_failures++;
+            if (g_anomaly_stats.factor_failures % 60 == 1) {
+                printf("Anomaly covariance factorization failed (%u times), using diagonal distance\n",
+                       g_anomaly_stats.factor_failures);
+            }
+            d2 = DiagonalDistance2(diff);
+            result->diagonal = true;
+        }
+
+        result->ready = true;
+        result->distance2 = (float)d2;
+        result->score = ChiSquareToScore((float)d2);
+
+        double max_z = 0.0;
+        for (int i = 0; i < ANOMALY_FEATURES; i++) {
+            double z = fabs(diff[i]) / sqrt(g_state.cov[i][i] + (double)g_std_floor[i] * g_std_floor[i]);
+            if (z > max_z) {
+                max_z = z;
+                result->dominant = (uint8_t)i;
+            }
+        }
+
+        // 异常块的偏差截断到门限距离后学习：单个异常块影响有界，持续的新状态仍会逐渐被接受
+        if (result->score > ANOMALY_GATE_SCORE) {
+            scale = sqrt(ScoreToChiSquare(ANOMALY_GATE_SCORE) / d2);
+            g_anomaly_stats.anomalies++;
+        }
+        if (result->score > g_anomaly_stats.max_score) {
+            g_anomaly_stats.max_score = result->score;
+        }
+    }
+
+    // 指数遗忘更新：预热期按累计平均快速收敛，之后按块时长换算遗忘系数
+    double alpha = (double)block_ms / ANOMALY_TAU_MS;
+    g_state.blocks++;
+    if (alpha < 1.0 / g_state.blocks) {
+        alpha = 1.0 / g_state.blocks;
+    }
+
+    for (int i = 0; i < ANOMALY_FEATURES; i++) {
+        diff[i] *= scale;
+    }
+    for (int i = 0; i < ANOMALY_FEATURES; i++) {
+        g_state.mean[i] += alpha * diff[i];
+        for (int j = i; j < ANOMALY_FEATURES; j++) {
+            g_state.cov[i][j] = (1.0 - alpha) * (g_state.cov[i][j] + alpha * diff[i] * diff[j]);
+            g_state.cov[j][i] = g_state.cov[i][j];
+        }
+    }
+
+    g_anomaly_stats.blocks = g_state.blocks;
+    g_anomaly_stats.last_score = result->score;
+}
+
+/**
+ * @brief 初始化异常检测
+ */
+int Anomaly_Init(void)
+{
+    if (g_anomaly_initialized) {
+        return 0;
+    }
+
+    if (LOS_MuxCreate(&g_anomaly_mutex) != LOS_OK) {
+        printf("Failed to create anomaly detector mutex\n");
+        return -1;
+    }
+
+    memset(&g_state, 0, sizeof(g_state));
+    memset(&g_anomaly_stats, 0, sizeof(g_anomaly_stats));
+    g_anomaly_initialized = true;
+    printf("Anomaly detector initialized (%d features, block %ds, warmup %ds)\n", ANOMALY_FEATURES,
+           ANOMALY_BLOCK_MS / 1000, ANOMALY_WARMUP_MS / 1000);
+    return 0;
+}
+
+/**
+ * @brief 反初始化异常检测
+ */
+void Anomaly_Deinit(void)
+{
+    if (!g_anomaly_initialized) {
+        return;
+    }
+
+    g_anomaly_initialized = false;
+    LOS_MuxDelete(g_anomaly_mutex);
+    g_anomaly_mutex = 0;
+}
+
+/**
+ * @brief 输入一个特征向量
+ */
+int Anomaly_Update(const float features[ANOMALY_FEATURES], uint32_t timestamp, AnomalyResult *result)
+{
+    if (!g_anomaly_initialized || features == NULL || result == NULL) {
+        return -1;
+    }
+
+    memset(result, 0, sizeof(AnomalyResult));
+    for (int i = 0; i < ANOMALY_FEATURES; i++) {
+        if (!isfinite(features[i])) {
+            return 0;   // 传感器无效值不参与检测和学习
+        }
+    }
+
+    LOS_MuxPend(g_anomaly_mutex, LOS_WAIT_FOREVER);
+
+    if (g_state.samples == 0) {
+        g_state.start_ms = timestamp;
+    } else {
+        uint32_t dt_ms = timestamp - g_state.last_ms;
+        if (dt_ms > ANOMALY_MAX_GAP_MS) {
+            dt_ms = ANOMALY_MAX_GAP_MS;
+        }
+        g_state.block_ms += dt_ms;
+    }
+    g_state.last_ms = timestamp;
+    g_state.samples++;
+
+    for (int i = 0; i < ANOMALY_FEATURES; i++) {
+        g_state.block_sum[i] += features[i];
+    }
+    g_state.block_samples++;
+
+    // 块结束：块平均特征评估并学习
+    if (g_state.block_ms >= ANOMALY_BLOCK_MS) {
+        if (!g_state.ready && timestamp - g_state.start_ms >= ANOMALY_WARMUP_MS) {
+            g_state.ready = true;
+            printf("Anomaly detector ready after %u blocks\n", g_state.blocks);
+        }
+
+        double block[ANOMALY_FEATURES];
+        for (int i = 0; i < ANOMALY_FEATURES; i++) {
+            block[i] = g_state.block_sum[i] / g_state.block_samples;
+        }
+        ProcessBlock(block, g_state.block_ms);
+
+        memset(g_state.block_sum, 0, sizeof(g_state.block_sum));
+        g_state.block_samples = 0;
+        g_state.block_ms = 0;
+    }
+
+    *result = g_state.result;
+    g_anomaly_stats.samples = g_state.samples;
+    g_anomaly_stats.ready = g_state.ready;
+
+    LOS_MuxPost(g_anomaly_mutex);
+    return 0;
+}
+
+/**
+ * @brief 获取检测统计信息
+ */
+int Anomaly_GetStats(AnomalyStats *stats)
+{
+    if (!g_anomaly_initialized || stats == NULL) {
+        return -1;
+    }
+
+    LOS_MuxPend(g_anomaly_mutex, LOS_WAIT_FOREVER);
+    *stats = g_anomaly_stats;
+    for (int i = 0; i < ANOMALY_FEATURES; i++) {
+        stats->mean[i] = (float)g_state.mean[i];
+        stats->std[i] = (float)sqrt(g_state.cov[i][i]);
+    }
+    LOS_MuxPost(g_anomaly_mutex);
+    return 0;
+}
@@ -0,0 +1,209 @@
+#include "button_input.h"
+#include "los_queue.h"
+#include "los_swtmr.h"
+#include "los_task.h"
+#include <stdio.h>
+
+static bool g_button_input_initialized = false;
+static uint32_t g_button_timer = 0;
+static uint32_t g_button_queue = 0;
+static uint32_t g_double_mask = 0;
+static ButtonNotifyFunc g_notify = NULL;
+static uint32_t g_dropped = 0;
+
+// 消抖状态（仅在定时器任务中访问）
+static ButtonState g_raw_key = BUTTON_STATE_RELEASED;       // 最近读数
+static uint8_t g_raw_count = 0;                             // 最近读数连续次数
+static ButtonState g_stable_key = BUTTON_STATE_RELEASED;    // 确认后的按键
+static uint32_t g_press_time = 0;
+static bool g_press_consumed = false;                       // 本次按下已产生长按或双击事件
+
+// 等待双击的单击
+static ButtonState g_click_key = BUTTON_STATE_RELEASED;
+static uint32_t g_click_press_time = 0;
+static uint32_t g_click_release_time = 0;
+
+/**
+ * @brief 事件入队（不等待，队列满时丢弃）
+ */
+static void PostEvent(ButtonState key, ButtonEventType type, uint32_t press_time, uint32_t now)
+{
+    ButtonEvent event = {key, type, press_time, now};
+
+    if (LOS_QueueWriteCopy(g_button_queue, &event, sizeof(event), 0) != LOS_OK) {
+        g_dropped++;
+        return;
+    }
+    if (g_notify != NULL) {
+        g_notify();
+    }
+}
+
+/**
+ * @brief 确认按下
+ */
+static void OnPress(ButtonState key, uint32_t now)
+{
+    g_press_time = now;
+    g_press_consumed = false;
+
+    if (g_click_key == key) {
+        // 双击间隔内再次按下同一按键，按下即产生双击事件
+        PostEvent(key, BUTTON_EVENT_DOUBLE, g_click_press_time, now);
+        g_click_key = BUTTON_STATE_RELEASED;
+        g_press_consumed = true;
+    } else if (g_click_key != BUTTON_STATE_RELEASED) {
+        // 按下其他按键，之前的单击不再等待双击
+        PostEvent(g_click_key, BUTTON_EVENT_SHORT, g_click_press_time, now);
+        g_click_key = BUTTON_STATE_RELEASED;
+    }
+}
+
+/**
+ * @brief 确认释放
+ */
+static void OnRelease(ButtonState key, uint32_t now)
+{
+    if (g_press_consumed) {
+        return;
+    }
+
+    if ((g_double_mask & BUTTON_KEY_MASK(key)) == 0) {
+        PostEvent(key, BUTTON_EVENT_SHORT, g_press_time, now);
+        return;
+    }
+
+    g_click_key = key;
+    g_click_press_time = g_press_time;
+    g_click_release_time = now;
+}
+
+/**
+ * @brief 定时器采样：消抖并检测短按、长按、双击
+ */
+static void ButtonSample(UINT32 arg)
+{
+    (void)arg;
+    uint32_t now = LOS_TickCountGet();
+    ButtonState key = Button_ReadKey();
+
+    // 双击间隔结束，按单击处理
+    if (g_click_key != BUTTON_STATE_RELEASED && now - g_click_release_time >= BUTTON_DOUBLE_GAP_MS) {
+        PostEvent(g_click_key, BUTTON_EVENT_SHORT, g_click_press_time, now);
+        g_click_key = BUTTON_STATE_RELEASED;
+    }
+
+    if (key == g_raw_key) {
+        if (g_raw_count < BUTTON_DEBOUNCE_SAMPLES) {
+            g_raw_count++;
+        }
+    } else {
+        g_raw_key = key;
+        g_raw_count = 1;
+    }
+
+    if (g_raw_count >= BUTTON_DEBOUNCE_SAMPLES && g_raw_key != g_stable_key) {
+        ButtonState previous = g_stable_key;
+        g_stable_key = g_raw_key;
+        if (previous != BUTTON_STATE_RELEASED) {
+            OnRelease(previous, now);
+        }
+        if (g_stable_key != BUTTON_STATE_RELEASED) {
+            OnPress(g_stable_key, now);
+        }
+    }
+
+    if (g_stable_key != BUTTON_STATE_RELEASED && !g_press_consumed && now - g_press_time >= BUTTON_LONG_PRESS_MS) {
+        PostEvent(g_stable_key, BUTTON_EVENT_LONG, g_press_time, now);
+        g_press_consumed = true;
+    }
+}
+
+/**
+ * @brief 初始化按键事件检测
+ */
+int ButtonInput_Init(uint32_t double_press_mask, ButtonNotifyFunc notify)
+{
+    if (g_button_input_initialized) {
+        return 0;
+    }
+
+    if (!Button_IsInitialized()) {
+        printf("Button input requires initialized button ADC\n");
+        return -1;
+    }
+
+    if (LOS_QueueCreate("ButtonQueue", BUTTON_EVENT_QUEUE_LENGTH, &g_button_queue, 0, sizeof(ButtonEvent)) != LOS_OK) {
+        printf("Failed to create button event queue\n");
+        return -1;
+    }
+
+    if (LOS_SwtmrCreate(BUTTON_SAMPLE_MS, LOS_SWTMR_MODE_PERIOD, ButtonSample, &g_button_timer, 0) != LOS_OK) {
+        printf("Failed to create button timer\n");
+        LOS_QueueDelete(g_button_queue);
+        g_button_queue = 0;
+        return -1;
+    }
+
+    g_double_mask = double_press_mask;
+    g_notify = notify;
+    g_dropped = 0;
+    g_raw_key = BUTTON_STATE_RELEASED;
+    g_raw_count = 0;
+    g_stable_key = BUTTON_STATE_RELEASED;
+    g_press_consumed = false;
+    g_click_key = BUTTON_STATE_RELEASED;
+
+    if (LOS_SwtmrStart(g_button_timer) != LOS_OK) {
+        printf("Failed to start button timer\n");
+        LOS_SwtmrDelete(g_button_timer);
+        LOS_QueueDelete(g_button_queue);
+        g_button_queue = 0;
+        return -1;
+    }
+
+    g_button_input_initialized = true;
+    printf("Button input initialized (sample %dms, debounce %d, long %dms, double %dms)\n",
+           BUTTON_SAMPLE_MS, BUTTON_DEBOUNCE_SAMPLES, BUTTON_LONG_PRESS_MS, BUTTON_DOUBLE_GAP_MS);
+    return 0;
+}
+
+/**
+ * @brief 停止采样并删除事件队列
+ */
+void ButtonInput_Deinit(void)
+{
+    if (!g_button_input_initialized) {
+        return;
+    }
+
+    g_button_input_initialized = false;
+    LOS_SwtmrStop(g_button_timer);
+    LOS_SwtmrDelete(g_button_timer);
+    LOS_QueueDelete(g_button_queue);
+    g_button_queue = 0;
+}
+
+/**
+ * @brief 读取按键事件
+ */
+int ButtonInput_ReadEvent(ButtonEvent *event, uint32_t timeout_ms)
+{
+    if (!g_button_input_initialized || event == NULL) {
+        return -1;
+    }
+
+    UINT32 size = sizeof(ButtonEvent);
+    if (LOS_QueueReadCopy(g_button_queue, event, &size, timeout_ms) != LOS_OK) {
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief 获取队列满丢弃的事件数
+ */
+uint32_t ButtonInput_GetDropped(void)
+{
+    return g_dropped;
+}
@@ -0,0 +1,605 @@
+#include "data_archive.h"
+#include "los_task.h"
+#include "los_mux.h"
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+
+// 单个时间窗口的汇总累加器
+typedef struct {
+    uint32_t start_time;                        // 窗口起始时间 (秒)
+    uint32_t count;                             // 样本数
+    float min[ARCHIVE_CHANNEL_COUNT];
+    float max[ARCHIVE_CHANNEL_COUNT];
+    float sum[ARCHIVE_CHANNEL_COUNT];
+    float last[ARCHIVE_CHANNEL_COUNT];
+} RollupAccumulator;
+
+// 归档管理结构
+typedef struct {
+    bool initialized;
+    UINT32 mutex;                               // 保护累加器和待写入队列
+    UINT32 flash_mutex;                         // 保护Flash环形区
+    StorageRing ring[ARCHIVE_TIER_COUNT];
+
+    // 归档时间轴：启动时从Flash恢复，之后按系统节拍累加
+    uint32_t time_base;
+    uint32_t last_tick;
+    uint32_t elapsed_ms;
+    uint32_t last_raw_time;
+    bool raw_started;
+
+    RollupAccumulator minute_acc;
+    RollupAccumulator hour_acc;
+
+    // 待写入队列（采集任务只写内存，Flash操作在Flush中完成）
+    ArchiveRawRecord raw_pending[ARCHIVE_RAW_PENDING];
+    uint8_t raw_head;
+    uint8_t raw_count;
+    ArchiveRollupRecord rollup_pending[ARCHIVE_ROLLUP_PENDING];
+    ArchiveTier rollup_tier[ARCHIVE_ROLLUP_PENDING];
+    uint8_t rollup_head;
+    uint8_t rollup_count;
+
+    ArchiveStats stats;
+} ArchiveManager;
+
+static ArchiveManager g_archive = {0};
+
+// 各通道定点缩放系数（int16存储）
+static const float g_channel_scale[ARCHIVE_CHANNEL_COUNT] = {
+    100.0f,     // X轴倾角 0.01°
+    100.0f,     // Y轴倾角 0.01°
+    1000.0f,    // 加速度模值 0.001g
+    10.0f,      // 角速度模值 0.1°/s
+    100.0f,     // 温度 0.01°C
+    100.0f,     // 湿度 0.01%
+    0.5f,       // 光照 2lux（BH1750量程约65535lux）
+};
+
+/**
+ * @brief 工程值转换为定点值（饱和处理）
+ */
+static int16_t EncodeValue(int channel, float value)
+{
+    float scaled = value * g_channel_scale[channel];
+    if (scaled >= 32767.0f) {
+        return 32767;
+    }
+    if (scaled <= -32768.0f) {
+        return -32768;
+    }
+    return (int16_t)lroundf(scaled);
+}
+
+/**
+ * @brief 定点值还原为工程值
+ */
+static float DecodeValue(int channel, int16_t value)
+{
+    return (float)value / g_channel_scale[channel];
+}
+
+/**
+ * @brief 从传感器数据提取各归档通道的值
+ */
+static void ExtractChannels(const SensorData *data, float *values)
+{
+    values[ARCHIVE_CH_ANGLE_X] = Sample_GetAngle(data, SAMPLE_AXIS_X);
+    values[ARCHIVE_CH_ANGLE_Y] = Sample_GetAngle(data, SAMPLE_AXIS_Y);
+    values[ARCHIVE_CH_ACCEL_MAG] = Sample_GetAccelMagnitude(data);
+    values[ARCHIVE_CH_GYRO_MAG] = Sample_GetGyroMagnitude(data);
+    values[ARCHIVE_CH_TEMPERATURE] = Sample_GetTemperature(data);
+    values[ARCHIVE_CH_HUMIDITY] = Sample_GetHumidity(data);
+    values[ARCHIVE_CH_LIGHT] = Sample_GetLight(data);
+}
+
+/**
+ * @brief 更新归档时间（处理节拍计数回绕）
+ * @note 调用者需持有g_archive.mutex
+ */
+static uint32_t UpdateClock(void)
+{
+    uint32_t tick = LOS_TickCountGet();
+    g_archive.elapsed_ms += tick - g_archive.last_tick;
+    g_archive.last_tick = tick;
+
+    // 整秒部分并入时间基准，避免毫秒累加溢出
+    g_archive.time_base += g_archive.elapsed_ms / 1000;
+    g_archive.elapsed_ms %= 1000;
+    return g_archive.time_base;
+}
+
+/**
+ * @brief 向累加器加入一组通道值
+ */
+static void AccumulateValues(RollupAccumulator *acc, const float *values, uint32_t window_start)
+{
+    if (acc->count == 0) {
+        acc->start_time = window_start;
+        for (int ch = 0; ch < ARCHIVE_CHANNEL_COUNT; ch++) {
+            acc->min[ch] = values[ch];
+            acc->max[ch] = values[ch];
+            acc->sum[ch] = 0.0f;
+        }
+    }
+
+    for (int ch = 0; ch < ARCHIVE_CHANNEL_COUNT; ch++) {
+        if (values[ch] < acc->min[ch]) {
+            acc->min[ch] = values[ch];
+        }
+        if (values[ch] > acc->max[ch]) {
+            acc->max[ch] = values[ch];
+        }
+        acc->sum[ch] += values[ch];
+        acc->last[ch] = values[ch];
+    }
+    acc->count++;
+}
+
+/**
+ * @brief 将一个窗口的汇总合并到更粗粒度的累加器
+ */
+static void MergeAccumulator(RollupAccumulator *dst, const RollupAccumulator *src, uint32_t window_start)
+{
+    if (src->count == 0) {
+        return;
+    }
+
+    if (dst->count == 0) {
+        dst->start_time = window_start;
+        memcpy(dst->min, src->min, sizeof(dst->min));
+        memcpy(dst->max, src->max, sizeof(dst->max));
+        memset(dst->sum, 0, sizeof(dst->sum));
+    }
+
+    for (int ch = 0; ch < ARCHIVE_CHANNEL_COUNT; ch++) {
+        if (src->min[ch] < dst->min[ch]) {
+            dst->min[ch] = src->min[ch];
+        }
+        if (src->max[ch] > dst->max[ch]) {
+            dst->max[ch] = src->max[ch];
+        }
+        dst->sum[ch] += src->sum[ch];
+        dst->last[ch] = src->last[ch];
+    }
+    dst->count += src->count;
+}
+
+/**
+ * @brief 累加器转换为Flash汇总记录
+ */
+static void AccumulatorToRecord(const RollupAccumulator *acc, ArchiveRollupRecord *record)
+{
+    memset(record, 0, sizeof(ArchiveRollupRecord));
+    record->start_time = acc->start_time;
+    record->sample_count = (acc->count > 0xFFFF) ? 0xFFFF : (uint16_t)acc->count;
+    for (int ch = 0; ch < ARCHIVE_CHANNEL_COUNT; ch++) {
+        record->min[ch] = EncodeValue(ch, acc->min[ch]);
+        record->max[ch] = EncodeValue(ch, acc->max[ch]);
+        record->mean[ch] = EncodeValue(ch, acc->sum[ch] / (float)acc->count);
+        record->last[ch] = EncodeValue(ch, acc->last[ch]);
+    }
+}
+
+/**
+ * @brief Flash汇总记录还原为累加器（用于重启后恢复小时窗口）
+ */
+static void RecordToAccumulator(const ArchiveRollupRecord *record, RollupAccumulator *acc)
+{
+    acc->start_time = record->start_time;
+    acc->count = record->sample_count;
+    for (int ch = 0; ch < ARCHIVE_CHANNEL_COUNT; ch++) {
+        acc->min[ch] = DecodeValue(ch, record->min[ch]);
+        acc->max[ch] = DecodeValue(ch, record->max[ch]);
+        acc->sum[ch] = DecodeValue(ch, record->mean[ch]) * (float)record->sample_count;
+        acc->last[ch] = DecodeValue(ch, record->last[ch]);
+    }
+}
+
+/**
+ * @brief 汇总记录加入待写入队列（队列满时丢弃最旧记录）
+ * @note 调用者需持有g_archive.mutex
+ */
+static void PushRollup(ArchiveTier tier, const RollupAccumulator *acc)
+{
+    if (g_archive.rollup_count >= ARCHIVE_ROLLUP_PENDING) {
+        g_archive.rollup_head = (g_archive.rollup_head + 1) % ARCHIVE_ROLLUP_PENDING;
+        g_archive.rollup_count--;
+        g_archive.stats.dropped++;
+    }
+
+    uint8_t idx = (g_archive.rollup_head + g_archive.rollup_count) % ARCHIVE_ROLLUP_PENDING;
+    AccumulatorToRecord(acc, &g_archive.rollup_pending[idx]);
+    g_archive.rollup_tier[idx] = tier;
+    g_archive.rollup_count++;
+}
+
+/**
+ * @brief 原始记录加入待写入队列（队列满时丢弃最旧记录）
+ * @note 调用者需持有g_archive.mutex
+ */
+static void PushRaw(uint32_t now, const float *values)
+{
+    if (g_archive.raw_count >= ARCHIVE_RAW_PENDING) {
+        g_archive.raw_head = (g_archive.raw_head + 1) % ARCHIVE_RAW_PENDING;
+        g_archive.raw_count--;
+        g_archive.stats.dropped++;
+    }
+
+    uint8_t idx = (g_archive.raw_head + g_archive.raw_count) % ARCHIVE_RAW_PENDING;
+    ArchiveRawRecord *record = &g_archive.raw_pending[idx];
+    memset(record, 0, sizeof(ArchiveRawRecord));
+    record->time = now;
+    for (int ch = 0; ch < ARCHIVE_CHANNEL_COUNT; ch++) {
+        record->value[ch] = EncodeValue(ch, values[ch]);
+    }
+    g_archive.raw_count++;
+}
+
+/**
+ * @brief 结束当前分钟窗口，必要时结束小时窗口
+ * @note 调用者需持有g_archive.mutex
+ */
+static void CloseMinuteWindow(void)
+{
+    RollupAccumulator *minute = &g_archive.minute_acc;
+    RollupAccumulator *hour = &g_archive.hour_acc;
+    uint32_t hour_start = minute->start_time - minute->start_time % ARCHIVE_HOUR_PERIOD_S;
+
+    PushRollup(ARCHIVE_TIER_MINUTE, minute);
+
+    if (hour->count > 0 && hour->start_time != hour_start) {
+        PushRollup(ARCHIVE_TIER_HOUR, hour);
+        memset(hour, 0, sizeof(RollupAccumulator));
+    }
+    MergeAccumulator(hour, minute, hour_start);
+
+    memset(minute, 0, sizeof(RollupAccumulator));
+}
+
+/**
+ * @brief 读取记录的时间字段
+ */
+static int ReadRecordTime(ArchiveTier tier, uint32_t index, uint32_t *time)
+{
+    if (tier == ARCHIVE_TIER_RAW) {
+        ArchiveRawRecord raw;
+        if (DataStorage_RingRead(&g_archive.ring[tier], index, &raw, sizeof(raw)) != 0) {
+            return -1;
+        }
+        *time = raw.time;
+    } else {
+        ArchiveRollupRecord rollup;
+        if (DataStorage_RingRead(&g_archive.ring[tier], index, &rollup, sizeof(rollup)) != 0) {
+            return -1;
+        }
+        *time = rollup.start_time;
+    }
+    return 0;
+}
+
+/**
+ * @brief 二分查找第一条时间不早于start_time的记录
+ * @note 调用者需持有g_archive.flash_mutex
+ */
+static uint32_t FindFirstIndex(ArchiveTier tier, uint32_t start_time)
+{
+    uint32_t lo = 0;
+    uint32_t hi = DataStorage_RingCount(&g_archive.ring[tier]);
+
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        uint32_t time;
+        // 损坏的记录视为早于目标时间，最多漏掉该条记录
+        if (ReadRecordTime(tier, mid, &time) != 0 || time < start_time) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/**
+ * @brief 从Flash恢复归档时间和当前小时窗口
+ */
+static void RestoreState(void)
+{
+    ArchiveRawRecord raw;
+    ArchiveRollupRecord rollup;
+    StorageRing *raw_ring = &g_archive.ring[ARCHIVE_TIER_RAW];
+    StorageRing *minute_ring = &g_archive.ring[ARCHIVE_TIER_MINUTE];
+    StorageRing *hour_ring = &g_archive.ring[ARCHIVE_TIER_HOUR];
+    uint32_t now = 0;
+
+    // 各层最新记录写入时刻的最大值作为本次启动的时间基准
+    if (DataStorage_RingReadLatest(raw_ring, &raw, sizeof(raw)) == 0 &&
+        raw.time + ARCHIVE_RAW_INTERVAL_S > now) {
+        now = raw.time + ARCHIVE_RAW_INTERVAL_S;
+    }
+    if (DataStorage_RingReadLatest(minute_ring, &rollup, sizeof(rollup)) == 0 &&
+        rollup.start_time + ARCHIVE_MINUTE_PERIOD_S > now) {
+        now = rollup.start_time + ARCHIVE_MINUTE_PERIOD_S;
+    }
+    if (DataStorage_RingReadLatest(hour_ring, &rollup, sizeof(rollup)) == 0 &&
+        rollup.start_time + ARCHIVE_HOUR_PERIOD_S > now) {
+        now = rollup.start_time + ARCHIVE_HOUR_PERIOD_S;
+    }
+    g_archive.time_base = now;
+
+    // 用分钟层中属于当前小时的记录重建小时累加器，重启不丢失整小时汇总
+    uint32_t hour_start = now - now % ARCHIVE_HOUR_PERIOD_S;
+    uint32_t first = FindFirstIndex(ARCHIVE_TIER_MINUTE, hour_start);
+    for (uint32_t i = first; i < minute_ring->count; i++) {
+        RollupAccumulator minute;
+        if (DataStorage_RingRead(minute_ring, i, &rollup, sizeof(rollup)) != 0 ||
+            rollup.sample_count == 0) {
+            continue;
+        }
+        RecordToAccumulator(&rollup, &minute);
+        MergeAccumulator(&g_archive.hour_acc, &minute, hour_start);
+    }
+}
+
+/**
+ * @brief 初始化多分辨率归档
+ */
+int DataArchive_Init(void)
+{
+    printf("Initializing data archive...\n");
+
+    memset(&g_archive, 0, sizeof(ArchiveManager));
+
+    if (LOS_MuxCreate(&g_archive.mutex) != LOS_OK ||
+        LOS_MuxCreate(&g_archive.flash_mutex) != LOS_OK) {
+        printf("Failed to create archive mutex\n");
+        return -1;
+    }
+
+    if (DataStorage_RingInit(&g_archive.ring[ARCHIVE_TIER_RAW], ARCHIVE_RAW_ADDR,
+                             ARCHIVE_RAW_SECTORS, sizeof(ArchiveRawRecord)) != 0 ||
+        DataStorage_RingInit(&g_archive.ring[ARCHIVE_TIER_MINUTE], ARCHIVE_MINUTE_ADDR,
+                             ARCHIVE_MINUTE_SECTORS, sizeof(ArchiveRollupRecord)) != 0 ||
+        DataStorage_RingInit(&g_archive.ring[ARCHIVE_TIER_HOUR], ARCHIVE_HOUR_ADDR,
+                             ARCHIVE_HOUR_SECTORS, sizeof(ArchiveRollupRecord)) != 0) {
+        printf("Failed to initialize archive rings\n");
+        return -2;
+    }
+
+    RestoreState();
+    g_archive.last_tick = LOS_TickCountGet();
+    g_archive.initialized = true;
+
+    printf("Data archive initialized: raw=%u, minute=%u, hour=%u records, time=%us\n",
+           g_archive.ring[ARCHIVE_TIER_RAW].count,
+           g_archive.ring[ARCHIVE_TIER_MINUTE].count,
+           g_archive.ring[ARCHIVE_TIER_HOUR].count,
+           g_archive.time_base);
+    return 0;
+}
+
+/**
+ * @brief 添加一个传感器样本
+ */
+void DataArchive_AddSample(const SensorData *data)
+{
+    if (!g_archive.initialized || data == NULL || !Sample_IsValid(data, SAMPLE_VALID_SENSORS)) {
+        return;
+    }
+
+    float values[ARCHIVE_CHANNEL_COUNT];
+    ExtractChannels(data, values);
+
+    LOS_MuxPend(g_archive.mutex, LOS_WAIT_FOREVER);
+
+    uint32_t now = UpdateClock();
+    uint32_t minute_start = now - now % ARCHIVE_MINUTE_PERIOD_S;
+
+    if (g_archive.minute_acc.count > 0 && g_archive.minute_acc.start_time != minute_start) {
+        CloseMinuteWindow();
+    }
+    AccumulateValues(&g_archive.minute_acc, values, minute_start);
+
+    // 原始层按固定间隔抽取，采样率变化不影响Flash写入量
+    if (!g_archive.raw_started || now - g_archive.last_raw_time >= ARCHIVE_RAW_INTERVAL_S) {
+        PushRaw(now, values);
+        g_archive.last_raw_time = now;
+        g_archive.raw_started = true;
+    }
+
+    LOS_MuxPost(g_archive.mutex);
+}
+
+/**
+ * @brief 将待写入记录写入Flash
+ */
+int DataArchive_Flush(void)
+{
+    if (!g_archive.initialized) {
+        return 0;
+    }
+
+    int written = 0;
+
+    while (1) {
+        ArchiveRawRecord raw;
+        ArchiveRollupRecord rollup;
+        ArchiveTier tier;
+        bool has_record = true;
+
+        // 只在出队时持锁，Flash擦写期间不阻塞采集任务
+        LOS_MuxPend(g_archive.mutex, LOS_WAIT_FOREVER);
+        if (g_archive.rollup_count > 0) {
+            tier = g_archive.rollup_tier[g_archive.rollup_head];
+            rollup = g_archive.rollup_pending[g_archive.rollup_head];
+            g_archive.rollup_head = (g_archive.rollup_head + 1) % ARCHIVE_ROLLUP_PENDING;
+            g_archive.rollup_count--;
+        } else if (g_archive.raw_count > 0) {
+            tier = ARCHIVE_TIER_RAW;
+            raw = g_archive.raw_pending[g_archive.raw_head];
+            g_archive.raw_head = (g_archive.raw_head + 1) % ARCHIVE_RAW_PENDING;
+            g_archive.raw_count--;
+        } else {
+            has_record = false;
+        }
+        LOS_MuxPost(g_archive.mutex);
+
+        if (!has_record) {
+            break;
+        }
+
+        LOS_MuxPend(g_archive.flash_mutex, LOS_WAIT_FOREVER);
+        int ret;
+        if (tier == ARCHIVE_TIER_RAW) {
+            ret = DataStorage_RingAppend(&g_archive.ring[tier], &raw, sizeof(raw));
+        } else {
+            ret = DataStorage_RingAppend(&g_archive.ring[tier], &rollup, sizeof(rollup));
+        }
+        LOS_MuxPost(g_archive.flash_mutex);
+
+        if (ret == 0) {
+            g_archive.stats.written[tier]++;
+            written++;
+        } else {
+            g_archive.stats.write_errors++;
+        }
+    }
+
+    return written;
+}
+
+/**
+ * @brief 按时间范围查询归档记录
+ */
+int DataArchive_Query(ArchiveTier tier, uint32_t start_time, uint32_t end_time,
+                      ArchiveQueryCallback callback, void *user_data)
+{
+    if (!g_archive.initialized || tier >= ARCHIVE_TIER_COUNT || callback == NULL || start_time > end_time) {
+        return -1;
+    }
+
+    int delivered = 0;
+    ArchiveSample sample;
+
+    LOS_MuxPend(g_archive.flash_mutex, LOS_WAIT_FOREVER);
+
+    uint32_t count = DataStorage_RingCount(&g_archive.ring[tier]);
+    for (uint32_t i = FindFirstIndex(tier, start_time); i < count; i++) {
+        memset(&sample, 0, sizeof(sample));
+        sample.tier = tier;
+
+        if (tier == ARCHIVE_TIER_RAW) {
+            ArchiveRawRecord raw;
+            if (DataStorage_RingRead(&g_archive.ring[tier], i, &raw, sizeof(raw)) != 0) {
+                continue;
+            }
+            sample.time = raw.time;
+            sample.sample_count = 1;
+            for (int ch = 0; ch < ARCHIVE_CHANNEL_COUNT; ch++) {
+                float value = DecodeValue(ch, raw.value[ch]);
+                sample.min[ch] = value;
+                sample.max[ch] = value;
+                sample.mean[ch] = value;
+                sample.last[ch] = value;
+            }
+        } else {
+            ArchiveRollupRecord rollup;
+            if (DataStorage_RingRead(&g_archive.ring[tier], i, &rollup, sizeof(rollup)) != 0) {
+                continue;
+            }
+            sample.time = rollup.start_time;
+            sample.sample_count = rollup.sample_count;
+            for (int ch = 0; ch < ARCHIVE_CHANNEL_COUNT; ch++) {
+                sample.min[ch] = DecodeValue(ch, rollup.min[ch]);
+                sample.max[ch] = DecodeValue(ch, rollup.max[ch]);
+                sample.mean[ch] = DecodeValue(ch, rollup.mean[ch]);
+                sample.last[ch] = DecodeValue(ch, rollup.last[ch]);
+            }
+        }
+
+        if (sample.time > end_time) {
+            break;
+        }
+
+        delivered++;
+        if (callback(&sample, user_data) != 0) {
+            break;
+        }
+    }
+
+    LOS_MuxPost(g_archive.flash_mutex);
+    return delivered;
+}
+
+/**
+ * @brief 获取当前归档时间
+ */
+uint32_t DataArchive_GetTime(void)
+{
+    if (!g_archive.initialized) {
+        return 0;
+    }
+
+    LOS_MuxPend(g_archive.mutex, LOS_WAIT_FOREVER);
+    uint32_t now = UpdateClock();
+    LOS_MuxPost(g_archive.mutex);
+    return now;
+}
+
+/**
+ * @brief 获取归档统计信息
+ */
+int DataArchive_GetStats(ArchiveStats *stats)
+{
+    if (!g_archive.initialized || stats == NULL) {
+        return -1;
+    }
+
+    LOS_MuxPend(g_archive.mutex, LOS_WAIT_FOREVER);
+    memcpy(stats, &g_archive.stats, sizeof(ArchiveStats));
+    stats->now = UpdateClock();
+    LOS_MuxPost(g_archive.mutex);
+
+    LOS_MuxPend(g_archive.flash_mutex, LOS_WAIT_FOREVER);
+    for (int tier = 0; tier < ARCHIVE_TIER_COUNT; tier++) {
+        stats->record_count[tier] = DataStorage_RingCount(&g_archive.ring[tier]);
+        stats->capacity[tier] = g_archive.ring[tier].total_slots;
+        if (stats->record_count[tier] == 0 || ReadRecordTime((ArchiveTier)tier, 0, &stats->oldest_time[tier]) != 0) {
+            stats->oldest_time[tier] = 0;
+        }
+    }
+    LOS_MuxPost(g_archive.flash_mutex);
+
+    return 0;
+}
+
+/**
+ * @brief 清空全部归档数据
+ */
+int DataArchive_Clear(void)
+{
+    if (!g_archive.initialized) {
+        return -1;
+    }
+
+    int ret = 0;
+
+    LOS_MuxPend(g_archive.mutex, LOS_WAIT_FOREVER);
+    memset(&g_archive.minute_acc, 0, sizeof(RollupAccumulator));
+    memset(&g_archive.hour_acc, 0, sizeof(RollupAccumulator));
+    g_archive.raw_count = 0;
+    g_archive.rollup_count = 0;
+    LOS_MuxPost(g_archive.mutex);
+
+    LOS_MuxPend(g_archive.flash_mutex, LOS_WAIT_FOREVER);
+    for (int tier = 0; tier < ARCHIVE_TIER_COUNT; tier++) {
+        if (DataStorage_RingClear(&g_archive.ring[tier]) != 0) {
+            ret = -1;
+        }
+    }
+    LOS_MuxPost(g_archive.flash_mutex);
+
+    printf("Data archive cleared\n");
+    return ret;
+}
@@ -0,0 +1,399 @@
+#include "data_cache.h"
+#include "los_task.h"
+#include "los_mux.h"
+#include <string.h>
+#include <stdio.h>
+
+// 队列管理结构
+// 顺序约定：Flash日志中的数据总是早于内存中的数据，补发时先Flash后内存
+typedef struct {
+    bool initialized;
+    bool flash_available;
+    UINT32 mutex;                               // 保护队列状态
+    UINT32 send_mutex;                          // 同一时间只允许一个任务补发
+    StorageRing ring;                           // Flash日志
+    uint32_t flash_read_index;                  // Flash中第一条未发送记录（相对最旧记录）
+    DataCacheItem ram[DATA_CACHE_RAM_SIZE];     // 内存队列（保存最新数据）
+    uint16_t ram_head;
+    uint16_t ram_count;
+    uint32_t next_id;
+    uint32_t retry_id;                          // 正在重试的数据ID
+    uint8_t retry_count;                        // 队首数据已重试次数
+    DataCacheStats stats;
+} DataCacheManager;
+
+static DataCacheManager g_cache = {0};
+
+/**
+ * @brief Flash中待发送条数
+ * @note 调用者需持有g_cache.mutex
+ */
+static uint32_t FlashPending(void)
+{
+    if (!g_cache.flash_available) {
+        return 0;
+    }
+    return DataStorage_RingCount(&g_cache.ring) - g_cache.flash_read_index;
+}
+
+/**
+ * @brief 追加数据到Flash日志，并修正因覆盖最旧扇区而移动的读位置
+ * @note 调用者需持有g_cache.mutex
+ */
+static int AppendToFlash(const DataCacheItem *item)
+{
+    uint32_t before = DataStorage_RingCount(&g_cache.ring);
+    int ret = DataStorage_RingAppend(&g_cache.ring, item, sizeof(DataCacheItem));
+    uint32_t after = DataStorage_RingCount(&g_cache.ring);
+
+    if (ret == 0 || after != before) {
+        uint32_t removed = (before + 1 > after) ? before + 1 - after : 0;
+        if (g_cache.flash_read_index >= removed) {
+            g_cache.flash_read_index -= removed;
+        } else {
+            // 长时间断网导致未发送数据被覆盖
+            g_cache.stats.total_dropped += removed - g_cache.flash_read_index;
+            g_cache.flash_read_index = 0;
+        }
+    }
+
+    return ret;
+}
+
+/**
+ * @brief 将内存队列最旧的一条写入Flash
+ * @note 调用者需持有g_cache.mutex
+ */
+static int SpillOldestRam(void)
+{
+    if (!g_cache.flash_available || g_cache.ram_count == 0) {
+        return -1;
+    }
+
+    if (AppendToFlash(&g_cache.ram[g_cache.ram_head]) != 0) {
+        return -1;
+    }
+
+    g_cache.ram_head = (g_cache.ram_head + 1) % DATA_CACHE_RAM_SIZE;
+    g_cache.ram_count--;
+    g_cache.stats.total_spilled++;
+    return 0;
+}
+
+/**
+ * @brief 读取队首数据（跳过Flash中损坏的记录）
+ * @note 调用者需持有g_cache.mutex
+ */
+static bool PeekHead(DataCacheItem *item)
+{
+    while (FlashPending() > 0) {
+        if (DataStorage_RingRead(&g_cache.ring, g_cache.flash_read_index, item, sizeof(DataCacheItem)) == 0) {
+            return true;
+        }
+        printf("  缓存Flash记录损坏，跳过\n");
+        DataStorage_RingClearFlags(&g_cache.ring, g_cache.flash_read_index, DATA_CACHE_FLAG_CONSUMED);
+        g_cache.flash_read_index++;
+        g_cache.stats.total_failed++;
+    }
+
+    if (g_cache.ram_count > 0) {
+        *item = g_cache.ram[g_cache.ram_head];
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief 若队首仍是指定数据则将其移出队列
+ * @note 调用者需持有g_cache.mutex；补发期间队首可能已从内存溢出到Flash，因此按ID确认
+ */
+static void PopHead(uint32_t id)
+{
+    DataCacheItem head;
+    if (!PeekHead(&head) || head.id != id) {
+        return;
+    }
+
+    if (FlashPending() > 0) {
+        DataStorage_RingClearFlags(&g_cache.ring, g_cache.flash_read_index, DATA_CACHE_FLAG_CONSUMED);
+        g_cache.flash_read_index++;
+    } else {
+        g_cache.ram_head = (g_cache.ram_head + 1) % DATA_CACHE_RAM_SIZE;
+        g_cache.ram_count--;
+    }
+}
+
+/**
+ * @brief 查找Flash中第一条未发送记录（已发送记录总是连续位于最旧一端）
+ */
+static uint32_t FindFirstPending(void)
+{
+    uint32_t lo = 0;
+    uint32_t hi = DataStorage_RingCount(&g_cache.ring);
+
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        uint32_t flags;
+        if (DataStorage_RingGetFlags(&g_cache.ring, mid, &flags) != 0 ||
+            (flags & DATA_CACHE_FLAG_CONSUMED) == 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/**
+ * @brief 初始化上传缓存队列
+ */
+int DataCache_Init(void)
+{
+    if (g_cache.initialized) {
+        return 0;  // 已经初始化
+    }
+
+    memset(&g_cache, 0, sizeof(DataCacheManager));
+    g_cache.next_id = 1;
+
+    if (LOS_MuxCreate(&g_cache.mutex) != LOS_OK ||
+        LOS_MuxCreate(&g_cache.send_mutex) != LOS_OK) {
+        printf(" 缓存队列互斥锁创建失败\n");
+        return -1;
+    }
+
+    int ret = 0;
+    if (DataStorage_RingInit(&g_cache.ring, DATA_CACHE_FLASH_ADDR,
+                             DATA_CACHE_FLASH_SECTORS, sizeof(DataCacheItem)) == 0) {
+        g_cache.flash_available = true;
+        g_cache.flash_read_index = FindFirstPending();
+
+        // 延续上次运行的ID序号
+        DataCacheItem last;
+        if (DataStorage_RingReadLatest(&g_cache.ring, &last, sizeof(last)) == 0) {
+            g_cache.next_id = last.id + 1;
+        }
+    } else {
+        printf("  缓存Flash日志不可用，仅使用内存队列\n");
+        ret = -2;
+    }
+
+    g_cache.initialized = true;
+    printf(" 数据缓存队列初始化完成: 内存%d条, Flash恢复待发送%u条\n",
+           DATA_CACHE_RAM_SIZE, FlashPending());
+
+    return ret;
+}
+
+/**
+ * @brief 数据入队
+ */
+int DataCache_Add(const LandslideIotData *data)
+{
+    if (!g_cache.initialized || data == NULL) {
+        return -1;
+    }
+
+    LOS_MuxPend(g_cache.mutex, LOS_WAIT_FOREVER);
+
+    // 内存满时最旧数据溢出到Flash，Flash不可用才丢弃
+    if (g_cache.ram_count >= DATA_CACHE_RAM_SIZE && SpillOldestRam() != 0) {
+        printf("  缓存已满，移除最旧数据\n");
+        g_cache.ram_head = (g_cache.ram_head + 1) % DATA_CACHE_RAM_SIZE;
+        g_cache.ram_count--;
+        g_cache.stats.total_dropped++;
+    }
+
+    DataCacheItem *item = &g_cache.ram[(g_cache.ram_head + g_cache.ram_count) % DATA_CACHE_RAM_SIZE];
+    item->id = g_cache.next_id++;
+    item->timestamp = LOS_TickCountGet();
+    memcpy(&item->data, data, sizeof(LandslideIotData));
+    g_cache.ram_count++;
+    g_cache.stats.total_cached++;
+
+    printf(" 数据已缓存 [内存%d Flash%u] 总缓存:%u\n",
+           g_cache.ram_count, FlashPending(), g_cache.stats.total_cached);
+
+    LOS_MuxPost(g_cache.mutex);
+    return 0;
+}
+
+/**
+ * @brief 按入队顺序补发缓存数据
+ */
+int DataCache_SendPending(DataCacheSendCallback send, int max_items)
+{
+    if (!g_cache.initialized || send == NULL) {
+        return 0;
+    }
+
+    // 其他任务正在补发时直接返回，避免重复发送
+    if (LOS_MuxPend(g_cache.send_mutex, LOS_NO_WAIT) != LOS_OK) {
+        return 0;
+    }
+
+    int sent_count = 0;
+    DataCacheItem item;
+
+    for (int i = 0; i < max_items; i++) {
+        LOS_MuxPend(g_cache.mutex, LOS_WAIT_FOREVER);
+        bool has_item = PeekHead(&item);
+        LOS_MuxPost(g_cache.mutex);
+        if (!has_item) {
+            break;
+        }
+
+        // 发送期间不持有队列锁，采集任务可继续入队
+        int ret = send(&item);
+
+        LOS_MuxPend(g_cache.mutex, LOS_WAIT_FOREVER);
+        if (ret == 0) {
+            PopHead(item.id);
+            g_cache.stats.total_sent++;
+            g_cache.retry_count = 0;
+            sent_count++;
+        } else if (ret < 0) {
+            if (g_cache.retry_id != item.id) {
+                g_cache.retry_id = item.id;
+                g_cache.retry_count = 0;
+            }
+            g_cache.retry_count++;
+            if (g_cache.retry_count >= DATA_CACHE_MAX_RETRY) {
+                printf(" 数据重试次数超限，丢弃 (重试:%d次)\n", g_cache.retry_count);
+                PopHead(item.id);
+                g_cache.stats.total_failed++;
+                g_cache.retry_count = 0;
+            }
+        }
+        LOS_MuxPost(g_cache.mutex);
+
+        if (ret != 0) {
+            break;  // 连接异常，等待下次补发
+        }
+
+        // 避免阻塞太久
+        LOS_Msleep(100);
+    }
+
+    LOS_MuxPost(g_cache.send_mutex);
+
+    if (sent_count > 0) {
+        printf(" 缓存数据发送完成: %d条成功\n", sent_count);
+    }
+
+    return sent_count;
+}
+
+/**
+ * @brief 将内存数据写入Flash
+ */
+int DataCache_Spill(bool all)
+{
+    if (!g_cache.initialized || !g_cache.flash_available) {
+        return 0;
+    }
+
+    int spilled = 0;
+    uint32_t now = LOS_TickCountGet();
+
+    LOS_MuxPend(g_cache.mutex, LOS_WAIT_FOREVER);
+    while (g_cache.ram_count > 0 &&
+           (all || now - g_cache.ram[g_cache.ram_head].timestamp >= DATA_CACHE_SPILL_AGE_MS)) {
+        if (SpillOldestRam() != 0) {
+            break;
+        }
+        spilled++;
+    }
+    LOS_MuxPost(g_cache.mutex);
+
+    return spilled;
+}
+
+/**
+ * @brief 获取待发送数据总数
+ */
+uint32_t DataCache_GetCount(void)
+{
+    if (!g_cache.initialized) {
+        return 0;
+    }
+
+    LOS_MuxPend(g_cache.mutex, LOS_WAIT_FOREVER);
+    uint32_t count = g_cache.ram_count + FlashPending();
+    LOS_MuxPost(g_cache.mutex);
+    return count;
+}
+
+/**
+ * @brief 获取队列总容量
+ */
+uint32_t DataCache_GetCapacity(void)
+{
+    return DATA_CACHE_RAM_SIZE + (g_cache.flash_available ? g_cache.ring.total_slots : 0);
+}
+
+/**
+ * @brief 获取缓存统计信息
+ */
+int DataCache_GetStats(DataCacheStats *stats)
+{
+    if (!g_cache.initialized || stats == NULL) {
+        return -1;
+    }
+
+    LOS_MuxPend(g_cache.mutex, LOS_WAIT_FOREVER);
+    memcpy(stats, &g_cache.stats, sizeof(DataCacheStats));
+    stats->ram_count = g_cache.ram_count;
+    stats->flash_count = FlashPending();
+    stats->ram_capacity = DATA_CACHE_RAM_SIZE;
+    stats->flash_capacity = g_cache.flash_available ? g_cache.ring.total_slots : 0;
+    stats->flash_available = g_cache.flash_available;
+    LOS_MuxPost(g_cache.mutex);
+
+    return 0;
+}
+
+/**
+ * @brief 清空全部缓存数据
+ */
+void DataCache_Clear(void)
+{
+    if (!g_cache.initialized) {
+        return;
+    }
+
+    LOS_MuxPend(g_cache.mutex, LOS_WAIT_FOREVER);
+    g_cache.ram_head = 0;
+    g_cache.ram_count = 0;
+    if (g_cache.flash_available) {
+        DataStorage_RingClear(&g_cache.ring);
+        g_cache.flash_read_index = 0;
+    }
+    LOS_MuxPost(g_cache.mutex);
+
+    printf("  数据缓存已清空\n");
+}
+
+/**
+ * @brief 打印缓存统计信息
+ */
+void DataCache_PrintStats(void)
+{
+    DataCacheStats stats;
+    if (DataCache_GetStats(&stats) != 0) {
+        printf(" 缓存系统未初始化\n");
+        return;
+    }
+
+    printf("\n === 数据缓存统计 ===\n");
+    printf("当前缓存: %u/%u 条 (内存%u/%u, Flash%u/%u)\n",
+           stats.ram_count + stats.flash_count, stats.ram_capacity + stats.flash_capacity,
+           stats.ram_count, stats.ram_capacity, stats.flash_count, stats.flash_capacity);
+    printf("总缓存数: %u 条\n", stats.total_cached);
+    printf("补发成功: %u 条\n", stats.total_sent);
+    printf("重试丢弃: %u 条\n", stats.total_failed);
+    printf("溢出Flash: %u 条\n", stats.total_spilled);
+    printf("覆盖丢失: %u 条\n", stats.total_dropped);
+    printf("========================\n\n");
+}
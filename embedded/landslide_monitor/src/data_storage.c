@@ -1,318 +1,385 @@
 #include "data_storage.h"
+#include "crc32.h"
 #include "iot_flash.h"
 #include "iot_errno.h"  // 添加IOT_SUCCESS等常量定义
 #include "los_task.h"
 #include "los_memory.h"
 #include <string.h>
 #include <stdio.h>
+#include <stddef.h>
 
-// 存储管理结构
-typedef struct {
-    bool initialized;
-    uint32_t current_index;     // 当前写入索引
-    uint32_t record_count;      // 记录数量
-    StorageStats stats;         // 统计信息
-} StorageManager;
+static bool g_storage_initialized = false;
 
-static StorageManager g_storage_mgr = {0};
+/**
+ * @brief 初始化数据存储
+ */
+int DataStorage_Init(void)
+{
+    if (g_storage_initialized) {
+        return 0;
+    }
+
+    printf("Initializing data storage...\n");
+
+    if (Crc32_SelfTest() != 0) {
+        printf("CRC32 self test failed\n");
+        return -1;
+    }
+
+    // 初始化Flash
+    if (IoTFlashInit() != IOT_SUCCESS) {
+        printf("Failed to initialize Flash\n");
+        return -1;
+    }
 
-// 魔数定义
-#define STORAGE_MAGIC_NUMBER    0x12345678
+    g_storage_initialized = true;
+    printf("Data storage initialized\n");
+    return 0;
+}
 
 /**
- * @brief 计算校验和
+ * @brief 反初始化数据存储
  */
-static uint16_t CalculateChecksum(const uint8_t *data, uint16_t size)
+void DataStorage_Deinit(void)
 {
-    uint16_t checksum = 0;
-    for (uint16_t i = 0; i < size; i++) {
-        checksum += data[i];
+    if (g_storage_initialized) {
+        IoTFlashDeinit();
+        g_storage_initialized = false;
+        printf("Data storage deinitialized\n");
     }
-    return checksum;
 }
 
+// ========== Flash环形区 ==========
+
 /**
- * @brief 获取记录的Flash地址
+ * @brief 获取环形区槽位的Flash地址
  */
-static uint32_t GetRecordAddress(uint32_t index)
+static uint32_t GetRingSlotAddress(const StorageRing *ring, uint32_t slot)
 {
-    return STORAGE_FLASH_BASE_ADDR + (index * STORAGE_RECORD_SIZE);
+    uint32_t sector = slot / ring->slots_per_sector;
+    uint32_t offset = slot % ring->slots_per_sector;
+    return ring->base_addr + sector * STORAGE_SECTOR_SIZE + offset * ring->slot_size;
 }
 
 /**
- * @brief 初始化数据存储
+ * @brief 读取槽位头部并检查是否为有效记录
  */
-int DataStorage_Init(void)
+static bool ReadRingHeader(const StorageRing *ring, uint32_t slot, StorageRingHeader *header)
 {
-    printf("Initializing data storage...\n");
-    
-    // 初始化Flash
-    if (IoTFlashInit() != IOT_SUCCESS) {
-        printf("Failed to initialize Flash\n");
-        return -1;
+    if (IoTFlashRead(GetRingSlotAddress(ring, slot), sizeof(StorageRingHeader), (uint8_t*)header) != IOT_SUCCESS) {
+        return false;
     }
-    
-    // 初始化存储管理器
-    memset(&g_storage_mgr, 0, sizeof(StorageManager));
-    g_storage_mgr.initialized = true;
-    g_storage_mgr.current_index = 0;
-    g_storage_mgr.record_count = 0;
-    
-    // 扫描现有记录
-    StorageRecord record;
-    for (uint32_t i = 0; i < STORAGE_MAX_RECORDS; i++) {
-        uint32_t addr = GetRecordAddress(i);
-        if (IoTFlashRead(addr, sizeof(StorageRecord), (uint8_t*)&record) == IOT_SUCCESS) {
-            if (record.header.magic == STORAGE_MAGIC_NUMBER) {
-                g_storage_mgr.record_count++;
-                if (record.header.timestamp > 0) {
-                    g_storage_mgr.current_index = (i + 1) % STORAGE_MAX_RECORDS;
-                }
-            }
+    return header->magic == STORAGE_RING_MAGIC && header->length == ring->payload_size;
+}
+
+/**
+ * @brief 计算记录校验值（覆盖头部魔数/长度/序号和载荷，不含可原地修改的flags）
+ */
+static uint32_t CalculateRecordCrc(const StorageRingHeader *header, const void *payload, uint16_t size)
+{
+    uint32_t crc = Crc32_Update(0, header, offsetof(StorageRingHeader, checksum));
+    return Crc32_Update(crc, payload, size);
+}
+
+/**
+ * @brief 分块读取Flash中的载荷并校验整条记录（扫描时使用，无需整条载荷缓冲区）
+ */
+static bool VerifyRingRecord(const StorageRing *ring, uint32_t slot, const StorageRingHeader *header)
+{
+    uint8_t chunk[64];
+    uint32_t addr = GetRingSlotAddress(ring, slot) + sizeof(StorageRingHeader);
+    uint32_t crc = Crc32_Update(0, header, offsetof(StorageRingHeader, checksum));
+
+    for (uint16_t done = 0; done < ring->payload_size; ) {
+        uint16_t len = ring->payload_size - done;
+        if (len > sizeof(chunk)) {
+            len = sizeof(chunk);
+        }
+        if (IoTFlashRead(addr + done, len, chunk) != IOT_SUCCESS) {
+            return false;
         }
+        crc = Crc32_Update(crc, chunk, len);
+        done += len;
     }
-    
-    // 初始化统计信息
-    g_storage_mgr.stats.total_records = STORAGE_MAX_RECORDS;
-    g_storage_mgr.stats.stored_records = g_storage_mgr.record_count;
-    g_storage_mgr.stats.uploaded_records = 0;
-    g_storage_mgr.stats.failed_records = 0;
-    g_storage_mgr.stats.state = STORAGE_STATE_READY;
-    
-    printf("Data storage initialized: %d existing records found\n", g_storage_mgr.record_count);
-    return 0;
+
+    return crc == header->checksum;
 }
 
 /**
- * @brief 反初始化数据存储
+ * @brief 读取槽位头部并校验整条记录（过滤掉电时写了一半的头部）
  */
-void DataStorage_Deinit(void)
+static bool ReadValidRingRecord(const StorageRing *ring, uint32_t slot, StorageRingHeader *header)
 {
-    if (g_storage_mgr.initialized) {
-        IoTFlashDeinit();
-        g_storage_mgr.initialized = false;
-        printf("Data storage deinitialized\n");
+    return ReadRingHeader(ring, slot, header) && VerifyRingRecord(ring, slot, header);
+}
+
+/**
+ * @brief 检查槽位是否仍为擦除状态（全0xFF）
+ */
+static bool IsRingSlotErased(const StorageRing *ring, uint32_t slot)
+{
+    uint8_t chunk[64];
+    uint32_t addr = GetRingSlotAddress(ring, slot);
+
+    for (uint16_t done = 0; done < ring->slot_size; ) {
+        uint16_t len = ring->slot_size - done;
+        if (len > sizeof(chunk)) {
+            len = sizeof(chunk);
+        }
+        if (IoTFlashRead(addr + done, len, chunk) != IOT_SUCCESS) {
+            return false;
+        }
+        for (uint16_t i = 0; i < len; i++) {
+            if (chunk[i] != 0xFF) {
+                return false;
+            }
+        }
+        done += len;
     }
+
+    return true;
 }
 
 /**
- * @brief 存储数据到Flash
+ * @brief 初始化Flash环形区并扫描已有记录
  */
-int DataStorage_Store(const LandslideIotData *data)
+int DataStorage_RingInit(StorageRing *ring, uint32_t base_addr, uint16_t sector_count, uint16_t payload_size)
 {
-    if (!g_storage_mgr.initialized || data == NULL) {
+    if (ring == NULL || payload_size == 0 || sector_count < STORAGE_RING_MIN_SECTORS ||
+        (base_addr & (STORAGE_SECTOR_SIZE - 1)) != 0 ||
+        payload_size + sizeof(StorageRingHeader) > STORAGE_SECTOR_SIZE) {
         return -1;
     }
-    
-    // 准备存储记录
-    StorageRecord record = {0};
-    record.header.magic = STORAGE_MAGIC_NUMBER;
-    record.header.timestamp = LOS_TickCountGet();
-    record.header.data_size = sizeof(LandslideIotData);
-    
-    // 复制数据
-    memcpy(&record.data, data, sizeof(LandslideIotData));
-    
-    // 计算校验和
-    record.header.checksum = CalculateChecksum((uint8_t*)&record.data, sizeof(LandslideIotData));
-    
-    // 获取存储地址
-    uint32_t addr = GetRecordAddress(g_storage_mgr.current_index);
-    
-    // 擦除扇区（如果需要）
-    if (g_storage_mgr.current_index % (STORAGE_SECTOR_SIZE / STORAGE_RECORD_SIZE) == 0) {
-        uint32_t sector_addr = addr & ~(STORAGE_SECTOR_SIZE - 1);
-        if (IoTFlashErase(sector_addr, STORAGE_SECTOR_SIZE) != IOT_SUCCESS) {
-            printf("Failed to erase Flash sector at 0x%x\n", sector_addr);
-            g_storage_mgr.stats.failed_records++;
-            return -1;
+
+    memset(ring, 0, sizeof(StorageRing));
+    ring->base_addr = base_addr;
+    ring->sector_count = sector_count;
+    ring->payload_size = payload_size;
+    ring->slot_size = (uint16_t)((payload_size + sizeof(StorageRingHeader) + 3) & ~3U);  // 4字节对齐
+    ring->slots_per_sector = STORAGE_SECTOR_SIZE / ring->slot_size;
+    ring->total_slots = (uint32_t)sector_count * ring->slots_per_sector;
+    ring->next_sequence = 1;
+
+    // 每个扇区只读首条记录，序号最大的扇区即当前写入扇区
+    StorageRingHeader header;
+    int32_t current_sector = -1;
+    uint32_t current_seq = 0;
+    for (uint32_t s = 0; s < sector_count; s++) {
+        if (ReadValidRingRecord(ring, s * ring->slots_per_sector, &header) &&
+            (current_sector < 0 || header.sequence > current_seq)) {
+            current_sector = (int32_t)s;
+            current_seq = header.sequence;
         }
     }
-    
-    // 写入Flash
-    if (IoTFlashWrite(addr, sizeof(StorageRecord), (uint8_t*)&record, 0) != IOT_SUCCESS) {
-        printf("Failed to write data to Flash at 0x%x\n", addr);
-        g_storage_mgr.stats.failed_records++;
-        return -1;
+
+    if (current_sector < 0) {
+        printf("Storage ring @0x%x: empty (%u slots)\n", base_addr, ring->total_slots);
+        return 0;
     }
-    
-    // 更新索引和统计
-    g_storage_mgr.current_index = (g_storage_mgr.current_index + 1) % STORAGE_MAX_RECORDS;
-    if (g_storage_mgr.record_count < STORAGE_MAX_RECORDS) {
-        g_storage_mgr.record_count++;
+
+    // 在当前扇区内查找序号最大的记录（跳过写入失败留下的空洞）
+    uint32_t first_slot = (uint32_t)current_sector * ring->slots_per_sector;
+    uint32_t last_offset = 0;
+    uint32_t last_seq = current_seq;
+    for (uint32_t i = 1; i < ring->slots_per_sector; i++) {
+        if (ReadValidRingRecord(ring, first_slot + i, &header) && header.sequence > last_seq) {
+            last_offset = i;
+            last_seq = header.sequence;
+        }
+    }
+    ring->write_slot = (first_slot + last_offset + 1) % ring->total_slots;
+    ring->next_sequence = last_seq + 1;
+
+    // 从当前扇区之后顺序查找第一个有效扇区，即最旧扇区
+    uint32_t full_sectors = 0;
+    ring->oldest_slot = first_slot;
+    for (uint32_t i = 1; i < sector_count; i++) {
+        uint32_t s = ((uint32_t)current_sector + i) % sector_count;
+        if (ReadValidRingRecord(ring, s * ring->slots_per_sector, &header) && header.sequence < current_seq) {
+            ring->oldest_slot = s * ring->slots_per_sector;
+            full_sectors = sector_count - i;
+            break;
+        }
     }
-    g_storage_mgr.stats.stored_records++;
-    
-    printf("Data stored to Flash: index=%d, timestamp=%d\n", 
-           g_storage_mgr.current_index - 1, record.header.timestamp);
-    
+    ring->count = full_sectors * ring->slots_per_sector + last_offset + 1;
+
+    // 掉电时写了一半的槽位不能再次编程，跳过直到空白槽位或扇区边界（新扇区写入前会擦除）
+    while (ring->write_slot % ring->slots_per_sector != 0 && !IsRingSlotErased(ring, ring->write_slot)) {
+        ring->write_slot = (ring->write_slot + 1) % ring->total_slots;
+        ring->count++;
+    }
+
+    printf("Storage ring @0x%x: %u/%u records, next seq %u\n",
+           base_addr, ring->count, ring->total_slots, ring->next_sequence);
     return 0;
 }
 
 /**
- * @brief 从Flash读取数据
+ * @brief 追加一条记录到环形区
  */
-int DataStorage_Read(uint32_t index, LandslideIotData *data)
+int DataStorage_RingAppend(StorageRing *ring, const void *payload, uint16_t size)
 {
-    if (!g_storage_mgr.initialized || data == NULL || index >= STORAGE_MAX_RECORDS) {
+    if (ring == NULL || payload == NULL || ring->total_slots == 0 || size != ring->payload_size) {
         return -1;
     }
-    
-    StorageRecord record;
-    uint32_t addr = GetRecordAddress(index);
-    
-    // 从Flash读取
-    if (IoTFlashRead(addr, sizeof(StorageRecord), (uint8_t*)&record) != IOT_SUCCESS) {
-        return -1;
+
+    uint32_t slot = ring->write_slot;
+    uint32_t addr = GetRingSlotAddress(ring, slot);
+
+    // 进入新扇区前先擦除，若扇区中仍有最旧数据则一并淘汰
+    if (slot % ring->slots_per_sector == 0) {
+        if (IoTFlashErase(addr, STORAGE_SECTOR_SIZE) != IOT_SUCCESS) {
+            printf("Failed to erase ring sector at 0x%x\n", addr);
+            return -1;
+        }
+        uint32_t free_slots = ring->total_slots - ring->count;
+        if (free_slots < ring->slots_per_sector) {
+            ring->count -= ring->slots_per_sector - free_slots;
+            ring->oldest_slot = (slot + ring->slots_per_sector) % ring->total_slots;
+        }
     }
-    
-    // 验证魔数
-    if (record.header.magic != STORAGE_MAGIC_NUMBER) {
-        return -1;
+
+    StorageRingHeader header;
+    header.magic = STORAGE_RING_MAGIC;
+    header.length = size;
+    header.sequence = ring->next_sequence;
+    header.flags = STORAGE_RING_FLAGS_ERASED;
+    header.checksum = CalculateRecordCrc(&header, payload, size);
+
+    // 槽位无论写入成功与否都被消耗，避免在已部分编程的区域重复写入
+    ring->write_slot = (slot + 1) % ring->total_slots;
+    ring->next_sequence++;
+    if (ring->count == 0) {
+        ring->oldest_slot = slot;
+    }
+    if (ring->count < ring->total_slots) {
+        ring->count++;
     }
-    
-    // 验证校验和
-    uint16_t checksum = CalculateChecksum((uint8_t*)&record.data, sizeof(LandslideIotData));
-    if (checksum != record.header.checksum) {
-        printf("Checksum mismatch for record %d\n", index);
+
+    // 先写载荷后写头部：掉电时头部无效，扫描时自动忽略残缺记录
+    if (IoTFlashWrite(addr + sizeof(StorageRingHeader), size, (const uint8_t*)payload, 0) != IOT_SUCCESS ||
+        IoTFlashWrite(addr, sizeof(StorageRingHeader), (const uint8_t*)&header, 0) != IOT_SUCCESS) {
+        printf("Failed to write ring record at 0x%x\n", addr);
         return -1;
     }
-    
-    // 复制数据
-    memcpy(data, &record.data, sizeof(LandslideIotData));
-    
+
     return 0;
 }
 
 /**
- * @brief 获取存储的记录数量
+ * @brief 按时间顺序读取环形区记录
  */
-uint32_t DataStorage_GetRecordCount(void)
+int DataStorage_RingRead(const StorageRing *ring, uint32_t index, void *payload, uint16_t size)
 {
-    return g_storage_mgr.record_count;
-}
+    if (ring == NULL || payload == NULL || index >= ring->count || size < ring->payload_size) {
+        return -1;
+    }
 
-/**
- * @brief 清空所有存储的数据
- */
-int DataStorage_Clear(void)
-{
-    if (!g_storage_mgr.initialized) {
+    uint32_t slot = (ring->oldest_slot + index) % ring->total_slots;
+    StorageRingHeader header;
+    if (!ReadRingHeader(ring, slot, &header)) {
         return -1;
     }
-    
-    printf("Clearing all stored data...\n");
-    
-    // 擦除所有存储区域
-    for (uint32_t addr = STORAGE_FLASH_BASE_ADDR; 
-         addr < STORAGE_FLASH_BASE_ADDR + STORAGE_TOTAL_SIZE; 
-         addr += STORAGE_SECTOR_SIZE) {
-        if (IoTFlashErase(addr, STORAGE_SECTOR_SIZE) != IOT_SUCCESS) {
-            printf("Failed to erase Flash sector at 0x%x\n", addr);
-            return -1;
-        }
+
+    if (IoTFlashRead(GetRingSlotAddress(ring, slot) + sizeof(StorageRingHeader),
+                     ring->payload_size, (uint8_t*)payload) != IOT_SUCCESS) {
+        return -1;
     }
-    
-    // 重置管理器
-    g_storage_mgr.current_index = 0;
-    g_storage_mgr.record_count = 0;
-    g_storage_mgr.stats.stored_records = 0;
-    g_storage_mgr.stats.uploaded_records = 0;
-    g_storage_mgr.stats.failed_records = 0;
-    
-    printf("All stored data cleared\n");
+
+    if (CalculateRecordCrc(&header, payload, ring->payload_size) != header.checksum) {
+        return -1;
+    }
+
     return 0;
 }
 
 /**
- * @brief 获取存储统计信息
+ * @brief 读取最新的一条有效记录
  */
-int DataStorage_GetStats(StorageStats *stats)
+int DataStorage_RingReadLatest(const StorageRing *ring, void *payload, uint16_t size)
 {
-    if (!g_storage_mgr.initialized || stats == NULL) {
+    if (ring == NULL) {
         return -1;
     }
-    
-    memcpy(stats, &g_storage_mgr.stats, sizeof(StorageStats));
-    return 0;
+
+    // 残缺槽位只出现在写入失败处，最多向前查找一个扇区
+    uint32_t limit = (ring->count < ring->slots_per_sector) ? ring->count : ring->slots_per_sector;
+    for (uint32_t i = 1; i <= limit; i++) {
+        if (DataStorage_RingRead(ring, ring->count - i, payload, size) == 0) {
+            return 0;
+        }
+    }
+
+    return -1;
 }
 
 /**
- * @brief 检查存储空间是否已满
+ * @brief 获取环形区有效记录数
  */
-bool DataStorage_IsFull(void)
+uint32_t DataStorage_RingCount(const StorageRing *ring)
 {
-    return g_storage_mgr.record_count >= STORAGE_MAX_RECORDS;
+    return (ring != NULL) ? ring->count : 0;
 }
 
 /**
- * @brief 获取Flash中的数据供内存缓存系统使用
- * @param callback 回调函数，用于处理每条数据
- * @return 处理的数据条数
+ * @brief 读取记录标志
  */
-int DataStorage_ProcessCached(int (*callback)(const LandslideIotData *data))
+int DataStorage_RingGetFlags(const StorageRing *ring, uint32_t index, uint32_t *flags)
 {
-    if (!g_storage_mgr.initialized || callback == NULL) {
-        return 0;
-    }
-
-    int processed_count = 0;
-    LandslideIotData data;
-
-    printf(" 处理Flash缓存数据，共%d条记录\n", g_storage_mgr.record_count);
-
-    int failed_count = 0;
-
-    // 遍历所有存储的记录
-    for (uint32_t i = 0; i < g_storage_mgr.record_count; i++) {
-        if (DataStorage_Read(i, &data) == 0) {
-            // 调用回调函数处理数据
-            if (callback(&data) == 0) {
-                processed_count++;
-                printf(" Flash记录 %d 已加载到内存缓存\n", i);
-            } else {
-                failed_count++;
-                printf("  Flash记录 %d 处理失败\n", i);
-            }
-        } else {
-            failed_count++;
-            printf("  Flash记录 %d 读取失败\n", i);
-        }
+    if (ring == NULL || flags == NULL || index >= ring->count) {
+        return -1;
     }
 
-    // 如果所有记录都无效，清空Flash
-    if (failed_count > 0 && processed_count == 0) {
-        printf(" 检测到%d条无效Flash记录，正在清理...\n", failed_count);
-        DataStorage_Clear();
-        printf(" Flash缓存已清理完成\n");
-    } else if (processed_count > 0 && processed_count == g_storage_mgr.record_count) {
-        printf("  Flash数据已全部加载到内存，清空Flash存储\n");
-        DataStorage_Clear();
-    } else if (failed_count > 0) {
-        printf("  Flash处理结果: 成功%d条，失败%d条\n", processed_count, failed_count);
+    StorageRingHeader header;
+    if (!ReadRingHeader(ring, (ring->oldest_slot + index) % ring->total_slots, &header)) {
+        return -1;
     }
 
-    return processed_count;
+    *flags = header.flags;
+    return 0;
 }
 
 /**
- * @brief 上传所有缓存的数据（保留接口兼容性）
- * @deprecated 建议使用DataStorage_ProcessCached配合内存缓存系统
+ * @brief 原地清除记录标志位
  */
-int DataStorage_UploadCached(void)
+int DataStorage_RingClearFlags(StorageRing *ring, uint32_t index, uint32_t mask)
 {
-    printf("  DataStorage_UploadCached已弃用，请使用统一的内存缓存系统\n");
+    if (ring == NULL || index >= ring->count) {
+        return -1;
+    }
+
+    // 只编程flags字段，写入值中要清除的位为0，其余位为1保持不变
+    uint32_t slot = (ring->oldest_slot + index) % ring->total_slots;
+    uint32_t value = ~mask;
+    uint32_t addr = GetRingSlotAddress(ring, slot) + offsetof(StorageRingHeader, flags);
+    if (IoTFlashWrite(addr, sizeof(value), (const uint8_t*)&value, 0) != IOT_SUCCESS) {
+        printf("Failed to update ring flags at 0x%x\n", addr);
+        return -1;
+    }
+
     return 0;
 }
 
 /**
- * @brief 获取最旧的记录索引
+ * @brief 擦除环形区全部记录
  */
-uint32_t DataStorage_GetOldestIndex(void)
+int DataStorage_RingClear(StorageRing *ring)
 {
-    if (g_storage_mgr.record_count < STORAGE_MAX_RECORDS) {
-        return 0;
-    } else {
-        return g_storage_mgr.current_index;
+    if (ring == NULL || ring->total_slots == 0) {
+        return -1;
+    }
+
+    for (uint32_t s = 0; s < ring->sector_count; s++) {
+        uint32_t addr = ring->base_addr + s * STORAGE_SECTOR_SIZE;
+        if (IoTFlashErase(addr, STORAGE_SECTOR_SIZE) != IOT_SUCCESS) {
+            printf("Failed to erase ring sector at 0x%x\n", addr);
+            return -1;
+        }
     }
+
+    // 序号继续递增，保证重启扫描时新旧记录可区分
+    ring->write_slot = 0;
+    ring->oldest_slot = 0;
+    ring->count = 0;
+    return 0;
 }
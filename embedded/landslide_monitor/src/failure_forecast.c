@@ -0,0 +1,411 @@
+#include "failure_forecast.h"
+#include "los_mux.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+// 时间单位：毫秒转小时
+#define MS_PER_HOUR         3600000.0
+// 最旧点距时间零点超过该值 (小时) 时重新计算累加和，保持数值精度
+#define REBASE_HOURS        240.0
+
+// 95%双侧Student t分位数（按自由度1~14），自由度更大时取2.0
+static const float g_t95[] = {12.71f, 4.30f, 3.18f, 2.78f, 2.57f, 2.45f, 2.36f,
+                              2.31f, 2.26f, 2.23f, 2.20f, 2.18f, 2.16f, 2.14f};
+
+// 反速度点
+typedef struct {
+    uint32_t timestamp;             // 时间戳 (ms)
+    float inverse_velocity;         // 反速度 1/v
+} InversePoint;
+
+// 单个数据源的反速度序列（环形窗口 + 累加和）
+typedef struct {
+    InversePoint points[FORECAST_WINDOW];
+    uint16_t count;                 // 窗口内点数
+    uint16_t head;                  // 下一个写入位置
+    uint16_t gap;                   // 连续速度不显著的点数
+    uint32_t ref_ms;                // 时间零点
+    uint32_t now_ms;                // 最近一次输入时间（剩余时间起算点）
+    float last_velocity;
+    double st;                      // Σt
+    double stt;                     // Σt²
+    double sy;                      // Σy
+    double sty;                     // Σt·y
+    double syy;                     // Σy²
+} InverseSeries;
+
+// 倾角块均值
+typedef struct {
+    float mean;
+    float se;                       // 均值标准误差
+    uint32_t mid_ms;                // 块中点时间
+} TiltBlockMean;
+
+// 倾角分块平均
+typedef struct {
+    uint32_t start_ms;
+    uint32_t last_ms;               // 上一个样本时间
+    float interval_ms;              // 样本间隔（指数平均，采样频率可在运行时调整），0表示未知
+    uint32_t count;
+    double sum;
+    double sum_sq;
+    TiltBlockMean blocks[FORECAST_TILT_RATE_BLOCKS];    // 最近的块均值（环形）
+    uint16_t block_count;
+    uint16_t block_head;
+    int8_t direction;               // 最近显著倾斜速率的符号
+} TiltBlock;
+
+static bool g_forecast_initialized = false;
+static uint32_t g_forecast_mutex = 0;
+static InverseSeries g_series[FORECAST_SOURCE_COUNT];
+static TiltBlock g_tilt_block;      // 只由数据处理任务访问
+
+/**
+ * @brief 95%置信区间系数
+ */
+static float StudentT95(int dof)
+{
+    if (dof < 1) {
+        return 0.0f;
+    }
+    if (dof <= (int)(sizeof(g_t95) / sizeof(g_t95[0]))) {
+        return g_t95[dof - 1];
+    }
+    return 2.0f;
+}
+
+/**
+ * @brief 把点计入（sign=1）或移出（sign=-1）累加和
+ */
+static void Accumulate(InverseSeries *series, const InversePoint *point, double sign)
+{
+    double t = (double)(point->timestamp - series->ref_ms) / MS_PER_HOUR;
+    double y = point->inverse_velocity;
+
+    series->st += sign * t;
+    series->stt += sign * t * t;
+    series->sy += sign * y;
+    series->sty += sign * t * y;
+    series->syy += sign * y * y;
+}
+
+/**
+ * @brief 清空序列
+ */
+static void ClearSeries(InverseSeries *series)
+{
+    memset(series, 0, sizeof(InverseSeries));
+}
+
+/**
+ * @brief 以最旧点为时间零点重新计算累加和
+ */
+static void RebaseSeries(InverseSeries *series)
+{
+    uint16_t oldest = (series->head + FORECAST_WINDOW - series->count) % FORECAST_WINDOW;
+
+    series->ref_ms = series->points[oldest].timestamp;
+    series->st = series->stt = series->sy = series->sty = series->syy = 0;
+    for (uint16_t i = 0; i < series->count; i++) {
+        Accumulate(series, &series->points[(oldest + i) % FORECAST_WINDOW], 1.0);
+    }
+}
+
+/**
+ * @brief 追加反速度点（窗口满时移出最旧点）
+ */
+static void PushPoint(InverseSeries *series, uint32_t timestamp, float inverse_velocity)
+{
+    if (series->count == 0) {
+        series->ref_ms = timestamp;
+    }
+
+    if (series->count == FORECAST_WINDOW) {
+        Accumulate(series, &series->points[series->head], -1.0);
+        series->count--;
+    }
+
+    InversePoint *point = &series->points[series->head];
+    point->timestamp = timestamp;
+    point->inverse_velocity = inverse_velocity;
+    Accumulate(series, point, 1.0);
+    series->head = (series->head + 1) % FORECAST_WINDOW;
+    series->count++;
+
+    uint16_t oldest = (series->head + FORECAST_WINDOW - series->count) % FORECAST_WINDOW;
+    if ((double)(series->points[oldest].timestamp - series->ref_ms) / MS_PER_HOUR > REBASE_HOURS) {
+        RebaseSeries(series);
+    }
+}
+
+/**
+ * @brief 对反速度序列做线性拟合并外推到1/v=0
+ */
+static void FitSeries(const InverseSeries *series, ForecastSource source, FailureForecast *forecast)
+{
+    memset(forecast, 0, sizeof(FailureForecast));
+    forecast->source = (uint8_t)source;
+    forecast->samples = series->count;
+    forecast->velocity = series->last_velocity;
+    forecast->timestamp = series->now_ms;
+
+    if (series->count < FORECAST_MIN_SAMPLES) {
+        return;
+    }
+
+    double n = series->count;
+    double mean_t = series->st / n;
+    double mean_y = series->sy / n;
+    double stt = series->stt - n * mean_t * mean_t;
+    double sty = series->sty - n * mean_t * mean_y;
+    double syy = series->syy - n * mean_y * mean_y;
+    if (stt <= 0 || syy <= 0) {
+        return;
+    }
+
+    double slope = sty / stt;
+    double residual = syy - slope * sty;
+    if (residual < 0) {
+        residual = 0;
+    }
+    double sigma2 = residual / (n - 2);
+    double t_now = (double)(series->now_ms - series->ref_ms) / MS_PER_HOUR;
+    double y_now = mean_y + slope * (t_now - mean_t);
+    double se_slope = sqrt(sigma2 / stt);
+    double se_y = sqrt(sigma2 * (1.0 / n + (t_now - mean_t) * (t_now - mean_t) / stt));
+    float t95 = StudentT95(series->count - 2);
+
+    forecast->inverse_velocity = (float)y_now;
+    forecast->inverse_velocity_slope = (float)slope;
+
+    // 反速度须显著下降（斜率上限仍小于0）才认为处于加速蠕变阶段
+    if (slope + t95 * se_slope >= 0) {
+        return;
+    }
+
+    // 剩余时间 = 当前反速度 / 下降速率；下限取反速度下限与斜率最陡值
+    // 反速度下限不为正时置信区间含"已失稳"，下限无意义，标记为不确定而不是0小时
+    double ttf = (y_now > 0) ? y_now / -slope : 0;
+    double y_lower = y_now - t95 * se_y;
+    double ttf_lower = (y_lower > 0) ? y_lower / (-slope + t95 * se_slope) : -1.0;
+    if ((ttf_lower >= 0) ? ttf_lower > FORECAST_MAX_HORIZON_H : ttf > FORECAST_MAX_HORIZON_H) {
+        return;
+    }
+
+    forecast->time_to_failure_h = (float)((ttf < FORECAST_MAX_HORIZON_H) ? ttf : FORECAST_MAX_HORIZON_H);
+    forecast->time_to_failure_lower_h = (float)ttf_lower;
+    forecast->confidence = (float)(sty * sty / (stt * syy));
+    forecast->valid = true;
+}
+
+/**
+ * @brief 初始化失稳时间预测
+ */
+int Forecast_Init(void)
+{
+    if (g_forecast_initialized) {
+        return 0;
+    }
+
+    if (LOS_MuxCreate(&g_forecast_mutex) != LOS_OK) {
+        printf("Failed to create forecast mutex\n");
+        return -1;
+    }
+
+    memset(g_series, 0, sizeof(g_series));
+    memset(&g_tilt_block, 0, sizeof(g_tilt_block));
+    g_forecast_initialized = true;
+    printf("Failure forecast initialized (window %d points)\n", FORECAST_WINDOW);
+    return 0;
+}
+
+/**
+ * @brief 反初始化失稳时间预测
+ */
+void Forecast_Deinit(void)
+{
+    if (!g_forecast_initialized) {
+        return;
+    }
+
+    g_forecast_initialized = false;
+    LOS_MuxDelete(g_forecast_mutex);
+    g_forecast_mutex = 0;
+}
+
+/**
+ * @brief 输入一个速度观测
+ */
+void Forecast_AddVelocity(ForecastSource source, uint32_t timestamp, float velocity, float velocity_ci,
+                          uint32_t lag_ms)
+{
+    if (!g_forecast_initialized || source >= FORECAST_SOURCE_COUNT) {
+        return;
+    }
+
+    LOS_MuxPend(g_forecast_mutex, LOS_WAIT_FOREVER);
+    InverseSeries *series = &g_series[source];
+
+    series->last_velocity = velocity;
+    if (velocity > velocity_ci && velocity > 0) {
+        series->gap = 0;
+        series->now_ms = timestamp;
+        PushPoint(series, timestamp - lag_ms, 1.0f / velocity);
+    } else if (++series->gap > FORECAST_MAX_GAP) {
+        // 速度持续处于噪声水平，不在加速阶段
+        ClearSeries(series);
+    }
+
+    LOS_MuxPost(g_forecast_mutex);
+}
+
+/**
+ * @brief 输入一个倾角样本
+ */
+void Forecast_AddTiltSample(uint32_t timestamp, float angle)
+{
+    TiltBlock *block = &g_tilt_block;
+
+    if (!g_forecast_initialized) {
+        return;
+    }
+
+    uint32_t interval = timestamp - block->last_ms;
+    if (block->last_ms != 0 && interval > 0 && interval <= FORECAST_TILT_MAX_INTERVAL_MS) {
+        block->interval_ms = (block->interval_ms > 0) ?
+                             block->interval_ms + (interval - block->interval_ms) / 64.0f : (float)interval;
+    }
+    block->last_ms = timestamp;
+
+    if (block->count == 0) {
+        block->start_ms = timestamp;
+    }
+    block->sum += angle;
+    block->sum_sq += (double)angle * angle;
+    block->count++;
+
+    if (timestamp - block->start_ms < FORECAST_TILT_BLOCK_MS) {
+        return;
+    }
+
+    // 块结束：块均值及其标准误差（相邻样本相关，按每秒一个独立样本估计）
+    uint32_t mid_ms = block->start_ms + (timestamp - block->start_ms) / 2;
+    float expected = (block->interval_ms > 0) ? (timestamp - block->start_ms) / block->interval_ms : 0.0f;
+    bool usable = expected > 0 && block->count >= expected * FORECAST_TILT_MIN_FILL;
+    float mean = (float)(block->sum / block->count);
+    double variance = block->sum_sq / block->count - (double)mean * mean;
+    float independent = (timestamp - block->start_ms) / 1000.0f;
+    if (independent > block->count) {
+        independent = block->count;
+    }
+    float se = sqrtf((float)((variance > 0) ? variance : 0) / independent);
+    if (se < FORECAST_TILT_RESOLUTION) {
+        se = FORECAST_TILT_RESOLUTION;
+    }
+
+    block->count = 0;
+    block->sum = 0;
+    block->sum_sq = 0;
+    if (!usable) {
+        // 数据中断，差分跨度不再可靠
+        block->block_count = 0;
+        block->direction = 0;
+        return;
+    }
+
+    // 环形缓冲已满时，block_head处即为FORECAST_TILT_RATE_BLOCKS块前的均值
+    TiltBlockMean *slot = &block->blocks[block->block_head];
+    if (block->block_count == FORECAST_TILT_RATE_BLOCKS) {
+        float hours = (float)((mid_ms - slot->mid_ms) / MS_PER_HOUR);
+        float rate = (mean - slot->mean) / hours;
+        float rate_ci = 1.96f * sqrtf(se * se + slot->se * slot->se) / hours;
+
+        if (fabsf(rate) > rate_ci) {
+            int8_t direction = (rate > 0) ? 1 : -1;
+            if (block->direction != 0 && direction != block->direction) {
+                LOS_MuxPend(g_forecast_mutex, LOS_WAIT_FOREVER);
+                ClearSeries(&g_series[FORECAST_SOURCE_TILT]);
+                LOS_MuxPost(g_forecast_mutex);
+            }
+            block->direction = direction;
+        }
+
+        // 速率对应两块中点的中间时刻
+        uint32_t rate_ms = slot->mid_ms + (mid_ms - slot->mid_ms) / 2;
+        Forecast_AddVelocity(FORECAST_SOURCE_TILT, timestamp, fabsf(rate), rate_ci, timestamp - rate_ms);
+    } else {
+        block->block_count++;
+    }
+
+    slot->mean = mean;
+    slot->se = se;
+    slot->mid_ms = mid_ms;
+    block->block_head = (block->block_head + 1) % FORECAST_TILT_RATE_BLOCKS;
+}
+
+/**
+ * @brief 获取指定数据源的预测
+ */
+int Forecast_Get(ForecastSource source, FailureForecast *forecast)
+{
+    if (!g_forecast_initialized || forecast == NULL || source >= FORECAST_SOURCE_COUNT) {
+        return -1;
+    }
+
+    LOS_MuxPend(g_forecast_mutex, LOS_WAIT_FOREVER);
+    FitSeries(&g_series[source], source, forecast);
+    LOS_MuxPost(g_forecast_mutex);
+    return 0;
+}
+
+/**
+ * @brief 获取最紧迫的预测
+ */
+int Forecast_GetMostUrgent(FailureForecast *forecast)
+{
+    if (!g_forecast_initialized || forecast == NULL) {
+        return -1;
+    }
+
+    memset(forecast, 0, sizeof(FailureForecast));
+    for (int i = 0; i < FORECAST_SOURCE_COUNT; i++) {
+        FailureForecast candidate;
+        Forecast_Get((ForecastSource)i, &candidate);
+        if (!candidate.valid || candidate.confidence < FORECAST_MIN_CONFIDENCE) {
+            continue;
+        }
+        // 先比较升级等级，同级时比较剩余时间（下限不确定时只有点估计可比）
+        ForecastLevel level = Forecast_GetLevel(&candidate);
+        ForecastLevel current = Forecast_GetLevel(forecast);
+        if (!forecast->valid || level > current ||
+            (level == current && candidate.time_to_failure_h < forecast->time_to_failure_h)) {
+            *forecast = candidate;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief 根据预测结果给出风险升级等级
+ */
+ForecastLevel Forecast_GetLevel(const FailureForecast *forecast)
+{
+    if (forecast == NULL || !forecast->valid || forecast->confidence < FORECAST_MIN_CONFIDENCE) {
+        return FORECAST_LEVEL_NONE;
+    }
+
+    // 下限不确定时只按点估计提示关注，不据此升级到高风险以上
+    if (forecast->time_to_failure_lower_h < 0) {
+        return (forecast->time_to_failure_h < FORECAST_MEDIUM_H) ? FORECAST_LEVEL_MEDIUM : FORECAST_LEVEL_NONE;
+    }
+
+    if (forecast->time_to_failure_lower_h < FORECAST_CRITICAL_H) {
+        return FORECAST_LEVEL_CRITICAL;
+    } else if (forecast->time_to_failure_lower_h < FORECAST_HIGH_H) {
+        return FORECAST_LEVEL_HIGH;
+    } else if (forecast->time_to_failure_lower_h < FORECAST_MEDIUM_H) {
+        return FORECAST_LEVEL_MEDIUM;
+    }
+    return FORECAST_LEVEL_NONE;
+}
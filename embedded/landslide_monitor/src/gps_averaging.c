@@ -0,0 +1,227 @@
+#include "gps_averaging.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/**
+ * @brief int32比较函数（qsort使用）
+ */
+static int CompareInt32(const void *a, const void *b)
+{
+    int32_t x = *(const int32_t *)a;
+    int32_t y = *(const int32_t *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief 对scratch中的n个值排序并返回中位数
+ */
+static float SortedMedian(int32_t *values, uint16_t n)
+{
+    qsort(values, n, sizeof(int32_t), CompareInt32);
+    if (n & 1) {
+        return values[n / 2];
+    }
+    return ((float)values[n / 2 - 1] + (float)values[n / 2]) / 2.0f;
+}
+
+/**
+ * @brief 读取历元的某个坐标分量
+ */
+static int16_t EpochAxis(const GpsAvgEpoch *epoch, int axis)
+{
+    return (axis == 0) ? epoch->east : (axis == 1) ? epoch->north : epoch->up;
+}
+
+/**
+ * @brief 以当前历元为原点开始新时段
+ */
+static void StartSession(GpsAverager *avg, double latitude, double longitude, float altitude, uint32_t timestamp)
+{
+    GpsEnu_InitFrame(&avg->frame, latitude, longitude, altitude);
+    avg->start_time = timestamp;
+    avg->last_time = timestamp;
+    avg->count = 0;
+    avg->received = 0;
+    avg->stride = 1;
+    avg->active = true;
+}
+
+/**
+ * @brief 结束时段：按中位数/MAD联合剔除粗差后求均值
+ * @return true: 输出有效坐标, false: 历元不足
+ */
+static bool FinishSession(GpsAverager *avg, GpsAvgSolution *solution)
+{
+    float median[3];
+    float bound[3];
+    double sum[3] = {0};
+    double sum_sq[3] = {0};
+    uint16_t used = 0;
+
+    memset(solution, 0, sizeof(GpsAvgSolution));
+    solution->epochs_total = avg->received;
+    solution->start_time = avg->start_time;
+    solution->end_time = avg->last_time;
+    avg->active = false;
+
+    if (avg->count < GPS_AVG_MIN_EPOCHS) {
+        avg->discarded_sessions++;
+        return false;
+    }
+
+    // 各分量的中位数和MAD（中位数绝对偏差）
+    for (int axis = 0; axis < 3; axis++) {
+        for (uint16_t i = 0; i < avg->count; i++) {
+            avg->scratch[i] = EpochAxis(&avg->epochs[i], axis);
+        }
+        median[axis] = SortedMedian(avg->scratch, avg->count);
+
+        for (uint16_t i = 0; i < avg->count; i++) {
+            avg->scratch[i] = (int32_t)fabsf(avg->scratch[i] - median[axis]);
+        }
+        float mad = SortedMedian(avg->scratch, avg->count);
+        bound[axis] = GPS_AVG_OUTLIER_K * 1.4826f * mad;
+        if (bound[axis] < GPS_AVG_OUTLIER_FLOOR_MM) {
+            bound[axis] = GPS_AVG_OUTLIER_FLOOR_MM;
+        }
+    }
+
+    // 任一分量超限即整个历元剔除
+    for (uint16_t i = 0; i < avg->count; i++) {
+        const GpsAvgEpoch *epoch = &avg->epochs[i];
+        bool inlier = true;
+
+        for (int axis = 0; axis < 3; axis++) {
+            if (fabsf(EpochAxis(epoch, axis) - median[axis]) > bound[axis]) {
+                inlier = false;
+                break;
+            }
+        }
+        if (!inlier) {
+            continue;
+        }
+
+        for (int axis = 0; axis < 3; axis++) {
+            double v = EpochAxis(epoch, axis);
+            sum[axis] += v;
+            sum_sq[axis] += v * v;
+        }
+        used++;
+    }
+
+    avg->outliers += avg->count - used;
+    if (used < GPS_AVG_MIN_EPOCHS) {
+        avg->discarded_sessions++;
+        return false;
+    }
+
+    double mean[3];
+    double variance[3];
+    for (int axis = 0; axis < 3; axis++) {
+        mean[axis] = sum[axis] / used;
+        variance[axis] = sum_sq[axis] / used - mean[axis] * mean[axis];
+        if (variance[axis] < 0) {
+            variance[axis] = 0;
+        }
+    }
+
+    // GNSS误差在分钟尺度上相关，独立样本数按相关时间估计，避免高估精度
+    float independent = (float)(avg->last_time - avg->start_time) / 1000.0f / GPS_AVG_CORRELATION_S;
+    if (independent > used) {
+        independent = used;
+    }
+    if (independent < 1.0f) {
+        independent = 1.0f;
+    }
+
+    GpsEnuVector position = {
+        .east = (float)(mean[0] / 1000.0),
+        .north = (float)(mean[1] / 1000.0),
+        .up = (float)(mean[2] / 1000.0)
+    };
+    GpsEnu_ToGeodetic(&avg->frame, &position, &solution->latitude, &solution->longitude, &solution->altitude);
+    solution->sigma_h = sqrtf((float)(variance[0] + variance[1]) / independent) / 1000.0f;
+    solution->sigma_v = sqrtf((float)variance[2] / independent) / 1000.0f;
+    solution->median_offset = hypotf(median[0] - (float)mean[0], median[1] - (float)mean[1]) / 1000.0f;
+    solution->epochs_used = used;
+    solution->valid = true;
+
+    avg->sessions++;
+    return true;
+}
+
+/**
+ * @brief 初始化平均器
+ */
+void GpsAvg_Init(GpsAverager *avg, uint32_t session_ms)
+{
+    memset(avg, 0, sizeof(GpsAverager));
+    avg->session_ms = session_ms;
+    avg->stride = 1;
+}
+
+/**
+ * @brief 丢弃当前时段
+ */
+void GpsAvg_Reset(GpsAverager *avg)
+{
+    avg->active = false;
+    avg->count = 0;
+    avg->received = 0;
+    avg->stride = 1;
+}
+
+/**
+ * @brief 输入一个历元
+ */
+int GpsAvg_AddEpoch(GpsAverager *avg, double latitude, double longitude, float altitude,
+                    uint32_t timestamp, GpsAvgSolution *solution)
+{
+    int result = 0;
+
+    // 无UTC时间时采集任务每个采样周期都会送入缓存的同一定位结果，只计一次
+    if (avg->last_input_time != 0 && timestamp == avg->last_input_time) {
+        avg->duplicates++;
+        return -2;
+    }
+    avg->last_input_time = timestamp;
+
+    if (avg->active && timestamp - avg->start_time >= avg->session_ms) {
+        result = FinishSession(avg, solution) ? 1 : 0;
+    }
+    if (!avg->active) {
+        StartSession(avg, latitude, longitude, altitude, timestamp);
+    }
+
+    GpsEnuVector offset;
+    GpsEnu_FromGeodetic(&avg->frame, latitude, longitude, altitude, &offset);
+
+    if (fabsf(offset.east) > GPS_AVG_MAX_OFFSET_M || fabsf(offset.north) > GPS_AVG_MAX_OFFSET_M ||
+        fabsf(offset.up) > GPS_AVG_MAX_OFFSET_M) {
+        avg->outliers++;
+        return (result == 1) ? 1 : -1;
+    }
+
+    avg->last_time = timestamp;
+    uint32_t index = avg->received++;
+
+    // 缓冲区满时丢弃奇数位置的历元并加倍步长，保持时段内均匀采样
+    if (index % avg->stride == 0 && avg->count == GPS_AVG_MAX_EPOCHS) {
+        for (uint16_t i = 0; i < GPS_AVG_MAX_EPOCHS / 2; i++) {
+            avg->epochs[i] = avg->epochs[i * 2];
+        }
+        avg->count = GPS_AVG_MAX_EPOCHS / 2;
+        avg->stride *= 2;
+    }
+    if (index % avg->stride != 0) {
+        return result;
+    }
+
+    GpsAvgEpoch *epoch = &avg->epochs[avg->count++];
+    epoch->east = (int16_t)lroundf(offset.east * 1000.0f);
+    epoch->north = (int16_t)lroundf(offset.north * 1000.0f);
+    epoch->up = (int16_t)lroundf(offset.up * 1000.0f);
+
+    return result;
+}
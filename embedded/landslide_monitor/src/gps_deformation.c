@@ -1,5 +1,10 @@
 #include "gps_deformation.h"
+#include "kv_store.h"
+#include "gps_averaging.h"
+#include "gps_trend.h"
+#include "failure_forecast.h"
 #include "los_memory.h"
+#include "los_mux.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -14,13 +19,53 @@
 
 // GPS形变监测全局变量
 static bool g_deform_initialized = false;
+static uint32_t g_deform_mutex = 0;                                // 保护历史、基准和分析结果（采集任务写入，网络任务导出）
 static GPSPositionRecord g_position_history[GPS_DEFORM_HISTORY_SIZE];
 static uint16_t g_history_count = 0;
 static uint16_t g_history_index = 0;
+static uint32_t g_history_sequence = 0;                            // 下一条历史记录的序号（导出游标使用）
+
+// 历史记录的导出附加信息（与g_position_history同下标）
+typedef struct {
+    uint32_t utc_seconds;
+    uint16_t flags;
+} HistoryMeta;
+
+static HistoryMeta g_history_meta[GPS_DEFORM_HISTORY_SIZE];
 static GPSPositionRecord g_baseline_position = {0};
+static GpsEnuFrame g_baseline_frame;                               // 以基准位置为原点的站心坐标系
 static bool g_baseline_established = false;
 static GPSDeformationAnalysis g_current_analysis = {0};
 static DeformationStats g_deform_stats = {0};
+static float g_alert_distance = GPS_DEFORM_ALERT_DISTANCE;        // 位移警报阈值（可由云端配置）
+static float g_critical_distance = GPS_DEFORM_CRITICAL_DISTANCE;  // 位移危险阈值（可由云端配置）
+static GpsAverager g_averager;                                     // 静态历元平均（单历元噪声为米级）
+static GpsAvgSolution g_last_solution = {0};
+static GpsTrend g_trend;                                           // 位置-时间最小二乘拟合
+static bool g_session_differential = false;                        // 当前平均时段历元的模式
+
+// Flash保存的时段平均坐标（相对基准的站心坐标）
+typedef struct {
+    int32_t east;                   // 东向 (mm)
+    int32_t north;                  // 北向 (mm)
+    int32_t up;                     // 天向 (mm)
+    uint32_t utc_seconds;           // 时段结束UTC时间（0表示未知）
+    uint16_t sigma_h;               // 水平标准误差 (mm)
+    uint16_t reserved;
+} StoredSolution;
+
+// Flash保存的形变历史（KV_KEY_GPS_HISTORY，每个时段平均坐标更新一次）
+typedef struct {
+    double baseline_latitude;       // 所属基准，与已保存基准不一致时丢弃
+    double baseline_longitude;
+    uint32_t baseline_utc;          // 基准建立UTC时间（0表示未知）
+    uint16_t count;
+    uint16_t reserved;
+    StoredSolution solutions[GPS_DEFORM_PERSIST_SIZE];
+} StoredHistory;
+
+static StoredHistory g_stored_history;
+static uint16_t g_restore_pending = 0;                              // 尚未对齐到本次启动时间轴的恢复坐标数
 
 // 内部函数声明
 static float CalculateHaversineDistance(double lat1, double lon1, double lat2, double lon2);
@@ -29,6 +74,8 @@ static void UpdateDeformationStats(const DisplacementVector *displacement);
 static DeformationRisk AssessDeformationRisk(const DisplacementVector *displacement, const DeformationVelocity *velocity);
 static DeformationType ClassifyDeformationType(const DisplacementVector *displacement);
 static void CalculateVelocity(DeformationVelocity *velocity);
+static void SetBaselineRecord(const GPSPositionRecord *record, uint32_t utc_seconds);
+static void RestoreHistory(void);
 
 /**
  * @brief 初始化GPS形变监测
@@ -41,6 +88,11 @@ int GPS_Deformation_Init(void)
     }
     
     printf("Initializing GPS deformation monitoring...\n");
+
+    if (LOS_MuxCreate(&g_deform_mutex) != LOS_OK) {
+        printf("Failed to create GPS deformation mutex\n");
+        return -1;
+    }
     
     // 初始化数据结构
     memset(g_position_history, 0, sizeof(g_position_history));
@@ -50,7 +102,28 @@ int GPS_Deformation_Init(void)
     
     g_history_count = 0;
     g_history_index = 0;
+    g_history_sequence = 0;
     g_baseline_established = false;
+    GpsAvg_Init(&g_averager, GPS_AVG_SESSION_MS);
+    g_session_differential = false;
+    memset(&g_last_solution, 0, sizeof(g_last_solution));
+    GpsTrend_Init(&g_trend);
+
+    // 恢复已保存的基准位置，避免重启后以当前（可能已位移的）位置作为新基准
+    if (KvStore_Get(KV_KEY_GPS_BASELINE, &g_baseline_position, sizeof(g_baseline_position)) == 0 &&
+        g_baseline_position.valid) {
+        // 时间戳为上次运行的系统tick，重启后从0计时
+        g_baseline_position.timestamp = 0;
+        g_baseline_established = true;
+        GpsEnu_InitFrame(&g_baseline_frame, g_baseline_position.latitude, g_baseline_position.longitude,
+                         g_baseline_position.altitude);
+        printf("GPS baseline restored: %.6f°, %.6f°, %.1fm (%s)\n",
+               g_baseline_position.latitude, g_baseline_position.longitude, g_baseline_position.altitude,
+               g_baseline_position.differential ? "differential" : "single point");
+        RestoreHistory();
+    } else {
+        memset(&g_baseline_position, 0, sizeof(g_baseline_position));
+    }
     
     g_deform_initialized = true;
     printf("GPS deformation monitoring initialized successfully\n");
@@ -69,119 +142,140 @@ void GPS_Deformation_Deinit(void)
     
     printf("Deinitializing GPS deformation monitoring...\n");
     g_deform_initialized = false;
+    LOS_MuxDelete(g_deform_mutex);
+    g_deform_mutex = 0;
     printf("GPS deformation monitoring deinitialized\n");
 }
 
 /**
- * @brief 设置基准位置
+ * @brief 检查定位历元质量（精度、3D定位、卫星数、PDOP）
  */
-int GPS_Deformation_SetBaseline(const GPSData *gps_data)
+static bool IsEpochUsable(const GPSData *gps_data)
 {
-    if (!g_deform_initialized || !gps_data || !gps_data->valid) {
-        return -1;
-    }
-    
-    // 检查GPS精度
     if (gps_data->accuracy > GPS_DEFORM_MIN_ACCURACY) {
-        printf("GPS accuracy too low for baseline: %.1fm (required: %.1fm)\n", 
-               gps_data->accuracy, GPS_DEFORM_MIN_ACCURACY);
-        return -2;
+        return false;
     }
-    
-    // 设置基准位置
-    g_baseline_position.latitude = gps_data->latitude;
-    g_baseline_position.longitude = gps_data->longitude;
-    g_baseline_position.altitude = gps_data->altitude;
-    g_baseline_position.accuracy = gps_data->accuracy;
-    g_baseline_position.timestamp = gps_data->last_update_time;
-    g_baseline_position.valid = true;
-    
+    // 以下质量信息来自GSA，接收机未输出时为0，不作限制
+    if (gps_data->fix_type != 0 && gps_data->fix_type < 3) {
+        return false;       // 2D定位高程不可信
+    }
+    if (gps_data->satellites_used != 0 && gps_data->satellites_used < GPS_DEFORM_MIN_SATELLITES) {
+        return false;
+    }
+    if (gps_data->pdop > GPS_DEFORM_MAX_PDOP) {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 设置基准位置并保存
+ */
+static void SetBaselineRecord(const GPSPositionRecord *record, uint32_t utc_seconds)
+{
+    g_baseline_position = *record;
     g_baseline_established = true;
+    GpsEnu_InitFrame(&g_baseline_frame, record->latitude, record->longitude, record->altitude);
+    GpsTrend_Init(&g_trend);    // 旧样本相对旧基准，不再可比
+    g_restore_pending = 0;
+
+    if (KvStore_Set(KV_KEY_GPS_BASELINE, &g_baseline_position, sizeof(g_baseline_position)) != 0) {
+        printf("Failed to save GPS baseline\n");
+    }
+
+    // 已保存的历史坐标相对旧基准
+    memset(&g_stored_history, 0, sizeof(g_stored_history));
+    g_stored_history.baseline_latitude = record->latitude;
+    g_stored_history.baseline_longitude = record->longitude;
+    g_stored_history.baseline_utc = utc_seconds;
+    KvStore_Delete(KV_KEY_GPS_HISTORY);
     
-    // 重置统计信息
-    memset(&g_deform_stats, 0, sizeof(g_deform_stats));
+    // 重置位移统计（保留历元和时段计数）
+    g_deform_stats.max_displacement = 0;
+    g_deform_stats.total_displacement = 0;
+    g_deform_stats.avg_velocity = 0;
+    g_deform_stats.max_velocity = 0;
+    g_deform_stats.alert_count = 0;
     g_deform_stats.monitoring_duration = 0;
+    g_deform_stats.dominant_type = DEFORM_TYPE_NONE;
     
-    printf("GPS baseline established: %.6f°, %.6f°, %.1fm (accuracy: %.1fm)\n",
+    printf("GPS baseline established: %.7f°, %.7f°, %.2fm (accuracy: %.2fm, %s)\n",
            g_baseline_position.latitude, g_baseline_position.longitude,
-           g_baseline_position.altitude, g_baseline_position.accuracy);
-    
-    return 0;
+           g_baseline_position.altitude, g_baseline_position.accuracy,
+           g_baseline_position.differential ? "differential" : "single point");
 }
 
 /**
- * @brief 添加GPS位置数据进行形变分析
+ * @brief 追加历史记录
  */
-int GPS_Deformation_AddPosition(const GPSData *gps_data)
+static void AddHistory(const GPSPositionRecord *record, uint32_t utc_seconds, uint16_t flags)
 {
-    if (!g_deform_initialized || !gps_data || !gps_data->valid) {
-        return -1;
-    }
-    
-    // 检查GPS精度
-    if (gps_data->accuracy > GPS_DEFORM_MIN_ACCURACY) {
-        return -2;
-    }
-    
-    // 如果没有基准位置，自动设置第一个有效位置为基准
-    if (!g_baseline_established) {
-        return GPS_Deformation_SetBaseline(gps_data);
-    }
-    
-    // 添加到历史记录
-    GPSPositionRecord *record = &g_position_history[g_history_index];
-    record->latitude = gps_data->latitude;
-    record->longitude = gps_data->longitude;
-    record->altitude = gps_data->altitude;
-    record->accuracy = gps_data->accuracy;
-    record->timestamp = gps_data->last_update_time;
-    record->valid = true;
-    
-    // 更新索引
+    g_position_history[g_history_index] = *record;
+    g_history_meta[g_history_index].utc_seconds = utc_seconds;
+    g_history_meta[g_history_index].flags = flags | (record->differential ? GPS_EXPORT_FLAG_DIFFERENTIAL : 0);
+    g_history_sequence++;
     g_history_index = (g_history_index + 1) % GPS_DEFORM_HISTORY_SIZE;
     if (g_history_count < GPS_DEFORM_HISTORY_SIZE) {
         g_history_count++;
     }
+}
+
+/**
+ * @brief 计算相对基准的位移（投影到基准站心坐标系，分量直接以米表示）
+ */
+static void ComputeDisplacement(const GPSPositionRecord *record, uint32_t utc_seconds,
+                                GpsEnuVector *enu, DisplacementVector *displacement)
+{
+    GpsEnu_FromGeodetic(&g_baseline_frame, record->latitude, record->longitude, record->altitude, enu);
+
+    memset(displacement, 0, sizeof(DisplacementVector));
+    displacement->east = enu->east;
+    displacement->north = enu->north;
+    displacement->up = enu->up;
+    displacement->horizontal_distance = sqrtf(enu->east * enu->east + enu->north * enu->north);
+    displacement->vertical_distance = enu->up;
+    displacement->distance_2d = displacement->horizontal_distance;
+    displacement->distance_3d = sqrtf(displacement->horizontal_distance * displacement->horizontal_distance +
+                                      displacement->vertical_distance * displacement->vertical_distance);
     
-    // 计算位移
-    DisplacementVector displacement = {0};
-    displacement.horizontal_distance = CalculateHaversineDistance(
-        g_baseline_position.latitude, g_baseline_position.longitude,
-        gps_data->latitude, gps_data->longitude);
-    
-    displacement.vertical_distance = gps_data->altitude - g_baseline_position.altitude;
-    displacement.distance_2d = displacement.horizontal_distance;
-    displacement.distance_3d = sqrtf(displacement.horizontal_distance * displacement.horizontal_distance +
-                                   displacement.vertical_distance * displacement.vertical_distance);
-    
-    displacement.bearing = CalculateBearing(
-        g_baseline_position.latitude, g_baseline_position.longitude,
-        gps_data->latitude, gps_data->longitude);
-    
-    if (displacement.horizontal_distance > 0) {
-        displacement.elevation_angle = atanf(displacement.vertical_distance / displacement.horizontal_distance) * 180.0f / M_PI;
+    if (displacement->horizontal_distance > 0) {
+        displacement->bearing = atan2f(enu->east, enu->north) * 180.0f / M_PI;
+        if (displacement->bearing < 0) {
+            displacement->bearing += 360.0f;
+        }
     }
     
-    displacement.time_span = (gps_data->last_update_time - g_baseline_position.timestamp) / 1000; // 转换为秒
-    
-    // 计算速度
-    DeformationVelocity velocity = {0};
-    CalculateVelocity(&velocity);
+    if (displacement->horizontal_distance > 0) {
+        displacement->elevation_angle = atanf(displacement->vertical_distance / displacement->horizontal_distance) * 180.0f / M_PI;
+    }
     
-    // 更新分析结果
+    // 跨重启的时间跨度以UTC计算，UTC未知时退回系统tick
+    if (utc_seconds != 0 && g_stored_history.baseline_utc != 0 && utc_seconds >= g_stored_history.baseline_utc) {
+        displacement->time_span = utc_seconds - g_stored_history.baseline_utc;
+    } else {
+        displacement->time_span = (record->timestamp - g_baseline_position.timestamp) / 1000; // 转换为秒
+    }
+}
+
+/**
+ * @brief 由位移和速度更新形变分析结果
+ */
+static void UpdateAnalysis(const GPSPositionRecord *record, const DisplacementVector *displacement,
+                           const DeformationVelocity *velocity)
+{
     g_current_analysis.baseline_position = g_baseline_position;
     g_current_analysis.current_position = *record;
-    g_current_analysis.displacement = displacement;
-    g_current_analysis.velocity = velocity;
-    g_current_analysis.risk_level = AssessDeformationRisk(&displacement, &velocity);
-    g_current_analysis.deform_type = ClassifyDeformationType(&displacement);
+    g_current_analysis.displacement = *displacement;
+    g_current_analysis.velocity = *velocity;
+    g_current_analysis.risk_level = AssessDeformationRisk(displacement, velocity);
+    g_current_analysis.deform_type = ClassifyDeformationType(displacement);
     g_current_analysis.baseline_established = true;
     g_current_analysis.analysis_valid = true;
-    g_current_analysis.analysis_timestamp = gps_data->last_update_time;
+    g_current_analysis.analysis_timestamp = record->timestamp;
     
-    // 计算置信度
-    float accuracy_factor = 1.0f - (gps_data->accuracy / GPS_DEFORM_MIN_ACCURACY);
-    float time_factor = (displacement.time_span > 300) ? 1.0f : (displacement.time_span / 300.0f); // 5分钟后达到满置信度
+    // 计算置信度（平均坐标的标准误差远小于单历元精度）
+    float accuracy_factor = 1.0f - (record->accuracy / GPS_DEFORM_MIN_ACCURACY);
+    float time_factor = (displacement->time_span > 300) ? 1.0f : (displacement->time_span / 300.0f); // 5分钟后达到满置信度
     g_current_analysis.confidence = accuracy_factor * time_factor;
     if (g_current_analysis.confidence > 1.0f) g_current_analysis.confidence = 1.0f;
     if (g_current_analysis.confidence < 0.0f) g_current_analysis.confidence = 0.0f;
@@ -190,40 +284,294 @@ int GPS_Deformation_AddPosition(const GPSData *gps_data)
     switch (g_current_analysis.risk_level) {
         case DEFORM_RISK_CRITICAL:
             snprintf(g_current_analysis.description, sizeof(g_current_analysis.description),
-                     "Critical deformation: %.1fm", displacement.distance_3d);
+                     "Critical deformation: %.2fm", displacement->distance_3d);
             break;
         case DEFORM_RISK_HIGH:
             snprintf(g_current_analysis.description, sizeof(g_current_analysis.description),
-                     "High deformation risk: %.1fm", displacement.distance_3d);
+                     "High deformation risk: %.2fm", displacement->distance_3d);
             break;
         case DEFORM_RISK_MEDIUM:
             snprintf(g_current_analysis.description, sizeof(g_current_analysis.description),
-                     "Medium deformation: %.1fm", displacement.distance_3d);
+                     "Medium deformation: %.2fm", displacement->distance_3d);
             break;
         case DEFORM_RISK_LOW:
             snprintf(g_current_analysis.description, sizeof(g_current_analysis.description),
-                     "Low deformation: %.1fm", displacement.distance_3d);
+                     "Low deformation: %.2fm", displacement->distance_3d);
             break;
         default:
             snprintf(g_current_analysis.description, sizeof(g_current_analysis.description),
-                     "Stable position: %.1fm", displacement.distance_3d);
+                     "Stable position: %.2fm", displacement->distance_3d);
             break;
     }
     
     // 更新统计信息
-    UpdateDeformationStats(&displacement);
+    UpdateDeformationStats(displacement);
+}
+
+/**
+ * @brief 追加时段平均坐标到Flash历史（保留最近GPS_DEFORM_PERSIST_SIZE个）
+ */
+static void PersistSolution(const GpsEnuVector *enu, float sigma_h, uint32_t utc_seconds)
+{
+    StoredHistory *history = &g_stored_history;
+
+    if (history->count == GPS_DEFORM_PERSIST_SIZE) {
+        memmove(&history->solutions[0], &history->solutions[1],
+                (GPS_DEFORM_PERSIST_SIZE - 1) * sizeof(StoredSolution));
+        history->count--;
+    }
+
+    StoredSolution *stored = &history->solutions[history->count++];
+    stored->east = (int32_t)lroundf(enu->east * 1000.0f);
+    stored->north = (int32_t)lroundf(enu->north * 1000.0f);
+    stored->up = (int32_t)lroundf(enu->up * 1000.0f);
+    stored->utc_seconds = utc_seconds;
+    stored->sigma_h = (uint16_t)((sigma_h * 1000.0f < 65535.0f) ? lroundf(sigma_h * 1000.0f) : 65535);
+    stored->reserved = 0;
+
+    if (KvStore_Set(KV_KEY_GPS_HISTORY, history, sizeof(StoredHistory)) != 0) {
+        printf("Failed to save GPS deformation history\n");
+    }
+}
+
+/**
+ * @brief 已保存坐标转换为历史记录（时间戳在对齐前为0）
+ */
+static void StoredToRecord(const StoredSolution *stored, GPSPositionRecord *record)
+{
+    GpsEnuVector enu = {stored->east / 1000.0f, stored->north / 1000.0f, stored->up / 1000.0f};
+
+    memset(record, 0, sizeof(GPSPositionRecord));
+    GpsEnu_ToGeodetic(&g_baseline_frame, &enu, &record->latitude, &record->longitude, &record->altitude);
+    record->accuracy = stored->sigma_h / 1000.0f;
+    record->valid = true;
+    record->differential = g_baseline_position.differential;     // 保存的坐标与基准同一模式
+}
+
+/**
+ * @brief 从Flash恢复最近的时段平均坐标，并以最新坐标立即恢复位移分析
+ * @note 需在基准恢复之后调用；速度拟合要等到本次启动第一个带UTC的时段坐标才能对齐时间轴
+ */
+static void RestoreHistory(void)
+{
+    StoredHistory *history = &g_stored_history;
+
+    if (KvStore_Get(KV_KEY_GPS_HISTORY, history, sizeof(StoredHistory)) != 0 ||
+        history->count > GPS_DEFORM_PERSIST_SIZE ||
+        history->baseline_latitude != g_baseline_position.latitude ||
+        history->baseline_longitude != g_baseline_position.longitude) {
+        // 无历史或不属于当前基准（旧版本只保存了基准）
+        memset(history, 0, sizeof(StoredHistory));
+        history->baseline_latitude = g_baseline_position.latitude;
+        history->baseline_longitude = g_baseline_position.longitude;
+        return;
+    }
+
+    GPSPositionRecord record;
+    for (uint16_t i = 0; i < history->count; i++) {
+        StoredToRecord(&history->solutions[i], &record);
+        AddHistory(&record, history->solutions[i].utc_seconds, GPS_EXPORT_FLAG_RESTORED);
+    }
+    g_restore_pending = history->count;
+    g_deform_stats.restored_solutions = history->count;
+
+    if (history->count > 0) {
+        const StoredSolution *latest = &history->solutions[history->count - 1];
+        GpsEnuVector enu;
+        DisplacementVector displacement;
+        DeformationVelocity velocity = {0};
+
+        StoredToRecord(latest, &record);
+        ComputeDisplacement(&record, latest->utc_seconds, &enu, &displacement);
+        UpdateAnalysis(&record, &displacement, &velocity);
+        printf("GPS deformation history restored: %d solutions, latest %.3fm (E:%.3fm N:%.3fm U:%.3fm)\n",
+               history->count, displacement.distance_3d, displacement.east, displacement.north, displacement.up);
+    }
+}
+
+/**
+ * @brief 把恢复的坐标按UTC差映射到本次启动的tick时间轴，重建趋势拟合
+ * @param tick 本次启动第一个时段坐标的结束tick
+ * @param utc_seconds 对应的UTC时间（0表示未知，此时放弃重建）
+ */
+static void AlignRestoredHistory(uint32_t tick, uint32_t utc_seconds)
+{
+    uint16_t aligned = 0;
+
+    for (uint16_t i = 0; i < g_restore_pending && utc_seconds != 0; i++) {
+        const StoredSolution *stored = &g_stored_history.solutions[i];
+        if (stored->utc_seconds == 0 || stored->utc_seconds > utc_seconds ||
+            utc_seconds - stored->utc_seconds > GPS_DEFORM_RESTORE_MAX_AGE_S) {
+            continue;
+        }
+
+        uint32_t restored_tick = tick - (utc_seconds - stored->utc_seconds) * 1000;
+        GpsEnuVector enu = {stored->east / 1000.0f, stored->north / 1000.0f, stored->up / 1000.0f};
+        GpsTrend_Add(&g_trend, restored_tick, &enu);
+        g_position_history[i].timestamp = restored_tick;    // 恢复时从下标0依次写入
+        aligned++;
+    }
+
+    printf("GPS deformation history aligned: %d/%d restored solutions used for velocity\n",
+           aligned, g_restore_pending);
+    g_restore_pending = 0;
+}
+
+/**
+ * @brief 以时段平均坐标更新历史记录和形变分析
+ */
+static void AnalyzeSolution(const GPSPositionRecord *record, uint32_t utc_seconds, float sigma_h)
+{
+    AddHistory(record, utc_seconds, 0);
+
+    GpsEnuVector enu;
+    DisplacementVector displacement;
+    ComputeDisplacement(record, utc_seconds, &enu, &displacement);
+    GpsTrend_Add(&g_trend, record->timestamp, &enu);
+    PersistSolution(&enu, sigma_h, utc_seconds);
+    
+    // 计算速度
+    DeformationVelocity velocity = {0};
+    CalculateVelocity(&velocity);
+
+    // 反速度失稳预测（拟合速度对应短窗口中点）
+    Forecast_AddVelocity(FORECAST_SOURCE_GNSS, record->timestamp, velocity.total_velocity, velocity.velocity_ci,
+                         (uint32_t)(velocity.short_term.span_hours * 1800000.0f));
+    
+    UpdateAnalysis(record, &displacement, &velocity);
     
     // 打印形变信息
     if (displacement.distance_3d > 1.0f) {
-        printf("GPS Deformation: %.1fm (H:%.1fm V:%.1fm) Risk:%d Type:%d\n",
+        printf("GPS Deformation: %.2fm (H:%.2fm V:%.2fm) Risk:%d Type:%d\n",
                displacement.distance_3d, displacement.horizontal_distance,
                displacement.vertical_distance, g_current_analysis.risk_level,
                g_current_analysis.deform_type);
     }
-    
+}
+
+/**
+ * @brief 添加GPS位置数据进行形变分析（持锁调用）
+ */
+static int AddPositionLocked(const GPSData *gps_data)
+{
+    // 检查定位质量
+    if (!IsEpochUsable(gps_data)) {
+        g_deform_stats.rejected_epochs++;
+        return -2;
+    }
+
+    // 单点与差分坐标相差米级，同一时段不混用
+    if (gps_data->differential != g_session_differential) {
+        GpsAvg_Reset(&g_averager);
+        g_session_differential = gps_data->differential;
+        g_deform_stats.mode_changes++;
+        printf("GPS positioning mode changed to %s, averaging session restarted\n",
+               g_session_differential ? "differential" : "single point");
+    }
+
+    // 单历元只参与时段平均，时段结束时才用平均坐标计算形变
+    GpsAvgSolution solution;
+    int ret = GpsAvg_AddEpoch(&g_averager, gps_data->latitude, gps_data->longitude, gps_data->altitude,
+                              gps_data->last_update_time, &solution);
+    g_deform_stats.outlier_epochs = g_averager.outliers;
+    g_deform_stats.discarded_sessions = g_averager.discarded_sessions;
+    if (ret != 1) {
+        return (ret < 0) ? -2 : 0;
+    }
+
+    g_last_solution = solution;
+    g_deform_stats.solutions++;
+    printf("GPS station solution: %.7f°, %.7f°, %.2fm (σh %.3fm σv %.3fm, %d/%d epochs)\n",
+           solution.latitude, solution.longitude, solution.altitude, solution.sigma_h, solution.sigma_v,
+           solution.epochs_used, solution.epochs_total);
+
+    GPSPositionRecord record = {0};
+    record.latitude = solution.latitude;
+    record.longitude = solution.longitude;
+    record.altitude = solution.altitude;
+    record.accuracy = solution.sigma_h;
+    record.timestamp = solution.end_time;
+    record.valid = true;
+    record.differential = g_session_differential;
+
+    // 时段结束时刻的UTC（当前历元之前的最后一个历元）
+    uint32_t utc_seconds = 0;
+    if (gps_data->utc_seconds != 0) {
+        utc_seconds = gps_data->utc_seconds - (gps_data->last_update_time - solution.end_time) / 1000;
+    }
+
+    // 首次运行（Flash中没有基准）时，第一个时段平均坐标作为基准；之后只能显式重建
+    if (!g_baseline_established) {
+        SetBaselineRecord(&record, utc_seconds);
+        return 0;
+    }
+
+    // 位移、速度拟合和历史只用与基准同一模式的坐标：差分生效后以差分坐标重建一次基准，
+    // 之后参考站中断期间的单点坐标跳过，不在位移序列中引入米级阶跃
+    if (record.differential != g_baseline_position.differential) {
+        if (record.differential) {
+            printf("GPS differential solutions available, rebuilding baseline\n");
+            SetBaselineRecord(&record, utc_seconds);
+        } else {
+            g_deform_stats.mode_skipped++;
+        }
+        return 0;
+    }
+
+    if (g_restore_pending > 0) {
+        AlignRestoredHistory(record.timestamp, utc_seconds);
+    }
+    AnalyzeSolution(&record, utc_seconds, solution.sigma_h);
+    return 0;
+}
+
+/**
+ * @brief 添加GPS位置数据进行形变分析
+ */
+int GPS_Deformation_AddPosition(const GPSData *gps_data)
+{
+    if (!g_deform_initialized || !gps_data || !gps_data->valid) {
+        return -1;
+    }
+
+    LOS_MuxPend(g_deform_mutex, LOS_WAIT_FOREVER);
+    int ret = AddPositionLocked(gps_data);
+    LOS_MuxPost(g_deform_mutex);
+    return ret;
+}
+
+/**
+ * @brief 设置时段平均长度
+ */
+int GPS_Deformation_SetAveragingPeriod(uint32_t period_ms)
+{
+    if (!g_deform_initialized || period_ms < GPS_AVG_MIN_SESSION_MS || period_ms > GPS_AVG_MAX_SESSION_MS) {
+        return -1;
+    }
+
+    // 当前时段按旧长度采集，直接丢弃重新开始
+    LOS_MuxPend(g_deform_mutex, LOS_WAIT_FOREVER);
+    GpsAvg_Init(&g_averager, period_ms);
+    LOS_MuxPost(g_deform_mutex);
+    printf("GPS averaging period: %us\n", period_ms / 1000);
     return 0;
 }
 
+/**
+ * @brief 获取最近一个时段平均坐标
+ */
+int GPS_Deformation_GetLastSolution(GpsAvgSolution *solution)
+{
+    if (!g_deform_initialized || !solution) {
+        return -1;
+    }
+
+    LOS_MuxPend(g_deform_mutex, LOS_WAIT_FOREVER);
+    *solution = g_last_solution;
+    LOS_MuxPost(g_deform_mutex);
+    return solution->valid ? 0 : -2;
+}
+
 /**
  * @brief 获取形变分析结果
  */
@@ -233,7 +581,9 @@ int GPS_Deformation_GetAnalysis(GPSDeformationAnalysis *analysis)
         return -1;
     }
 
+    LOS_MuxPend(g_deform_mutex, LOS_WAIT_FOREVER);
     memcpy(analysis, &g_current_analysis, sizeof(GPSDeformationAnalysis));
+    LOS_MuxPost(g_deform_mutex);
     return 0;
 }
 
@@ -272,17 +622,43 @@ void GPS_Deformation_Reset(void)
 
     printf("Resetting GPS deformation monitoring data...\n");
 
+    LOS_MuxPend(g_deform_mutex, LOS_WAIT_FOREVER);
     memset(g_position_history, 0, sizeof(g_position_history));
     memset(&g_current_analysis, 0, sizeof(g_current_analysis));
     memset(&g_deform_stats, 0, sizeof(g_deform_stats));
 
+    // 序号继续递增，未导出完的游标把清除的记录计入skipped
     g_history_count = 0;
     g_history_index = 0;
     g_baseline_established = false;
+    GpsAvg_Reset(&g_averager);
+    g_session_differential = false;
+    memset(&g_last_solution, 0, sizeof(g_last_solution));
+    GpsTrend_Init(&g_trend);
+    memset(&g_stored_history, 0, sizeof(g_stored_history));
+    g_restore_pending = 0;
+    KvStore_Delete(KV_KEY_GPS_BASELINE);
+    KvStore_Delete(KV_KEY_GPS_HISTORY);
+    LOS_MuxPost(g_deform_mutex);
 
     printf("GPS deformation monitoring data reset\n");
 }
 
+/**
+ * @brief 设置位移报警阈值
+ */
+int GPS_Deformation_SetThresholds(float alert_distance, float critical_distance)
+{
+    if (alert_distance <= 0.0f || critical_distance <= alert_distance) {
+        return -1;
+    }
+
+    g_alert_distance = alert_distance;
+    g_critical_distance = critical_distance;
+    printf("GPS deformation thresholds: alert %.2fm, critical %.2fm\n", alert_distance, critical_distance);
+    return 0;
+}
+
 /**
  * @brief 计算两点间距离 (Haversine公式)
  */
@@ -333,7 +709,7 @@ static void UpdateDeformationStats(const DisplacementVector *displacement)
     }
 
     // 更新警报计数
-    if (displacement->distance_3d > GPS_DEFORM_ALERT_DISTANCE) {
+    if (displacement->distance_3d > g_alert_distance) {
         g_deform_stats.alert_count++;
     }
 }
@@ -348,12 +724,14 @@ static DeformationRisk AssessDeformationRisk(const DisplacementVector *displacem
     }
 
     float distance = displacement->distance_3d;
-    float vel = velocity->total_velocity;
+    // 速度取95%置信下限，避免噪声造成的虚假速度触发报警
+    float vel = velocity->total_velocity - velocity->velocity_ci;
+    DeformationRisk velocity_risk = DEFORM_RISK_SAFE;
 
     // 基于位移距离的风险评估
-    if (distance >= GPS_DEFORM_CRITICAL_DISTANCE) {
+    if (distance >= g_critical_distance) {
         return DEFORM_RISK_CRITICAL;
-    } else if (distance >= GPS_DEFORM_ALERT_DISTANCE) {
+    } else if (distance >= g_alert_distance) {
         return DEFORM_RISK_HIGH;
     } else if (distance >= 1.0f) {
         return DEFORM_RISK_MEDIUM;
@@ -363,14 +741,19 @@ static DeformationRisk AssessDeformationRisk(const DisplacementVector *displacem
 
     // 基于速度的风险评估
     if (vel > 1.0f) {  // 超过1米/小时
-        return DEFORM_RISK_HIGH;
+        velocity_risk = DEFORM_RISK_HIGH;
     } else if (vel > 0.5f) {  // 超过0.5米/小时
-        return DEFORM_RISK_MEDIUM;
+        velocity_risk = DEFORM_RISK_MEDIUM;
     } else if (vel > 0.1f) {  // 超过0.1米/小时
-        return DEFORM_RISK_LOW;
+        velocity_risk = DEFORM_RISK_LOW;
+    }
+
+    // 已有显著速度且显著加速时提高一级
+    if (velocity_risk != DEFORM_RISK_SAFE && velocity_risk < DEFORM_RISK_HIGH && velocity->is_accelerating) {
+        velocity_risk++;
     }
 
-    return DEFORM_RISK_SAFE;
+    return velocity_risk;
 }
 
 /**
@@ -405,53 +788,42 @@ static DeformationType ClassifyDeformationType(const DisplacementVector *displac
  */
 static void CalculateVelocity(DeformationVelocity *velocity)
 {
-    if (!velocity || g_history_count < 2) {
-        memset(velocity, 0, sizeof(DeformationVelocity));
-        return;
-    }
+    memset(velocity, 0, sizeof(DeformationVelocity));
 
-    // 使用最近的几个点计算速度
-    int window_size = (g_history_count < GPS_DEFORM_VELOCITY_WINDOW) ? g_history_count : GPS_DEFORM_VELOCITY_WINDOW;
-
-    if (window_size < 2) {
-        memset(velocity, 0, sizeof(DeformationVelocity));
+    if (GpsTrend_GetFit(&g_trend, GPS_TREND_SHORT, &velocity->short_term) != 0) {
         return;
     }
+    GpsTrend_GetFit(&g_trend, GPS_TREND_LONG, &velocity->long_term);
 
-    // 获取最新和最旧的位置
-    int latest_idx = (g_history_index - 1 + GPS_DEFORM_HISTORY_SIZE) % GPS_DEFORM_HISTORY_SIZE;
-    int oldest_idx = (g_history_index - window_size + GPS_DEFORM_HISTORY_SIZE) % GPS_DEFORM_HISTORY_SIZE;
-
-    GPSPositionRecord *latest = &g_position_history[latest_idx];
-    GPSPositionRecord *oldest = &g_position_history[oldest_idx];
-
-    if (!latest->valid || !oldest->valid) {
-        memset(velocity, 0, sizeof(DeformationVelocity));
-        return;
-    }
+    // 速度取短窗口，反应较快
+    const float *v = velocity->short_term.velocity;
+    const float *v_ci = velocity->short_term.velocity_ci;
+    velocity->horizontal_velocity = sqrtf(v[0] * v[0] + v[1] * v[1]);
+    velocity->vertical_velocity = v[2];
+    velocity->total_velocity = sqrtf(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
 
-    // 计算时间差 (小时)
-    float time_diff_hours = (latest->timestamp - oldest->timestamp) / (1000.0f * 3600.0f);
-    if (time_diff_hours <= 0) {
-        memset(velocity, 0, sizeof(DeformationVelocity));
-        return;
+    // 沿运动方向投影各分量的置信区间
+    float ci_sq = 0;
+    for (int axis = 0; axis < 3; axis++) {
+        float weight = (velocity->total_velocity > 0) ? v[axis] / velocity->total_velocity : 1.0f;
+        ci_sq += weight * weight * v_ci[axis] * v_ci[axis];
     }
+    velocity->velocity_ci = sqrtf(ci_sq);
 
-    // 计算距离差
-    float h_distance = CalculateHaversineDistance(oldest->latitude, oldest->longitude,
-                                                 latest->latitude, latest->longitude);
-    float v_distance = latest->altitude - oldest->altitude;
-    float total_distance = sqrtf(h_distance * h_distance + v_distance * v_distance);
-
-    // 计算速度
-    velocity->horizontal_velocity = h_distance / time_diff_hours;
-    velocity->vertical_velocity = v_distance / time_diff_hours;
-    velocity->total_velocity = total_distance / time_diff_hours;
-
-    // 计算加速度 (简化版本)
-    if (g_deform_stats.max_velocity > 0) {
-        velocity->acceleration = (velocity->total_velocity - g_deform_stats.max_velocity) / time_diff_hours;
-        velocity->is_accelerating = (velocity->acceleration > 0.01f);
+    // 加速度优先取长窗口（二次拟合需要更多样本才稳定）
+    const GpsTrendFit *accel_fit = velocity->long_term.acceleration_valid ? &velocity->long_term :
+                                   velocity->short_term.acceleration_valid ? &velocity->short_term : NULL;
+    if (accel_fit != NULL && velocity->total_velocity > 0) {
+        float along = 0;
+        ci_sq = 0;
+        for (int axis = 0; axis < 3; axis++) {
+            float weight = v[axis] / velocity->total_velocity;
+            along += weight * accel_fit->acceleration[axis];
+            ci_sq += weight * weight * accel_fit->acceleration_ci[axis] * accel_fit->acceleration_ci[axis];
+        }
+        velocity->acceleration = along;
+        velocity->acceleration_ci = sqrtf(ci_sq);
+        velocity->is_accelerating = (along - velocity->acceleration_ci > 0);
     }
 
     // 更新最大速度
@@ -485,7 +857,9 @@ void GPS_Deformation_GetStats(DeformationStats *stats)
         return;
     }
 
+    LOS_MuxPend(g_deform_mutex, LOS_WAIT_FOREVER);
     memcpy(stats, &g_deform_stats, sizeof(DeformationStats));
+    LOS_MuxPost(g_deform_mutex);
 }
 
 /**
@@ -512,15 +886,20 @@ void GPS_Deformation_PrintDebugInfo(void)
                g_current_analysis.current_position.longitude,
                g_current_analysis.current_position.altitude);
 
-        printf("Displacement: %.1fm (H:%.1fm V:%.1fm)\n",
+        printf("Displacement: %.3fm (E:%.3fm N:%.3fm U:%.3fm)\n",
                g_current_analysis.displacement.distance_3d,
-               g_current_analysis.displacement.horizontal_distance,
-               g_current_analysis.displacement.vertical_distance);
+               g_current_analysis.displacement.east,
+               g_current_analysis.displacement.north,
+               g_current_analysis.displacement.up);
 
-        printf("Velocity: %.3fm/h (H:%.3fm/h V:%.3fm/h)\n",
+        printf("Velocity: %.4f±%.4fm/h (H:%.4fm/h V:%.4fm/h), accel %.5f±%.5fm/h²%s\n",
                g_current_analysis.velocity.total_velocity,
+               g_current_analysis.velocity.velocity_ci,
                g_current_analysis.velocity.horizontal_velocity,
-               g_current_analysis.velocity.vertical_velocity);
+               g_current_analysis.velocity.vertical_velocity,
+               g_current_analysis.velocity.acceleration,
+               g_current_analysis.velocity.acceleration_ci,
+               g_current_analysis.velocity.is_accelerating ? " (accelerating)" : "");
 
         printf("Risk Level: %d, Type: %d, Confidence: %.2f\n",
                g_current_analysis.risk_level, g_current_analysis.deform_type,
@@ -534,7 +913,139 @@ void GPS_Deformation_PrintDebugInfo(void)
     printf("  Total displacement: %.1fm\n", g_deform_stats.total_displacement);
     printf("  Max velocity: %.3fm/h\n", g_deform_stats.max_velocity);
     printf("  Alert count: %d\n", g_deform_stats.alert_count);
+    printf("  Rejected epochs: %d, outlier epochs: %d\n", g_deform_stats.rejected_epochs,
+           g_deform_stats.outlier_epochs);
+    printf("  Station solutions: %d (discarded sessions: %d)\n", g_deform_stats.solutions,
+           g_deform_stats.discarded_sessions);
+    printf("  Baseline mode: %s, mode changes: %d, skipped solutions: %d\n",
+           g_baseline_position.differential ? "differential" : "single point",
+           g_deform_stats.mode_changes, g_deform_stats.mode_skipped);
     printf("  Monitoring duration: %ds\n", g_deform_stats.monitoring_duration);
-    printf("  History count: %d/%d\n", g_history_count, GPS_DEFORM_HISTORY_SIZE);
+    printf("  History count: %d/%d (restored: %d)\n", g_history_count, GPS_DEFORM_HISTORY_SIZE,
+           g_deform_stats.restored_solutions);
     printf("================================\n\n");
 }
+
+/**
+ * @brief 开始导出形变历史
+ */
+int GPS_Deformation_ExportBegin(GpsExportCursor *cursor, uint32_t start_utc, uint32_t end_utc,
+                                GpsExportFormat format)
+{
+    if (!g_deform_initialized || !cursor || format > GPS_EXPORT_FORMAT_CSV) {
+        return -1;
+    }
+
+    memset(cursor, 0, sizeof(GpsExportCursor));
+    LOS_MuxPend(g_deform_mutex, LOS_WAIT_FOREVER);
+    cursor->next_sequence = g_history_sequence - g_history_count;
+    LOS_MuxPost(g_deform_mutex);
+    cursor->start_utc = start_utc;
+    cursor->end_utc = end_utc;
+    cursor->format = (uint8_t)format;
+    return 0;
+}
+
+/**
+ * @brief 按序号取历史记录并转换为导出记录（持锁调用）
+ */
+static void BuildExportRecord(uint32_t sequence, GpsExportRecord *out)
+{
+    uint16_t slot = (g_history_index + GPS_DEFORM_HISTORY_SIZE - (g_history_sequence - sequence)) %
+                    GPS_DEFORM_HISTORY_SIZE;
+    const GPSPositionRecord *record = &g_position_history[slot];
+    GpsEnuVector enu;
+
+    GpsEnu_FromGeodetic(&g_baseline_frame, record->latitude, record->longitude, record->altitude, &enu);
+    out->sequence = sequence;
+    out->utc_seconds = g_history_meta[slot].utc_seconds;
+    out->east = (int32_t)lroundf(enu.east * 1000.0f);
+    out->north = (int32_t)lroundf(enu.north * 1000.0f);
+    out->up = (int32_t)lroundf(enu.up * 1000.0f);
+    out->sigma_h = (uint16_t)((record->accuracy * 1000.0f < 65535.0f) ? lroundf(record->accuracy * 1000.0f) : 65535);
+    out->flags = g_history_meta[slot].flags;
+}
+
+/**
+ * @brief 按游标导出下一块形变历史（持锁调用）
+ */
+static int ExportNextLocked(GpsExportCursor *cursor, uint8_t *buffer, size_t buffer_size)
+{
+    // 游标落后于最旧记录时，中间的记录已被覆盖；超前时说明历史在游标创建后被重新初始化
+    uint32_t oldest = g_history_sequence - g_history_count;
+    if ((int32_t)(cursor->next_sequence - oldest) < 0) {
+        cursor->skipped += oldest - cursor->next_sequence;
+        cursor->next_sequence = oldest;
+    } else if ((int32_t)(cursor->next_sequence - g_history_sequence) > 0) {
+        cursor->next_sequence = oldest;
+    }
+
+    size_t used = 0;
+    if (cursor->format == GPS_EXPORT_FORMAT_CSV && !cursor->header_sent) {
+        size_t header_len = strlen(GPS_EXPORT_CSV_HEADER);
+        if (header_len > buffer_size) {
+            return -2;
+        }
+        memcpy(buffer, GPS_EXPORT_CSV_HEADER, header_len);
+        used = header_len;
+    }
+
+    bool filtered = (cursor->start_utc != 0 || cursor->end_utc != 0);
+    while (cursor->next_sequence != g_history_sequence) {
+        GpsExportRecord record;
+        BuildExportRecord(cursor->next_sequence, &record);
+
+        if (filtered && (record.utc_seconds == 0 || record.utc_seconds < cursor->start_utc ||
+                         (cursor->end_utc != 0 && record.utc_seconds > cursor->end_utc))) {
+            cursor->next_sequence++;
+            continue;
+        }
+
+        char line[80];
+        const void *data = &record;
+        size_t len = sizeof(record);
+        if (cursor->format == GPS_EXPORT_FORMAT_CSV) {
+            len = (size_t)snprintf(line, sizeof(line), "%u,%u,%d,%d,%d,%u,%u\n",
+                                   (unsigned int)record.sequence, (unsigned int)record.utc_seconds,
+                                   (int)record.east, (int)record.north, (int)record.up,
+                                   (unsigned int)record.sigma_h, (unsigned int)record.flags);
+            data = line;
+        }
+
+        if (used + len > buffer_size) {
+            break;
+        }
+        memcpy(buffer + used, data, len);
+        used += len;
+        cursor->next_sequence++;
+        cursor->exported++;
+    }
+
+    if (cursor->format == GPS_EXPORT_FORMAT_CSV && used > 0) {
+        if (cursor->next_sequence == g_history_sequence || used > strlen(GPS_EXPORT_CSV_HEADER)) {
+            cursor->header_sent = true;
+        } else {
+            return -2;      // 表头之后放不下一条记录
+        }
+    }
+    if (used == 0 && cursor->next_sequence != g_history_sequence) {
+        return -2;
+    }
+    return (int)used;
+}
+
+/**
+ * @brief 按游标导出下一块形变历史
+ * @note 每块在锁内生成，块与块之间采集任务可继续追加历史
+ */
+int GPS_Deformation_ExportNext(GpsExportCursor *cursor, uint8_t *buffer, size_t buffer_size)
+{
+    if (!g_deform_initialized || !cursor || !buffer) {
+        return -1;
+    }
+
+    LOS_MuxPend(g_deform_mutex, LOS_WAIT_FOREVER);
+    int ret = ExportNextLocked(cursor, buffer, buffer_size);
+    LOS_MuxPost(g_deform_mutex);
+    return ret;
+}
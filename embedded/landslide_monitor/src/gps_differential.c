@@ -0,0 +1,354 @@
+#include "gps_differential.h"
+#include "nmea_parser.h"
+#include "kv_store.h"
+#include "los_mux.h"
+#include "los_task.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define SECONDS_PER_DAY     86400
+#define METERS_PER_DEGREE   111319.49     // 赤道处每度弧长，用于打印改正量
+
+// 参考站已知坐标（KV_KEY_GPS_REFERENCE）
+typedef struct {
+    double latitude;
+    double longitude;
+    float altitude;
+    uint32_t valid;
+} ReferencePosition;
+
+// 参考站整秒历元（按当日UTC秒 % GPS_DIFF_REF_SLOTS 存放）
+typedef struct {
+    double latitude;
+    double longitude;
+    float altitude;
+    uint32_t tod;                   // 当日UTC秒
+    bool valid;
+} ReferenceEpoch;
+
+// 等待配对的本站历元
+typedef struct {
+    double latitude;
+    double longitude;
+    float altitude;
+    float accuracy;
+    float vertical_accuracy;
+    float pdop;
+    uint32_t utc_seconds;
+    uint32_t update_time;
+    uint8_t fix_quality;
+    uint8_t fix_type;
+    uint8_t satellites_used;
+} RoverEpoch;
+
+static bool g_diff_initialized = false;
+static uint32_t g_diff_mutex = 0;
+static NmeaParser g_ref_parser;                             // 参考站数据流解析器（与本站串口解析器独立）
+static ReferencePosition g_ref_known;
+static double g_ref_sum[3];                                 // 自动建立已知坐标的累加和
+static uint32_t g_ref_sum_count = 0;
+static ReferenceEpoch g_ref_epochs[GPS_DIFF_REF_SLOTS];
+static uint32_t g_ref_last_tick = 0;
+static bool g_ref_received = false;
+static RoverEpoch g_rover_queue[GPS_DIFF_ROVER_QUEUE];
+static uint16_t g_rover_head = 0;
+static uint16_t g_rover_count = 0;
+static uint32_t g_rover_last_utc = 0;
+static GpsDiffStats g_diff_stats;
+
+/**
+ * @brief 初始化位置域差分
+ */
+int GpsDiff_Init(void)
+{
+    if (g_diff_initialized) {
+        return 0;
+    }
+
+    if (LOS_MuxCreate(&g_diff_mutex) != LOS_OK) {
+        printf("Failed to create GPS differential mutex\n");
+        return -1;
+    }
+
+    Nmea_Init(&g_ref_parser);
+    memset(g_ref_epochs, 0, sizeof(g_ref_epochs));
+    memset(g_rover_queue, 0, sizeof(g_rover_queue));
+    memset(&g_diff_stats, 0, sizeof(g_diff_stats));
+    memset(g_ref_sum, 0, sizeof(g_ref_sum));
+    g_ref_sum_count = 0;
+    g_ref_received = false;
+    g_rover_head = 0;
+    g_rover_count = 0;
+    g_rover_last_utc = 0;
+
+    if (KvStore_Get(KV_KEY_GPS_REFERENCE, &g_ref_known, sizeof(g_ref_known)) == 0 && g_ref_known.valid) {
+        g_diff_stats.reference_known = true;
+        printf("GPS reference position restored: %.7f°, %.7f°, %.2fm\n",
+               g_ref_known.latitude, g_ref_known.longitude, g_ref_known.altitude);
+    } else {
+        memset(&g_ref_known, 0, sizeof(g_ref_known));
+    }
+
+    g_diff_initialized = true;
+    return 0;
+}
+
+/**
+ * @brief 反初始化位置域差分
+ */
+void GpsDiff_Deinit(void)
+{
+    if (!g_diff_initialized) {
+        return;
+    }
+
+    g_diff_initialized = false;
+    LOS_MuxDelete(g_diff_mutex);
+    g_diff_mutex = 0;
+}
+
+/**
+ * @brief 保存参考站已知坐标（调用者持有互斥锁）
+ */
+static void SaveReferencePosition(double latitude, double longitude, float altitude)
+{
+    g_ref_known.latitude = latitude;
+    g_ref_known.longitude = longitude;
+    g_ref_known.altitude = altitude;
+    g_ref_known.valid = 1;
+    g_diff_stats.reference_known = true;
+
+    if (KvStore_Set(KV_KEY_GPS_REFERENCE, &g_ref_known, sizeof(g_ref_known)) != 0) {
+        printf("Failed to save GPS reference position\n");
+    }
+    printf("GPS reference position set: %.7f°, %.7f°, %.2fm\n", latitude, longitude, altitude);
+}
+
+/**
+ * @brief 设置参考站已知坐标
+ */
+int GpsDiff_SetReferencePosition(double latitude, double longitude, float altitude)
+{
+    if (!g_diff_initialized || fabs(latitude) > 90.0 || fabs(longitude) > 180.0) {
+        return -1;
+    }
+
+    LOS_MuxPend(g_diff_mutex, LOS_WAIT_FOREVER);
+    SaveReferencePosition(latitude, longitude, altitude);
+    g_ref_sum_count = 0;
+    LOS_MuxPost(g_diff_mutex);
+    return 0;
+}
+
+/**
+ * @brief 记录一个参考站GGA历元（调用者持有互斥锁）
+ * @return true: 已记录
+ */
+static bool AddReferenceEpoch(const NmeaGga *gga)
+{
+    const uint8_t required = NMEA_GGA_HAS_TIME | NMEA_GGA_HAS_POSITION | NMEA_GGA_HAS_ALTITUDE;
+
+    // 只用整秒历元，与本站按UTC秒配对
+    if ((gga->present & required) != required || gga->quality == 0 || gga->utc_time_ms % 1000 != 0) {
+        return false;
+    }
+
+    uint32_t tod = gga->utc_time_ms / 1000;
+    ReferenceEpoch *epoch = &g_ref_epochs[tod % GPS_DIFF_REF_SLOTS];
+    epoch->latitude = gga->latitude / 1e7;
+    epoch->longitude = gga->longitude / 1e7;
+    epoch->altitude = gga->altitude / 100.0f;
+    epoch->tod = tod;
+    epoch->valid = true;
+
+    g_ref_last_tick = LOS_TickCountGet();
+    g_ref_received = true;
+    g_diff_stats.reference_epochs++;
+
+    // 未设置已知坐标时以最初的历元均值代替（只影响整体平移，不影响形变量）
+    if (!g_diff_stats.reference_known) {
+        g_ref_sum[0] += epoch->latitude;
+        g_ref_sum[1] += epoch->longitude;
+        g_ref_sum[2] += epoch->altitude;
+        if (++g_ref_sum_count >= GPS_DIFF_REF_INIT_EPOCHS) {
+            SaveReferencePosition(g_ref_sum[0] / g_ref_sum_count, g_ref_sum[1] / g_ref_sum_count,
+                                  (float)(g_ref_sum[2] / g_ref_sum_count));
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 输入参考站NMEA数据流
+ */
+int GpsDiff_FeedReference(const char *data, uint32_t length)
+{
+    if (!g_diff_initialized || !data) {
+        return -1;
+    }
+
+    int added = 0;
+    LOS_MuxPend(g_diff_mutex, LOS_WAIT_FOREVER);
+    for (uint32_t i = 0; i < length; i++) {
+        if (Nmea_Feed(&g_ref_parser, data[i]) == NMEA_TYPE_GGA && AddReferenceEpoch(&g_ref_parser.gga)) {
+            added++;
+        }
+    }
+    LOS_MuxPost(g_diff_mutex);
+    return added;
+}
+
+/**
+ * @brief 输入本站历元
+ */
+int GpsDiff_AddRover(const GPSData *rover)
+{
+    if (!g_diff_initialized || !rover) {
+        return -1;
+    }
+    if (!rover->valid || rover->utc_seconds == 0 || rover->utc_seconds == g_rover_last_utc) {
+        return -2;
+    }
+
+    LOS_MuxPend(g_diff_mutex, LOS_WAIT_FOREVER);
+    g_rover_last_utc = rover->utc_seconds;
+    if (g_rover_count == GPS_DIFF_ROVER_QUEUE) {
+        // 丢弃最旧的历元
+        g_rover_head = (g_rover_head + 1) % GPS_DIFF_ROVER_QUEUE;
+        g_rover_count--;
+        g_diff_stats.overflows++;
+    }
+
+    RoverEpoch *epoch = &g_rover_queue[(g_rover_head + g_rover_count) % GPS_DIFF_ROVER_QUEUE];
+    epoch->latitude = rover->latitude;
+    epoch->longitude = rover->longitude;
+    epoch->altitude = rover->altitude;
+    epoch->accuracy = rover->accuracy;
+    epoch->vertical_accuracy = rover->vertical_accuracy;
+    epoch->pdop = rover->pdop;
+    epoch->utc_seconds = rover->utc_seconds;
+    epoch->update_time = rover->last_update_time;
+    epoch->fix_quality = rover->fix_quality;
+    epoch->fix_type = rover->fix_type;
+    epoch->satellites_used = rover->satellites_used;
+    g_rover_count++;
+    g_diff_stats.rover_epochs++;
+    LOS_MuxPost(g_diff_mutex);
+    return 0;
+}
+
+/**
+ * @brief 差分模式是否生效（调用者持有互斥锁）
+ */
+static bool IsActiveLocked(uint32_t now)
+{
+    return g_diff_stats.reference_known && g_ref_received && now - g_ref_last_tick <= GPS_DIFF_REF_TIMEOUT_MS;
+}
+
+/**
+ * @brief 取出下一个可用于形变分析的本站历元
+ */
+int GpsDiff_GetCorrected(GPSData *output)
+{
+    if (!g_diff_initialized || !output) {
+        return -1;
+    }
+
+    int result = -2;
+    uint32_t now = LOS_TickCountGet();
+
+    LOS_MuxPend(g_diff_mutex, LOS_WAIT_FOREVER);
+    bool active = IsActiveLocked(now);
+    if (active != g_diff_stats.active) {
+        g_diff_stats.active = active;
+        printf("GPS differential mode %s\n", active ? "active" : "lost, using single point positions");
+    }
+
+    while (g_rover_count > 0) {
+        const RoverEpoch *rover = &g_rover_queue[g_rover_head];
+        const ReferenceEpoch *reference = &g_ref_epochs[(rover->utc_seconds % SECONDS_PER_DAY) % GPS_DIFF_REF_SLOTS];
+        bool matched = active && reference->valid && reference->tod == rover->utc_seconds % SECONDS_PER_DAY;
+
+        if (active && !matched && now - rover->update_time < GPS_DIFF_MAX_WAIT_MS) {
+            break;      // 参考站同一历元可能尚未到达
+        }
+
+        g_rover_head = (g_rover_head + 1) % GPS_DIFF_ROVER_QUEUE;
+        g_rover_count--;
+        if (active && !matched) {
+            g_diff_stats.unmatched++;
+            continue;
+        }
+
+        memset(output, 0, sizeof(GPSData));
+        output->latitude = rover->latitude;
+        output->longitude = rover->longitude;
+        output->altitude = rover->altitude;
+        output->accuracy = rover->accuracy;
+        output->vertical_accuracy = rover->vertical_accuracy;
+        output->pdop = rover->pdop;
+        output->fix_quality = rover->fix_quality;
+        output->fix_type = rover->fix_type;
+        output->satellites_used = rover->satellites_used;
+        output->utc_seconds = rover->utc_seconds;
+        output->last_update_time = rover->update_time;
+        output->valid = true;
+
+        if (matched) {
+            // 参考站观测值减已知坐标即为两站共同的误差
+            double dlat = reference->latitude - g_ref_known.latitude;
+            double dlon = reference->longitude - g_ref_known.longitude;
+            float dalt = reference->altitude - g_ref_known.altitude;
+            output->latitude -= dlat;
+            output->longitude -= dlon;
+            output->altitude -= dalt;
+            output->differential = true;
+            g_diff_stats.corrected++;
+            g_diff_stats.last_correction_h = (float)(METERS_PER_DEGREE *
+                sqrt(dlat * dlat + dlon * dlon * cos(g_ref_known.latitude * M_PI / 180.0) *
+                     cos(g_ref_known.latitude * M_PI / 180.0)));
+            g_diff_stats.last_correction_v = dalt;
+        } else {
+            g_diff_stats.passthrough++;
+        }
+        result = 0;
+        break;
+    }
+    LOS_MuxPost(g_diff_mutex);
+    return result;
+}
+
+/**
+ * @brief 差分模式是否生效
+ */
+bool GpsDiff_IsActive(void)
+{
+    if (!g_diff_initialized) {
+        return false;
+    }
+
+    LOS_MuxPend(g_diff_mutex, LOS_WAIT_FOREVER);
+    bool active = IsActiveLocked(LOS_TickCountGet());
+    LOS_MuxPost(g_diff_mutex);
+    return active;
+}
+
+/**
+ * @brief 获取差分统计信息
+ */
+int GpsDiff_GetStats(GpsDiffStats *stats)
+{
+    if (!g_diff_initialized || !stats) {
+        return -1;
+    }
+
+    LOS_MuxPend(g_diff_mutex, LOS_WAIT_FOREVER);
+    *stats = g_diff_stats;
+    LOS_MuxPost(g_diff_mutex);
+    return 0;
+}
@@ -0,0 +1,55 @@
+#include "gps_enu.h"
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/**
+ * @brief 建立站心坐标系
+ */
+void GpsEnu_InitFrame(GpsEnuFrame *frame, double latitude, double longitude, float altitude)
+{
+    double phi = latitude * M_PI / 180.0;
+    double sin_phi = sin(phi);
+    double w = sqrt(1.0 - GPS_ENU_WGS84_E2 * sin_phi * sin_phi);
+    double prime_vertical = GPS_ENU_WGS84_A / w;                                // 卯酉圈曲率半径
+    double meridian = GPS_ENU_WGS84_A * (1.0 - GPS_ENU_WGS84_E2) / (w * w * w); // 子午圈曲率半径
+
+    frame->latitude = latitude;
+    frame->longitude = longitude;
+    frame->altitude = altitude;
+    frame->north_per_degree = (meridian + altitude) * M_PI / 180.0;
+    frame->east_per_degree = (prime_vertical + altitude) * cos(phi) * M_PI / 180.0;
+}
+
+/**
+ * @brief 经纬度转换为站心坐标
+ */
+void GpsEnu_FromGeodetic(const GpsEnuFrame *frame, double latitude, double longitude, float altitude,
+                         GpsEnuVector *enu)
+{
+    double dlon = longitude - frame->longitude;
+
+    // 跨越180°经线
+    if (dlon > 180.0) {
+        dlon -= 360.0;
+    } else if (dlon < -180.0) {
+        dlon += 360.0;
+    }
+
+    enu->east = (float)(dlon * frame->east_per_degree);
+    enu->north = (float)((latitude - frame->latitude) * frame->north_per_degree);
+    enu->up = altitude - frame->altitude;
+}
+
+/**
+ * @brief 站心坐标转换为经纬度
+ */
+void GpsEnu_ToGeodetic(const GpsEnuFrame *frame, const GpsEnuVector *enu,
+                       double *latitude, double *longitude, float *altitude)
+{
+    *latitude = frame->latitude + enu->north / frame->north_per_degree;
+    *longitude = frame->longitude + enu->east / frame->east_per_degree;
+    *altitude = frame->altitude + enu->up;
+}
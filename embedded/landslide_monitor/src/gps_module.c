@@ -1,8 +1,10 @@
 #include "gps_module.h"
+#include "task_profiler.h"
 #include "iot_uart.h"
 #include "iot_errno.h"
 #include "los_task.h"
 #include "los_memory.h"
+#include "los_event.h"
 #include "cmsis_os2.h"
 #include <stdio.h>
 #include <stdlib.h>
@@ -13,8 +15,40 @@
 static bool g_gps_initialized = false;
 static GPSData g_current_gps_data = {0};
 static GpsStats g_gps_stats = {0};
-static GpsRawData g_gps_raw_data = {0};
+static NmeaParser g_nmea_parser;
+static GpsQuality g_gps_quality = {0};
+static NmeaType g_last_sentence = NMEA_TYPE_UNKNOWN;    // 上一条语句类型（识别GSA历元边界）
+static uint32_t g_last_fix_log = 0;
+static uint32_t g_rmc_date_seconds = 0;     // 最近有效RMC日期零点（2000-01-01起秒数，0表示未知）
+static uint32_t g_rmc_time_ms = 0;          // 该RMC的当日时间
+
+// GSV分组累加（一个系统的可见卫星分多条语句，收齐一组后才更新）
+typedef struct {
+    uint8_t in_view;
+    uint8_t tracked;
+    uint8_t cn0_max;
+    uint16_t cn0_sum;
+} GsvAccumulator;
+
+static GsvAccumulator g_gsv_receiving[NMEA_SYSTEM_COUNT];
+static GsvAccumulator g_gsv_complete[NMEA_SYSTEM_COUNT];
 static uint32_t g_gps_task_id = 0;
+static uint32_t g_gps_rx_task_id = 0;
+
+// 接收环形缓冲区（单生产者单消费者，无锁：接收任务只写head，解析任务只写tail）
+#define GPS_RX_EVENT_LINE           0x01        // 缓冲区中有完整语句
+
+static uint8_t g_rx_ring[GPS_RX_RING_SIZE];
+static volatile uint32_t g_rx_head = 0;
+static volatile uint32_t g_rx_tail = 0;
+static volatile uint32_t g_rx_lines_produced = 0;           // 已接收的行结束符数
+static uint32_t g_rx_lines_consumed = 0;                    // 已解析的行结束符数
+static volatile uint32_t g_rx_line_ticks[GPS_RX_LINE_SLOTS]; // 行结束符到达时刻
+static volatile uint32_t g_rx_overruns = 0;
+static uint32_t g_rx_overruns_base = 0;                     // 统计重置时的丢弃字节数
+static uint64_t g_rx_latency_sum = 0;
+static uint32_t g_rx_latency_count = 0;
+static EVENT_CB_S g_gps_rx_event;
 
 // 互斥锁保护GPS数据
 static uint32_t g_gps_mutex = 0;
@@ -43,7 +77,20 @@ int GPS_Init(void)
     // 初始化GPS数据
     memset(&g_current_gps_data, 0, sizeof(g_current_gps_data));
     memset(&g_gps_stats, 0, sizeof(g_gps_stats));
-    memset(&g_gps_raw_data, 0, sizeof(g_gps_raw_data));
+    Nmea_Init(&g_nmea_parser);
+    g_rx_head = 0;
+    g_rx_tail = 0;
+    g_rx_lines_produced = 0;
+    g_rx_lines_consumed = 0;
+    g_rx_overruns = 0;
+    g_rx_overruns_base = 0;
+    g_rx_latency_sum = 0;
+    g_rx_latency_count = 0;
+    memset(&g_gps_quality, 0, sizeof(g_gps_quality));
+    g_rmc_date_seconds = 0;
+    g_rmc_time_ms = 0;
+    memset(g_gsv_receiving, 0, sizeof(g_gsv_receiving));
+    memset(g_gsv_complete, 0, sizeof(g_gsv_complete));
     
     // 设置默认GPS坐标（广西地区）
     g_current_gps_data.latitude = 22.8154;   // 广西南宁纬度
@@ -53,8 +100,15 @@ int GPS_Init(void)
     g_current_gps_data.valid = false;         // 初始状态为无效
     
     g_gps_stats.status = GPS_STATUS_INIT;
+
+    ret = LOS_EventInit(&g_gps_rx_event);
+    if (ret != LOS_OK) {
+        printf("Failed to create GPS RX event: %d\n", ret);
+        LOS_MuxDelete(g_gps_mutex);
+        return -1;
+    }
     
-    // 创建GPS任务
+    // 创建GPS解析任务
     TSK_INIT_PARAM_S task_param = {0};
     task_param.pfnTaskEntry = (TSK_ENTRY_FUNC)GPS_Task;
     task_param.uwStackSize = 4096;
@@ -64,6 +118,24 @@ int GPS_Init(void)
     ret = LOS_TaskCreate(&g_gps_task_id, &task_param);
     if (ret != LOS_OK) {
         printf("Failed to create GPS task: %d\n", ret);
+        LOS_EventDestroy(&g_gps_rx_event);
+        LOS_MuxDelete(g_gps_mutex);
+        return -2;
+    }
+
+    // 创建GPS串口接收任务（优先级高于解析任务，保证硬件FIFO及时搬空）
+    TSK_INIT_PARAM_S rx_task_param = {0};
+    rx_task_param.pfnTaskEntry = (TSK_ENTRY_FUNC)GPS_RxTask;
+    rx_task_param.uwStackSize = 1024;
+    rx_task_param.pcName = "GPS_RxTask";
+    rx_task_param.usTaskPrio = 20;
+
+    ret = LOS_TaskCreate(&g_gps_rx_task_id, &rx_task_param);
+    if (ret != LOS_OK) {
+        printf("Failed to create GPS RX task: %d\n", ret);
+        LOS_TaskDelete(g_gps_task_id);
+        g_gps_task_id = 0;
+        LOS_EventDestroy(&g_gps_rx_event);
         LOS_MuxDelete(g_gps_mutex);
         return -2;
     }
@@ -86,10 +158,15 @@ void GPS_Deinit(void)
     printf("Deinitializing GPS module...\n");
     
     // 删除任务
+    if (g_gps_rx_task_id != 0) {
+        LOS_TaskDelete(g_gps_rx_task_id);
+        g_gps_rx_task_id = 0;
+    }
     if (g_gps_task_id != 0) {
         LOS_TaskDelete(g_gps_task_id);
         g_gps_task_id = 0;
     }
+    LOS_EventDestroy(&g_gps_rx_event);
     
     // 反初始化UART
     IoTUartDeinit(GPS_UART_PORT);
@@ -184,52 +261,31 @@ void GPS_ResetStats(void)
     
     if (LOS_MuxPend(g_gps_mutex, 1000) == LOS_OK) {
         memset(&g_gps_stats, 0, sizeof(g_gps_stats));
+        memset(&g_nmea_parser.stats, 0, sizeof(g_nmea_parser.stats));
+        g_rx_overruns_base = g_rx_overruns;
+        g_rx_latency_sum = 0;
+        g_rx_latency_count = 0;
         g_gps_stats.status = GPS_STATUS_INIT;
         LOS_MuxPost(g_gps_mutex);
     }
 }
 
 /**
- * @brief 转换坐标格式
+ * @brief 获取GNSS定位质量
  */
-double GPS_ConvertCoordinate(const char *coord_str)
+int GPS_GetQuality(GpsQuality *quality)
 {
-    if (!coord_str || strlen(coord_str) == 0) {
-        return 0.0;
+    if (!g_gps_initialized || quality == NULL) {
+        return -1;
     }
-    
-    double coord = atof(coord_str);
-    int degrees = (int)(coord / 100);
-    double minutes = coord - degrees * 100;
-    
-    return degrees + minutes / 60.0;
-}
 
-/**
- * @brief 验证NMEA校验和
- */
-bool GPS_VerifyChecksum(const char *sentence)
-{
-    if (!sentence || strlen(sentence) < 4) {
-        return false;
-    }
-    
-    // 查找校验和位置
-    const char *checksum_pos = strrchr(sentence, '*');
-    if (!checksum_pos) {
-        return false;  // 没有校验和
-    }
-    
-    // 计算校验和
-    uint8_t calculated_checksum = 0;
-    for (const char *p = sentence + 1; p < checksum_pos; p++) {
-        calculated_checksum ^= *p;
+    if (LOS_MuxPend(g_gps_mutex, 1000) != LOS_OK) {
+        return -2;
     }
-    
-    // 解析校验和
-    uint8_t provided_checksum = (uint8_t)strtol(checksum_pos + 1, NULL, 16);
-    
-    return calculated_checksum == provided_checksum;
+    *quality = g_gps_quality;
+    LOS_MuxPost(g_gps_mutex);
+
+    return 0;
 }
 
 /**
@@ -259,141 +315,425 @@ void GPS_PrintDebugInfo(void)
     printf("  Total sentences: %d\n", g_gps_stats.total_sentences);
     printf("  Valid sentences: %d\n", g_gps_stats.valid_sentences);
     printf("  GGA count: %d\n", g_gps_stats.gga_count);
+    printf("  RMC/GSA/GSV/VTG count: %d/%d/%d/%d\n", g_gps_stats.rmc_count, g_gps_stats.gsa_count,
+           g_gps_stats.gsv_count, g_gps_stats.vtg_count);
     printf("  Parse errors: %d\n", g_gps_stats.parse_errors);
+    printf("  RX: %u bytes, %u lines, %u overruns, %u wakeups, latency avg %ums max %ums\n",
+           g_gps_stats.rx_bytes, g_gps_stats.rx_lines, g_gps_stats.rx_overruns, g_gps_stats.rx_wakeups,
+           g_gps_stats.line_latency_avg_ms, g_gps_stats.line_latency_max_ms);
+    printf("Quality: fix %d/%dD, sats %d/%d (GPS %d, GLO %d, GAL %d, BDS %d), PDOP %.2f HDOP %.2f VDOP %.2f, C/N0 %d/%d dB-Hz\n",
+           g_gps_quality.fix_quality, g_gps_quality.fix_type,
+           g_gps_quality.satellites_used, g_gps_quality.satellites_in_view,
+           g_gps_quality.used_by_system[NMEA_SYSTEM_GPS], g_gps_quality.used_by_system[NMEA_SYSTEM_GLONASS],
+           g_gps_quality.used_by_system[NMEA_SYSTEM_GALILEO], g_gps_quality.used_by_system[NMEA_SYSTEM_BEIDOU],
+           g_gps_quality.pdop / 100.0f, g_gps_quality.hdop / 100.0f, g_gps_quality.vdop / 100.0f,
+           g_gps_quality.cn0_mean, g_gps_quality.cn0_max);
     printf("=============================\n\n");
 }
 
 /**
- * @brief 解析GGA语句
+ * @brief 根据定位质量、DOP和载噪比更新精度估计
+ * @note 调用者需持有g_gps_mutex
  */
-int GPS_ParseGGA(const char *sentence)
+static void UpdateAccuracyEstimate(void)
 {
-    if (!sentence) {
-        return -1;
+    GpsQuality *q = &g_gps_quality;
+    float uere;
+
+    switch (q->fix_quality) {
+        case 2:
+            uere = GPS_UERE_DGPS;
+            break;
+        case 4:
+            uere = GPS_UERE_RTK_FIXED;
+            break;
+        case 5:
+            uere = GPS_UERE_RTK_FLOAT;
+            break;
+        default:
+            uere = GPS_UERE_SINGLE;
+            break;
     }
 
-    // 验证校验和
-    if (!GPS_VerifyChecksum(sentence)) {
-        g_gps_stats.parse_errors++;
-        return -2;
+    // 弱信号下多路径和噪声误差显著增大
+    if (q->tracked > 0 && q->cn0_mean < GPS_WEAK_CN0) {
+        uere *= 1.5f;
     }
 
-    // 复制原始数据
-    strncpy(g_gps_raw_data.raw_sentence, sentence, sizeof(g_gps_raw_data.raw_sentence) - 1);
-    g_gps_raw_data.raw_sentence[sizeof(g_gps_raw_data.raw_sentence) - 1] = '\0';
+    // HDOP未知时精度按不可用处理，避免被当作0米误差
+    if (q->hdop == 0) {
+        q->horizontal_accuracy = GPS_ACCURACY_UNKNOWN;
+        q->vertical_accuracy = GPS_ACCURACY_UNKNOWN;
+        return;
+    }
+
+    q->horizontal_accuracy = q->hdop / 100.0f * uere;
+    // 缺少VDOP时按典型值VDOP≈1.5×HDOP估计
+    q->vertical_accuracy = (q->vdop > 0 ? q->vdop : q->hdop * 3 / 2) / 100.0f * uere;
+}
 
-    // 解析GGA语句
-    char *copy = strdup(sentence);
-    if (!copy) {
-        g_gps_stats.parse_errors++;
-        return -3;
+/**
+ * @brief UTC日期时间转换为2000-01-01起的秒数
+ */
+static uint32_t UtcToSeconds(uint16_t year, uint8_t month, uint8_t day, uint32_t time_ms)
+{
+    // 按3月为年首计算日序，闰日落在年末
+    uint32_t y = year - ((month <= 2) ? 1 : 0);
+    uint32_t m = (month <= 2) ? month + 9 : month - 3;
+    uint32_t days = 365 * y + y / 4 - y / 100 + y / 400 + (153 * m + 2) / 5 + day - 1;
+    const uint32_t days_2000 = 730425;  // 2000-01-01按同一公式的日序
+
+    return (days - days_2000) * 86400 + time_ms / 1000;
+}
+
+/**
+ * @brief GGA当日时间结合最近RMC日期换算为UTC秒数
+ * @note 接收机先输出RMC或先输出GGA都按GGA自身的历元计时；跨零点时相差超过半天的按相邻日期修正
+ * @return UTC秒数, 0: 尚无有效日期
+ */
+static uint32_t GgaToSeconds(uint32_t time_ms)
+{
+    const uint32_t half_day_ms = 12 * 3600 * 1000;
+    uint32_t seconds;
+
+    if (g_rmc_date_seconds == 0) {
+        return 0;
     }
 
-    int field_index = 0;
-    char *token;
-    char *saveptr;
-    char *p = copy;
+    seconds = g_rmc_date_seconds + time_ms / 1000;
+    if (time_ms + half_day_ms < g_rmc_time_ms) {
+        seconds += 86400;       // RMC在零点前，GGA在零点后
+    } else if (time_ms > g_rmc_time_ms + half_day_ms && seconds >= 86400) {
+        seconds -= 86400;       // RMC在零点后，GGA在零点前
+    }
+    return seconds;
+}
 
-    while ((token = strtok_r(p, ",", &saveptr)) != NULL) {
-        p = NULL;
-        field_index++;
+/**
+ * @brief 应用GGA定位结果
+ * @note 调用者需持有g_gps_mutex
+ */
+static void ApplyGga(const NmeaGga *gga)
+{
+    GpsQuality *q = &g_gps_quality;
+    uint8_t gsa_used = 0;
 
-        switch (field_index) {
-            case 3: // 纬度
-                if (strlen(token) > 0) {
-                    strncpy(g_gps_raw_data.latitude_str, token, sizeof(g_gps_raw_data.latitude_str) - 1);
-                }
-                break;
-            case 4: // 南北半球指示符
-                g_gps_raw_data.ns_indicator = token[0];
-                break;
-            case 5: // 经度
-                if (strlen(token) > 0) {
-                    strncpy(g_gps_raw_data.longitude_str, token, sizeof(g_gps_raw_data.longitude_str) - 1);
-                }
-                break;
-            case 6: // 东西半球指示符
-                g_gps_raw_data.ew_indicator = token[0];
-                break;
-            case 7: // 定位质量指示符
-                g_gps_raw_data.quality_indicator = token[0];
-                break;
-            case 8: // 卫星数量
-                g_gps_raw_data.satellite_count = (uint8_t)atoi(token);
-                break;
-            case 9: // 水平精度因子
-                g_gps_raw_data.hdop = atof(token);
-                break;
-            case 10: // 海拔高度
-                g_gps_raw_data.altitude = atof(token);
-                break;
-            case 11: // 海拔单位
-                g_gps_raw_data.altitude_unit = token[0];
-                break;
-            default:
-                break;
+    for (int i = 0; i < NMEA_SYSTEM_COUNT; i++) {
+        gsa_used += q->used_by_system[i];
+    }
+
+    q->fix_quality = gga->quality;
+    if (gga->present & NMEA_GGA_HAS_TIME) {
+        q->utc_time_ms = gga->utc_time_ms;
+    }
+    // GSA按系统列出的卫星数比GGA更准确（部分接收机GGA最多报12颗）
+    q->satellites_used = (gsa_used > 0) ? gsa_used : gga->satellites;
+    if (q->hdop == 0 && (gga->present & NMEA_GGA_HAS_HDOP)) {
+        q->hdop = gga->hdop;
+    }
+    UpdateAccuracyEstimate();
+    q->update_time = LOS_TickCountGet();
+
+    // 检查数据有效性
+    if (gga->quality >= 1 && (gga->present & NMEA_GGA_HAS_POSITION) == NMEA_GGA_HAS_POSITION) {
+        // 定点值只在此处转换一次
+        g_current_gps_data.latitude = gga->latitude / 1e7;
+        g_current_gps_data.longitude = gga->longitude / 1e7;
+        if (gga->present & NMEA_GGA_HAS_ALTITUDE) {
+            g_current_gps_data.altitude = gga->altitude / 100.0f;
+        }
+        g_current_gps_data.accuracy = q->horizontal_accuracy;
+        g_current_gps_data.vertical_accuracy = q->vertical_accuracy;
+        g_current_gps_data.pdop = q->pdop / 100.0f;
+        g_current_gps_data.fix_quality = q->fix_quality;
+        g_current_gps_data.fix_type = q->fix_type;
+        g_current_gps_data.satellites_used = q->satellites_used;
+        g_current_gps_data.utc_seconds = (gga->present & NMEA_GGA_HAS_TIME) ? GgaToSeconds(gga->utc_time_ms) : 0;
+        g_current_gps_data.valid = true;
+        g_current_gps_data.last_update_time = q->update_time;
+
+        // 复制原始数据
+        snprintf(g_current_gps_data.raw_data, sizeof(g_current_gps_data.raw_data),
+                 "%.6f,%.6f,%.1f", g_current_gps_data.latitude,
+                 g_current_gps_data.longitude, g_current_gps_data.altitude);
+
+        g_gps_stats.status = GPS_STATUS_FIXED;
+        g_gps_stats.valid_sentences++;
+
+        if (q->update_time - g_last_fix_log >= GPS_LOG_INTERVAL_MS) {
+            printf("GPS: %.6f°, %.6f°, %.1fm (Sats: %d/%d, HDOP: %.2f, Acc: %.1fm)\n",
+                   g_current_gps_data.latitude, g_current_gps_data.longitude,
+                   g_current_gps_data.altitude, q->satellites_used, q->satellites_in_view,
+                   q->hdop / 100.0f, q->horizontal_accuracy);
+            g_last_fix_log = q->update_time;
         }
+    } else {
+        g_gps_stats.status = GPS_STATUS_SEARCHING;
     }
 
-    free(copy);
+    g_gps_stats.gga_count++;
+    g_gps_stats.last_update_time = q->update_time;
+}
 
-    // 更新GPS数据
-    if (LOS_MuxPend(g_gps_mutex, 1000) == LOS_OK) {
-        // 检查数据有效性
-        if (g_gps_raw_data.quality_indicator >= '1' &&
-            strlen(g_gps_raw_data.latitude_str) > 0 &&
-            strlen(g_gps_raw_data.longitude_str) > 0) {
-
-            // 转换坐标
-            g_current_gps_data.latitude = GPS_ConvertCoordinate(g_gps_raw_data.latitude_str);
-            g_current_gps_data.longitude = GPS_ConvertCoordinate(g_gps_raw_data.longitude_str);
-
-            // 应用南北/东西半球指示符
-            if (g_gps_raw_data.ns_indicator == 'S' || g_gps_raw_data.ns_indicator == 's') {
-                g_current_gps_data.latitude = -g_current_gps_data.latitude;
-            }
-            if (g_gps_raw_data.ew_indicator == 'W' || g_gps_raw_data.ew_indicator == 'w') {
-                g_current_gps_data.longitude = -g_current_gps_data.longitude;
+/**
+ * @brief 应用RMC时间、日期和速度
+ * @note 调用者需持有g_gps_mutex
+ */
+static void ApplyRmc(const NmeaRmc *rmc)
+{
+    GpsQuality *q = &g_gps_quality;
+
+    if (rmc->present & NMEA_RMC_HAS_TIME) {
+        q->utc_time_ms = rmc->utc_time_ms;
+    }
+    if (rmc->present & NMEA_RMC_HAS_DATE) {
+        q->utc_year = rmc->year;
+        q->utc_month = rmc->month;
+        q->utc_day = rmc->day;
+    }
+    // 只记录日期，定位时间取自GGA（RMC可能先于同历元GGA输出，不能给上一历元的位置计时）
+    if ((rmc->present & NMEA_RMC_HAS_TIME) && (rmc->present & NMEA_RMC_HAS_DATE) && rmc->status == 'A' &&
+        rmc->month >= 1 && rmc->month <= 12 && rmc->day >= 1) {
+        g_rmc_date_seconds = UtcToSeconds(rmc->year, rmc->month, rmc->day, 0);
+        g_rmc_time_ms = rmc->utc_time_ms;
+    }
+    if (rmc->present & NMEA_RMC_HAS_SPEED) {
+        q->speed = rmc->speed;
+    }
+    if (rmc->present & NMEA_RMC_HAS_COURSE) {
+        q->course = rmc->course;
+    }
+    g_gps_stats.rmc_count++;
+}
+
+/**
+ * @brief 应用GSA精度因子和参与定位卫星
+ * @note 调用者需持有g_gps_mutex；多系统接收机每个历元连续输出多条GSA
+ */
+static void ApplyGsa(const NmeaGsa *gsa)
+{
+    GpsQuality *q = &g_gps_quality;
+
+    // 新历元的第一条GSA：清除上一历元的各系统卫星数
+    if (g_last_sentence != NMEA_TYPE_GSA) {
+        memset(q->used_by_system, 0, sizeof(q->used_by_system));
+        q->fix_type = 0;
+    }
+
+    if (gsa->system < NMEA_SYSTEM_COUNT) {
+        q->used_by_system[gsa->system] = gsa->used_count;
+    }
+    if (gsa->fix_type > q->fix_type) {
+        q->fix_type = gsa->fix_type;
+    }
+    if (gsa->pdop > 0) {
+        q->pdop = gsa->pdop;
+        q->hdop = gsa->hdop;
+        q->vdop = gsa->vdop;
+    }
+    g_gps_stats.gsa_count++;
+}
+
+/**
+ * @brief 应用GSV可见卫星和载噪比
+ * @note 调用者需持有g_gps_mutex
+ */
+static void ApplyGsv(const NmeaGsv *gsv)
+{
+    GpsQuality *q = &g_gps_quality;
+
+    g_gps_stats.gsv_count++;
+    if (gsv->system >= NMEA_SYSTEM_COUNT) {
+        return;
+    }
+
+    GsvAccumulator *acc = &g_gsv_receiving[gsv->system];
+    if (gsv->message_number == 1) {
+        memset(acc, 0, sizeof(GsvAccumulator));
+    }
+    acc->in_view = gsv->in_view;
+    for (int i = 0; i < gsv->count; i++) {
+        uint8_t cn0 = gsv->sats[i].cn0;
+        if (cn0 > 0) {
+            acc->tracked++;
+            acc->cn0_sum += cn0;
+            if (cn0 > acc->cn0_max) {
+                acc->cn0_max = cn0;
             }
+        }
+    }
+    if (gsv->message_number != gsv->total_messages) {
+        return;
+    }
 
-            // 更新其他数据
-            g_current_gps_data.altitude = g_gps_raw_data.altitude;
-            g_current_gps_data.accuracy = g_gps_raw_data.hdop * 5.0;  // 估算精度
-            g_current_gps_data.valid = true;
-            g_current_gps_data.last_update_time = LOS_TickCountGet();
+    // 一组收齐后汇总所有系统
+    g_gsv_complete[gsv->system] = *acc;
+    uint16_t cn0_sum = 0;
+    q->satellites_in_view = 0;
+    q->tracked = 0;
+    q->cn0_max = 0;
+    for (int i = 0; i < NMEA_SYSTEM_COUNT; i++) {
+        const GsvAccumulator *done = &g_gsv_complete[i];
+        q->in_view_by_system[i] = done->in_view;
+        q->satellites_in_view += done->in_view;
+        q->tracked += done->tracked;
+        cn0_sum += done->cn0_sum;
+        if (done->cn0_max > q->cn0_max) {
+            q->cn0_max = done->cn0_max;
+        }
+    }
+    q->cn0_mean = (q->tracked > 0) ? (uint8_t)(cn0_sum / q->tracked) : 0;
+}
 
-            // 复制原始数据
-            snprintf(g_current_gps_data.raw_data, sizeof(g_current_gps_data.raw_data),
-                     "%.6f,%.6f,%.1f", g_current_gps_data.latitude,
-                     g_current_gps_data.longitude, g_current_gps_data.altitude);
+/**
+ * @brief 应用VTG速度
+ * @note 调用者需持有g_gps_mutex
+ */
+static void ApplyVtg(const NmeaVtg *vtg)
+{
+    if (vtg->has_speed) {
+        g_gps_quality.speed = vtg->speed;
+    }
+    if (vtg->has_course) {
+        g_gps_quality.course = vtg->course;
+    }
+    g_gps_stats.vtg_count++;
+}
 
-            g_gps_stats.status = GPS_STATUS_FIXED;
-            g_gps_stats.valid_sentences++;
+/**
+ * @brief 分发校验通过的语句
+ */
+static void HandleSentence(NmeaType type)
+{
+    if (LOS_MuxPend(g_gps_mutex, 1000) != LOS_OK) {
+        return;
+    }
 
-            printf("GPS: %.6f°, %.6f°, %.1fm (Sats: %d)\n",
-                   g_current_gps_data.latitude, g_current_gps_data.longitude,
-                   g_current_gps_data.altitude, g_gps_raw_data.satellite_count);
-        } else {
-            g_gps_stats.status = GPS_STATUS_SEARCHING;
+    switch (type) {
+        case NMEA_TYPE_GGA:
+            ApplyGga(&g_nmea_parser.gga);
+            break;
+        case NMEA_TYPE_RMC:
+            ApplyRmc(&g_nmea_parser.rmc);
+            break;
+        case NMEA_TYPE_GSA:
+            ApplyGsa(&g_nmea_parser.gsa);
+            break;
+        case NMEA_TYPE_GSV:
+            ApplyGsv(&g_nmea_parser.gsv);
+            break;
+        case NMEA_TYPE_VTG:
+            ApplyVtg(&g_nmea_parser.vtg);
+            break;
+        default:
+            break;
+    }
+    g_last_sentence = type;
+
+    LOS_MuxPost(g_gps_mutex);
+}
+
+/**
+ * @brief 同步解析器统计到GPS统计信息
+ */
+static void SyncParserStats(void)
+{
+    const NmeaStats *stats = &g_nmea_parser.stats;
+    uint32_t errors = stats->checksum_errors + stats->format_errors;
+
+    g_gps_stats.total_sentences = stats->sentences + errors;
+    g_gps_stats.parse_errors = errors;
+    g_gps_stats.rx_overruns = g_rx_overruns - g_rx_overruns_base;
+    g_gps_stats.line_latency_avg_ms = g_rx_latency_count > 0 ?
+                                      (uint32_t)(g_rx_latency_sum / g_rx_latency_count) : 0;
+}
+
+/**
+ * @brief 写入接收环形缓冲区（生产者，不加锁，可改为在UART中断中调用）
+ * @return 写入的行结束符数
+ */
+static uint32_t GpsRxPush(const uint8_t *data, uint32_t len)
+{
+    uint32_t head = g_rx_head;
+    uint32_t lines = 0;
+    uint32_t now = LOS_TickCountGet();
+
+    for (uint32_t i = 0; i < len; i++) {
+        if (head - g_rx_tail >= GPS_RX_RING_SIZE) {
+            // 缓冲区满：丢弃新数据，残缺语句由校验和剔除
+            g_rx_overruns += len - i;
+            break;
+        }
+        g_rx_ring[head & (GPS_RX_RING_SIZE - 1)] = data[i];
+        head++;
+        if (data[i] == '\n') {
+            uint32_t line = g_rx_lines_produced;
+            g_rx_line_ticks[line & (GPS_RX_LINE_SLOTS - 1)] = now;
+            g_rx_lines_produced = line + 1;
+            lines++;
         }
+    }
+    g_rx_head = head;
 
-        g_gps_stats.gga_count++;
-        g_gps_stats.last_update_time = LOS_TickCountGet();
+    return lines;
+}
 
-        LOS_MuxPost(g_gps_mutex);
+/**
+ * @brief 记录一行语句从接收完成到解析的延迟
+ */
+static void RecordLineLatency(uint32_t now)
+{
+    uint32_t line = g_rx_lines_consumed++;
+    uint32_t tick = g_rx_line_ticks[line & (GPS_RX_LINE_SLOTS - 1)];
+
+    // 积压超过槽位数时时间戳已被覆盖，不计入延迟统计
+    if (g_rx_lines_produced - line >= GPS_RX_LINE_SLOTS) {
+        return;
     }
 
-    return 0;
+    uint32_t latency = now - tick;
+    g_rx_latency_sum += latency;
+    g_rx_latency_count++;
+    if (latency > g_gps_stats.line_latency_max_ms) {
+        g_gps_stats.line_latency_max_ms = latency;
+    }
 }
 
 /**
- * @brief GPS任务函数
+ * @brief 解析环形缓冲区中的全部数据（消费者）
  */
-void GPS_Task(void *arg)
+static void GpsRxDrain(void)
 {
-    (void)arg;
+    uint32_t tail = g_rx_tail;
+    uint32_t head = g_rx_head;
+    uint32_t now = LOS_TickCountGet();
 
-    printf("GPS task started\n");
+    g_gps_stats.rx_bytes += head - tail;
+
+    // 逐字节解析，语句校验通过时才提交结果
+    while (tail != head) {
+        char c = (char)g_rx_ring[tail & (GPS_RX_RING_SIZE - 1)];
+        tail++;
+
+        NmeaType type = Nmea_Feed(&g_nmea_parser, c);
+        if (type != NMEA_TYPE_UNKNOWN) {
+            HandleSentence(type);
+        }
+        if (c == '\n') {
+            g_gps_stats.rx_lines++;
+            RecordLineLatency(now);
+        }
+    }
+    g_rx_tail = tail;
+}
+
+/**
+ * @brief GPS串口接收任务：搬运UART数据到环形缓冲区
+ * @note HAL未提供UART接收回调，按硬件FIFO填满时间的一半轮询；收到完整语句才唤醒解析任务
+ */
+void GPS_RxTask(void *arg)
+{
+    (void)arg;
 
     // 初始化UART
     IotUartAttribute uart_attr = {
@@ -419,49 +759,57 @@ void GPS_Task(void *arg)
         return;
     }
 
-    printf("GPS UART initialized successfully (Port: EUART0_M0, Baudrate: %d)\n", GPS_UART_BAUDRATE);
+    printf("GPS UART initialized successfully (Port: EUART0_M0, Baudrate: %d, poll %dms)\n",
+           GPS_UART_BAUDRATE, GPS_RX_POLL_MS);
+
+    uint8_t chunk[GPS_UART_FIFO_SIZE];
+
+    while (1) {
+        Profiler_LoopBegin();
+        int len = IoTUartRead(GPS_UART_PORT, chunk, sizeof(chunk));
+
+        if (len > 0 && GpsRxPush(chunk, (uint32_t)len) > 0) {
+            LOS_EventWrite(&g_gps_rx_event, GPS_RX_EVENT_LINE);
+        }
+
+        // 读满一个FIFO说明还有积压，立即继续读取
+        if (len < (int)sizeof(chunk)) {
+            Profiler_LoopEnd(GPS_RX_POLL_MS);
+            LOS_Msleep(GPS_RX_POLL_MS);
+        } else {
+            Profiler_LoopEnd(0);
+        }
+    }
+}
+
+/**
+ * @brief GPS任务函数
+ */
+void GPS_Task(void *arg)
+{
+    (void)arg;
+
+    printf("GPS task started\n");
 
-    // 接收缓冲区
-    unsigned char recv_buf[GPS_RECV_BUF_SIZE] = {0};
-    char line_buf[GPS_MAX_SENTENCE_LEN] = {0};
-    int line_pos = 0;
     int no_data_count = 0;
     uint32_t last_status_print = 0;
 
-    g_gps_stats.status = GPS_STATUS_SEARCHING;
+    // 接收任务优先级更高，先完成UART初始化；初始化失败时保留错误状态
+    if (g_gps_stats.status == GPS_STATUS_INIT) {
+        g_gps_stats.status = GPS_STATUS_SEARCHING;
+    }
 
     while (1) {
-        // 读取UART数据
-        int len = IoTUartRead(GPS_UART_PORT, recv_buf, sizeof(recv_buf) - 1);
+        // 等待完整语句，超时用于检测数据丢失
+        UINT32 events = LOS_EventRead(&g_gps_rx_event, GPS_RX_EVENT_LINE,
+                                      LOS_WAITMODE_OR | LOS_WAITMODE_CLR, GPS_RX_WAIT_MS);
+        Profiler_LoopBegin();
 
-        if (len > 0) {
+        if (events & GPS_RX_EVENT_LINE) {
             no_data_count = 0;
-            g_gps_stats.total_sentences++;
-
-            // 处理接收到的数据
-            for (int i = 0; i < len; i++) {
-                char c = recv_buf[i];
-
-                if (c == '\n' || c == '\r') {
-                    if (line_pos > 0) {
-                        line_buf[line_pos] = '\0';
-
-                        // 解析NMEA语句
-                        if (strncmp(line_buf, "$GPGGA", 6) == 0 || strncmp(line_buf, "$GNGGA", 6) == 0) {
-                            GPS_ParseGGA(line_buf);
-                        }
-
-                        // 重置行缓冲区
-                        line_pos = 0;
-                        memset(line_buf, 0, sizeof(line_buf));
-                    }
-                } else {
-                    // 添加字符到行缓冲区
-                    if (line_pos < GPS_MAX_SENTENCE_LEN - 1) {
-                        line_buf[line_pos++] = c;
-                    }
-                }
-            }
+            g_gps_stats.rx_wakeups++;
+            GpsRxDrain();
+            SyncParserStats();
         } else {
             no_data_count++;
 
@@ -489,12 +837,8 @@ void GPS_Task(void *arg)
                 last_status_print = current_time;
             }
         }
-
-        // 任务延时
-        usleep(10000);  // 10ms
+        Profiler_LoopEnd(GPS_RX_WAIT_MS);
     }
 
-    // 清理资源
-    IoTUartDeinit(GPS_UART_PORT);
     printf("GPS task ended\n");
 }
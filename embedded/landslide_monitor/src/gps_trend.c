@@ -0,0 +1,193 @@
+#include "gps_trend.h"
+#include <string.h>
+#include <math.h>
+
+// 时间单位：毫秒转小时
+#define MS_PER_HOUR         3600000.0
+
+// 95%双侧Student t分位数（按自由度1~10），自由度更大时取2.0
+static const float g_t95[] = {12.71f, 4.30f, 3.18f, 2.78f, 2.57f, 2.45f, 2.36f, 2.31f, 2.26f, 2.23f};
+
+/**
+ * @brief 95%置信区间系数
+ */
+static float StudentT95(int dof)
+{
+    if (dof < 1) {
+        return 0.0f;
+    }
+    if (dof <= (int)(sizeof(g_t95) / sizeof(g_t95[0]))) {
+        return g_t95[dof - 1];
+    }
+    return 2.0f;
+}
+
+/**
+ * @brief 相对时间零点的小时数
+ */
+static double Hours(const GpsTrend *trend, uint32_t timestamp)
+{
+    return (double)(timestamp - trend->ref_ms) / MS_PER_HOUR;
+}
+
+/**
+ * @brief 把样本计入（sign=1）或移出（sign=-1）窗口累加和
+ */
+static void Accumulate(const GpsTrend *trend, GpsTrendWindow *window, const GpsTrendSample *sample, double sign)
+{
+    double t = Hours(trend, sample->timestamp);
+    double x[3] = {sample->position.east, sample->position.north, sample->position.up};
+    double p = sign;
+
+    for (int k = 0; k < 5; k++) {
+        window->st[k] += p;
+        p *= t;
+    }
+    for (int axis = 0; axis < 3; axis++) {
+        window->sx[axis][0] += sign * x[axis];
+        window->sx[axis][1] += sign * t * x[axis];
+        window->sx[axis][2] += sign * t * t * x[axis];
+        window->sxx[axis] += sign * x[axis] * x[axis];
+    }
+}
+
+/**
+ * @brief 按新的时间零点从样本重新计算窗口累加和
+ */
+static void Recompute(GpsTrend *trend, GpsTrendWindow *window)
+{
+    uint32_t n = (trend->total < window->size) ? trend->total : window->size;
+
+    memset(window->st, 0, sizeof(window->st));
+    memset(window->sx, 0, sizeof(window->sx));
+    memset(window->sxx, 0, sizeof(window->sxx));
+    for (uint32_t i = trend->total - n; i < trend->total; i++) {
+        Accumulate(trend, window, &trend->samples[i % GPS_TREND_CAPACITY], 1.0);
+    }
+    window->count = (uint16_t)n;
+}
+
+/**
+ * @brief 初始化趋势估计器
+ */
+void GpsTrend_Init(GpsTrend *trend)
+{
+    memset(trend, 0, sizeof(GpsTrend));
+    trend->windows[GPS_TREND_SHORT].size = GPS_TREND_SHORT_WINDOW;
+    trend->windows[GPS_TREND_LONG].size = GPS_TREND_LONG_WINDOW;
+}
+
+/**
+ * @brief 输入一个位置样本
+ */
+void GpsTrend_Add(GpsTrend *trend, uint32_t timestamp, const GpsEnuVector *position)
+{
+    uint32_t index = trend->total;
+
+    // 先移出各窗口最旧样本（最长窗口的最旧样本即将被覆盖）
+    for (int w = 0; w < GPS_TREND_WINDOW_COUNT; w++) {
+        GpsTrendWindow *window = &trend->windows[w];
+        if (window->count == window->size) {
+            Accumulate(trend, window, &trend->samples[(index - window->size) % GPS_TREND_CAPACITY], -1.0);
+            window->count--;
+        }
+    }
+
+    GpsTrendSample *sample = &trend->samples[index % GPS_TREND_CAPACITY];
+    sample->timestamp = timestamp;
+    sample->position = *position;
+    trend->total++;
+
+    if (index == 0) {
+        trend->ref_ms = timestamp;
+        trend->ref_index = 0;
+    }
+
+    // 时间零点样本移出缓冲区后改以最旧样本为零点并重算（每CAPACITY次一次），保持t较小以免累加和失去精度
+    if (index - trend->ref_index >= GPS_TREND_CAPACITY) {
+        trend->ref_index = index - GPS_TREND_CAPACITY + 1;
+        trend->ref_ms = trend->samples[trend->ref_index % GPS_TREND_CAPACITY].timestamp;
+        for (int w = 0; w < GPS_TREND_WINDOW_COUNT; w++) {
+            Recompute(trend, &trend->windows[w]);
+        }
+        return;
+    }
+
+    for (int w = 0; w < GPS_TREND_WINDOW_COUNT; w++) {
+        Accumulate(trend, &trend->windows[w], sample, 1.0);
+        trend->windows[w].count++;
+    }
+}
+
+/**
+ * @brief 计算窗口拟合结果
+ */
+int GpsTrend_GetFit(const GpsTrend *trend, GpsTrendWindowId window_id, GpsTrendFit *fit)
+{
+    const GpsTrendWindow *window = &trend->windows[window_id];
+    int n = window->count;
+
+    memset(fit, 0, sizeof(GpsTrendFit));
+    if (n < GPS_TREND_MIN_LINEAR) {
+        return -1;
+    }
+
+    const double *st = window->st;
+    double first = Hours(trend, trend->samples[(trend->total - n) % GPS_TREND_CAPACITY].timestamp);
+    double last = Hours(trend, trend->samples[(trend->total - 1) % GPS_TREND_CAPACITY].timestamp);
+
+    // 线性拟合 x = a + b·t
+    double det = st[0] * st[2] - st[1] * st[1];
+    if (det <= 1e-12 * st[0] * st[2]) {
+        return -1;      // 样本时间相同
+    }
+
+    float t_linear = StudentT95(n - 2);
+    for (int axis = 0; axis < 3; axis++) {
+        const double *sx = window->sx[axis];
+        double b = (st[0] * sx[1] - st[1] * sx[0]) / det;
+        double a = (sx[0] - b * st[1]) / st[0];
+        double ssr = window->sxx[axis] - a * sx[0] - b * sx[1];
+        double s2 = (ssr > 0 && n > 2) ? ssr / (n - 2) : 0;
+
+        fit->velocity[axis] = (float)b;
+        fit->velocity_ci[axis] = t_linear * (float)sqrt(s2 * st[0] / det);
+    }
+
+    fit->span_hours = (float)(last - first);
+    fit->samples = (uint16_t)n;
+    fit->valid = true;
+
+    if (n < GPS_TREND_MIN_QUADRATIC) {
+        return 0;
+    }
+
+    // 二次拟合 x = a + b·t + c·t²，正规方程矩阵求逆（对称阵余子式）
+    double m00 = st[0], m01 = st[1], m02 = st[2], m11 = st[2], m12 = st[3], m22 = st[4];
+    double c00 = m11 * m22 - m12 * m12;
+    double c01 = m02 * m12 - m01 * m22;
+    double c02 = m01 * m12 - m02 * m11;
+    double c11 = m00 * m22 - m02 * m02;
+    double c12 = m01 * m02 - m00 * m12;
+    double c22 = m00 * m11 - m01 * m01;
+    double det3 = m00 * c00 + m01 * c01 + m02 * c02;
+    if (fabs(det3) <= 1e-12 * fabs(m00 * c00)) {
+        return 0;
+    }
+
+    float t_quadratic = StudentT95(n - 3);
+    for (int axis = 0; axis < 3; axis++) {
+        const double *sx = window->sx[axis];
+        double b0 = (c00 * sx[0] + c01 * sx[1] + c02 * sx[2]) / det3;
+        double b1 = (c01 * sx[0] + c11 * sx[1] + c12 * sx[2]) / det3;
+        double b2 = (c02 * sx[0] + c12 * sx[1] + c22 * sx[2]) / det3;
+        double ssr = window->sxx[axis] - b0 * sx[0] - b1 * sx[1] - b2 * sx[2];
+        double s2 = (ssr > 0) ? ssr / (n - 3) : 0;
+
+        fit->acceleration[axis] = (float)(2.0 * b2);
+        fit->acceleration_ci[axis] = t_quadratic * 2.0f * (float)sqrt(s2 * c22 / det3);
+    }
+    fit->acceleration_valid = true;
+
+    return 0;
+}
@@ -14,6 +14,13 @@
  */
 
 #include "iot_cloud.h"
+#include "data_cache.h"
+#include "gps_deformation.h"
+#include "gps_differential.h"
+#include "risk_rules.h"
+#include "tilt_creep.h"
+#include "output_devices.h"
+#include "task_profiler.h"
 #include "MQTTClient.h"
 #include "cJSON.h"
 #include "cmsis_os2.h"
@@ -31,6 +38,7 @@
 
 #define MAX_BUFFER_LENGTH 1024
 #define MAX_STRING_LENGTH 64
+#define EXPORT_CHUNK_SIZE 480       // 形变历史导出每块字节数（二进制20条记录）
 
 // MQTT相关变量（参考e1_iot_smart_home）
 static unsigned char sendBuf[MAX_BUFFER_LENGTH];
@@ -43,7 +51,6 @@ static MQTTClient client;
 // 不再需要静态字符数组，直接使用宏定义更简洁高效
 
 // 前向声明
-static void convert_landslide_to_iot_data(const LandslideIotData *landslide_data, e_iot_data *iot_data);
 void set_motor_state(cJSON *root);
 void set_buzzer_state(cJSON *root);
 void set_rgb_state(cJSON *root);
@@ -51,265 +58,130 @@ void set_alarm_reset(void);
 
 static unsigned int mqttConnectFlag = 0;
 
-// 数据缓存和连接状态管理
-static DataCache g_data_cache = {0};
+// 连接状态管理
 static ConnectionStatus g_connection_status = {0};
-static bool g_cache_initialized = false;
+static bool g_network_ready = false;  // WiFi连接成功、网络任务进入主循环后置位
+
+// 形变历史导出（命令回调和发送都在网络任务中执行）
+static GpsExportCursor g_export_cursor;
+static bool g_export_active = false;
+
+// 任务统计上报（0为关闭，由task_profile命令设置）
+static uint32_t g_profile_report_interval_ms = 0;
+static uint32_t g_last_profile_report = 0;
 
 // WiFi重连计数器（全局变量，便于在不同函数间共享）
 uint32_t wifi_reconnect_attempts = 0;
 
-// ==================== 数据缓存管理功能 ====================
+// ==================== 数据缓存补发功能 ====================
 
 /**
- * @brief 初始化数据缓存系统
- * @return 0成功，-1失败
+ * @brief 缓存补发回调：发布到MQTT
+ * @param item 缓存数据
+ * @return 0: 成功, 1: 未连接（稍后重试）, -1: 发布失败
  */
-int DataCache_Init(void)
+static int SendCachedItem(const DataCacheItem *item)
 {
-    if (g_cache_initialized) {
-        return 0;  // 已经初始化
+    if (!mqtt_is_connected()) {
+        return 1;
     }
 
-    // 初始化缓存结构
-    memset(&g_data_cache, 0, sizeof(DataCache));
-    g_data_cache.head = 0;
-    g_data_cache.tail = 0;
-    g_data_cache.count = 0;
-    g_data_cache.is_full = false;
-
-    // 初始化连接状态
-    memset(&g_connection_status, 0, sizeof(ConnectionStatus));
-
-    // 尝试从文件加载缓存数据
-    DataCache_LoadFromFile();
-
-    g_cache_initialized = true;
-    printf(" 数据缓存系统初始化成功\n");
-    DataCache_PrintStats();
-
-    return 0;
-}
+    send_msg_to_mqtt(&item->data);
 
-/**
- * @brief 添加数据到缓存队列
- * @param data IoT数据指针
- * @return 0成功，-1失败
- */
-int DataCache_Add(const e_iot_data *data)
-{
-    if (!g_cache_initialized || data == NULL) {
+    // 发布失败时send_msg_to_mqtt会清除连接标志
+    if (!mqttConnectFlag) {
         return -1;
     }
 
-    // 如果缓存满了，移除最旧的数据
-    if (g_data_cache.count >= MAX_CACHE_SIZE) {
-        printf("  缓存已满，移除最旧数据\n");
-        g_data_cache.head = (g_data_cache.head + 1) % MAX_CACHE_SIZE;
-        g_data_cache.count--;
-    }
-
-    // 添加新数据到队列尾部
-    CachedDataItem *item = &g_data_cache.items[g_data_cache.tail];
-    memcpy(&item->data, data, sizeof(e_iot_data));
-    item->timestamp = LOS_TickCountGet();  // 使用系统tick作为时间戳
-    item->retry_count = 0;
-    item->is_valid = true;
-
-    g_data_cache.tail = (g_data_cache.tail + 1) % MAX_CACHE_SIZE;
-    g_data_cache.count++;
-    g_data_cache.total_cached++;
-
-    printf(" 数据已缓存 [%d/%d] 总缓存:%d\n",
-           g_data_cache.count, MAX_CACHE_SIZE, g_data_cache.total_cached);
-
+    g_connection_status.data_sent_count++;
+    g_connection_status.last_data_send_time = LOS_TickCountGet();
     return 0;
 }
 
 /**
- * @brief 发送缓存中的待发送数据
- * @return 发送成功的数据条数
+ * @brief 发送一块形变历史导出数据（每次主循环最多一块，发布失败时保留游标下次重发）
  */
-int DataCache_SendPending(void)
+static void SendExportChunk(void)
 {
-    if (!g_cache_initialized || g_data_cache.count == 0) {
-        return 0;
-    }
-
-    int sent_count = 0;
-    int processed_count = 0;
-    uint16_t current_head = g_data_cache.head;
-
-    printf(" 开始发送缓存数据，待发送:%d条\n", g_data_cache.count);
-
-    // 遍历缓存队列发送数据
-    while (processed_count < g_data_cache.count && processed_count < 10) {  // 限制单次处理数量
-        CachedDataItem *item = &g_data_cache.items[current_head];
-
-        if (!item->is_valid) {
-            current_head = (current_head + 1) % MAX_CACHE_SIZE;
-            processed_count++;
-            continue;
-        }
-
-        // 检查是否超过最大重试次数
-        if (item->retry_count >= MAX_RETRY_COUNT) {
-            printf(" 数据重试次数超限，丢弃 (重试:%d次)\n", item->retry_count);
-            item->is_valid = false;
-            g_data_cache.total_failed++;
-
-            // 移除失败的数据
-            if (current_head == g_data_cache.head) {
-                g_data_cache.head = (g_data_cache.head + 1) % MAX_CACHE_SIZE;
-                g_data_cache.count--;
-            }
-        } else {
-            // 尝试发送数据
-            // 缓存数据发送日志已优化，减少输出频率
-
-            if (mqtt_is_connected()) {
-                send_msg_to_mqtt(&item->data);
-
-                // 发送成功，标记为无效并移除
-                item->is_valid = false;
-                g_data_cache.total_sent++;
-                sent_count++;
-
-                if (current_head == g_data_cache.head) {
-                    g_data_cache.head = (g_data_cache.head + 1) % MAX_CACHE_SIZE;
-                    g_data_cache.count--;
-                }
-
-                printf(" 缓存数据发送成功\n");
-            } else {
-                // 发送失败，增加重试次数
-                item->retry_count++;
-                printf("  MQTT未连接，重试次数+1 (%d/%d)\n",
-                       item->retry_count, MAX_RETRY_COUNT);
-                break;  // MQTT未连接，停止发送
-            }
-        }
-
-        current_head = (current_head + 1) % MAX_CACHE_SIZE;
-        processed_count++;
-
-        // 避免阻塞太久
-        LOS_Msleep(100);
-    }
-
-    if (sent_count > 0) {
-        printf(" 缓存数据发送完成: %d条成功\n", sent_count);
-        // DataCache_SaveToFile();  // 移除无用的简化实现调用
+    static uint8_t chunk[EXPORT_CHUNK_SIZE];
+    GpsExportCursor cursor = g_export_cursor;
+
+    int len = GPS_Deformation_ExportNext(&cursor, chunk, sizeof(chunk));
+    if (len <= 0) {
+        printf("Deformation export %s: %u records, %u skipped\n", (len == 0) ? "finished" : "failed",
+               cursor.exported, cursor.skipped);
+        g_export_active = false;
+        return;
     }
 
-    return sent_count;
-}
-
-/**
- * @brief 将缓存数据保存到文件
- * @return 0成功，-1失败
- */
-int DataCache_SaveToFile(void)
-{
-    // 注意：rk2206平台文件系统支持有限，这里使用简化实现
-    // 实际项目中可以根据平台特性选择合适的持久化方案
-    printf(" 缓存数据保存到文件 (简化实现)\n");
-    return 0;  // 简化实现，总是返回成功
-}
+    MQTTMessage message;
+    message.qos = 0;
+    message.retained = 0;
+    message.payload = chunk;
+    message.payloadlen = len;
 
-/**
- * @brief Flash数据加载回调函数
- * @param data Flash中的数据
- * @return 0成功，-1失败
- */
-static int FlashDataLoadCallback(const LandslideIotData *data)
-{
-    if (data == NULL) {
-        return -1;
+    if (MQTTPublish(&client, EXPORT_TOPIC, &message) != 0) {
+        printf("Failed to publish deformation export chunk, will retry\n");
+        return;
     }
-
-    // 转换数据格式
-    e_iot_data iot_data;
-    convert_landslide_to_iot_data(data, &iot_data);
-
-    // 添加到内存缓存
-    return DataCache_Add(&iot_data);
+    g_export_cursor = cursor;
 }
 
 /**
- * @brief 从Flash加载缓存数据到内存
- * @return 加载的数据条数
+ * @brief 发布任务统计到PROFILE_TOPIC
  */
-int DataCache_LoadFromFlash(void)
+static void SendTaskProfile(void)
 {
-    printf(" 从Flash加载缓存数据到内存...\n");
-
-    extern int DataStorage_ProcessCached(int (*callback)(const LandslideIotData *data));
-    int loaded_count = DataStorage_ProcessCached(FlashDataLoadCallback);
+    TaskProfile profiles[PROFILER_MAX_TASKS];
+    int count = Profiler_GetStats(profiles, PROFILER_MAX_TASKS);
 
-    if (loaded_count > 0) {
-        printf(" 从Flash加载了 %d 条缓存数据到内存\n", loaded_count);
-    } else {
-        printf(" Flash中没有缓存数据需要加载\n");
+    cJSON *root = cJSON_CreateObject();
+    cJSON_AddNumberToObject(root, "uptime", LOS_TickCountGet() / 1000);
+    cJSON *tasks = cJSON_AddArrayToObject(root, "tasks");
+    for (int i = 0; i < count; i++) {
+        cJSON *task = cJSON_CreateObject();
+        cJSON_AddStringToObject(task, "name", profiles[i].name);
+        cJSON_AddNumberToObject(task, "cpu_percent", roundf(profiles[i].load_percent * 100.0f) / 100.0);
+        cJSON_AddNumberToObject(task, "run_avg_us", profiles[i].run_avg_us);
+        cJSON_AddNumberToObject(task, "run_max_us", profiles[i].run_max_us);
+        cJSON_AddNumberToObject(task, "wake_late_avg_us", profiles[i].wake_late_avg_us);
+        cJSON_AddNumberToObject(task, "wake_late_max_us", profiles[i].wake_late_max_us);
+        cJSON_AddNumberToObject(task, "stack_peak", profiles[i].stack_peak);
+        cJSON_AddNumberToObject(task, "stack_size", profiles[i].stack_size);
+        cJSON_AddItemToArray(tasks, task);
     }
 
-    return loaded_count;
-}
-
-/**
- * @brief 从文件加载缓存数据（保留接口兼容性）
- * @return 0成功，-1失败
- */
-int DataCache_LoadFromFile(void)
-{
-    // 实际从Flash加载数据
-    int loaded = DataCache_LoadFromFlash();
-    return (loaded >= 0) ? 0 : -1;
-}
-
-/**
- * @brief 清空数据缓存
- */
-void DataCache_Clear(void)
-{
-    if (!g_cache_initialized) {
-        return;
+    char *payload = cJSON_PrintUnformatted(root);
+    if (payload != NULL) {
+        MQTTMessage message;
+        message.qos = 0;
+        message.retained = 0;
+        message.payload = payload;
+        message.payloadlen = strlen(payload);
+
+        if (MQTTPublish(&client, PROFILE_TOPIC, &message) != 0) {
+            printf("Failed to publish task profile\n");
+        }
+        cJSON_free(payload);
     }
-
-    memset(&g_data_cache.items, 0, sizeof(g_data_cache.items));
-    g_data_cache.head = 0;
-    g_data_cache.tail = 0;
-    g_data_cache.count = 0;
-    g_data_cache.is_full = false;
-
-    printf("  数据缓存已清空\n");
+    cJSON_Delete(root);
 }
 
 /**
- * @brief 打印缓存统计信息
+ * @brief 计算数据上传成功率（只有重试超限丢弃的数据计为失败）
+ * @param total_attempts 输出总尝试次数
+ * @return 成功率 (%)
  */
-void DataCache_PrintStats(void)
+static float GetUploadSuccessRate(uint32_t *total_attempts)
 {
-    if (!g_cache_initialized) {
-        printf(" 缓存系统未初始化\n");
-        return;
-    }
-
-    printf("\n === 数据缓存统计 ===\n");
-    printf("当前缓存: %d/%d 条\n", g_data_cache.count, MAX_CACHE_SIZE);
-    printf("总缓存数: %d 条\n", g_data_cache.total_cached);
-    printf("发送成功: %d 条\n", g_data_cache.total_sent);
-    printf("发送失败: %d 条\n", g_data_cache.total_failed);
+    DataCacheStats cache_stats = {0};
+    DataCache_GetStats(&cache_stats);
 
-    // 成功率计算（修正逻辑：只有真正失败的才算失败）
-    uint32_t total_attempts = g_data_cache.total_sent + g_data_cache.total_failed;
-    if (total_attempts > 0) {
-        float success_rate = (float)g_data_cache.total_sent / total_attempts * 100.0f;
-        printf("成功率: %.1f%%\n", success_rate);
-    } else {
-        printf("成功率: 100%% (无失败记录)\n");
+    *total_attempts = g_connection_status.data_sent_count + cache_stats.total_failed;
+    if (*total_attempts == 0) {
+        return 100.0f;
     }
-    printf("========================\n\n");
+    return (float)g_connection_status.data_sent_count / *total_attempts * 100.0f;
 }
 
 // ==================== 连接状态管理功能 ====================
@@ -319,7 +191,7 @@ void DataCache_PrintStats(void)
  */
 void ConnectionStatus_Update(void)
 {
-    if (!g_cache_initialized) {
+    if (!g_network_ready) {
         return;
     }
 
@@ -425,7 +297,7 @@ void ConnectionStatus_Update(void)
  */
 void ConnectionStatus_PrintStats(void)
 {
-    if (!g_cache_initialized) {
+    if (!g_network_ready) {
         return;
     }
 
@@ -451,7 +323,7 @@ void ConnectionStatus_PrintStats(void)
  */
 bool ConnectionStatus_IsStable(void)
 {
-    if (!g_cache_initialized) {
+    if (!g_network_ready) {
         return false;
     }
 
@@ -788,6 +660,11 @@ int IoTCloud_Init(void)
     printf("Device ID: %s\n", DEVICE_ID);
     printf("MQTT Host: %s:%d\n", HOST_ADDR, HOST_PORT);
 
+    // 上传缓存队列随系统启动初始化，恢复上次断网未发送的数据
+    if (DataCache_Init() != 0) {
+        printf("Data cache initialized without flash log (RAM only)\n");
+    }
+
     // 注意：MQTT初始化将在WiFi连接成功后进行
     printf("IoT Cloud configuration ready, waiting for network task to start...\n");
 
@@ -935,28 +812,27 @@ reconnect:
         return;
     }
 
-    // WiFi连接成功后，初始化缓存系统和MQTT
-    DataCache_Init();
+    // WiFi连接成功后初始化MQTT（缓存队列已在IoTCloud_Init中初始化）
+    g_network_ready = true;
     mqtt_init();
 
     // 保持MQTT连接并处理缓存数据
     uint32_t last_cache_check = 0;
     uint32_t last_stats_print = 0;
     uint32_t last_health_check = 0;
-    uint32_t last_flash_check = 0;
-    uint32_t cache_check_interval = 5000;    // 5秒检查一次内存缓存
+    uint32_t cache_check_interval = 5000;    // 5秒检查一次缓存队列
     uint32_t stats_print_interval = 60000;   // 1分钟打印一次统计
     uint32_t health_check_interval = 60000;  // 1分钟进行一次健康检查（优化）
-    uint32_t flash_check_interval = 120000;  // 2分钟检查一次Flash缓存
 
     printf(" IoT网络任务启动完成，开始数据处理循环\n");
 
     // 显示初始系统状态
     printf("\n === 系统启动状态 ===\n");
-    printf(" 缓存系统: %s\n", g_cache_initialized ? " 已初始化" : " 未初始化");
+    DataCacheStats cache_stats;
+    printf(" 缓存系统: %s\n", DataCache_GetStats(&cache_stats) == 0 ? " 已初始化" : " 未初始化");
     printf(" WiFi状态: %s\n", g_connection_status.wifi_connected ? " 已连接" : " 断开");
     printf(" MQTT状态: %s\n", g_connection_status.mqtt_connected ? " 已连接" : " 断开");
-    printf(" 缓存容量: %d/%d 条\n", g_data_cache.count, MAX_CACHE_SIZE);
+    printf(" 缓存容量: %u/%u 条\n", DataCache_GetCount(), DataCache_GetCapacity());
     printf(" 监控间隔: 缓存检查%ds, 状态报告%ds, 健康检查%ds\n",
            cache_check_interval/1000, stats_print_interval/1000, health_check_interval/1000);
     printf("========================\n\n");
@@ -966,10 +842,14 @@ reconnect:
     IoTCloud_HealthCheck();
 
     while (1) {
+        Profiler_LoopBegin();
         uint32_t current_time = LOS_TickCountGet();
 
-        // 检查MQTT连接状态（只在WiFi连接正常时尝试重连）
-        if (!wait_message()) {
+        // 检查MQTT连接状态（只在WiFi连接正常时尝试重连）；收包等待不计入任务活动时间
+        Profiler_WaitBegin();
+        int mqtt_alive = wait_message();
+        Profiler_WaitEnd();
+        if (!mqtt_alive) {
             static uint32_t last_mqtt_reconnect = 0;
             uint32_t mqtt_reconnect_interval = 15000;  // 15秒重连间隔（比WiFi重连间隔长）
 
@@ -984,7 +864,9 @@ reconnect:
                 printf(" MQTT连接断开，WiFi正常，尝试重连MQTT...\n");
                 printf(" 当前MQTT状态: mqttConnectFlag=%d\n", mqttConnectFlag);
                 g_connection_status.disconnect_count++;
+                Profiler_WaitBegin();
                 mqtt_init();
+                Profiler_WaitEnd();
                 g_connection_status.reconnect_count++;
                 last_mqtt_reconnect = current_time;
             } else if (mqttConnectFlag) {
@@ -1001,33 +883,28 @@ reconnect:
         // 更新连接状态
         ConnectionStatus_Update();
 
-        // 定期检查并发送内存缓存数据
+        // 定期按顺序补发缓存队列（Flash中较早的数据优先）
         if (current_time - last_cache_check > cache_check_interval) {
-            if (ConnectionStatus_IsStable() && g_data_cache.count > 0) {
-                printf(" 定期检查内存缓存数据...\n");
-                int sent_count = DataCache_SendPending();
+            if (ConnectionStatus_IsStable() && DataCache_GetCount() > 0) {
+                printf(" 定期检查缓存数据...\n");
+                int sent_count = DataCache_SendPending(SendCachedItem, DATA_CACHE_SEND_BATCH);
                 if (sent_count > 0) {
-                    printf(" 定期发送了 %d 条内存缓存数据\n", sent_count);
+                    printf(" 定期发送了 %d 条缓存数据\n", sent_count);
                 }
             }
             last_cache_check = current_time;
         }
 
-        // 定期检查并加载Flash缓存数据到内存
-        if (current_time - last_flash_check > flash_check_interval) {
-            if (ConnectionStatus_IsStable() && g_data_cache.count < MAX_CACHE_SIZE * 0.5) {
-                extern uint32_t DataStorage_GetRecordCount(void);
-
-                uint32_t flash_count = DataStorage_GetRecordCount();
-                if (flash_count > 0) {
-                    printf(" 检测到%d条Flash缓存数据，加载到内存缓存...\n", flash_count);
-                    int loaded = DataCache_LoadFromFlash();
-                    if (loaded > 0) {
-                        printf(" Flash数据加载: %d/%d 条成功\n", loaded, flash_count);
-                    }
-                }
-            }
-            last_flash_check = current_time;
+        // 分块发送形变历史导出
+        if (g_export_active && mqttConnectFlag) {
+            SendExportChunk();
+        }
+
+        // 定期上报任务统计（命令开启后）
+        if (g_profile_report_interval_ms > 0 && mqttConnectFlag &&
+            current_time - g_last_profile_report >= g_profile_report_interval_ms) {
+            SendTaskProfile();
+            g_last_profile_report = current_time;
         }
 
         // 定期打印统计信息
@@ -1059,8 +936,8 @@ reconnect:
                 printf(" 系统健康状态良好\n");
 
                 // 简化的健康状态报告
-                printf(" 快速状态: 缓存%d/%d条 | WiFi=%s | MQTT=%s | 错误%d次\n",
-                       g_data_cache.count, MAX_CACHE_SIZE,
+                printf(" 快速状态: 缓存%u/%u条 | WiFi=%s | MQTT=%s | 错误%d次\n",
+                       DataCache_GetCount(), DataCache_GetCapacity(),
                        g_connection_status.wifi_connected ? "√" : "×",
                        g_connection_status.mqtt_connected ? "√" : "×",
                        g_connection_status.network_error_count);
@@ -1071,7 +948,9 @@ reconnect:
 
         // 处理MQTT消息（包括命令）
         if (mqttConnectFlag) {
+            Profiler_WaitBegin();
             int yield_result = MQTTYield(&client, 100);
+            Profiler_WaitEnd();
             if (yield_result != 0) {
                 printf("MQTTYield returned error: %d (ignoring for stability)\n", yield_result);
                 // 不要因为yield错误就断开连接，这可能是暂时的
@@ -1081,7 +960,9 @@ reconnect:
             static uint32_t last_yield_check = 0;
             if (current_time - last_yield_check > 1000) {  // 每秒检查一次
                 // 尝试更长的yield时间
+                Profiler_WaitBegin();
                 int extended_yield = MQTTYield(&client, 1000);
+                Profiler_WaitEnd();
                 if (extended_yield != 0) {
                     printf("Extended MQTTYield error: %d\n", extended_yield);
                 }
@@ -1100,7 +981,9 @@ reconnect:
 
                 // 强制检查是否有待处理的消息
                 printf("Forcing message check...\n");
+                Profiler_WaitBegin();
                 int force_yield = MQTTYield(&client, 2000);  // 2秒强制检查
+                Profiler_WaitEnd();
                 if (force_yield != 0) {
                     printf("Force yield returned: %d\n", force_yield);
                 } else {
@@ -1118,6 +1001,7 @@ reconnect:
             }
         }
 
+        Profiler_LoopEnd(100);
         LOS_Msleep(100);  // 减少CPU占用
     }
 }
@@ -1170,19 +1054,17 @@ void IoTCloud_TestCacheSystem(void)
     DataCache_Init();
 
     // 创建测试数据
-    e_iot_data test_data = {0};
-    test_data.temperature = 25.5;
-    test_data.humidity = 60.0;
-    test_data.illumination = 100.0;
-    test_data.acceleration_x = 100;
-    test_data.acceleration_y = 200;
-    test_data.acceleration_z = 1000;
+    LandslideIotData test_data = {0};
+    const float accel[3] = {0.1f, 0.2f, 1.0f};
+    const float gyro[3] = {0.0f, 0.0f, 0.0f};
+    Sample_SetMotion(&test_data.sample, accel, gyro, 0.0f, 0.0f, 25.5f);
+    Sample_SetEnvironment(&test_data.sample, 25.5f, 60.0f, 100.0f);
+    test_data.sample.valid = SAMPLE_VALID_SENSORS;
     test_data.risk_level = 1;
-    test_data.alarm_active = false;
 
     printf(" 添加测试数据到缓存...\n");
     for (int i = 0; i < 5; i++) {
-        test_data.temperature = 25.0 + i;
+        Sample_SetEnvironment(&test_data.sample, 25.0f + i, 60.0f, 100.0f);
         test_data.risk_level = i % 5;
         DataCache_Add(&test_data);
         LOS_Msleep(100);
@@ -1193,7 +1075,7 @@ void IoTCloud_TestCacheSystem(void)
 
     printf(" 模拟网络恢复，发送缓存数据...\n");
     if (mqtt_is_connected()) {
-        int sent = DataCache_SendPending();
+        int sent = DataCache_SendPending(SendCachedItem, DATA_CACHE_SEND_BATCH);
         printf(" 发送了 %d 条缓存数据\n", sent);
     } else {
         printf("  MQTT未连接，无法发送缓存数据\n");
@@ -1226,15 +1108,13 @@ void IoTCloud_SimulateNetworkFailure(int duration_seconds)
     printf(" 网络已断开，开始缓存数据...\n");
 
     // 在故障期间添加一些测试数据
-    e_iot_data test_data = {0};
-    test_data.temperature = 26.0;
-    test_data.humidity = 65.0;
-    test_data.illumination = 80.0;
+    LandslideIotData test_data = {0};
+    test_data.sample.valid = SAMPLE_VALID_SENSORS;
     test_data.risk_level = 2;
-    test_data.alarm_active = true;
+    test_data.flags = IOT_DATA_FLAG_ALARM_ACTIVE;
 
     for (int i = 0; i < duration_seconds; i++) {
-        test_data.temperature = 26.0 + i * 0.1;
+        Sample_SetEnvironment(&test_data.sample, 26.0f + i * 0.1f, 65.0f, 80.0f);
         DataCache_Add(&test_data);
         printf(" 故障期间数据已缓存 (%d/%d秒)\n", i + 1, duration_seconds);
         LOS_Msleep(1000);
@@ -1248,7 +1128,7 @@ void IoTCloud_SimulateNetworkFailure(int duration_seconds)
     printf(" 网络已恢复，开始发送缓存数据...\n");
 
     if (ConnectionStatus_IsStable()) {
-        int sent = DataCache_SendPending();
+        int sent = DataCache_SendPending(SendCachedItem, DATA_CACHE_SEND_BATCH);
         printf(" 网络恢复后发送了 %d 条缓存数据\n", sent);
     }
 
@@ -1262,7 +1142,8 @@ void IoTCloud_ForceResendCache(void)
 {
     printf("\n === 强制重发缓存数据 ===\n");
 
-    if (!g_cache_initialized) {
+    DataCacheStats cache_stats;
+    if (DataCache_GetStats(&cache_stats) != 0) {
         printf(" 缓存系统未初始化\n");
         return;
     }
@@ -1270,13 +1151,13 @@ void IoTCloud_ForceResendCache(void)
     printf(" 重发前缓存状态:\n");
     DataCache_PrintStats();
 
-    if (g_data_cache.count == 0) {
+    if (DataCache_GetCount() == 0) {
         printf("ℹ 缓存为空，无需重发\n");
         return;
     }
 
     if (ConnectionStatus_IsStable()) {
-        int sent = DataCache_SendPending();
+        int sent = DataCache_SendPending(SendCachedItem, DATA_CACHE_SEND_BATCH);
         printf(" 强制重发了 %d 条缓存数据\n", sent);
     } else {
         printf("  网络连接不稳定，无法重发数据\n");
@@ -1303,14 +1184,21 @@ void IoTCloud_HealthCheck(void)
     bool system_healthy = true;
 
     // 检查缓存系统
-    if (!g_cache_initialized) {
+    DataCacheStats cache_stats;
+    if (DataCache_GetStats(&cache_stats) != 0) {
         printf(" 缓存系统未初始化\n");
         system_healthy = false;
     } else {
-        printf(" 缓存系统正常运行\n");
+        printf(" 缓存系统正常运行 (内存%u/%u, Flash%u/%u)\n",
+               cache_stats.ram_count, cache_stats.ram_capacity,
+               cache_stats.flash_count, cache_stats.flash_capacity);
+        if (!cache_stats.flash_available) {
+            printf("  缓存Flash日志不可用，断网数据无法掉电保存\n");
+            system_healthy = false;
+        }
 
         // 检查缓存使用率
-        float cache_usage = (float)g_data_cache.count / MAX_CACHE_SIZE * 100.0f;
+        float cache_usage = (float)DataCache_GetCount() / DataCache_GetCapacity() * 100.0f;
         if (cache_usage > 80.0f) {
             printf("  缓存使用率过高: %.1f%%\n", cache_usage);
             system_healthy = false;
@@ -1329,9 +1217,9 @@ void IoTCloud_HealthCheck(void)
     }
 
     // 检查数据发送成功率（修正逻辑：只有真正失败的才算失败）
-    uint32_t total_attempts = g_data_cache.total_sent + g_data_cache.total_failed;
+    uint32_t total_attempts;
+    float success_rate = GetUploadSuccessRate(&total_attempts);
     if (total_attempts > 0) {
-        float success_rate = (float)g_data_cache.total_sent / total_attempts * 100.0f;
         if (success_rate < 90.0f) {
             printf("  数据发送成功率偏低: %.1f%%\n", success_rate);
             system_healthy = false;
@@ -1350,6 +1238,13 @@ void IoTCloud_HealthCheck(void)
         printf(" 网络错误次数正常: %d 次\n", g_connection_status.network_error_count);
     }
 
+    // 检查任务栈水位
+    int stack_warnings = Profiler_PrintReport();
+    if (stack_warnings > 0) {
+        printf("  %d 个任务栈使用超过 %d%%\n", stack_warnings, PROFILER_STACK_WARN_PERCENT);
+        system_healthy = false;
+    }
+
     // 总体健康状态
     printf("\n 系统总体状态: %s\n", system_healthy ? " 健康" : " 需要关注");
 
@@ -1359,6 +1254,9 @@ void IoTCloud_HealthCheck(void)
         printf("   2. 清理缓存数据: IoTCloud_ForceResendCache()\n");
         printf("   3. 重启网络服务\n");
         printf("   4. 检查云平台配置\n");
+        if (stack_warnings > 0) {
+            printf("   5. 增大栈水位告警任务的栈大小\n");
+        }
     }
 
     printf(" === 系统健康检查完成 ===\n\n");
@@ -1383,15 +1281,18 @@ void IoTCloud_PrintSystemStatus(void)
 
     // 数据统计
     printf("\n 数据统计:\n");
-    printf("   当前缓存: %d/%d 条\n", g_data_cache.count, MAX_CACHE_SIZE);
-    printf("   总缓存数: %d 条\n", g_data_cache.total_cached);
-    printf("   发送成功: %d 条\n", g_data_cache.total_sent);
-    printf("   发送失败: %d 条\n", g_data_cache.total_failed);
+    DataCacheStats cache_stats = {0};
+    DataCache_GetStats(&cache_stats);
+    printf("   当前缓存: %u/%u 条 (Flash %u 条)\n", DataCache_GetCount(), DataCache_GetCapacity(),
+           cache_stats.flash_count);
+    printf("   总缓存数: %u 条\n", cache_stats.total_cached);
+    printf("   发送成功: %u 条\n", g_connection_status.data_sent_count);
+    printf("   发送失败: %u 条\n", cache_stats.total_failed);
 
     // 成功率计算（修正逻辑：只有真正失败的才算失败）
-    uint32_t total_attempts = g_data_cache.total_sent + g_data_cache.total_failed;
+    uint32_t total_attempts;
+    float success_rate = GetUploadSuccessRate(&total_attempts);
     if (total_attempts > 0) {
-        float success_rate = (float)g_data_cache.total_sent / total_attempts * 100.0f;
         printf("   成功率: %.1f%%\n", success_rate);
     } else {
         printf("   成功率: 100%% (无失败记录)\n");
@@ -1403,6 +1304,10 @@ void IoTCloud_PrintSystemStatus(void)
     printf("   重连次数: %d 次\n", g_connection_status.reconnect_count);
     printf("   网络错误: %d 次\n", g_connection_status.network_error_count);
 
+    // 任务统计
+    printf("\n");
+    Profiler_PrintReport();
+
     printf(" === 状态总览完成 ===\n\n");
 }
 
@@ -1413,10 +1318,11 @@ void IoTCloud_PrintSystemStatus(void)
 bool IoTCloud_IsSystemHealthy(void)
 {
     // 检查缓存系统
-    if (!g_cache_initialized) return false;
+    DataCacheStats cache_stats;
+    if (DataCache_GetStats(&cache_stats) != 0) return false;
 
     // 检查缓存使用率
-    float cache_usage = (float)g_data_cache.count / MAX_CACHE_SIZE * 100.0f;
+    float cache_usage = (float)DataCache_GetCount() / DataCache_GetCapacity() * 100.0f;
     if (cache_usage > 90.0f) return false;
 
     // 检查网络连接
@@ -1424,9 +1330,9 @@ bool IoTCloud_IsSystemHealthy(void)
     if (!ConnectionStatus_IsStable()) return false;
 
     // 检查数据发送成功率（修正逻辑：只有真正失败的才算失败）
-    uint32_t total_attempts = g_data_cache.total_sent + g_data_cache.total_failed;
+    uint32_t total_attempts;
+    float success_rate = GetUploadSuccessRate(&total_attempts);
     if (total_attempts > 10) {
-        float success_rate = (float)g_data_cache.total_sent / total_attempts * 100.0f;
         if (success_rate < 85.0f) return false;
     }
 
@@ -1448,59 +1354,65 @@ int IoTCloud_SendData(const LandslideIotData *data)
     }
 
     // 确保缓存系统已初始化
-    if (!g_cache_initialized) {
-        DataCache_Init();
-    }
+    DataCache_Init();
 
     // 更新连接状态
     ConnectionStatus_Update();
 
-    // 转换数据结构
-    e_iot_data iot_data;
-    convert_landslide_to_iot_data(data, &iot_data);
-
     // 检查连接状态
     if (ConnectionStatus_IsStable() && mqttConnectFlag) {
-        // 连接稳定，先尝试发送缓存数据
-        int sent_cached = DataCache_SendPending();
+        // 连接稳定，先按顺序补发缓存数据
+        int sent_cached = DataCache_SendPending(SendCachedItem, DATA_CACHE_SEND_BATCH);
         if (sent_cached > 0) {
             printf(" 发送了 %d 条缓存数据\n", sent_cached);
         }
 
+        // 仍有积压时当前数据排到队尾，保证云端收到的数据按时间顺序
+        uint32_t backlog = DataCache_GetCount();
+        if (backlog > 0) {
+            printf(" 缓存仍有%u条待补发，当前数据排队发送\n", backlog);
+            return DataCache_Add(data);
+        }
+
         // 然后发送当前数据（减少日志输出）
-        send_msg_to_mqtt(&iot_data);
+        send_msg_to_mqtt(data);
+        if (!mqttConnectFlag) {
+            printf("  数据发布失败，加入缓存队列\n");
+            return DataCache_Add(data);
+        }
         g_connection_status.last_data_send_time = LOS_TickCountGet();
-        g_data_cache.total_sent++;
+        g_connection_status.data_sent_count++;
 
         // 打印发送状态
         static uint32_t upload_count = 0;
         upload_count++;
         printf("=== IoT Data Upload #%d ===\n", upload_count);
+        const SampleRecord *sample = &data->sample;
+        bool gps_valid = Sample_IsValid(sample, SAMPLE_VALID_GPS);
         printf("Service: smartHome | Risk=%d | Temp=%.1f°C | Humidity=%.1f%%\n",
-               data->risk_level, data->temperature, data->humidity);
+               data->risk_level, Sample_GetTemperature(sample), Sample_GetHumidity(sample));
         printf("Motion: X=%.1f° Y=%.1f° | Light=%.1fLux | Alarm=%s\n",
-               data->angle_x, data->angle_y, data->light, data->alarm_active ? "ACTIVE" : "NORMAL");
+               Sample_GetAngle(sample, SAMPLE_AXIS_X), Sample_GetAngle(sample, SAMPLE_AXIS_Y),
+               Sample_GetLight(sample), (data->flags & IOT_DATA_FLAG_ALARM_ACTIVE) ? "ACTIVE" : "NORMAL");
         printf("GPS: %.6f°, %.6f° (%s) | Altitude=%.1fm\n",
-               data->gps_latitude, data->gps_longitude,
-               data->gps_valid ? "Valid" : "Default", data->gps_altitude);
-        printf("Deform: %.1fm (H:%.1fm V:%.1fm) | Vel:%.2fm/h | Risk:%d | Base:%s\n",
-               data->deformation_distance_3d, data->deformation_horizontal, data->deformation_vertical,
-               data->deformation_velocity, data->deformation_risk_level,
-               data->baseline_established ? "Yes" : "No");
-        printf(" 缓存状态: %d/%d条 | 连接: WiFi=%s MQTT=%s\n",
-               g_data_cache.count, MAX_CACHE_SIZE,
+               Sample_GetLatitude(sample), Sample_GetLongitude(sample),
+               gps_valid ? "Valid" : "Default", Sample_GetAltitude(sample));
+        printf("Deform: %dmm (E:%dmm N:%dmm U:%dmm) | Vel:%d±%dmm/h | Risk:%d | Base:%s\n",
+               (int)data->deformation_distance_3d, (int)data->deformation_east,
+               (int)data->deformation_north, (int)data->deformation_vertical,
+               (int)data->deformation_velocity, (int)data->deformation_velocity_ci,
+               data->deformation_risk_level, (data->flags & IOT_DATA_FLAG_BASELINE) ? "Yes" : "No");
+        printf(" 缓存状态: %u/%u条 | 连接: WiFi=%s MQTT=%s\n",
+               DataCache_GetCount(), DataCache_GetCapacity(),
                g_connection_status.wifi_connected ? "√" : "×",
                g_connection_status.mqtt_connected ? "√" : "×");
 
         // 计算并显示成功率（修正逻辑：只有真正失败的才算失败）
-        uint32_t total_attempts = g_data_cache.total_sent + g_data_cache.total_failed;
+        uint32_t total_attempts;
+        float success_rate = GetUploadSuccessRate(&total_attempts);
         if (total_attempts > 0) {
-            float success_rate = (float)g_data_cache.total_sent / total_attempts * 100.0f;
-            printf(" 数据上传成功率: %.1f%% (%d/%d)\n",
-                   success_rate, g_data_cache.total_sent, total_attempts);
-            if (g_data_cache.total_cached > 0) {
-                printf(" 当前缓存数据: %d条 (等待发送，不计入失败)\n", g_data_cache.count);
-            }
+            printf(" 数据上传成功率: %.1f%% (%u/%u)\n",
+                   success_rate, g_connection_status.data_sent_count, total_attempts);
         } else {
             printf(" 数据上传成功率: 100.0%% (无失败记录)\n");
         }
@@ -1508,115 +1420,23 @@ int IoTCloud_SendData(const LandslideIotData *data)
 
         return 0;
     } else {
-        // 连接不稳定，将数据加入内存缓存
-        printf("  连接不稳定，数据加入内存缓存队列\n");
-        int cache_result = DataCache_Add(&iot_data);
-
-        if (cache_result == 0) {
-            printf(" 数据已加入内存缓存，等待网络恢复后发送\n");
-
-            // 如果内存缓存接近满，将数据存储到Flash作为长期备份
-            if (g_data_cache.count > MAX_CACHE_SIZE * 0.8) {
-                printf(" 内存缓存接近满(>80%)，将数据备份到Flash存储\n");
-                extern int DataStorage_Store(const LandslideIotData *data);
-                if (DataStorage_Store(data) == 0) {
-                    printf(" 数据已备份到Flash存储（长期保存）\n");
-                } else {
-                    printf(" Flash存储失败\n");
-                }
-            }
-
+        // 连接不稳定，加入缓存队列（内存满后自动溢出到Flash）
+        printf("  连接不稳定，数据加入缓存队列\n");
+        if (DataCache_Add(data) == 0) {
+            printf(" 数据已加入缓存队列，等待网络恢复后发送\n");
             return 0;  // 缓存成功也算发送成功
-        } else {
-            printf(" 内存缓存失败，尝试直接存储到Flash\n");
-            extern int DataStorage_Store(const LandslideIotData *data);
-            if (DataStorage_Store(data) == 0) {
-                printf(" 数据已存储到Flash，等待网络恢复\n");
-                return 0;
-            } else {
-                printf(" 所有缓存方式都失败\n");
-                g_connection_status.network_error_count++;
-                return -1;
-            }
         }
-    }
-}
-
-/**
- * @brief 数据结构转换函数（LandslideIotData -> e_iot_data）
- */
-static void convert_landslide_to_iot_data(const LandslideIotData *landslide_data, e_iot_data *iot_data)
-{
-    if (landslide_data == NULL || iot_data == NULL) {
-        return;
-    }
-
-    // 基础环境传感器数据（decimal类型）
-    iot_data->temperature = (double)landslide_data->temperature;    // 温度 (°C)
-    iot_data->illumination = (double)landslide_data->light;         // 光照强度 (lux)
-    iot_data->humidity = (double)landslide_data->humidity;          // 湿度 (%)
-
-    // MPU6050加速度数据（long类型 - 发送g单位，直观易读）
-    // 将g值乘以1000保持精度，云端配置为decimal类型，除以1000显示
-    // 云端配置：decimal类型，单位g，范围-2.0~2.0
-    iot_data->acceleration_x = (long)(landslide_data->accel_x * 1000);  // X轴加速度(g×1000)
-    iot_data->acceleration_y = (long)(landslide_data->accel_y * 1000);  // Y轴加速度(g×1000)
-    iot_data->acceleration_z = (long)(landslide_data->accel_z * 1000);  // Z轴加速度(g×1000)
-
-    // MPU6050陀螺仪数据（long类型 - 发送°/s单位，直观易读）
-    // 将°/s值乘以100保持精度，云端配置为decimal类型，除以100显示
-    // 云端配置：decimal类型，单位°/s，范围-250~250
-    iot_data->gyroscope_x = (long)(landslide_data->gyro_x * 100);       // X轴陀螺仪(°/s×100)
-    iot_data->gyroscope_y = (long)(landslide_data->gyro_y * 100);       // Y轴陀螺仪(°/s×100)
-    iot_data->gyroscope_z = (long)(landslide_data->gyro_z * 100);       // Z轴陀螺仪(°/s×100)
-
-    // MPU6050温度（decimal类型）
-    iot_data->mpu_temperature = (double)landslide_data->temperature;    // 使用环境温度作为MPU温度
 
-    // GPS定位数据（decimal类型）- 使用真实GPS数据或默认坐标
-    if (landslide_data->gps_valid) {
-        iot_data->latitude = landslide_data->gps_latitude;      // 真实GPS纬度
-        iot_data->longitude = landslide_data->gps_longitude;    // 真实GPS经度
-    } else {
-        // GPS无效时使用默认位置坐标（广西南宁）
-        iot_data->latitude = 22.8170;      // 广西南宁纬度
-        iot_data->longitude = 108.3669;    // 广西南宁经度
+        printf(" 数据缓存失败\n");
+        g_connection_status.network_error_count++;
+        return -1;
     }
-
-    // GPS形变分析数据（decimal类型）
-    iot_data->deformation_distance_3d = (double)landslide_data->deformation_distance_3d;
-    iot_data->deformation_horizontal = (double)landslide_data->deformation_horizontal;
-    iot_data->deformation_vertical = (double)landslide_data->deformation_vertical;
-    iot_data->deformation_velocity = (double)landslide_data->deformation_velocity;
-    iot_data->deformation_risk_level = landslide_data->deformation_risk_level;
-    iot_data->deformation_type = landslide_data->deformation_type;
-    iot_data->deformation_confidence = (double)landslide_data->deformation_confidence;
-    iot_data->baseline_established = landslide_data->baseline_established;
-
-    // 振动传感器数据（decimal类型）
-    // 振动强度基于陀螺仪数据计算，已经过滤波和校准处理
-    // 数值范围：0-200+ (°/s的幅值)，正常情况下 <10，异常时 >20
-    iot_data->vibration = (double)landslide_data->vibration;            // 振动强度 (°/s)
-
-    // 滑坡监测专用数据
-    iot_data->risk_level = (int)landslide_data->risk_level;             // 风险等级 (0-4)
-    iot_data->alarm_active = landslide_data->alarm_active;              // 报警状态 (boolean)
-    iot_data->uptime = (long)landslide_data->uptime;                    // 系统运行时间 (秒)
-
-    // 倾角数据（decimal类型）
-    iot_data->angle_x = (double)landslide_data->angle_x;                // X轴倾角 (°)
-    iot_data->angle_y = (double)landslide_data->angle_y;                // Y轴倾角 (°)
-
-    // 计算总倾斜角度（基于X、Y轴）
-    double total_angle = sqrt(iot_data->angle_x * iot_data->angle_x +
-                             iot_data->angle_y * iot_data->angle_y);
-    iot_data->angle_z = total_angle;                                    // 总倾斜角度
 }
 
 /**
  * @brief 发送消息到MQTT（基于成熟版本）
  */
-void send_msg_to_mqtt(e_iot_data *iot_data)
+void send_msg_to_mqtt(const LandslideIotData *iot_data)
 {
     // 检查WiFi和MQTT连接状态
     bool wifi_connected = (check_wifi_connected() == 1);
@@ -1637,54 +1457,87 @@ void send_msg_to_mqtt(e_iot_data *iot_data)
     cJSON_AddStringToObject(service, "service_id", "smartHome");
     cJSON *props = cJSON_CreateObject();
 
+    // 直接从定点记录按云端字段定义序列化（加速度g×1000、角速度°/s×100与记录存储单位一致）
+    const SampleRecord *sample = &iot_data->sample;
+
     // 基础环境传感器数据（decimal类型）
-    cJSON_AddNumberToObject(props, "temperature", iot_data->temperature);
-    cJSON_AddNumberToObject(props, "illumination", iot_data->illumination);
-    cJSON_AddNumberToObject(props, "humidity", iot_data->humidity);
+    cJSON_AddNumberToObject(props, "temperature", Sample_GetTemperature(sample));
+    cJSON_AddNumberToObject(props, "illumination", Sample_GetLight(sample));
+    cJSON_AddNumberToObject(props, "humidity", Sample_GetHumidity(sample));
 
-    // MPU6050加速度数据（long类型）
-    cJSON_AddNumberToObject(props, "acceleration_x", iot_data->acceleration_x);
-    cJSON_AddNumberToObject(props, "acceleration_y", iot_data->acceleration_y);
-    cJSON_AddNumberToObject(props, "acceleration_z", iot_data->acceleration_z);
+    // MPU6050加速度数据（long类型，g×1000）
+    cJSON_AddNumberToObject(props, "acceleration_x", sample->accel[SAMPLE_AXIS_X]);
+    cJSON_AddNumberToObject(props, "acceleration_y", sample->accel[SAMPLE_AXIS_Y]);
+    cJSON_AddNumberToObject(props, "acceleration_z", sample->accel[SAMPLE_AXIS_Z]);
 
-    // MPU6050陀螺仪数据（long类型）
-    cJSON_AddNumberToObject(props, "gyroscope_x", iot_data->gyroscope_x);
-    cJSON_AddNumberToObject(props, "gyroscope_y", iot_data->gyroscope_y);
-    cJSON_AddNumberToObject(props, "gyroscope_z", iot_data->gyroscope_z);
+    // MPU6050陀螺仪数据（long类型，°/s×100）
+    cJSON_AddNumberToObject(props, "gyroscope_x", sample->gyro[SAMPLE_AXIS_X]);
+    cJSON_AddNumberToObject(props, "gyroscope_y", sample->gyro[SAMPLE_AXIS_Y]);
+    cJSON_AddNumberToObject(props, "gyroscope_z", sample->gyro[SAMPLE_AXIS_Z]);
 
-    // MPU6050温度（decimal类型）
-    cJSON_AddNumberToObject(props, "mpu_temperature", iot_data->mpu_temperature);
+    // MPU6050温度（decimal类型，沿用环境温度）
+    cJSON_AddNumberToObject(props, "mpu_temperature", Sample_GetTemperature(sample));
 
-    // GPS定位数据（decimal类型）
-    cJSON_AddNumberToObject(props, "latitude", iot_data->latitude);
-    cJSON_AddNumberToObject(props, "longitude", iot_data->longitude);
+    // GPS定位数据（decimal类型）- 使用真实GPS数据或默认坐标
+    if (Sample_IsValid(sample, SAMPLE_VALID_GPS)) {
+        cJSON_AddNumberToObject(props, "latitude", Sample_GetLatitude(sample));
+        cJSON_AddNumberToObject(props, "longitude", Sample_GetLongitude(sample));
+    } else {
+        // GPS无效时使用默认位置坐标（广西南宁）
+        cJSON_AddNumberToObject(props, "latitude", 22.8170);
+        cJSON_AddNumberToObject(props, "longitude", 108.3669);
+    }
 
-    // 振动传感器数据（decimal类型）
-    cJSON_AddNumberToObject(props, "vibration", iot_data->vibration);
+    // 振动数据（decimal类型，加速度模值）
+    cJSON_AddNumberToObject(props, "vibration", Sample_GetAccelMagnitude(sample));
 
     // 滑坡监测专用数据
     cJSON_AddNumberToObject(props, "risk_level", iot_data->risk_level);        // int - 风险等级(0-4)
-    cJSON_AddBoolToObject(props, "alarm_active", iot_data->alarm_active);      // boolean - 报警状态
+    cJSON_AddBoolToObject(props, "alarm_active",
+                          (iot_data->flags & IOT_DATA_FLAG_ALARM_ACTIVE) != 0); // boolean - 报警状态
     cJSON_AddNumberToObject(props, "uptime", iot_data->uptime);                // long - 系统运行时间
 
     // 倾角数据（decimal类型）
-    cJSON_AddNumberToObject(props, "angle_x", iot_data->angle_x);              // decimal - X轴倾角
-    cJSON_AddNumberToObject(props, "angle_y", iot_data->angle_y);              // decimal - Y轴倾角
-    cJSON_AddNumberToObject(props, "angle_z", iot_data->angle_z);              // decimal - 总倾斜角度
-
-    // GPS定位数据（decimal类型）
-    cJSON_AddNumberToObject(props, "latitude", iot_data->latitude);            // decimal - 纬度
-    cJSON_AddNumberToObject(props, "longitude", iot_data->longitude);          // decimal - 经度
+    cJSON_AddNumberToObject(props, "angle_x", Sample_GetAngle(sample, SAMPLE_AXIS_X));  // decimal - X轴倾角
+    cJSON_AddNumberToObject(props, "angle_y", Sample_GetAngle(sample, SAMPLE_AXIS_Y));  // decimal - Y轴倾角
+    cJSON_AddNumberToObject(props, "angle_z", Sample_GetTiltMagnitude(sample));         // decimal - 总倾斜角度
 
     // GPS形变分析数据
-    cJSON_AddNumberToObject(props, "deformation_distance_3d", iot_data->deformation_distance_3d);     // decimal - 3D总位移(米)
-    cJSON_AddNumberToObject(props, "deformation_horizontal", iot_data->deformation_horizontal);       // decimal - 水平位移(米)
-    cJSON_AddNumberToObject(props, "deformation_vertical", iot_data->deformation_vertical);           // decimal - 垂直位移(米)
-    cJSON_AddNumberToObject(props, "deformation_velocity", iot_data->deformation_velocity);           // decimal - 形变速度(米/小时)
+    cJSON_AddNumberToObject(props, "deformation_distance_3d",
+                            iot_data->deformation_distance_3d / IOT_DEFORM_DISTANCE_SCALE);   // decimal - 3D总位移(米)
+    cJSON_AddNumberToObject(props, "deformation_horizontal",
+                            iot_data->deformation_horizontal / IOT_DEFORM_DISTANCE_SCALE);    // decimal - 水平位移(米)
+    cJSON_AddNumberToObject(props, "deformation_vertical",
+                            iot_data->deformation_vertical / IOT_DEFORM_DISTANCE_SCALE);      // decimal - 垂直位移(米)
+    cJSON_AddNumberToObject(props, "deformation_velocity",
+                            iot_data->deformation_velocity / IOT_DEFORM_DISTANCE_SCALE);      // decimal - 形变速度(米/小时)
+    cJSON_AddNumberToObject(props, "deformation_east",
+                            iot_data->deformation_east / IOT_DEFORM_DISTANCE_SCALE);          // decimal - 东向位移(米)
+    cJSON_AddNumberToObject(props, "deformation_north",
+                            iot_data->deformation_north / IOT_DEFORM_DISTANCE_SCALE);         // decimal - 北向位移(米)
+    cJSON_AddNumberToObject(props, "deformation_velocity_ci",
+                            iot_data->deformation_velocity_ci / IOT_DEFORM_DISTANCE_SCALE);   // decimal - 速度95%置信半宽(米/小时)
+    cJSON_AddNumberToObject(props, "deformation_acceleration",
+                            iot_data->deformation_acceleration / IOT_DEFORM_DISTANCE_SCALE);  // decimal - 加速度(米/小时²)
     cJSON_AddNumberToObject(props, "deformation_risk_level", iot_data->deformation_risk_level);       // int - 形变风险等级(0-4)
     cJSON_AddNumberToObject(props, "deformation_type", iot_data->deformation_type);                   // int - 形变类型(0-4)
-    cJSON_AddNumberToObject(props, "deformation_confidence", iot_data->deformation_confidence);       // decimal - 置信度(0.0-1.0)
-    cJSON_AddBoolToObject(props, "baseline_established", iot_data->baseline_established);             // boolean - 基准是否建立
+    cJSON_AddNumberToObject(props, "deformation_confidence",
+                            iot_data->deformation_confidence / IOT_DEFORM_CONFIDENCE_SCALE);  // decimal - 置信度(0.0-1.0)
+    cJSON_AddBoolToObject(props, "baseline_established",
+                          (iot_data->flags & IOT_DATA_FLAG_BASELINE) != 0);                   // boolean - 基准是否建立
+    cJSON_AddNumberToObject(props, "forecast_time_to_failure",
+                            (iot_data->forecast_time_to_failure >= 0) ?
+                            iot_data->forecast_time_to_failure / 60.0 : -1.0);                // decimal - 预测失稳剩余时间(小时，-1表示无预测)
+    cJSON_AddNumberToObject(props, "forecast_confidence",
+                            iot_data->forecast_confidence / IOT_DEFORM_CONFIDENCE_SCALE);     // decimal - 预测置信度(0.0-1.0)
+    cJSON_AddNumberToObject(props, "sample_rate_requested", iot_data->sample_rate_requested / 10.0);   // decimal - 请求采样频率(Hz)
+    cJSON_AddNumberToObject(props, "sample_rate_achieved", iot_data->sample_rate_achieved / 10.0);     // decimal - 实测采样频率(Hz)
+    cJSON_AddNumberToObject(props, "alarm_latency_ms", iot_data->alarm_latency);                       // int - 采样到报警输出平均延迟(ms)
+    cJSON_AddNumberToObject(props, "alarm_latency_max_ms", iot_data->alarm_latency_max);               // int - 采样到报警输出最大延迟(ms)
+    cJSON_AddNumberToObject(props, "anomaly_score", iot_data->anomaly_score / 100.0);                  // decimal - 多传感器异常分数
+    cJSON_AddNumberToObject(props, "moisture_index", iot_data->moisture_index / 1000.0);               // decimal - 前期湿润综合指数(0.0-1.0)
+    cJSON_AddNumberToObject(props, "infiltration_index", iot_data->infiltration_index / 1000.0);       // decimal - 降雨入渗代理指数(0.0-1.0)
+    cJSON_AddNumberToObject(props, "tilt_creep", iot_data->tilt_creep / 100.0);                        // decimal - 倾斜蠕变统计量(>=1报警)
 
     cJSON_AddItemToObject(service, "properties", props);
     cJSON_AddItemToArray(services, service);
@@ -1824,6 +1677,38 @@ void IoTCloud_ProcessCommand(const char *command_name, const char *payload)
         IoTCloud_HandleConfigUpdateCommand(payload);
     } else if (!strcmp(command_name, "calibration")) {
         IoTCloud_HandleCalibrationCommand();
+    } else if (!strcmp(command_name, "rebaseline")) {
+        IoTCloud_HandleRebaselineCommand();
+    } else if (!strcmp(command_name, "export_deformation")) {
+        uint32_t start_utc = 0;
+        uint32_t end_utc = 0;
+        bool binary = false;
+        cJSON *root = cJSON_Parse(payload);
+        if (root != NULL) {
+            cJSON *start = cJSON_GetObjectItem(root, "start_utc");
+            cJSON *end = cJSON_GetObjectItem(root, "end_utc");
+            cJSON *format = cJSON_GetObjectItem(root, "format");
+            if (cJSON_IsNumber(start) && start->valuedouble > 0) {
+                start_utc = (uint32_t)start->valuedouble;
+            }
+            if (cJSON_IsNumber(end) && end->valuedouble > 0) {
+                end_utc = (uint32_t)end->valuedouble;
+            }
+            binary = cJSON_IsString(format) && !strcmp(format->valuestring, "binary");
+            cJSON_Delete(root);
+        }
+        IoTCloud_HandleExportCommand(start_utc, end_utc, binary);
+    } else if (!strcmp(command_name, "gnss_reference")) {
+        IoTCloud_HandleReferenceCommand(payload);
+    } else if (!strcmp(command_name, "task_profile")) {
+        cJSON *root = cJSON_Parse(payload);
+        if (root != NULL) {
+            cJSON *interval = cJSON_GetObjectItem(root, "interval");
+            if (cJSON_IsNumber(interval) && interval->valuedouble >= 0) {
+                IoTCloud_HandleTaskProfileCommand((uint32_t)interval->valuedouble);
+            }
+            cJSON_Delete(root);
+        }
     } else if (!strcmp(command_name, "test_mode")) {
         cJSON *root = cJSON_Parse(payload);
         if (root != NULL) {
@@ -1942,10 +1827,7 @@ void IoTCloud_HandleBuzzerCommand(bool enable, int frequency, int duration, int
 
             case 3: // 间歇模式 (3次短响)
                 printf("Buzzer intermittent pattern\n");
-                for (int i = 0; i < 3; i++) {
-                    Buzzer_BeepWithFreq(200, frequency > 0 ? frequency : 2000);
-                    LOS_Msleep(300);  // 间隔300ms
-                }
+                Buzzer_BeepRepeat(200, 300, frequency > 0 ? frequency : 2000, 3);  // 间隔300ms
                 break;
 
             default:
@@ -2010,6 +1892,12 @@ void IoTCloud_HandleSystemRebootCommand(void)
     printf("Handling system reboot command\n");
     printf("System will reboot in 3 seconds...\n");
 
+    // 重启前将内存中未发送的数据写入Flash
+    int spilled = DataCache_Spill(true);
+    if (spilled > 0) {
+        printf("Saved %d cached records to flash before reboot\n", spilled);
+    }
+
     // 延迟3秒后重启
     osDelay(3000);
 
@@ -2017,6 +1905,120 @@ void IoTCloud_HandleSystemRebootCommand(void)
     LOS_Reboot();
 }
 
+/**
+ * @brief 按名称查找规则输入量或风险因子
+ * @return 下标, -1: 未找到
+ */
+static int FindRiskRuleName(const cJSON *item, const char *(*get_name)(int), int count)
+{
+    if (!cJSON_IsString(item)) {
+        return -1;
+    }
+    for (int i = 0; i < count; i++) {
+        if (strcmp(item->valuestring, get_name(i)) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static const char *RiskInputName(int index)
+{
+    return RiskRules_GetInputName((RiskInput)index);
+}
+
+static const char *RiskFactorName(int index)
+{
+    return RiskRules_GetFactorName((RiskFactor)index);
+}
+
+/**
+ * @brief 解析风险规则集（未下发的权重、分界、规则保持当前值；下发rules时整表替换全部规则）
+ * @param json {"version": n, "weights": [各因子权重], "cutoffs": [4个分界],
+ *              "rules": [{"input": "tilt", "factor": "tilt", "points": [[x, y], ...]}, ...]}
+ * @param set 输入当前规则集，输出解析结果
+ * @return 0: 成功, -1: 格式错误
+ */
+static int ParseRiskRules(const cJSON *json, RiskRuleSet *set)
+{
+    cJSON *version = cJSON_GetObjectItem(json, "version");
+    if (cJSON_IsNumber(version)) {
+        set->version = (uint16_t)version->valueint;
+    }
+
+    cJSON *weights = cJSON_GetObjectItem(json, "weights");
+    if (weights != NULL) {
+        if (!cJSON_IsArray(weights) || cJSON_GetArraySize(weights) != RISK_FACTOR_COUNT) {
+            return -1;
+        }
+        for (int i = 0; i < RISK_FACTOR_COUNT; i++) {
+            cJSON *weight = cJSON_GetArrayItem(weights, i);
+            if (!cJSON_IsNumber(weight)) {
+                return -1;
+            }
+            set->weights[i] = (float)weight->valuedouble;
+        }
+    }
+
+    cJSON *cutoffs = cJSON_GetObjectItem(json, "cutoffs");
+    if (cutoffs != NULL) {
+        if (!cJSON_IsArray(cutoffs) || cJSON_GetArraySize(cutoffs) != RISK_RULE_CUTOFFS) {
+            return -1;
+        }
+        for (int i = 0; i < RISK_RULE_CUTOFFS; i++) {
+            cJSON *cutoff = cJSON_GetArrayItem(cutoffs, i);
+            if (!cJSON_IsNumber(cutoff)) {
+                return -1;
+            }
+            set->cutoffs[i] = (float)cutoff->valuedouble;
+        }
+    }
+
+    cJSON *rules = cJSON_GetObjectItem(json, "rules");
+    if (rules == NULL) {
+        return 0;
+    }
+    if (!cJSON_IsArray(rules) || cJSON_GetArraySize(rules) > RISK_RULES_MAX) {
+        return -1;
+    }
+
+    set->rule_count = 0;
+    set->point_count = 0;
+    memset(set->rules, 0, sizeof(set->rules));
+    memset(set->points, 0, sizeof(set->points));
+
+    for (int i = 0; i < cJSON_GetArraySize(rules); i++) {
+        cJSON *rule_json = cJSON_GetArrayItem(rules, i);
+        int input = FindRiskRuleName(cJSON_GetObjectItem(rule_json, "input"), RiskInputName, RISK_INPUT_COUNT);
+        int factor = FindRiskRuleName(cJSON_GetObjectItem(rule_json, "factor"), RiskFactorName, RISK_FACTOR_COUNT);
+        cJSON *points = cJSON_GetObjectItem(rule_json, "points");
+        if (input < 0 || factor < 0 || !cJSON_IsArray(points) ||
+            set->point_count + cJSON_GetArraySize(points) > RISK_RULE_POINTS_MAX) {
+            return -1;
+        }
+
+        RiskRule *rule = &set->rules[set->rule_count++];
+        rule->input = (uint8_t)input;
+        rule->factor = (uint8_t)factor;
+        rule->first_point = set->point_count;
+
+        for (int j = 0; j < cJSON_GetArraySize(points); j++) {
+            cJSON *point = cJSON_GetArrayItem(points, j);
+            cJSON *x = cJSON_GetArrayItem(point, 0);
+            cJSON *y = cJSON_GetArrayItem(point, 1);
+            if (!cJSON_IsArray(point) || !cJSON_IsNumber(x) || !cJSON_IsNumber(y)) {
+                return -1;
+            }
+            set->points[set->point_count].x = (float)x->valuedouble;
+            set->points[set->point_count].y = (float)y->valuedouble;
+            set->point_count++;
+            rule->point_count++;
+        }
+    }
+
+    return 0;
+}
+
 /**
  * @brief 处理配置更新命令
  * @param config_json 配置JSON字符串
@@ -2054,6 +2056,69 @@ void IoTCloud_HandleConfigUpdateCommand(const char *config_json)
             }
         }
 
+        // 处理风险规则表（"default"恢复默认规则，对象为新规则集；校验通过后整表生效）
+        cJSON *risk_rules = cJSON_GetObjectItem(root, "risk_rules");
+        if (cJSON_IsString(risk_rules) && strcmp(risk_rules->valuestring, "default") == 0) {
+            RiskRules_Reset();
+        } else if (cJSON_IsObject(risk_rules)) {
+            static RiskRuleSet rule_set;    // 只由MQTT消息回调使用，用静态变量节省栈
+            if (RiskRules_Get(&rule_set) != 0 || ParseRiskRules(risk_rules, &rule_set) != 0 ||
+                RiskRules_Set(&rule_set) == -1) {
+                printf("Risk rules update rejected\n");
+            }
+        }
+
+        // 处理倾斜蠕变检测参数（未下发的项保持当前值）
+        cJSON *tilt_creep = cJSON_GetObjectItem(root, "tilt_creep");
+        if (cJSON_IsObject(tilt_creep)) {
+            CreepConfig creep_config;
+            if (TiltCreep_GetConfig(&creep_config) == 0) {
+                cJSON *drift = cJSON_GetObjectItem(tilt_creep, "drift");
+                cJSON *threshold = cJSON_GetObjectItem(tilt_creep, "threshold");
+                if (cJSON_IsNumber(drift)) {
+                    creep_config.drift = (float)drift->valuedouble;
+                }
+                if (cJSON_IsNumber(threshold)) {
+                    creep_config.threshold = (float)threshold->valuedouble;
+                }
+                if (TiltCreep_SetConfig(&creep_config) == -1) {
+                    printf("Tilt creep config rejected\n");
+                }
+            }
+        }
+
+        // 处理运行配置（未下发的项保持当前值，生效后保存到Flash）
+        RuntimeConfig config;
+        bool config_changed = false;
+        GetRuntimeConfig(&config);
+
+        cJSON *intervals = cJSON_GetObjectItem(root, "upload_intervals");
+        if (cJSON_IsArray(intervals) && cJSON_GetArraySize(intervals) == RISK_LEVEL_CRITICAL + 1) {
+            for (int i = RISK_LEVEL_SAFE; i <= RISK_LEVEL_CRITICAL; i++) {
+                cJSON *interval = cJSON_GetArrayItem(intervals, i);
+                if (cJSON_IsNumber(interval) && interval->valuedouble > 0) {
+                    config.upload_interval_ms[i] = (uint32_t)interval->valuedouble;
+                }
+            }
+            config_changed = true;
+        }
+
+        cJSON *alert_distance = cJSON_GetObjectItem(root, "deform_alert_distance");
+        if (cJSON_IsNumber(alert_distance)) {
+            config.deform_alert_distance = (float)alert_distance->valuedouble;
+            config_changed = true;
+        }
+
+        cJSON *critical_distance = cJSON_GetObjectItem(root, "deform_critical_distance");
+        if (cJSON_IsNumber(critical_distance)) {
+            config.deform_critical_distance = (float)critical_distance->valuedouble;
+            config_changed = true;
+        }
+
+        if (config_changed && SetRuntimeConfig(&config) == -1) {
+            printf("Runtime config update rejected\n");
+        }
+
         cJSON_Delete(root);
     }
 }
@@ -2065,13 +2130,85 @@ void IoTCloud_HandleCalibrationCommand(void)
 {
     printf("Handling sensor calibration command\n");
 
-    // 执行传感器校准
-    printf("Starting sensor calibration...\n");
+    // 数据处理任务在后续100个样本上重新计算陀螺仪零偏，完成后自动保存
+    RequestGyroCalibration();
+}
+
+/**
+ * @brief 处理GPS形变基准重建命令
+ */
+void IoTCloud_HandleRebaselineCommand(void)
+{
+    printf("Handling GPS rebaseline command\n");
+
+    // 采集任务在下一个GPS历元前清除基准和历史，之后第一个时段平均坐标成为新基准
+    RequestGpsRebaseline();
+}
+
+/**
+ * @brief 处理形变历史导出命令（网络任务主循环中按块发布到EXPORT_TOPIC）
+ * @param start_utc 起始UTC时间（2000-01-01起秒数，0表示不限）
+ * @param end_utc 结束UTC时间（0表示不限）
+ * @param binary true: GpsExportRecord二进制, false: CSV
+ */
+void IoTCloud_HandleExportCommand(uint32_t start_utc, uint32_t end_utc, bool binary)
+{
+    printf("Handling deformation export command: utc %u-%u, %s\n", start_utc, end_utc,
+           binary ? "binary" : "csv");
+
+    if (GPS_Deformation_ExportBegin(&g_export_cursor, start_utc, end_utc,
+                                    binary ? GPS_EXPORT_FORMAT_BINARY : GPS_EXPORT_FORMAT_CSV) != 0) {
+        printf("Deformation export not available\n");
+        return;
+    }
+    g_export_active = true;
+}
+
+/**
+ * @brief 处理任务统计上报命令（网络任务主循环中定期发布到PROFILE_TOPIC）
+ * @param interval_s 上报间隔（秒，0为关闭）
+ */
+void IoTCloud_HandleTaskProfileCommand(uint32_t interval_s)
+{
+    printf("Handling task profile command: interval %us\n", interval_s);
+
+    // 至少间隔10秒，避免占用上传带宽
+    if (interval_s > 0 && interval_s < 10) {
+        interval_s = 10;
+    }
+    g_profile_report_interval_ms = interval_s * 1000;
+    g_last_profile_report = LOS_TickCountGet() - g_profile_report_interval_ms;
+}
+
+/**
+ * @brief 处理参考站数据命令
+ * @param payload {"nmea": "参考站GGA语句（可多条）", "latitude"/"longitude"/"altitude": 参考站已知坐标（可选）}
+ */
+void IoTCloud_HandleReferenceCommand(const char *payload)
+{
+    cJSON *root = cJSON_Parse(payload);
+    if (root == NULL) {
+        printf("Invalid reference payload\n");
+        return;
+    }
+
+    cJSON *latitude = cJSON_GetObjectItem(root, "latitude");
+    cJSON *longitude = cJSON_GetObjectItem(root, "longitude");
+    cJSON *altitude = cJSON_GetObjectItem(root, "altitude");
+    if (cJSON_IsNumber(latitude) && cJSON_IsNumber(longitude) && cJSON_IsNumber(altitude)) {
+        if (GpsDiff_SetReferencePosition(latitude->valuedouble, longitude->valuedouble,
+                                         (float)altitude->valuedouble) != 0) {
+            printf("Reference position rejected\n");
+        }
+    }
 
-    // 这里应该调用实际的传感器校准函数
-    // 例如: SensorCalibration();
+    cJSON *nmea = cJSON_GetObjectItem(root, "nmea");
+    if (cJSON_IsString(nmea)) {
+        int added = GpsDiff_FeedReference(nmea->valuestring, strlen(nmea->valuestring));
+        printf("Reference epochs received: %d\n", added);
+    }
 
-    printf("Sensor calibration completed\n");
+    cJSON_Delete(root);
 }
 
 /**
@@ -0,0 +1,427 @@
+#include "kv_store.h"
+#include "crc32.h"
+#include "iot_flash.h"
+#include "iot_errno.h"
+#include "los_task.h"
+#include "los_mux.h"
+#include <string.h>
+#include <stdio.h>
+
+// 扇区头部（压缩时最后写入，头部有效即扇区内容完整）
+typedef struct {
+    uint32_t magic;
+    uint32_t generation;
+} KvSectorHeader;
+
+// 条目头部（写入顺序：先头部后值，整条CRC通过才生效；length为0表示删除）
+typedef struct {
+    uint16_t key;
+    uint16_t length;
+    uint32_t crc;                               // CRC32(key, length, value)
+} KvEntryHeader;
+
+#define KV_ERASED_KEY       0xFFFF              // 擦除状态的键，表示日志结束
+#define KV_ALIGN(n)         (((n) + 3u) & ~3u)  // 条目按4字节对齐
+
+// 内存索引项（offset为0表示键不存在，扇区头部占用偏移0）
+typedef struct {
+    uint16_t offset;
+    uint16_t length;
+    uint32_t crc;
+} KvIndexEntry;
+
+typedef struct {
+    bool initialized;
+    UINT32 mutex;
+    uint8_t active;                             // 活动扇区序号
+    uint32_t generation;
+    uint32_t write_offset;                      // 活动扇区下一条目偏移
+    KvIndexEntry index[KV_MAX_KEYS];
+    uint32_t writes;
+    uint32_t compactions;
+} KvStoreManager;
+
+static KvStoreManager g_kv = {0};
+
+static uint32_t SectorAddress(uint8_t sector)
+{
+    return KV_FLASH_ADDR + sector * STORAGE_SECTOR_SIZE;
+}
+
+static uint32_t EntrySize(uint16_t length)
+{
+    return sizeof(KvEntryHeader) + KV_ALIGN(length);
+}
+
+/**
+ * @brief 计算条目校验值
+ */
+static uint32_t CalculateEntryCrc(uint16_t key, uint16_t length, const void *value)
+{
+    uint16_t head[2] = {key, length};
+    uint32_t crc = Crc32_Update(0, head, sizeof(head));
+    return Crc32_Update(crc, value, length);
+}
+
+/**
+ * @brief 分块读取Flash中的条目并校验
+ */
+static bool VerifyEntry(uint32_t addr, const KvEntryHeader *header)
+{
+    uint8_t chunk[64];
+    uint16_t head[2] = {header->key, header->length};
+    uint32_t crc = Crc32_Update(0, head, sizeof(head));
+
+    addr += sizeof(KvEntryHeader);
+    for (uint16_t done = 0; done < header->length; ) {
+        uint16_t len = header->length - done;
+        if (len > sizeof(chunk)) {
+            len = sizeof(chunk);
+        }
+        if (IoTFlashRead(addr + done, len, chunk) != IOT_SUCCESS) {
+            return false;
+        }
+        crc = Crc32_Update(crc, chunk, len);
+        done += len;
+    }
+
+    return crc == header->crc;
+}
+
+/**
+ * @brief 读取扇区头部
+ */
+static bool ReadSectorHeader(uint8_t sector, KvSectorHeader *header)
+{
+    if (IoTFlashRead(SectorAddress(sector), sizeof(KvSectorHeader), (uint8_t*)header) != IOT_SUCCESS) {
+        return false;
+    }
+    return header->magic == KV_SECTOR_MAGIC && header->generation != 0xFFFFFFFF;
+}
+
+/**
+ * @brief 扫描活动扇区重建内存索引，后写入的条目覆盖先写入的
+ * @note 头部未完全擦除或键值越界（掉电写了一半的头部）时视为日志结束，下次写入触发压缩
+ */
+static void ScanActiveSector(void)
+{
+    uint32_t base = SectorAddress(g_kv.active);
+    uint32_t offset = sizeof(KvSectorHeader);
+
+    memset(g_kv.index, 0, sizeof(g_kv.index));
+
+    while (offset + sizeof(KvEntryHeader) <= STORAGE_SECTOR_SIZE) {
+        KvEntryHeader header;
+        if (IoTFlashRead(base + offset, sizeof(header), (uint8_t*)&header) != IOT_SUCCESS) {
+            offset = STORAGE_SECTOR_SIZE;
+            break;
+        }
+        if (header.key == KV_ERASED_KEY && header.length == 0xFFFF && header.crc == 0xFFFFFFFF) {
+            break;
+        }
+        if (header.key == 0 || header.key >= KV_MAX_KEYS || header.length > KV_MAX_VALUE_SIZE ||
+            offset + EntrySize(header.length) > STORAGE_SECTOR_SIZE) {
+            printf("KV store: corrupted entry at offset %u, stop scanning\n", offset);
+            offset = STORAGE_SECTOR_SIZE;
+            break;
+        }
+
+        // CRC不通过的条目（掉电时未写完）保留旧值
+        if (VerifyEntry(base + offset, &header)) {
+            KvIndexEntry *entry = &g_kv.index[header.key];
+            if (header.length == 0) {
+                memset(entry, 0, sizeof(*entry));
+            } else {
+                entry->offset = offset;
+                entry->length = header.length;
+                entry->crc = header.crc;
+            }
+        }
+        offset += EntrySize(header.length);
+    }
+
+    g_kv.write_offset = offset;
+}
+
+/**
+ * @brief 格式化指定扇区为空的活动扇区
+ */
+static int FormatSector(uint8_t sector, uint32_t generation)
+{
+    KvSectorHeader header = {KV_SECTOR_MAGIC, generation};
+    uint32_t addr = SectorAddress(sector);
+
+    if (IoTFlashErase(addr, STORAGE_SECTOR_SIZE) != IOT_SUCCESS ||
+        IoTFlashWrite(addr, sizeof(header), (const uint8_t*)&header, 0) != IOT_SUCCESS) {
+        printf("KV store: failed to format sector at 0x%x\n", addr);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief 把各键最新值复制到备用扇区，最后写入扇区头部完成切换
+ * @note 调用者需持有g_kv.mutex；切换前掉电时旧扇区仍为活动扇区
+ */
+static int Compact(void)
+{
+    uint8_t target = g_kv.active ^ 1;
+    uint32_t src_base = SectorAddress(g_kv.active);
+    uint32_t dst_base = SectorAddress(target);
+    uint32_t offset = sizeof(KvSectorHeader);
+    KvIndexEntry index[KV_MAX_KEYS];
+    uint8_t chunk[64];
+
+    if (IoTFlashErase(dst_base, STORAGE_SECTOR_SIZE) != IOT_SUCCESS) {
+        printf("KV store: failed to erase sector at 0x%x\n", dst_base);
+        return -1;
+    }
+
+    memset(index, 0, sizeof(index));
+    for (uint16_t key = 1; key < KV_MAX_KEYS; key++) {
+        const KvIndexEntry *entry = &g_kv.index[key];
+        if (entry->offset == 0) {
+            continue;
+        }
+
+        uint32_t size = sizeof(KvEntryHeader) + entry->length;
+        for (uint32_t done = 0; done < size; ) {
+            uint32_t len = size - done;
+            if (len > sizeof(chunk)) {
+                len = sizeof(chunk);
+            }
+            if (IoTFlashRead(src_base + entry->offset + done, len, chunk) != IOT_SUCCESS ||
+                IoTFlashWrite(dst_base + offset + done, len, chunk, 0) != IOT_SUCCESS) {
+                printf("KV store: failed to copy key %u\n", key);
+                return -1;
+            }
+            done += len;
+        }
+
+        index[key] = *entry;
+        index[key].offset = offset;
+        offset += EntrySize(entry->length);
+    }
+
+    KvSectorHeader header = {KV_SECTOR_MAGIC, g_kv.generation + 1};
+    if (IoTFlashWrite(dst_base, sizeof(header), (const uint8_t*)&header, 0) != IOT_SUCCESS) {
+        printf("KV store: failed to activate sector at 0x%x\n", dst_base);
+        return -1;
+    }
+
+    memcpy(g_kv.index, index, sizeof(index));
+    g_kv.active = target;
+    g_kv.generation = header.generation;
+    g_kv.write_offset = offset;
+    g_kv.compactions++;
+
+    printf("KV store compacted: generation %u, %u bytes used\n", g_kv.generation, offset);
+    return 0;
+}
+
+/**
+ * @brief 追加一个条目（length为0表示删除），空间不足时先压缩
+ * @note 调用者需持有g_kv.mutex
+ */
+static int AppendEntry(uint16_t key, const void *value, uint16_t length, uint32_t crc)
+{
+    uint32_t size = EntrySize(length);
+
+    if (g_kv.write_offset + size > STORAGE_SECTOR_SIZE) {
+        if (Compact() != 0) {
+            return -1;
+        }
+        if (g_kv.write_offset + size > STORAGE_SECTOR_SIZE) {
+            printf("KV store full: key %u needs %u bytes\n", key, size);
+            return -3;
+        }
+    }
+
+    KvEntryHeader header = {key, length, crc};
+    uint32_t addr = SectorAddress(g_kv.active) + g_kv.write_offset;
+
+    g_kv.write_offset += size;
+    g_kv.writes++;
+
+    // 写入失败时头部长度可能已损坏，重启扫描无法越过该条目，因此不再追加，下次写入先压缩
+    if (IoTFlashWrite(addr, sizeof(header), (const uint8_t*)&header, 0) != IOT_SUCCESS ||
+        (length > 0 && IoTFlashWrite(addr + sizeof(header), length, (const uint8_t*)value, 0) != IOT_SUCCESS) ||
+        !VerifyEntry(addr, &header)) {
+        printf("KV store: failed to write key %u at 0x%x\n", key, addr);
+        g_kv.write_offset = STORAGE_SECTOR_SIZE;
+        return -1;
+    }
+
+    KvIndexEntry *entry = &g_kv.index[key];
+    if (length == 0) {
+        memset(entry, 0, sizeof(*entry));
+    } else {
+        entry->offset = addr - SectorAddress(g_kv.active);
+        entry->length = length;
+        entry->crc = crc;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 初始化KV存储并建立内存索引
+ */
+int KvStore_Init(void)
+{
+    if (g_kv.initialized) {
+        return 0;
+    }
+
+    if (LOS_MuxCreate(&g_kv.mutex) != LOS_OK) {
+        printf("Failed to create KV store mutex\n");
+        return -1;
+    }
+
+    // 两个扇区头部均有效时取代数较大者（压缩完成后旧扇区尚未被再次擦除）
+    KvSectorHeader headers[KV_FLASH_SECTORS];
+    bool valid[KV_FLASH_SECTORS];
+    for (uint8_t s = 0; s < KV_FLASH_SECTORS; s++) {
+        valid[s] = ReadSectorHeader(s, &headers[s]);
+    }
+
+    if (!valid[0] && !valid[1]) {
+        printf("KV store: no valid sector, formatting\n");
+        if (FormatSector(0, 1) != 0) {
+            LOS_MuxDelete(g_kv.mutex);
+            return -1;
+        }
+        g_kv.active = 0;
+        g_kv.generation = 1;
+    } else if (valid[0] && (!valid[1] || headers[0].generation > headers[1].generation)) {
+        g_kv.active = 0;
+        g_kv.generation = headers[0].generation;
+    } else {
+        g_kv.active = 1;
+        g_kv.generation = headers[1].generation;
+    }
+
+    ScanActiveSector();
+    g_kv.writes = 0;
+    g_kv.compactions = 0;
+    g_kv.initialized = true;
+
+    uint32_t keys = 0;
+    for (uint16_t key = 1; key < KV_MAX_KEYS; key++) {
+        if (g_kv.index[key].offset != 0) {
+            keys++;
+        }
+    }
+    printf("KV store initialized: sector %u, generation %u, %u keys, %u/%u bytes used\n",
+           g_kv.active, g_kv.generation, keys, g_kv.write_offset, STORAGE_SECTOR_SIZE);
+    return 0;
+}
+
+/**
+ * @brief 读取键值
+ */
+int KvStore_Get(uint16_t key, void *value, uint16_t size)
+{
+    if (!g_kv.initialized || key == 0 || key >= KV_MAX_KEYS || value == NULL) {
+        return -1;
+    }
+
+    int ret = 0;
+    LOS_MuxPend(g_kv.mutex, LOS_WAIT_FOREVER);
+
+    const KvIndexEntry *entry = &g_kv.index[key];
+    if (entry->offset == 0) {
+        ret = -1;
+    } else if (entry->length != size) {
+        printf("KV store: key %u size mismatch (stored %u, expected %u)\n", key, entry->length, size);
+        ret = -2;
+    } else if (IoTFlashRead(SectorAddress(g_kv.active) + entry->offset + sizeof(KvEntryHeader),
+                            size, (uint8_t*)value) != IOT_SUCCESS ||
+               CalculateEntryCrc(key, size, value) != entry->crc) {
+        ret = -2;
+    }
+
+    LOS_MuxPost(g_kv.mutex);
+    return ret;
+}
+
+/**
+ * @brief 写入键值，与当前值相同时不写Flash
+ */
+int KvStore_Set(uint16_t key, const void *value, uint16_t size)
+{
+    if (!g_kv.initialized || key == 0 || key >= KV_MAX_KEYS || value == NULL ||
+        size == 0 || size > KV_MAX_VALUE_SIZE) {
+        return -1;
+    }
+
+    uint32_t crc = CalculateEntryCrc(key, size, value);
+    int ret = 0;
+
+    LOS_MuxPend(g_kv.mutex, LOS_WAIT_FOREVER);
+    const KvIndexEntry *entry = &g_kv.index[key];
+    if (entry->offset == 0 || entry->length != size || entry->crc != crc) {
+        ret = AppendEntry(key, value, size, crc);
+    }
+    LOS_MuxPost(g_kv.mutex);
+
+    return ret;
+}
+
+/**
+ * @brief 删除键
+ */
+int KvStore_Delete(uint16_t key)
+{
+    if (!g_kv.initialized || key == 0 || key >= KV_MAX_KEYS) {
+        return -1;
+    }
+
+    int ret = 0;
+    LOS_MuxPend(g_kv.mutex, LOS_WAIT_FOREVER);
+    if (g_kv.index[key].offset != 0) {
+        ret = AppendEntry(key, NULL, 0, CalculateEntryCrc(key, 0, NULL));
+    }
+    LOS_MuxPost(g_kv.mutex);
+
+    return ret;
+}
+
+/**
+ * @brief 检查键是否存在
+ */
+bool KvStore_Exists(uint16_t key)
+{
+    if (!g_kv.initialized || key == 0 || key >= KV_MAX_KEYS) {
+        return false;
+    }
+    return g_kv.index[key].offset != 0;
+}
+
+/**
+ * @brief 获取KV存储统计信息
+ */
+int KvStore_GetStats(KvStoreStats *stats)
+{
+    if (stats == NULL || !g_kv.initialized) {
+        return -1;
+    }
+
+    memset(stats, 0, sizeof(KvStoreStats));
+    LOS_MuxPend(g_kv.mutex, LOS_WAIT_FOREVER);
+    stats->active_addr = SectorAddress(g_kv.active);
+    stats->generation = g_kv.generation;
+    stats->used_bytes = g_kv.write_offset;
+    stats->live_bytes = sizeof(KvSectorHeader);
+    for (uint16_t key = 1; key < KV_MAX_KEYS; key++) {
+        if (g_kv.index[key].offset != 0) {
+            stats->key_count++;
+            stats->live_bytes += EntrySize(g_kv.index[key].length);
+        }
+    }
+    stats->writes = g_kv.writes;
+    stats->compactions = g_kv.compactions;
+    LOS_MuxPost(g_kv.mutex);
+
+    return 0;
+}
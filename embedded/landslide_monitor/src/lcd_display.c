@@ -112,7 +112,7 @@ void LCD_ShowString(uint16_t x, uint16_t y, const char *str, uint16_t fc, uint16
  */
 void LCD_DisplayRealTimeData(const SensorData *data)
 {
-    if (!g_lcd_initialized || data == NULL || !data->data_valid) {
+    if (!g_lcd_initialized || data == NULL || !Sample_IsValid(data, SAMPLE_VALID_SENSORS)) {
         return;
     }
 
@@ -498,14 +498,18 @@ void LCD_UpdateTrendChartData(const RiskAssessment *assessment)
         lcd_show_string(216, 65, (const uint8_t *)"稳定", LCD_BLUE, LCD_WHITE, 16, 0);
     }
 
-    // 6. 预测等级（基于当前趋势）
+    // 6. 预测等级（反速度法失稳预测给出的风险下限与当前等级取较高者）
     lcd_fill(232, 65, 120, 16, LCD_WHITE);
-    float predicted_risk = current_overall + change_rate * 2; // 简单线性预测
-    if (predicted_risk > 0.8f) {
+    bool has_forecast = assessment->forecast_ttf_h >= 0;
+    RiskLevel predicted_level = (assessment->forecast_level > assessment->level) ?
+                                assessment->forecast_level : assessment->level;
+    if (predicted_level >= RISK_LEVEL_CRITICAL) {
+        lcd_show_chinese(232, 65, (uint8_t *)"极危险", LCD_RED, LCD_WHITE, 16, 0);
+    } else if (predicted_level >= RISK_LEVEL_HIGH) {
         lcd_show_chinese(232, 65, (uint8_t *)"高风险", LCD_RED, LCD_WHITE, 16, 0);
-    } else if (predicted_risk > 0.5f) {
+    } else if (predicted_level >= RISK_LEVEL_MEDIUM) {
         lcd_show_chinese(232, 65, (uint8_t *)"中风险", LCD_ORANGE, LCD_WHITE, 16, 0);
-    } else if (predicted_risk > 0.2f) {
+    } else if (predicted_level >= RISK_LEVEL_LOW) {
         lcd_show_chinese(232, 65, (uint8_t *)"低风险", LCD_YELLOW, LCD_WHITE, 16, 0);
     } else {
         lcd_show_chinese(232, 65, (uint8_t *)"安全", LCD_GREEN, LCD_WHITE, 16, 0);
@@ -532,19 +536,26 @@ void LCD_UpdateTrendChartData(const RiskAssessment *assessment)
         lcd_show_chinese(232, 105, (uint8_t *)"不稳定", LCD_RED, LCD_WHITE, 16, 0);
     }
 
-    // 9. 时间窗口（预测有效期）
+    // 9. 时间窗口（有失稳预测时显示预测剩余时间）
     lcd_fill(85, 175, 150, 16, LCD_WHITE);
-    if (fabsf(change_rate) > 0.1f) {
+    if (has_forecast) {
+        snprintf(data_str, sizeof(data_str), "TTF %.0fh R2 %.2f",
+                 assessment->forecast_ttf_h, assessment->forecast_confidence);
+        lcd_show_string(85, 175, (const uint8_t *)data_str,
+                        (predicted_level >= RISK_LEVEL_HIGH) ? LCD_RED : LCD_ORANGE, LCD_WHITE, 16, 0);
+    } else if (fabsf(change_rate) > 0.1f) {
         lcd_show_chinese(85, 175, (uint8_t *)"短期预测", LCD_ORANGE, LCD_WHITE, 16, 0);
     } else {
         lcd_show_chinese(85, 175, (uint8_t *)"中期预测", LCD_GREEN, LCD_WHITE, 16, 0);
     }
 
-    // 10. 建议行动（基于趋势预测）
+    // 10. 建议行动（基于预测等级）
     lcd_fill(85, 195, 200, 16, LCD_WHITE);
-    if (predicted_risk > 0.8f && change_rate > 0.05f) {
+    if (predicted_level >= RISK_LEVEL_CRITICAL && has_forecast) {
+        lcd_show_chinese(85, 195, (uint8_t *)"准备撤离", LCD_RED, LCD_WHITE, 16, 0);
+    } else if (predicted_level >= RISK_LEVEL_HIGH) {
         lcd_show_chinese(85, 195, (uint8_t *)"加强监测", LCD_RED, LCD_WHITE, 16, 0);
-    } else if (predicted_risk > 0.5f) {
+    } else if (predicted_level >= RISK_LEVEL_MEDIUM) {
         lcd_show_chinese(85, 195, (uint8_t *)"持续观察", LCD_ORANGE, LCD_WHITE, 16, 0);
     } else if (change_rate < -0.05f) {
         lcd_show_chinese(85, 195, (uint8_t *)"风险降低", LCD_GREEN, LCD_WHITE, 16, 0);
@@ -759,7 +770,7 @@ void lcd_set_risk_level(const SensorData *data)
  */
 void LCD_UpdateStatusOnly(const SensorData *data)
 {
-    if (!g_lcd_initialized || !data->data_valid) {
+    if (!g_lcd_initialized || !Sample_IsValid(data, SAMPLE_VALID_SENSORS)) {
         return;
     }
 
@@ -773,7 +784,7 @@ void LCD_UpdateStatusOnly(const SensorData *data)
 void lcd_set_tilt_angle(const SensorData *data)
 {
     char buf[50] = {0};  // 使用char类型
-    float angle_magnitude = sqrtf(data->angle_x * data->angle_x + data->angle_y * data->angle_y);
+    float angle_magnitude = Sample_GetTiltMagnitude(data);
     sprintf(buf, "%.2f", angle_magnitude);
     lcd_show_string(119, 58, (const uint8_t *)buf, LCD_RED, LCD_WHITE, 24, 0);
     // 调整"度"字位置，给两位小数留出足够空间（约48像素宽度）
@@ -786,7 +797,7 @@ void lcd_set_tilt_angle(const SensorData *data)
 void lcd_set_temperature(const SensorData *data)
 {
     char buf[50] = {0};  // 使用char类型
-    sprintf(buf, "%.1fC", data->sht_temperature);  // 使用ASCII字符C替代℃
+    sprintf(buf, "%.1fC", Sample_GetTemperature(data));  // 使用ASCII字符C替代℃
     lcd_show_string(71, 82, (const uint8_t *)buf, LCD_BLUE, LCD_WHITE, 24, 0);
 }
 
@@ -796,7 +807,7 @@ void lcd_set_temperature(const SensorData *data)
 void lcd_set_humidity(const SensorData *data)
 {
     char buf[50] = {0};  // 使用char类型
-    sprintf(buf, "%.1f%%", data->humidity);
+    sprintf(buf, "%.1f%%", Sample_GetHumidity(data));
     lcd_show_string(71, 156, (const uint8_t *)buf, LCD_GREEN, LCD_WHITE, 24, 0);
 }
 
@@ -806,7 +817,7 @@ void lcd_set_humidity(const SensorData *data)
 void lcd_set_light(const SensorData *data)
 {
     char buf[50] = {0};  // 使用char类型
-    sprintf(buf, "%.0flux", data->light_intensity);
+    sprintf(buf, "%.0flux", Sample_GetLight(data));
     lcd_show_string(71, 180, (const uint8_t *)buf, LCD_ORANGE, LCD_WHITE, 24, 0);
 }
 
@@ -815,7 +826,7 @@ void lcd_set_light(const SensorData *data)
  */
 void LCD_UpdateDataOnly(const SensorData *data)
 {
-    if (!g_lcd_initialized || !data->data_valid) {
+    if (!g_lcd_initialized || !Sample_IsValid(data, SAMPLE_VALID_SENSORS)) {
         return;
     }
 
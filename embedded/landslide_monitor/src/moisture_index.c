@@ -0,0 +1,211 @@
+#include "moisture_index.h"
+#include "kv_store.h"
+#include "los_mux.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+// Magnus露点公式系数（-45~60°C）
+#define MAGNUS_B            17.62f
+#define MAGNUS_C            243.12f
+
+static const float g_scale_tau_ms[MOISTURE_SCALES] = {
+    MOISTURE_TAU_SHORT_H * 3600.0f * 1000.0f,
+    MOISTURE_TAU_MEDIUM_H * 3600.0f * 1000.0f,
+    MOISTURE_TAU_LONG_H * 3600.0f * 1000.0f,
+};
+
+// 综合指数中各尺度的权重（和为1）
+static const float g_scale_weights[MOISTURE_SCALES] = {0.2f, 0.4f, 0.4f};
+
+// Flash保存的指数（KV_KEY_MOISTURE_INDEX）
+typedef struct {
+    float scales[MOISTURE_SCALES];
+    uint32_t blocks;                // 累计块数
+} StoredMoisture;
+
+static bool g_moisture_initialized = false;
+static uint32_t g_moisture_mutex = 0;
+static MoistureIndex g_index;
+static StoredMoisture g_stored;
+static float g_block_wet_ms = 0.0f;         // 当前块湿润度×时长累计
+static uint32_t g_block_ms = 0;             // 当前块已累计时长
+static uint32_t g_last_ms = 0;
+static bool g_has_last = false;
+static uint32_t g_unsaved_blocks = 0;
+
+/**
+ * @brief 由温度和相对湿度计算露点（Magnus公式）
+ */
+static float DewPoint(float temperature, float humidity)
+{
+    float gamma = logf(humidity / 100.0f) + MAGNUS_B * temperature / (MAGNUS_C + temperature);
+    return MAGNUS_C * gamma / (MAGNUS_B - gamma);
+}
+
+/**
+ * @brief 湿润度：湿度项按相对湿度线性计入，凝结项按露点差计入（同样湿度下气温越低越接近凝结）
+ */
+static float Wetness(float humidity, float spread)
+{
+    float rh_term = (humidity - MOISTURE_RH_DRY) / (100.0f - MOISTURE_RH_DRY);
+    float dew_term = 1.0f - spread / MOISTURE_DEW_SPREAD_C;
+    rh_term = fminf(fmaxf(rh_term, 0.0f), 1.0f);
+    dew_term = fminf(fmaxf(dew_term, 0.0f), 1.0f);
+    return 0.5f * rh_term + 0.5f * dew_term;
+}
+
+/**
+ * @brief 重新计算综合指数
+ */
+static void UpdateCombined(void)
+{
+    g_index.index = 0.0f;
+    for (int i = 0; i < MOISTURE_SCALES; i++) {
+        g_index.scales[i] = g_stored.scales[i];
+        g_index.index += g_scale_weights[i] * g_stored.scales[i];
+    }
+}
+
+/**
+ * @brief 保存指数到Flash
+ */
+static void SaveIndex(void)
+{
+    if (KvStore_Set(KV_KEY_MOISTURE_INDEX, &g_stored, sizeof(g_stored)) != 0) {
+        printf("Failed to save moisture index\n");
+    }
+    g_unsaved_blocks = 0;
+}
+
+/**
+ * @brief 初始化前期湿润指数
+ */
+int Moisture_Init(void)
+{
+    if (g_moisture_initialized) {
+        return 0;
+    }
+
+    if (LOS_MuxCreate(&g_moisture_mutex) != LOS_OK) {
+        printf("Failed to create moisture index mutex\n");
+        return -1;
+    }
+
+    memset(&g_index, 0, sizeof(g_index));
+    memset(&g_stored, 0, sizeof(g_stored));
+    g_block_wet_ms = 0.0f;
+    g_block_ms = 0;
+    g_has_last = false;
+    g_unsaved_blocks = 0;
+
+    if (KvStore_Get(KV_KEY_MOISTURE_INDEX, &g_stored, sizeof(g_stored)) == 0) {
+        bool valid = true;
+        for (int i = 0; i < MOISTURE_SCALES; i++) {
+            if (!isfinite(g_stored.scales[i]) || g_stored.scales[i] < 0.0f || g_stored.scales[i] > 1.0f) {
+                valid = false;
+            }
+        }
+        if (valid) {
+            g_index.restored = true;
+            printf("Moisture index restored: %.2f/%.2f/%.2f (%u blocks)\n", g_stored.scales[MOISTURE_SCALE_SHORT],
+                   g_stored.scales[MOISTURE_SCALE_MEDIUM], g_stored.scales[MOISTURE_SCALE_LONG], g_stored.blocks);
+        } else {
+            memset(&g_stored, 0, sizeof(g_stored));
+        }
+    }
+    UpdateCombined();
+
+    g_moisture_initialized = true;
+    printf("Moisture index initialized (tau %.0f/%.0f/%.0f h)\n", MOISTURE_TAU_SHORT_H, MOISTURE_TAU_MEDIUM_H,
+           MOISTURE_TAU_LONG_H);
+    return 0;
+}
+
+/**
+ * @brief 反初始化前期湿润指数
+ */
+void Moisture_Deinit(void)
+{
+    if (!g_moisture_initialized) {
+        return;
+    }
+
+    LOS_MuxPend(g_moisture_mutex, LOS_WAIT_FOREVER);
+    if (g_unsaved_blocks > 0) {
+        SaveIndex();
+    }
+    g_moisture_initialized = false;
+    LOS_MuxPost(g_moisture_mutex);
+
+    LOS_MuxDelete(g_moisture_mutex);
+    g_moisture_mutex = 0;
+}
+
+/**
+ * @brief 输入一个温湿度样本
+ */
+int Moisture_Update(float humidity, float temperature, uint32_t timestamp, MoistureIndex *index)
+{
+    if (!g_moisture_initialized) {
+        return -1;
+    }
+
+    LOS_MuxPend(g_moisture_mutex, LOS_WAIT_FOREVER);
+
+    if (isfinite(humidity) && isfinite(temperature) && humidity > 0.0f && humidity <= 100.0f) {
+        g_index.dew_point = DewPoint(temperature, humidity);
+        g_index.wetness = Wetness(humidity, temperature - g_index.dew_point);
+
+        // 样本湿润度保持到下一个样本，按实际间隔累计
+        if (g_has_last) {
+            uint32_t dt_ms = timestamp - g_last_ms;
+            if (dt_ms > MOISTURE_MAX_GAP_MS) {
+                dt_ms = MOISTURE_MAX_GAP_MS;
+            }
+            g_block_wet_ms += g_index.wetness * dt_ms;
+            g_block_ms += dt_ms;
+        }
+        g_last_ms = timestamp;
+        g_has_last = true;
+
+        // 块结束：块平均湿润度按块时长一次衰减更新各尺度
+        if (g_block_ms >= MOISTURE_BLOCK_MS) {
+            float block_wetness = g_block_wet_ms / g_block_ms;
+            for (int i = 0; i < MOISTURE_SCALES; i++) {
+                float alpha = 1.0f - expf(-(float)g_block_ms / g_scale_tau_ms[i]);
+                g_stored.scales[i] += alpha * (block_wetness - g_stored.scales[i]);
+            }
+            g_stored.blocks++;
+            g_block_wet_ms = 0.0f;
+            g_block_ms = 0;
+            UpdateCombined();
+
+            if (++g_unsaved_blocks >= MOISTURE_SAVE_BLOCKS) {
+                SaveIndex();
+            }
+        }
+    }
+
+    if (index != NULL) {
+        *index = g_index;
+    }
+
+    LOS_MuxPost(g_moisture_mutex);
+    return 0;
+}
+
+/**
+ * @brief 获取当前指数
+ */
+int Moisture_Get(MoistureIndex *index)
+{
+    if (!g_moisture_initialized || index == NULL) {
+        return -1;
+    }
+
+    LOS_MuxPend(g_moisture_mutex, LOS_WAIT_FOREVER);
+    *index = g_index;
+    LOS_MuxPost(g_moisture_mutex);
+    return 0;
+}
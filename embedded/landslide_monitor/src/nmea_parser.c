@@ -0,0 +1,686 @@
+#include "nmea_parser.h"
+#include <string.h>
+
+// 解析状态
+enum {
+    NMEA_STATE_IDLE = 0,            // 等待'$'
+    NMEA_STATE_BODY,                // 接收地址和数据字段
+    NMEA_STATE_CHECKSUM_HI,         // 校验和高位
+    NMEA_STATE_CHECKSUM_LO          // 校验和低位
+};
+
+static const int64_t g_pow10[] = {
+    1LL, 10LL, 100LL, 1000LL, 10000LL, 100000LL, 1000000LL, 10000000LL, 100000000LL, 1000000000LL
+};
+
+// 各语句需要解析的最后一个字段序号（之后的字段只做校验）
+#define NMEA_GGA_LAST_FIELD         9           // 海拔
+#define NMEA_RMC_LAST_FIELD         12          // 模式指示
+#define NMEA_GSA_LAST_FIELD         18          // 系统ID
+#define NMEA_GSV_LAST_FIELD         20          // 4颗卫星 + 信号ID
+#define NMEA_VTG_LAST_FIELD         9           // 模式指示
+
+// 速度换算
+#define NMEA_KNOT_TO_MM_S_NUM       514444      // 1节 = 0.514444 m/s
+#define NMEA_KMH_TO_MM_S_DEN        3600        // 1 km/h = 1000000/3600 mm/s
+
+// 整数部分上限（超过时视为非数值字段，防止溢出）
+#define NMEA_MANTISSA_LIMIT         100000000000LL
+
+/**
+ * @brief 重置字段累加状态
+ */
+static void ResetField(NmeaField *field)
+{
+    memset(field, 0, sizeof(NmeaField));
+    field->numeric = true;
+}
+
+/**
+ * @brief 字段是否为有效数值
+ */
+static bool FieldIsNumber(const NmeaField *field)
+{
+    return field->numeric && field->digits > 0;
+}
+
+/**
+ * @brief 字段整数部分
+ */
+static int64_t FieldInteger(const NmeaField *field)
+{
+    return field->mantissa / g_pow10[field->frac_digits];
+}
+
+/**
+ * @brief 字段值按指定小数位转换为定点整数（四舍五入）
+ */
+static int64_t FieldScaled(const NmeaField *field, uint8_t digits)
+{
+    int64_t value = field->mantissa;
+
+    if (field->frac_digits > digits) {
+        int64_t div = g_pow10[field->frac_digits - digits];
+        value = (value + div / 2) / div;
+    } else {
+        value *= g_pow10[digits - field->frac_digits];
+    }
+    return field->negative ? -value : value;
+}
+
+/**
+ * @brief ddmm.mmmm格式坐标转换为1e-7度
+ */
+static int32_t FieldCoordinate(const NmeaField *field)
+{
+    int64_t unit = 100 * g_pow10[field->frac_digits];
+    int64_t degrees = field->mantissa / unit;
+    int64_t minutes = field->mantissa % unit;     // 分 × 10^frac_digits
+    int64_t denom = 60 * g_pow10[field->frac_digits];
+
+    return (int32_t)(degrees * 10000000LL + (minutes * 10000000LL + denom / 2) / denom);
+}
+
+/**
+ * @brief hhmmss.sss格式时间转换为当日毫秒
+ */
+static uint32_t FieldTimeOfDay(const NmeaField *field)
+{
+    int64_t hhmmss = FieldInteger(field);
+    int64_t frac = field->mantissa % g_pow10[field->frac_digits];
+    int64_t ms = (field->frac_digits >= 3) ? frac / g_pow10[field->frac_digits - 3]
+                                           : frac * g_pow10[3 - field->frac_digits];
+
+    return (uint32_t)(((hhmmss / 10000) * 3600 + (hhmmss / 100 % 100) * 60 + hhmmss % 100) * 1000 + ms);
+}
+
+/**
+ * @brief 累加字段字符
+ */
+static void AddFieldChar(NmeaField *field, char c)
+{
+    if (field->length == 0) {
+        field->first = c;
+    }
+    field->length++;
+
+    if (!field->numeric) {
+        return;
+    }
+
+    if (c >= '0' && c <= '9') {
+        if (field->has_dot) {
+            // 超出精度的小数位直接丢弃
+            if (field->frac_digits < NMEA_MAX_FRAC_DIGITS) {
+                field->mantissa = field->mantissa * 10 + (c - '0');
+                field->frac_digits++;
+            }
+        } else if (field->mantissa < NMEA_MANTISSA_LIMIT) {
+            field->mantissa = field->mantissa * 10 + (c - '0');
+        } else {
+            field->numeric = false;
+        }
+        field->digits++;
+    } else if (c == '.' && !field->has_dot) {
+        field->has_dot = true;
+    } else if (c == '-' && field->length == 1) {
+        field->negative = true;
+    } else {
+        field->numeric = false;
+    }
+}
+
+/**
+ * @brief 字段值饱和转换为uint16
+ */
+static uint16_t FieldU16(const NmeaField *field, uint8_t digits)
+{
+    int64_t value = FieldScaled(field, digits);
+    if (value < 0) {
+        return 0;
+    }
+    return (value > UINT16_MAX) ? UINT16_MAX : (uint16_t)value;
+}
+
+/**
+ * @brief 根据发送方标识判断卫星系统（GN为多系统混合，返回未知）
+ */
+static uint8_t SystemFromTalker(const char *address)
+{
+    if (address[0] == 'G') {
+        switch (address[1]) {
+            case 'P': return NMEA_SYSTEM_GPS;
+            case 'L': return NMEA_SYSTEM_GLONASS;
+            case 'A': return NMEA_SYSTEM_GALILEO;
+            case 'B': return NMEA_SYSTEM_BEIDOU;
+            case 'Q': return NMEA_SYSTEM_QZSS;
+            default: break;
+        }
+    } else if (address[0] == 'B' && address[1] == 'D') {
+        return NMEA_SYSTEM_BEIDOU;
+    }
+    return NMEA_SYSTEM_UNKNOWN;
+}
+
+/**
+ * @brief 根据NMEA 4.10系统ID判断卫星系统
+ */
+static uint8_t SystemFromId(int64_t id)
+{
+    switch (id) {
+        case 1: return NMEA_SYSTEM_GPS;
+        case 2: return NMEA_SYSTEM_GLONASS;
+        case 3: return NMEA_SYSTEM_GALILEO;
+        case 4: return NMEA_SYSTEM_BEIDOU;
+        case 5: return NMEA_SYSTEM_QZSS;
+        default: return NMEA_SYSTEM_UNKNOWN;
+    }
+}
+
+/**
+ * @brief 根据PRN编号范围判断卫星系统（GN语句未提供系统ID时使用）
+ */
+static uint8_t SystemFromPrn(uint16_t prn)
+{
+    if (prn >= 1 && prn <= 32) {
+        return NMEA_SYSTEM_GPS;
+    } else if (prn >= 65 && prn <= 96) {
+        return NMEA_SYSTEM_GLONASS;
+    } else if (prn >= 193 && prn <= 200) {
+        return NMEA_SYSTEM_QZSS;
+    } else if ((prn >= 201 && prn <= 264) || (prn >= 401 && prn <= 463)) {
+        return NMEA_SYSTEM_BEIDOU;
+    } else if (prn >= 301 && prn <= 336) {
+        return NMEA_SYSTEM_GALILEO;
+    }
+    return NMEA_SYSTEM_UNKNOWN;
+}
+
+/**
+ * @brief 根据地址字段识别语句类型（接受任意两字符发送方标识，如GP/GN/BD/GL）
+ */
+static NmeaType IdentifySentence(const char *address, uint8_t len)
+{
+    if (len != 5) {
+        return NMEA_TYPE_UNKNOWN;
+    }
+
+    const char *formatter = address + 2;
+    if (memcmp(formatter, "GGA", 3) == 0) {
+        return NMEA_TYPE_GGA;
+    } else if (memcmp(formatter, "RMC", 3) == 0) {
+        return NMEA_TYPE_RMC;
+    } else if (memcmp(formatter, "GSA", 3) == 0) {
+        return NMEA_TYPE_GSA;
+    } else if (memcmp(formatter, "GSV", 3) == 0) {
+        return NMEA_TYPE_GSV;
+    } else if (memcmp(formatter, "VTG", 3) == 0) {
+        return NMEA_TYPE_VTG;
+    }
+    return NMEA_TYPE_UNKNOWN;
+}
+
+/**
+ * @brief 处理GGA字段（字段按序号定位，空字段不会导致后续字段错位）
+ */
+static void HandleGgaField(NmeaGga *gga, uint8_t index, const NmeaField *field)
+{
+    bool number = FieldIsNumber(field);
+
+    switch (index) {
+        case 1:  // UTC时间
+            if (number) {
+                gga->utc_time_ms = FieldTimeOfDay(field);
+                gga->present |= NMEA_GGA_HAS_TIME;
+            }
+            break;
+        case 2:  // 纬度
+            if (number) {
+                gga->latitude = FieldCoordinate(field);
+                gga->present |= NMEA_GGA_HAS_LATITUDE;
+            }
+            break;
+        case 3:  // 南北半球
+            if (field->first == 'S') {
+                gga->latitude = -gga->latitude;
+            } else if (field->first != 'N') {
+                gga->present &= ~NMEA_GGA_HAS_LATITUDE;
+            }
+            break;
+        case 4:  // 经度
+            if (number) {
+                gga->longitude = FieldCoordinate(field);
+                gga->present |= NMEA_GGA_HAS_LONGITUDE;
+            }
+            break;
+        case 5:  // 东西半球
+            if (field->first == 'W') {
+                gga->longitude = -gga->longitude;
+            } else if (field->first != 'E') {
+                gga->present &= ~NMEA_GGA_HAS_LONGITUDE;
+            }
+            break;
+        case 6:  // 定位质量
+            gga->quality = number ? (uint8_t)FieldInteger(field) : 0;
+            break;
+        case 7:  // 卫星数
+            gga->satellites = number ? (uint8_t)FieldInteger(field) : 0;
+            break;
+        case 8:  // HDOP
+            if (number) {
+                int64_t hdop = FieldScaled(field, 2);
+                gga->hdop = (hdop > UINT16_MAX) ? UINT16_MAX : (uint16_t)hdop;
+                gga->present |= NMEA_GGA_HAS_HDOP;
+            }
+            break;
+        case 9:  // 海拔 (米)
+            if (number) {
+                gga->altitude = (int32_t)FieldScaled(field, 2);
+                gga->present |= NMEA_GGA_HAS_ALTITUDE;
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief 处理RMC字段
+ */
+static void HandleRmcField(NmeaRmc *rmc, uint8_t index, const NmeaField *field)
+{
+    bool number = FieldIsNumber(field);
+
+    switch (index) {
+        case 1:  // UTC时间
+            if (number) {
+                rmc->utc_time_ms = FieldTimeOfDay(field);
+                rmc->present |= NMEA_RMC_HAS_TIME;
+            }
+            break;
+        case 2:  // 状态
+            rmc->status = field->first;
+            break;
+        case 3:  // 纬度
+            if (number) {
+                rmc->latitude = FieldCoordinate(field);
+                rmc->present |= NMEA_RMC_HAS_POSITION;
+            }
+            break;
+        case 4:
+            if (field->first == 'S') {
+                rmc->latitude = -rmc->latitude;
+            } else if (field->first != 'N') {
+                rmc->present &= ~NMEA_RMC_HAS_POSITION;
+            }
+            break;
+        case 5:  // 经度（纬度缺失时不置位）
+            if (number && (rmc->present & NMEA_RMC_HAS_POSITION)) {
+                rmc->longitude = FieldCoordinate(field);
+            } else {
+                rmc->present &= ~NMEA_RMC_HAS_POSITION;
+            }
+            break;
+        case 6:
+            if (field->first == 'W') {
+                rmc->longitude = -rmc->longitude;
+            } else if (field->first != 'E') {
+                rmc->present &= ~NMEA_RMC_HAS_POSITION;
+            }
+            break;
+        case 7:  // 速度 (节)
+            if (number) {
+                rmc->speed = (uint32_t)(FieldScaled(field, 3) * NMEA_KNOT_TO_MM_S_NUM / 1000000);
+                rmc->present |= NMEA_RMC_HAS_SPEED;
+            }
+            break;
+        case 8:  // 航向
+            if (number) {
+                rmc->course = FieldU16(field, 2);
+                rmc->present |= NMEA_RMC_HAS_COURSE;
+            }
+            break;
+        case 9:  // 日期 ddmmyy
+            if (number) {
+                int64_t date = FieldInteger(field);
+                rmc->day = (uint8_t)(date / 10000);
+                rmc->month = (uint8_t)(date / 100 % 100);
+                rmc->year = (uint16_t)(2000 + date % 100);
+                rmc->present |= NMEA_RMC_HAS_DATE;
+            }
+            break;
+        case 12:  // 模式指示（NMEA 2.3+）
+            rmc->mode = field->first;
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief 处理GSA字段
+ */
+static void HandleGsaField(NmeaGsa *gsa, uint8_t index, const NmeaField *field)
+{
+    bool number = FieldIsNumber(field);
+
+    if (index >= 3 && index < 3 + NMEA_GSA_MAX_SATELLITES) {
+        // 参与定位卫星PRN，空字段表示该位置未使用
+        if (number && gsa->used_count < NMEA_GSA_MAX_SATELLITES) {
+            gsa->prn[gsa->used_count++] = FieldU16(field, 0);
+        }
+        return;
+    }
+
+    switch (index) {
+        case 1:
+            gsa->mode = field->first;
+            break;
+        case 2:
+            gsa->fix_type = number ? (uint8_t)FieldInteger(field) : 0;
+            break;
+        case 15:
+            gsa->pdop = number ? FieldU16(field, 2) : 0;
+            break;
+        case 16:
+            gsa->hdop = number ? FieldU16(field, 2) : 0;
+            break;
+        case 17:
+            gsa->vdop = number ? FieldU16(field, 2) : 0;
+            break;
+        case 18:  // 系统ID（NMEA 4.10+）
+            if (number) {
+                gsa->system = SystemFromId(FieldInteger(field));
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief 处理GSV字段（卫星组数由总数和序号推算，其后的字段为信号ID）
+ */
+static void HandleGsvField(NmeaGsv *gsv, uint8_t index, const NmeaField *field)
+{
+    bool number = FieldIsNumber(field);
+    int64_t value = number ? FieldInteger(field) : 0;
+
+    switch (index) {
+        case 1:
+            gsv->total_messages = (uint8_t)value;
+            return;
+        case 2:
+            gsv->message_number = (uint8_t)value;
+            return;
+        case 3:
+            gsv->in_view = (uint8_t)value;
+            return;
+        default:
+            break;
+    }
+
+    int remaining = gsv->in_view - (gsv->message_number - 1) * NMEA_GSV_SATS_PER_MSG;
+    int groups = (remaining < 0) ? 0 : (remaining > NMEA_GSV_SATS_PER_MSG ? NMEA_GSV_SATS_PER_MSG : remaining);
+    int group = (index - 4) / 4;
+
+    if (group >= groups) {
+        if (index == 4 + groups * 4 && number) {
+            gsv->signal_id = (uint8_t)value;
+        }
+        return;
+    }
+
+    NmeaSatellite *sat = &gsv->sats[group];
+    switch ((index - 4) % 4) {
+        case 0:
+            sat->prn = (uint16_t)value;
+            if (number) {
+                gsv->count = group + 1;
+            }
+            break;
+        case 1:
+            sat->elevation = (int8_t)value;
+            break;
+        case 2:
+            sat->azimuth = (uint16_t)value;
+            break;
+        default:
+            sat->cn0 = (value > UINT8_MAX) ? UINT8_MAX : (uint8_t)value;
+            break;
+    }
+}
+
+/**
+ * @brief 处理VTG字段
+ */
+static void HandleVtgField(NmeaVtg *vtg, uint8_t index, const NmeaField *field)
+{
+    bool number = FieldIsNumber(field);
+
+    switch (index) {
+        case 1:  // 真北航向
+            if (number) {
+                vtg->course = FieldU16(field, 2);
+                vtg->has_course = true;
+            }
+            break;
+        case 7:  // 速度 (km/h)
+            if (number) {
+                vtg->speed = (uint32_t)(FieldScaled(field, 3) * 1000 / NMEA_KMH_TO_MM_S_DEN);
+                vtg->has_speed = true;
+            }
+            break;
+        case 9:  // 模式指示
+            vtg->mode = field->first;
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief 语句类型需要解析的最后一个字段
+ */
+static uint8_t LastField(NmeaType type)
+{
+    switch (type) {
+        case NMEA_TYPE_GGA: return NMEA_GGA_LAST_FIELD;
+        case NMEA_TYPE_RMC: return NMEA_RMC_LAST_FIELD;
+        case NMEA_TYPE_GSA: return NMEA_GSA_LAST_FIELD;
+        case NMEA_TYPE_GSV: return NMEA_GSV_LAST_FIELD;
+        case NMEA_TYPE_VTG: return NMEA_VTG_LAST_FIELD;
+        default: return 0;
+    }
+}
+
+/**
+ * @brief 字段结束（遇到','或'*'）
+ */
+static void EndField(NmeaParser *parser)
+{
+    uint8_t index = parser->field_index;
+    const NmeaField *field = &parser->field;
+
+    switch (parser->type) {
+        case NMEA_TYPE_GGA:
+            HandleGgaField(&parser->pending.gga, index, field);
+            break;
+        case NMEA_TYPE_RMC:
+            HandleRmcField(&parser->pending.rmc, index, field);
+            break;
+        case NMEA_TYPE_GSA:
+            HandleGsaField(&parser->pending.gsa, index, field);
+            break;
+        case NMEA_TYPE_GSV:
+            HandleGsvField(&parser->pending.gsv, index, field);
+            break;
+        case NMEA_TYPE_VTG:
+            HandleVtgField(&parser->pending.vtg, index, field);
+            break;
+        default:
+            if (index == 0) {
+                parser->type = IdentifySentence(parser->address, parser->address_len);
+                if (parser->type == NMEA_TYPE_GSA) {
+                    parser->pending.gsa.system = SystemFromTalker(parser->address);
+                } else if (parser->type == NMEA_TYPE_GSV) {
+                    parser->pending.gsv.system = SystemFromTalker(parser->address);
+                }
+            }
+            break;
+    }
+
+    if (parser->field_index < UINT8_MAX) {
+        parser->field_index++;
+    }
+    // 不需要的字段和未处理的语句只做校验，不累加数值
+    parser->collect = (parser->field_index <= LastField(parser->type));
+    ResetField(&parser->field);
+}
+
+/**
+ * @brief 十六进制字符转数值
+ */
+static int HexValue(char c)
+{
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    } else if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    } else if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    return -1;
+}
+
+/**
+ * @brief 校验通过后提交语句结果
+ */
+static NmeaType CommitSentence(NmeaParser *parser)
+{
+    parser->stats.sentences++;
+
+    switch (parser->type) {
+        case NMEA_TYPE_GGA:
+            parser->gga = parser->pending.gga;
+            break;
+        case NMEA_TYPE_RMC:
+            parser->rmc = parser->pending.rmc;
+            break;
+        case NMEA_TYPE_GSA:
+            // 多系统GN语句未带系统ID时按首颗卫星PRN判断
+            if (parser->pending.gsa.system == NMEA_SYSTEM_UNKNOWN && parser->pending.gsa.used_count > 0) {
+                parser->pending.gsa.system = SystemFromPrn(parser->pending.gsa.prn[0]);
+            }
+            parser->gsa = parser->pending.gsa;
+            break;
+        case NMEA_TYPE_GSV:
+            if (parser->pending.gsv.system == NMEA_SYSTEM_UNKNOWN && parser->pending.gsv.count > 0) {
+                parser->pending.gsv.system = SystemFromPrn(parser->pending.gsv.sats[0].prn);
+            }
+            parser->gsv = parser->pending.gsv;
+            break;
+        case NMEA_TYPE_VTG:
+            parser->vtg = parser->pending.vtg;
+            break;
+        default:
+            break;
+    }
+    return parser->type;
+}
+
+/**
+ * @brief 初始化解析器
+ */
+void Nmea_Init(NmeaParser *parser)
+{
+    if (parser == NULL) {
+        return;
+    }
+
+    memset(parser, 0, sizeof(NmeaParser));
+    parser->state = NMEA_STATE_IDLE;
+    ResetField(&parser->field);
+}
+
+/**
+ * @brief 输入一个字节
+ */
+NmeaType Nmea_Feed(NmeaParser *parser, char c)
+{
+    if (parser == NULL) {
+        return NMEA_TYPE_UNKNOWN;
+    }
+
+    // 任意位置出现'$'都重新开始，丢弃未完成的语句
+    if (c == '$') {
+        if (parser->state != NMEA_STATE_IDLE) {
+            parser->stats.format_errors++;
+        }
+        parser->state = NMEA_STATE_BODY;
+        parser->checksum = 0;
+        parser->length = 1;
+        parser->field_index = 0;
+        parser->address_len = 0;
+        parser->type = NMEA_TYPE_UNKNOWN;
+        parser->collect = true;
+        memset(&parser->pending, 0, sizeof(parser->pending));
+        ResetField(&parser->field);
+        return NMEA_TYPE_UNKNOWN;
+    }
+
+    switch (parser->state) {
+        case NMEA_STATE_BODY:
+            if (c == '*') {
+                EndField(parser);
+                parser->state = NMEA_STATE_CHECKSUM_HI;
+                break;
+            }
+            if (c < 0x20 || c > 0x7E || ++parser->length > NMEA_MAX_SENTENCE_LEN) {
+                // 缺少校验和、非法字符或超长
+                parser->stats.format_errors++;
+                parser->state = NMEA_STATE_IDLE;
+                break;
+            }
+
+            parser->checksum ^= (uint8_t)c;
+            if (c == ',') {
+                EndField(parser);
+            } else if (parser->collect) {
+                if (parser->field_index == 0 && parser->address_len < NMEA_ADDRESS_LEN) {
+                    parser->address[parser->address_len++] = c;
+                }
+                AddFieldChar(&parser->field, c);
+            }
+            break;
+
+        case NMEA_STATE_CHECKSUM_HI:
+        case NMEA_STATE_CHECKSUM_LO: {
+            int value = HexValue(c);
+            if (value < 0) {
+                parser->stats.format_errors++;
+                parser->state = NMEA_STATE_IDLE;
+                break;
+            }
+            if (parser->state == NMEA_STATE_CHECKSUM_HI) {
+                parser->received_checksum = (uint8_t)(value << 4);
+                parser->state = NMEA_STATE_CHECKSUM_LO;
+                break;
+            }
+
+            parser->received_checksum |= (uint8_t)value;
+            parser->state = NMEA_STATE_IDLE;
+            if (parser->received_checksum != parser->checksum) {
+                parser->stats.checksum_errors++;
+                break;
+            }
+            return CommitSentence(parser);
+        }
+
+        default:
+            // 语句之间的CR/LF和噪声
+            break;
+    }
+
+    return NMEA_TYPE_UNKNOWN;
+}
@@ -17,6 +17,8 @@
 #include <stdlib.h>
 #include <string.h>
 #include "output_devices.h"
+#include "actuator_pattern.h"
+#include "voice_queue.h"
 #include "iot_gpio.h"
 #include "iot_pwm.h"
 #include "iot_uart.h"
@@ -36,10 +38,35 @@ static bool g_voice_initialized = false;
 static bool g_cloud_alarm_acknowledged = false;
 static uint32_t g_last_cloud_command_time = 0;
 
-// 马达自动停止定时器变量
-static bool g_motor_auto_stop_enabled = false;
-static uint32_t g_motor_start_time = 0;
-static uint32_t g_motor_duration_ms = 0;
+// 报警模式参数
+#define BUZZER_DEFAULT_FREQ_HZ      2000        // 默认蜂鸣频率
+#define MOTOR_VIBRATE_DUTY          70          // 振动占空比 (%)
+
+// 各风险等级的蜂鸣模式（频率0为静音间隔）
+static const ActuatorStep g_buzzer_low[] = {{120, BUZZER_DEFAULT_FREQ_HZ}};
+static const ActuatorStep g_buzzer_medium[] = {
+    {120, BUZZER_DEFAULT_FREQ_HZ}, {100, 0}, {120, BUZZER_DEFAULT_FREQ_HZ}
+};
+static const ActuatorStep g_buzzer_high[] = {
+    {120, BUZZER_DEFAULT_FREQ_HZ}, {80, 0}, {120, BUZZER_DEFAULT_FREQ_HZ}, {80, 0}, {120, BUZZER_DEFAULT_FREQ_HZ}
+};
+static const ActuatorStep g_buzzer_critical[] = {
+    {500, BUZZER_DEFAULT_FREQ_HZ}, {150, 0}, {100, BUZZER_DEFAULT_FREQ_HZ}, {80, 0},
+    {100, BUZZER_DEFAULT_FREQ_HZ}, {150, 0}, {500, BUZZER_DEFAULT_FREQ_HZ}
+};
+
+// 各风险等级的振动模式（占空比0为停止间隔）
+static const ActuatorStep g_motor_low[] = {{150, MOTOR_VIBRATE_DUTY}};
+static const ActuatorStep g_motor_medium[] = {{200, MOTOR_VIBRATE_DUTY}, {150, 0}, {200, MOTOR_VIBRATE_DUTY}};
+static const ActuatorStep g_motor_high[] = {
+    {250, MOTOR_VIBRATE_DUTY}, {120, 0}, {250, MOTOR_VIBRATE_DUTY}, {120, 0}, {250, MOTOR_VIBRATE_DUTY}
+};
+static const ActuatorStep g_motor_critical[] = {
+    {400, MOTOR_VIBRATE_DUTY}, {100, 0}, {120, MOTOR_VIBRATE_DUTY}, {60, 0}, {120, MOTOR_VIBRATE_DUTY},
+    {60, 0}, {120, MOTOR_VIBRATE_DUTY}, {100, 0}, {400, MOTOR_VIBRATE_DUTY}
+};
+
+#define PATTERN_STEPS(pattern)      ((uint8_t)(sizeof(pattern) / sizeof((pattern)[0])))
 
 static RGB_Color g_current_rgb_color = RGB_COLOR_OFF;
 static bool g_alarm_muted = false;
@@ -50,6 +77,39 @@ static ButtonState g_button_state = BUTTON_STATE_RELEASED;
 static uint32_t g_button_press_time = 0;
 static ButtonState g_last_pressed_button = BUTTON_STATE_RELEASED;
 
+/**
+ * @brief 蜂鸣器通道输出（定时器任务调用）
+ * @param level 频率 (Hz)，0为静音
+ */
+static void BuzzerOutput(uint16_t level)
+{
+    if (level > 0) {
+        IoTPwmStart(BUZZER_PWM, 50, level);
+    } else {
+        IoTPwmStop(BUZZER_PWM);
+    }
+}
+
+/**
+ * @brief 电机通道输出（定时器任务调用）
+ * @param level 占空比 (%)，0为停止（使用最小占空比1代替0）
+ */
+static void MotorOutput(uint16_t level)
+{
+    IoTPwmStart(MOTOR_PWM, level > 0 ? level : 1, PWM_FREQ_HZ);
+}
+
+/**
+ * @brief 报警灯通道输出（定时器任务调用）
+ * @param level 非0为点亮
+ */
+static void AlarmLightOutput(uint16_t level)
+{
+    if (g_alarm_light_initialized) {
+        IoTGpioSetOutputVal(ALARM_LIGHT_PIN, level ? IOT_GPIO_VALUE1 : IOT_GPIO_VALUE0);
+    }
+}
+
 /**
  * @brief 初始化所有输出设备
  * @return 0: 成功, 其他: 失败
@@ -60,6 +120,16 @@ int OutputDevices_Init(void)
     int error_count = 0;
     
     printf("Initializing output devices...\n");
+
+    // 初始化报警模式播放（蜂鸣器、电机、报警灯由软件定时器驱动，调用方不阻塞）
+    ret = Actuator_Init();
+    if (ret != 0) {
+        printf("Actuator sequencer initialization failed: %d\n", ret);
+        error_count++;
+    }
+    Actuator_SetOutput(ACTUATOR_BUZZER, BuzzerOutput);
+    Actuator_SetOutput(ACTUATOR_MOTOR, MotorOutput);
+    Actuator_SetOutput(ACTUATOR_ALARM_LIGHT, AlarmLightOutput);
     
     // 初始化RGB灯
     ret = RGB_Init();
@@ -119,6 +189,7 @@ int OutputDevices_Init(void)
  */
 void OutputDevices_Deinit(void)
 {
+    Actuator_Deinit();
     RGB_Off();
     Buzzer_Off();
     Motor_Off();
@@ -146,6 +217,7 @@ void OutputDevices_Deinit(void)
     }
     
     if (g_voice_initialized) {
+        VoiceQueue_Deinit();
         IoTUartDeinit(VOICE_UART_BUS);
         g_voice_initialized = false;
     }
@@ -346,7 +418,17 @@ int Buzzer_Init(void)
 }
 
 /**
- * @brief 蜂鸣器响铃
+ * @brief 限制蜂鸣频率范围 (100Hz - 10kHz)
+ */
+static uint32_t ClampBuzzerFrequency(uint32_t frequency_hz)
+{
+    if (frequency_hz < 100) frequency_hz = 100;
+    if (frequency_hz > 10000) frequency_hz = 10000;
+    return frequency_hz;
+}
+
+/**
+ * @brief 蜂鸣器响铃（非阻塞）
  * @param duration_ms 持续时间 (毫秒)
  */
 void Buzzer_Beep(uint32_t duration_ms)
@@ -354,17 +436,13 @@ void Buzzer_Beep(uint32_t duration_ms)
     if (!g_buzzer_initialized || g_alarm_muted) {
         return;
     }
-    
-    // 开启蜂鸣器 (50%占空比, 2kHz频率)
-    IoTPwmStart(BUZZER_PWM, 50, 2000);
 
-    // 延时后关闭
-    LOS_Msleep(duration_ms);
-    IoTPwmStop(BUZZER_PWM);
+    ActuatorStep step = {duration_ms, BUZZER_DEFAULT_FREQ_HZ};
+    Actuator_Play(ACTUATOR_BUZZER, &step, 1, 1, ACTUATOR_PRIO_MANUAL);
 }
 
 /**
- * @brief 根据风险等级蜂鸣
+ * @brief 根据风险等级蜂鸣（非阻塞，高等级模式抢占正在播放的低等级模式）
  * @param risk_level 风险等级
  */
 void Buzzer_BeepByRisk(RiskLevel risk_level)
@@ -372,7 +450,10 @@ void Buzzer_BeepByRisk(RiskLevel risk_level)
     if (!g_buzzer_initialized || g_alarm_muted) {
         return;
     }
-    
+
+    const ActuatorStep *pattern = NULL;
+    uint8_t steps = 0;
+
     switch (risk_level) {
         case RISK_LEVEL_SAFE:
             // 安全状态不响
@@ -380,40 +461,36 @@ void Buzzer_BeepByRisk(RiskLevel risk_level)
         case RISK_LEVEL_LOW:
             // 低风险：1声短响 (滴)
             printf("ALARM: Low risk - 1 short beep\n");
-            Buzzer_Beep(120);
+            pattern = g_buzzer_low;
+            steps = PATTERN_STEPS(g_buzzer_low);
             break;
         case RISK_LEVEL_MEDIUM:
             // 中风险：2声短响 (滴-滴)
             printf("ALARM: Medium risk - 2 short beeps\n");
-            Buzzer_Beep(120);
-            LOS_Msleep(100);
-            Buzzer_Beep(120);
+            pattern = g_buzzer_medium;
+            steps = PATTERN_STEPS(g_buzzer_medium);
             break;
         case RISK_LEVEL_HIGH:
             // 高风险：3声短响 (滴-滴-滴)
             printf("ALARM: High risk - 3 short beeps\n");
-            Buzzer_Beep(120);
-            LOS_Msleep(80);
-            Buzzer_Beep(120);
-            LOS_Msleep(80);
-            Buzzer_Beep(120);
+            pattern = g_buzzer_high;
+            steps = PATTERN_STEPS(g_buzzer_high);
             break;
         case RISK_LEVEL_CRITICAL:
             // 危急：长响-短响-长响 (滴——滴滴——)
             printf("ALARM: Critical risk - long-short-long pattern\n");
-            Buzzer_Beep(500);  // 长响
-            LOS_Msleep(150);
-            Buzzer_Beep(100);  // 短响
-            LOS_Msleep(80);
-            Buzzer_Beep(100);  // 短响
-            LOS_Msleep(150);
-            Buzzer_Beep(500);  // 长响
+            pattern = g_buzzer_critical;
+            steps = PATTERN_STEPS(g_buzzer_critical);
             break;
     }
+
+    if (pattern != NULL) {
+        Actuator_Play(ACTUATOR_BUZZER, pattern, steps, 1, ACTUATOR_PRIO_RISK_BASE + risk_level - RISK_LEVEL_LOW);
+    }
 }
 
 /**
- * @brief 蜂鸣器响铃（自定义频率）
+ * @brief 蜂鸣器响铃（自定义频率，非阻塞）
  * @param duration_ms 持续时间 (毫秒)
  * @param frequency_hz 频率 (Hz)
  */
@@ -423,18 +500,31 @@ void Buzzer_BeepWithFreq(uint32_t duration_ms, uint32_t frequency_hz)
         return;
     }
 
-    // 限制频率范围 (100Hz - 10kHz)
-    if (frequency_hz < 100) frequency_hz = 100;
-    if (frequency_hz > 10000) frequency_hz = 10000;
-
+    frequency_hz = ClampBuzzerFrequency(frequency_hz);
     printf("Buzzer beep: %dms at %dHz\n", duration_ms, frequency_hz);
 
-    // 开启蜂鸣器 (50%占空比, 自定义频率)
-    IoTPwmStart(BUZZER_PWM, 50, frequency_hz);
+    ActuatorStep step = {duration_ms, (uint16_t)frequency_hz};
+    Actuator_Play(ACTUATOR_BUZZER, &step, 1, 1, ACTUATOR_PRIO_MANUAL);
+}
 
-    // 延时后关闭
-    LOS_Msleep(duration_ms);
-    IoTPwmStop(BUZZER_PWM);
+/**
+ * @brief 蜂鸣器间歇响（自定义频率，非阻塞）
+ * @param on_ms 每声持续时间 (毫秒)
+ * @param off_ms 间隔 (毫秒)
+ * @param frequency_hz 频率 (Hz)
+ * @param count 响声次数
+ */
+void Buzzer_BeepRepeat(uint32_t on_ms, uint32_t off_ms, uint32_t frequency_hz, uint8_t count)
+{
+    if (!g_buzzer_initialized || g_alarm_muted || count == 0) {
+        return;
+    }
+
+    frequency_hz = ClampBuzzerFrequency(frequency_hz);
+    printf("Buzzer beep x%d: %dms on / %dms off at %dHz\n", count, on_ms, off_ms, frequency_hz);
+
+    ActuatorStep steps[] = {{on_ms, (uint16_t)frequency_hz}, {off_ms, 0}};
+    Actuator_Play(ACTUATOR_BUZZER, steps, PATTERN_STEPS(steps), count, ACTUATOR_PRIO_MANUAL);
 }
 
 /**
@@ -447,13 +537,11 @@ void Buzzer_Start(uint32_t frequency_hz)
         return;
     }
 
-    // 限制频率范围 (100Hz - 10kHz)
-    if (frequency_hz < 100) frequency_hz = 100;
-    if (frequency_hz > 10000) frequency_hz = 10000;
-
+    frequency_hz = ClampBuzzerFrequency(frequency_hz);
     printf("Buzzer start continuous at %dHz\n", frequency_hz);
 
-    // 开启蜂鸣器 (50%占空比, 自定义频率)
+    // 停止正在播放的模式后直接开启 (50%占空比, 自定义频率)
+    Actuator_Stop(ACTUATOR_BUZZER);
     IoTPwmStart(BUZZER_PWM, 50, frequency_hz);
 }
 
@@ -464,6 +552,7 @@ void Buzzer_Off(void)
 {
     if (g_buzzer_initialized) {
         printf("Buzzer stopped\n");
+        Actuator_Stop(ACTUATOR_BUZZER);
         IoTPwmStop(BUZZER_PWM);  // 完全停止PWM输出
     }
 }
@@ -494,7 +583,7 @@ int Motor_Init(void)
 }
 
 /**
- * @brief 电机振动
+ * @brief 电机振动（非阻塞）
  * @param duration_ms 持续时间 (毫秒)
  */
 void Motor_Vibrate(uint32_t duration_ms)
@@ -503,16 +592,12 @@ void Motor_Vibrate(uint32_t duration_ms)
         return;
     }
 
-    // 开启电机 (70%占空比)
-    IoTPwmStart(MOTOR_PWM, 70, PWM_FREQ_HZ);
-
-    // 延时后关闭
-    LOS_Msleep(duration_ms);
-    IoTPwmStart(MOTOR_PWM, 1, PWM_FREQ_HZ);  // 使用最小占空比代替0
+    ActuatorStep step = {duration_ms, MOTOR_VIBRATE_DUTY};
+    Actuator_Play(ACTUATOR_MOTOR, &step, 1, 1, ACTUATOR_PRIO_MANUAL);
 }
 
 /**
- * @brief 根据风险等级振动
+ * @brief 根据风险等级振动（非阻塞，高等级模式抢占正在播放的低等级模式）
  * @param risk_level 风险等级
  */
 void Motor_VibrateByRisk(RiskLevel risk_level)
@@ -521,6 +606,9 @@ void Motor_VibrateByRisk(RiskLevel risk_level)
         return;
     }
 
+    const ActuatorStep *pattern = NULL;
+    uint8_t steps = 0;
+
     switch (risk_level) {
         case RISK_LEVEL_SAFE:
             // 安全状态不振动
@@ -528,38 +616,32 @@ void Motor_VibrateByRisk(RiskLevel risk_level)
         case RISK_LEVEL_LOW:
             // 低风险：1次轻微振动
             printf("VIBRATION: Low risk - 1 light vibration\n");
-            Motor_Vibrate(150);
+            pattern = g_motor_low;
+            steps = PATTERN_STEPS(g_motor_low);
             break;
         case RISK_LEVEL_MEDIUM:
             // 中风险：2次中等振动
             printf("VIBRATION: Medium risk - 2 medium vibrations\n");
-            Motor_Vibrate(200);
-            LOS_Msleep(150);
-            Motor_Vibrate(200);
+            pattern = g_motor_medium;
+            steps = PATTERN_STEPS(g_motor_medium);
             break;
         case RISK_LEVEL_HIGH:
             // 高风险：3次强振动
             printf("VIBRATION: High risk - 3 strong vibrations\n");
-            Motor_Vibrate(250);
-            LOS_Msleep(120);
-            Motor_Vibrate(250);
-            LOS_Msleep(120);
-            Motor_Vibrate(250);
+            pattern = g_motor_high;
+            steps = PATTERN_STEPS(g_motor_high);
             break;
         case RISK_LEVEL_CRITICAL:
             // 危急：持续强振动模式
             printf("VIBRATION: Critical risk - continuous strong pattern\n");
-            Motor_Vibrate(400);  // 长振动
-            LOS_Msleep(100);
-            Motor_Vibrate(120);  // 短振动
-            LOS_Msleep(60);
-            Motor_Vibrate(120);  // 短振动
-            LOS_Msleep(60);
-            Motor_Vibrate(120);  // 短振动
-            LOS_Msleep(100);
-            Motor_Vibrate(400);  // 长振动
+            pattern = g_motor_critical;
+            steps = PATTERN_STEPS(g_motor_critical);
             break;
     }
+
+    if (pattern != NULL) {
+        Actuator_Play(ACTUATOR_MOTOR, pattern, steps, 1, ACTUATOR_PRIO_RISK_BASE + risk_level - RISK_LEVEL_LOW);
+    }
 }
 
 /**
@@ -568,13 +650,9 @@ void Motor_VibrateByRisk(RiskLevel risk_level)
 void Motor_Off(void)
 {
     if (g_motor_initialized) {
+        Actuator_Stop(ACTUATOR_MOTOR);
         IoTPwmStop(MOTOR_PWM);  // 完全停止PWM输出
-
-        // 清除自动停止定时器
-        g_motor_auto_stop_enabled = false;
-        g_motor_start_time = 0;
-        g_motor_duration_ms = 0;
-        printf("Motor stopped and auto-stop timer cleared\n");
+        printf("Motor stopped\n");
     }
 }
 
@@ -646,51 +724,19 @@ void Motor_Run(uint8_t speed, MotorDirection direction, uint32_t duration_ms)
     // 为了避免占空比为0的问题，最小值设为1，最大值设为99
     uint32_t duty_cycle = (speed * 98 / 100) + 1;  // 1-99范围
 
-    // 启动PWM
-    IoTPwmStart(MOTOR_PWM, duty_cycle, PWM_FREQ_HZ);
-
-    // 如果设置了持续时间，启动定时器
     if (duration_ms > 0) {
+        // 定时运行：由模式播放定时器到时停止
         printf("Motor will run for %d milliseconds\n", duration_ms);
-        // 使用非阻塞方式：记录启动时间，在主循环中检查是否需要停止
-        g_motor_start_time = LOS_TickCountGet();
-        g_motor_duration_ms = duration_ms;
-        g_motor_auto_stop_enabled = true;
-        printf("Motor auto-stop timer set for %d ms\n", duration_ms);
+        ActuatorStep step = {duration_ms, (uint16_t)duty_cycle};
+        Actuator_Play(ACTUATOR_MOTOR, &step, 1, 1, ACTUATOR_PRIO_MANUAL);
     } else {
         // 持续运行模式
-        g_motor_auto_stop_enabled = false;
+        Actuator_Stop(ACTUATOR_MOTOR);
+        IoTPwmStart(MOTOR_PWM, duty_cycle, PWM_FREQ_HZ);
         printf("Motor running continuously (no auto-stop)\n");
     }
 }
 
-/**
- * @brief 检查马达是否需要自动停止（非阻塞）
- * 应该在主循环中定期调用此函数
- */
-void Motor_CheckAutoStop(void)
-{
-    if (!g_motor_auto_stop_enabled) {
-        return;
-    }
-
-    uint32_t current_time = LOS_TickCountGet();
-    uint32_t elapsed_ticks = current_time - g_motor_start_time;
-    uint32_t elapsed_ms = elapsed_ticks;  // 在rk2206上，1 tick = 1 ms
-
-    // 每2秒打印一次运行状态（减少输出频率）
-    static uint32_t last_debug_time = 0;
-    if (current_time - last_debug_time >= 2000) {  // 每2秒
-        printf("Motor running: %d/%d ms\n", elapsed_ms, g_motor_duration_ms);
-        last_debug_time = current_time;
-    }
-
-    if (elapsed_ms >= g_motor_duration_ms) {
-        printf("Motor auto-stop triggered after %d ms\n", elapsed_ms);
-        Motor_Off();
-    }
-}
-
 // ==================== 报警灯控制函数 ====================
 
 /**
@@ -717,7 +763,12 @@ void AlarmLight_SetState(bool state)
         return;
     }
 
+    // 设置固定状态时结束闪烁（停止时已输出熄灭）
     static bool last_state = false;
+    if (Actuator_IsActive(ACTUATOR_ALARM_LIGHT)) {
+        Actuator_Stop(ACTUATOR_ALARM_LIGHT);
+        last_state = false;
+    }
     if (state == last_state) {
         return;  // 状态未改变，不需要操作
     }
@@ -756,24 +807,17 @@ void AlarmLight_SetByRisk(RiskLevel risk_level)
 }
 
 /**
- * @brief 报警灯闪烁
+ * @brief 报警灯闪烁（非阻塞，已在闪烁时保持当前节奏）
  * @param interval_ms 闪烁间隔(毫秒)
  */
 void AlarmLight_Blink(uint32_t interval_ms)
 {
-    if (!g_alarm_light_initialized) {
+    if (!g_alarm_light_initialized || Actuator_IsActive(ACTUATOR_ALARM_LIGHT)) {
         return;
     }
 
-    static uint32_t last_toggle_time = 0;
-    static bool current_state = false;
-    uint32_t current_time = LOS_TickCountGet();
-
-    if (current_time - last_toggle_time >= interval_ms) {
-        current_state = !current_state;
-        AlarmLight_SetState(current_state);
-        last_toggle_time = current_time;
-    }
+    ActuatorStep steps[] = {{interval_ms, 1}, {interval_ms, 0}};
+    Actuator_Play(ACTUATOR_ALARM_LIGHT, steps, PATTERN_STEPS(steps), ACTUATOR_REPEAT_FOREVER, ACTUATOR_PRIO_MANUAL);
 }
 
 /**
@@ -819,6 +863,42 @@ int Button_Init(void)
     return 0;
 }
 
+/**
+ * @brief 根据ADC值判断按键
+ * @param adc_value ADC值
+ * @return 按键状态
+ */
+static ButtonState ClassifyButtonAdc(unsigned int adc_value)
+{
+    if (adc_value >= BUTTON_K3_MIN && adc_value <= BUTTON_K3_MAX) {
+        return BUTTON_STATE_K3_PRESSED;  // UP按键 - 手动重置
+    } else if (adc_value >= BUTTON_K6_MIN && adc_value <= BUTTON_K6_MAX) {
+        return BUTTON_STATE_K6_PRESSED;  // RIGHT按键 - 预留功能
+    } else if (adc_value >= BUTTON_K4_MIN && adc_value <= BUTTON_K4_MAX) {
+        return BUTTON_STATE_K4_PRESSED;  // DOWN按键 - 切换显示模式
+    } else if (adc_value >= BUTTON_K5_MIN && adc_value <= BUTTON_K5_MAX) {
+        return BUTTON_STATE_K5_PRESSED;  // LEFT按键 - 静音/取消静音
+    }
+    return BUTTON_STATE_RELEASED;
+}
+
+/**
+ * @brief 读取当前按键（单次ADC读数，不消抖、不回调）
+ * @return 按键状态
+ */
+ButtonState Button_ReadKey(void)
+{
+    if (!g_button_initialized) {
+        return BUTTON_STATE_RELEASED;
+    }
+
+    unsigned int adc_value = 0;
+    if (IoTAdcGetVal(BUTTON_ADC_CHANNEL, &adc_value) != IOT_SUCCESS) {
+        return BUTTON_STATE_RELEASED;
+    }
+    return ClassifyButtonAdc(adc_value);
+}
+
 /**
  * @brief 获取按键状态
  * @return 按键状态
@@ -837,19 +917,7 @@ ButtonState Button_GetState(void)
     }
 
     // 根据ADC值判断按键状态
-    ButtonState new_state = BUTTON_STATE_RELEASED;
-
-    if (adc_value >= BUTTON_K3_MIN && adc_value <= BUTTON_K3_MAX) {
-        new_state = BUTTON_STATE_K3_PRESSED;  // UP按键 - 手动重置
-    } else if (adc_value >= BUTTON_K6_MIN && adc_value <= BUTTON_K6_MAX) {
-        new_state = BUTTON_STATE_K6_PRESSED;  // RIGHT按键 - 预留功能
-    } else if (adc_value >= BUTTON_K4_MIN && adc_value <= BUTTON_K4_MAX) {
-        new_state = BUTTON_STATE_K4_PRESSED;  // DOWN按键 - 切换显示模式
-    } else if (adc_value >= BUTTON_K5_MIN && adc_value <= BUTTON_K5_MAX) {
-        new_state = BUTTON_STATE_K5_PRESSED;  // LEFT按键 - 静音/取消静音
-    } else if (adc_value >= BUTTON_RELEASED_MIN && adc_value <= BUTTON_RELEASED_MAX) {
-        new_state = BUTTON_STATE_RELEASED;
-    }
+    ButtonState new_state = ClassifyButtonAdc(adc_value);
 
     // 检测按键状态变化
     if (new_state != g_button_state) {
@@ -861,16 +929,7 @@ ButtonState Button_GetState(void)
             ret = IoTAdcGetVal(BUTTON_ADC_CHANNEL, &adc_value);
             if (ret == IOT_SUCCESS) {
                 // 重新判断状态
-                ButtonState confirmed_state = BUTTON_STATE_RELEASED;
-                if (adc_value >= BUTTON_K3_MIN && adc_value <= BUTTON_K3_MAX) {
-                    confirmed_state = BUTTON_STATE_K3_PRESSED;
-                } else if (adc_value >= BUTTON_K6_MIN && adc_value <= BUTTON_K6_MAX) {
-                    confirmed_state = BUTTON_STATE_K6_PRESSED;
-                } else if (adc_value >= BUTTON_K4_MIN && adc_value <= BUTTON_K4_MAX) {
-                    confirmed_state = BUTTON_STATE_K4_PRESSED;
-                } else if (adc_value >= BUTTON_K5_MIN && adc_value <= BUTTON_K5_MAX) {
-                    confirmed_state = BUTTON_STATE_K5_PRESSED;
-                }
+                ButtonState confirmed_state = ClassifyButtonAdc(adc_value);
 
                 if (confirmed_state != BUTTON_STATE_RELEASED) {
                     g_button_press_time = LOS_TickCountGet();
@@ -985,6 +1044,13 @@ int Voice_Init(void)
         return -1;
     }
 
+    // 语音任务独占串口，播报请求只入队
+    ret = VoiceQueue_Init(VOICE_UART_BUS);
+    if (ret != 0) {
+        IoTUartDeinit(VOICE_UART_BUS);
+        return -2;
+    }
+
     g_voice_initialized = true;
     printf("Voice module initialized successfully\n");
 
@@ -1012,8 +1078,31 @@ void Voice_PlayMessage(VoiceMessage msg)
         "System error"              // VOICE_MSG_SYSTEM_ERROR
     };
 
-    if (msg < sizeof(messages) / sizeof(messages[0])) {
-        Voice_PlayCustom(messages[msg]);
+    if (msg >= sizeof(messages) / sizeof(messages[0])) {
+        return;
+    }
+
+    // 风险播报优先于例行消息，危急风险打断正在进行的播报
+    VoicePriority priority;
+    switch (msg) {
+        case VOICE_MSG_SAFE:
+            priority = VOICE_PRIO_LOW;
+            break;
+        case VOICE_MSG_LOW_RISK:
+        case VOICE_MSG_MEDIUM_RISK:
+        case VOICE_MSG_HIGH_RISK:
+            priority = VOICE_PRIO_HIGH;
+            break;
+        case VOICE_MSG_CRITICAL_RISK:
+            priority = VOICE_PRIO_CRITICAL;
+            break;
+        default:
+            priority = VOICE_PRIO_NORMAL;
+            break;
+    }
+
+    if (VoiceQueue_Post(messages[msg], priority) == 0 && msg != VOICE_MSG_SAFE) {
+        printf("Voice: %s\n", messages[msg]);
     }
 }
 
@@ -1027,18 +1116,20 @@ void Voice_PlayCustom(const char *text)
         return;
     }
 
-    // 发送语音播报命令 (简化实现)
-    char cmd[128];
-    snprintf(cmd, sizeof(cmd), "[v10][t5]%s", text);
-
-    IoTUartWrite(VOICE_UART_BUS, (unsigned char*)cmd, strlen(cmd));
-
-    // 只在非安全状态时输出语音日志，减少日志噪音
-    if (strstr(text, "safe") == NULL) {
+    if (VoiceQueue_Post(text, VOICE_PRIO_NORMAL) == 0) {
         printf("Voice: %s\n", text);
     }
 }
 
+/**
+ * @brief 语音是否忙
+ * @return true: 正在播报或有待播报消息, false: 空闲
+ */
+bool Voice_IsBusy(void)
+{
+    return g_voice_initialized && VoiceQueue_IsBusy();
+}
+
 /**
  * @brief 综合报警控制
  * @param risk_level 风险等级
@@ -0,0 +1,434 @@
+#include "risk_rules.h"
+#include "kv_store.h"
+#include "los_mux.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+
+// 阶跃段（相邻点x相同）的斜率倒数：输入刚超过x即取满增量，等于x时仍取前一点
+#define STEP_GAIN           1e30f
+// 等级分界比较余量：分数恰好落在分界上时（各档取值为整齐小数，浮点舍入可能落在任一侧）一律计入较高等级
+#define CUTOFF_TOLERANCE    1e-5f
+// 零风险输入：低于所有折线首点，各线段输出为0（非有限输入评估前替换为该值）
+#define ZERO_RISK_INPUT     (-FLT_MAX)
+
+// 编译后的规则表：每条折线拆成若干线段，线段输出 = dy × clamp((x - x0) × gain, 0, 1)
+// 评估时对全部线段做同一循环，不按规则分支
+typedef struct {
+    uint8_t input[RISK_RULE_POINTS_MAX];
+    uint8_t factor[RISK_RULE_POINTS_MAX];
+    float x0[RISK_RULE_POINTS_MAX];
+    float gain[RISK_RULE_POINTS_MAX];
+    float dy[RISK_RULE_POINTS_MAX];
+    float base[RISK_FACTOR_COUNT];              // 各因子在所有折线首点以下的输出
+    float weights[RISK_FACTOR_COUNT];           // 归一化权重
+    float cutoffs[RISK_RULE_CUTOFFS];
+    uint16_t segment_count;
+    uint16_t version;
+} CompiledRules;
+
+static const char *g_input_names[RISK_INPUT_COUNT] = {
+    "tilt", "vibration", "humidity", "humidity_trend", "light_change", "gps_deform", "anomaly", "moisture",
+    "infiltration", "tilt_creep"
+};
+
+static const char *g_factor_names[RISK_FACTOR_COUNT] = {
+    "tilt", "vibration", "humidity", "light", "gps_deform", "anomaly", "moisture"
+};
+
+static bool g_rules_initialized = false;
+static uint32_t g_rules_mutex = 0;
+static RiskRuleSet g_rule_set;              // 生效的规则集（互斥锁保护）
+static CompiledRules g_compiled;            // 生效的编译结果（互斥锁保护）
+
+/**
+ * @brief 向规则集追加一条规则
+ */
+static void AppendRule(RiskRuleSet *set, RiskInput input, RiskFactor factor,
+                       const RiskCurvePoint *points, uint8_t count)
+{
+    RiskRule *rule = &set->rules[set->rule_count++];
+
+    rule->input = (uint8_t)input;
+    rule->factor = (uint8_t)factor;
+    rule->first_point = set->point_count;
+    rule->point_count = count;
+    memcpy(&set->points[set->point_count], points, count * sizeof(RiskCurvePoint));
+    set->point_count += count;
+}
+
+/**
+ * @brief 获取默认规则集
+ */
+void RiskRules_GetDefault(RiskRuleSet *set)
+{
+    // 分段阈值与原评估逻辑相同：超过阈值（不含）即进入下一档
+    static const RiskCurvePoint tilt[] = {
+        {5.0f, 0.0f}, {5.0f, 0.3f}, {10.0f, 0.3f}, {10.0f, 0.6f},
+        {15.0f, 0.6f}, {15.0f, 0.8f}, {20.0f, 0.8f}, {20.0f, 1.0f}
+    };
+    static const RiskCurvePoint vibration[] = {
+        {10.0f, 0.0f}, {10.0f, 0.2f}, {20.0f, 0.2f}, {20.0f, 0.4f},
+        {50.0f, 0.4f}, {50.0f, 0.7f}, {100.0f, 0.7f}, {100.0f, 1.0f}
+    };
+    static const RiskCurvePoint humidity[] = {
+        {70.0f, 0.0f}, {70.0f, 0.3f}, {80.0f, 0.3f}, {80.0f, 0.6f}, {90.0f, 0.6f}, {90.0f, 0.8f}
+    };
+    static const RiskCurvePoint humidity_trend[] = {{10.0f, 0.0f}, {10.0f, 0.3f}};
+    static const RiskCurvePoint light_change[] = {{1000.0f, 0.0f}, {1000.0f, 0.5f}};
+    // 形变风险等级为整数，折线在整数点上取原对应值
+    static const RiskCurvePoint gps_deform[] = {
+        {0.0f, 0.0f}, {1.0f, 0.3f}, {2.0f, 0.6f}, {3.0f, 0.8f}, {4.0f, 1.0f}
+    };
+    // 异常分数正常时约N(0,1)，3以上开始计入，单独满分只到低风险，需与其他因子叠加才会升级
+    static const RiskCurvePoint anomaly[] = {{3.0f, 0.0f}, {6.0f, 1.0f}};
+    // 前期湿润指数：连续阴雨约一天（综合指数约0.5）开始计入，约三天达到满分；短时强降雨入渗单独加分
+    static const RiskCurvePoint moisture[] = {{0.4f, 0.0f}, {0.8f, 1.0f}};
+    static const RiskCurvePoint infiltration[] = {{0.7f, 0.0f}, {0.95f, 0.3f}};
+    // 倾斜蠕变计入倾斜因子：达到报警阈值时为低风险，累积到阈值4倍时单独即可升至中风险
+    static const RiskCurvePoint tilt_creep[] = {{0.5f, 0.0f}, {1.0f, 0.6f}, {4.0f, 1.0f}};
+
+    memset(set, 0, sizeof(RiskRuleSet));
+    AppendRule(set, RISK_INPUT_TILT, RISK_FACTOR_TILT, tilt, 8);
+    AppendRule(set, RISK_INPUT_VIBRATION, RISK_FACTOR_VIBRATION, vibration, 8);
+    AppendRule(set, RISK_INPUT_HUMIDITY, RISK_FACTOR_HUMIDITY, humidity, 6);
+    AppendRule(set, RISK_INPUT_HUMIDITY_TREND, RISK_FACTOR_HUMIDITY, humidity_trend, 2);
+    AppendRule(set, RISK_INPUT_LIGHT_CHANGE, RISK_FACTOR_LIGHT, light_change, 2);
+    AppendRule(set, RISK_INPUT_GPS_DEFORM, RISK_FACTOR_GPS_DEFORM, gps_deform, 5);
+    AppendRule(set, RISK_INPUT_ANOMALY, RISK_FACTOR_ANOMALY, anomaly, 2);
+    AppendRule(set, RISK_INPUT_MOISTURE, RISK_FACTOR_MOISTURE, moisture, 2);
+    AppendRule(set, RISK_INPUT_INFILTRATION, RISK_FACTOR_MOISTURE, infiltration, 2);
+    AppendRule(set, RISK_INPUT_TILT_CREEP, RISK_FACTOR_TILT, tilt_creep, 3);
+
+    // 原权重0.4/0.3/0.2/0.05/0.25，分界0.2/0.4/0.6/0.8为加权和的绝对值，除以权重和换算到归一化分数
+    set->weights[RISK_FACTOR_TILT] = 0.4f;
+    set->weights[RISK_FACTOR_VIBRATION] = 0.3f;
+    set->weights[RISK_FACTOR_HUMIDITY] = 0.2f;
+    set->weights[RISK_FACTOR_LIGHT] = 0.05f;
+    set->weights[RISK_FACTOR_GPS_DEFORM] = 0.25f;
+    set->weights[RISK_FACTOR_ANOMALY] = 0.3f;
+    set->weights[RISK_FACTOR_MOISTURE] = 0.2f;
+
+    float weight_sum = 0.0f;
+    for (int i = 0; i < RISK_FACTOR_COUNT; i++) {
+        weight_sum += set->weights[i];
+    }
+    for (int i = 0; i < RISK_RULE_CUTOFFS; i++) {
+        set->cutoffs[i] = 0.2f * (i + 1) / weight_sum;
+    }
+}
+
+/**
+ * @brief 检查规则集是否有效
+ */
+int RiskRules_Validate(const RiskRuleSet *set)
+{
+    if (set == NULL || set->rule_count == 0 || set->rule_count > RISK_RULES_MAX ||
+        set->point_count > RISK_RULE_POINTS_MAX) {
+        return -1;
+    }
+
+    for (uint8_t i = 0; i < set->rule_count; i++) {
+        const RiskRule *rule = &set->rules[i];
+        if (rule->input >= RISK_INPUT_COUNT || rule->factor >= RISK_FACTOR_COUNT || rule->point_count < 2 ||
+            rule->first_point + rule->point_count > set->point_count) {
+            return -1;
+        }
+
+        const RiskCurvePoint *points = &set->points[rule->first_point];
+        for (uint8_t j = 0; j < rule->point_count; j++) {
+            if (!isfinite(points[j].x) || !(points[j].y >= 0.0f && points[j].y <= 1.0f)) {
+                return -1;
+            }
+            if (j > 0 && points[j].x < points[j - 1].x) {
+                return -1;
+            }
+        }
+    }
+
+    float weight_sum = 0.0f;
+    for (int i = 0; i < RISK_FACTOR_COUNT; i++) {
+        if (!(set->weights[i] >= 0.0f && set->weights[i] <= 1000.0f)) {
+            return -1;
+        }
+        weight_sum += set->weights[i];
+    }
+    if (weight_sum <= 0.0f) {
+        return -1;
+    }
+
+    for (int i = 0; i < RISK_RULE_CUTOFFS; i++) {
+        float lower = (i == 0) ? 0.0f : set->cutoffs[i - 1];
+        if (!(set->cutoffs[i] > lower && set->cutoffs[i] <= 1.0f)) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 把规则集编译为线段表（规则集须已通过校验）
+ */
+static void CompileRules(const RiskRuleSet *set, CompiledRules *compiled)
+{
+    memset(compiled, 0, sizeof(CompiledRules));
+    compiled->version = set->version;
+
+    for (uint8_t i = 0; i < set->rule_count; i++) {
+        const RiskRule *rule = &set->rules[i];
+        const RiskCurvePoint *points = &set->points[rule->first_point];
+
+        compiled->base[rule->factor] += points[0].y;
+        for (uint8_t j = 1; j < rule->point_count; j++) {
+            float dx = points[j].x - points[j - 1].x;
+            float dy = points[j].y - points[j - 1].y;
+            if (dy == 0.0f) {
+                continue;   // 水平段不影响输出
+            }
+
+            uint16_t n = compiled->segment_count++;
+            compiled->input[n] = rule->input;
+            compiled->factor[n] = rule->factor;
+            compiled->x0[n] = points[j - 1].x;
+            compiled->gain[n] = (dx > 0.0f) ? 1.0f / dx : STEP_GAIN;
+            compiled->dy[n] = dy;
+        }
+    }
+
+    float weight_sum = 0.0f;
+    for (int i = 0; i < RISK_FACTOR_COUNT; i++) {
+        weight_sum += set->weights[i];
+    }
+    for (int i = 0; i < RISK_FACTOR_COUNT; i++) {
+        compiled->weights[i] = set->weights[i] / weight_sum;
+    }
+    for (int i = 0; i < RISK_RULE_CUTOFFS; i++) {
+        compiled->cutoffs[i] = set->cutoffs[i] - CUTOFF_TOLERANCE;
+    }
+}
+
+/**
+ * @brief 评估编译后的规则表
+ */
+static void EvaluateCompiled(const CompiledRules *compiled, const float inputs[RISK_INPUT_COUNT],
+                             RiskRuleResult *result)
+{
+    float factors[RISK_FACTOR_COUNT];
+    memcpy(factors, compiled->base, sizeof(factors));
+
+    // 非有限输入（NaN、±inf，传感器故障）只取各曲线起点，不产生风险
+    float values[RISK_INPUT_COUNT];
+    for (int i = 0; i < RISK_INPUT_COUNT; i++) {
+        values[i] = isfinite(inputs[i]) ? inputs[i] : ZERO_RISK_INPUT;
+    }
+
+    for (uint16_t i = 0; i < compiled->segment_count; i++) {
+        float t = (values[compiled->input[i]] - compiled->x0[i]) * compiled->gain[i];
+        factors[compiled->factor[i]] += compiled->dy[i] * fminf(fmaxf(t, 0.0f), 1.0f);
+    }
+
+    float score = 0.0f;
+    for (int i = 0; i < RISK_FACTOR_COUNT; i++) {
+        result->factors[i] = fminf(fmaxf(factors[i], 0.0f), 1.0f);
+        score += compiled->weights[i] * result->factors[i];
+    }
+
+    uint8_t level = 0;
+    for (int i = 0; i < RISK_RULE_CUTOFFS; i++) {
+        level += (uint8_t)(score >= compiled->cutoffs[i]);
+    }
+
+    result->score = score;
+    result->level = level;
+    result->version = compiled->version;
+}
+
+/**
+ * @brief 初始化风险规则
+ */
+int RiskRules_Init(void)
+{
+    if (g_rules_initialized) {
+        return 0;
+    }
+
+    if (LOS_MuxCreate(&g_rules_mutex) != LOS_OK) {
+        printf("Failed to create risk rules mutex\n");
+        return -1;
+    }
+
+    if (KvStore_Get(KV_KEY_RISK_RULES, &g_rule_set, sizeof(g_rule_set)) == 0 &&
+        RiskRules_Validate(&g_rule_set) == 0) {
+        printf("Risk rules restored: version %u, %u rules\n", g_rule_set.version, g_rule_set.rule_count);
+    } else {
+        RiskRules_GetDefault(&g_rule_set);
+    }
+    CompileRules(&g_rule_set, &g_compiled);
+
+    g_rules_initialized = true;
+    printf("Risk rules initialized (%u segments)\n", g_compiled.segment_count);
+    return 0;
+}
+
+/**
+ * @brief 反初始化风险规则
+ */
+void RiskRules_Deinit(void)
+{
+    if (!g_rules_initialized) {
+        return;
+    }
+
+    g_rules_initialized = false;
+    LOS_MuxDelete(g_rules_mutex);
+    g_rules_mutex = 0;
+}
+
+/**
+ * @brief 整表替换生效的规则集并保存到Flash
+ */
+int RiskRules_Set(const RiskRuleSet *set)
+{
+    if (!g_rules_initialized || RiskRules_Validate(set) != 0) {
+        printf("Invalid risk rules rejected\n");
+        return -1;
+    }
+
+    // 在锁外编译，锁内只做整表复制（只由云端命令处理调用，编译缓冲区用静态变量节省栈）
+    static CompiledRules compiled;
+    CompileRules(set, &compiled);
+
+    LOS_MuxPend(g_rules_mutex, LOS_WAIT_FOREVER);
+    g_rule_set = *set;
+    g_compiled = compiled;
+    LOS_MuxPost(g_rules_mutex);
+
+    printf("Risk rules updated: version %u, %u rules, %u segments\n",
+           set->version, set->rule_count, compiled.segment_count);
+
+    if (KvStore_Set(KV_KEY_RISK_RULES, set, sizeof(RiskRuleSet)) != 0) {
+        printf("Failed to save risk rules\n");
+        return -2;
+    }
+    return 0;
+}
+
+/**
+ * @brief 获取生效的规则集
+ */
+int RiskRules_Get(RiskRuleSet *set)
+{
+    if (!g_rules_initialized || set == NULL) {
+        return -1;
+    }
+
+    LOS_MuxPend(g_rules_mutex, LOS_WAIT_FOREVER);
+    *set = g_rule_set;
+    LOS_MuxPost(g_rules_mutex);
+    return 0;
+}
+
+/**
+ * @brief 恢复默认规则集
+ */
+void RiskRules_Reset(void)
+{
+    if (!g_rules_initialized) {
+        return;
+    }
+
+    static RiskRuleSet set;
+    static CompiledRules compiled;
+    RiskRules_GetDefault(&set);
+    CompileRules(&set, &compiled);
+
+    LOS_MuxPend(g_rules_mutex, LOS_WAIT_FOREVER);
+    g_rule_set = set;
+    g_compiled = compiled;
+    LOS_MuxPost(g_rules_mutex);
+
+    KvStore_Delete(KV_KEY_RISK_RULES);
+    printf("Risk rules reset to defaults\n");
+}
+
+/**
+ * @brief 按新的起始阈值等比缩放某个输入的全部折线
+ */
+int RiskRules_ScaleInput(RiskRuleSet *set, RiskInput input, float threshold)
+{
+    if (set == NULL || input >= RISK_INPUT_COUNT || !(threshold > 0.0f && isfinite(threshold))) {
+        return -1;
+    }
+
+    float start = 0.0f;
+    for (uint8_t i = 0; i < set->rule_count; i++) {
+        const RiskRule *rule = &set->rules[i];
+        float x = set->points[rule->first_point].x;
+        if (rule->input == input && x > 0.0f && (start == 0.0f || x < start)) {
+            start = x;
+        }
+    }
+    if (start == 0.0f) {
+        return -1;
+    }
+
+    float scale = threshold / start;
+    for (uint8_t i = 0; i < set->rule_count; i++) {
+        const RiskRule *rule = &set->rules[i];
+        if (rule->input != input) {
+            continue;
+        }
+        for (uint8_t j = 0; j < rule->point_count; j++) {
+            set->points[rule->first_point + j].x *= scale;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief 用生效的规则集评估一组输入
+ */
+int RiskRules_Evaluate(const float inputs[RISK_INPUT_COUNT], RiskRuleResult *result)
+{
+    if (!g_rules_initialized || inputs == NULL || result == NULL) {
+        return -1;
+    }
+
+    LOS_MuxPend(g_rules_mutex, LOS_WAIT_FOREVER);
+    EvaluateCompiled(&g_compiled, inputs, result);
+    LOS_MuxPost(g_rules_mutex);
+    return 0;
+}
+
+/**
+ * @brief 用指定规则集评估一组输入
+ */
+int RiskRules_EvaluateSet(const RiskRuleSet *set, const float inputs[RISK_INPUT_COUNT], RiskRuleResult *result)
+{
+    if (inputs == NULL || result == NULL || RiskRules_Validate(set) != 0) {
+        return -1;
+    }
+
+    CompiledRules compiled;
+    CompileRules(set, &compiled);
+    EvaluateCompiled(&compiled, inputs, result);
+    return 0;
+}
+
+/**
+ * @brief 获取输入量名称
+ */
+const char *RiskRules_GetInputName(RiskInput input)
+{
+    return (input < RISK_INPUT_COUNT) ? g_input_names[input] : NULL;
+}
+
+/**
+ * @brief 获取风险因子名称
+ */
+const char *RiskRules_GetFactorName(RiskFactor factor)
+{
+    return (factor < RISK_FACTOR_COUNT) ? g_factor_names[factor] : NULL;
+}
@@ -0,0 +1,274 @@
+#include "task_profiler.h"
+#include "los_task.h"
+#include "los_tick.h"
+#include "los_mux.h"
+#include <stdio.h>
+#include <string.h>
+
+#define PROFILER_EW_SHIFT           3           // 指数平均系数 1/8
+
+// 单个任务的打点状态
+typedef struct {
+    TaskProfile profile;
+    uint64_t begin_us;              // 本次循环开始（或阻塞等待结束）时间
+    uint64_t run_us;                // 本次循环已累计的活动时间（不含循环内阻塞等待）
+    uint64_t window_start_us;
+    uint64_t window_busy_us;        // 本窗口累计活动时间
+    uint64_t expected_wake_us;      // 超时唤醒的预期时刻
+    bool wake_pending;
+    bool running;                   // 已调用LoopBegin尚未调用LoopEnd
+    bool waiting;                   // 循环内阻塞等待中（已调用WaitBegin尚未调用WaitEnd）
+} ProfileSlot;
+
+static bool g_profiler_initialized = false;
+static uint32_t g_profiler_mutex = 0;
+static ProfileSlot g_slots[PROFILER_MAX_TASKS];
+static int g_slot_count = 0;
+
+/**
+ * @brief 当前时间 (us)
+ */
+static uint64_t NowUs(void)
+{
+    return LOS_CurrNanosec() / 1000;
+}
+
+/**
+ * @brief 查找当前任务的打点状态，未登记时登记（持锁调用）
+ * @return 打点状态, NULL: 已满
+ */
+static ProfileSlot *FindSlot(uint32_t task_id)
+{
+    for (int i = 0; i < g_slot_count; i++) {
+        if (g_slots[i].profile.task_id == task_id) {
+            return &g_slots[i];
+        }
+    }
+    if (g_slot_count >= PROFILER_MAX_TASKS) {
+        return NULL;
+    }
+
+    ProfileSlot *slot = &g_slots[g_slot_count++];
+    memset(slot, 0, sizeof(*slot));
+    slot->profile.task_id = task_id;
+
+    TSK_INFO_S info;
+    if (LOS_TaskInfoGet(task_id, &info) == LOS_OK) {
+        snprintf(slot->profile.name, PROFILER_NAME_LEN, "%s", info.acName);
+    } else {
+        snprintf(slot->profile.name, PROFILER_NAME_LEN, "task%u", task_id);
+    }
+    return slot;
+}
+
+/**
+ * @brief 指数平均
+ */
+static uint32_t UpdateAverage(uint32_t average, uint32_t value, uint32_t count)
+{
+    if (count <= 1) {
+        return value;
+    }
+    return average - (average >> PROFILER_EW_SHIFT) + (value >> PROFILER_EW_SHIFT);
+}
+
+/**
+ * @brief 初始化任务性能统计
+ */
+int Profiler_Init(void)
+{
+    if (g_profiler_initialized) {
+        return 0;
+    }
+
+    if (LOS_MuxCreate(&g_profiler_mutex) != LOS_OK) {
+        printf("Failed to create profiler mutex\n");
+        return -1;
+    }
+
+    memset(g_slots, 0, sizeof(g_slots));
+    g_slot_count = 0;
+    g_profiler_initialized = true;
+    printf("Task profiler initialized (%d tasks, window %dms)\n", PROFILER_MAX_TASKS, PROFILER_WINDOW_MS);
+    return 0;
+}
+
+/**
+ * @brief 反初始化任务性能统计
+ */
+void Profiler_Deinit(void)
+{
+    if (!g_profiler_initialized) {
+        return;
+    }
+
+    g_profiler_initialized = false;
+    LOS_MuxDelete(g_profiler_mutex);
+    g_profiler_mutex = 0;
+}
+
+/**
+ * @brief 当前任务循环开始
+ */
+void Profiler_LoopBegin(void)
+{
+    if (!g_profiler_initialized) {
+        return;
+    }
+
+    uint64_t now = NowUs();
+    LOS_MuxPend(g_profiler_mutex, LOS_WAIT_FOREVER);
+    ProfileSlot *slot = FindSlot(LOS_CurTaskIDGet());
+    if (slot != NULL) {
+        TaskProfile *p = &slot->profile;
+
+        // 提前被事件唤醒时不计唤醒延迟
+        if (slot->wake_pending && now >= slot->expected_wake_us) {
+            uint32_t late = (uint32_t)(now - slot->expected_wake_us);
+            p->wake_late_avg_us = UpdateAverage(p->wake_late_avg_us, late, p->loops + 1);
+            if (late > p->wake_late_max_us) {
+                p->wake_late_max_us = late;
+            }
+        }
+        if (slot->window_start_us == 0) {
+            slot->window_start_us = now;
+        }
+        slot->wake_pending = false;
+        slot->begin_us = now;
+        slot->run_us = 0;
+        slot->running = true;
+        slot->waiting = false;
+    }
+    LOS_MuxPost(g_profiler_mutex);
+}
+
+/**
+ * @brief 当前任务循环结束
+ */
+void Profiler_LoopEnd(uint32_t wait_ms)
+{
+    if (!g_profiler_initialized) {
+        return;
+    }
+
+    uint64_t now = NowUs();
+    LOS_MuxPend(g_profiler_mutex, LOS_WAIT_FOREVER);
+    ProfileSlot *slot = FindSlot(LOS_CurTaskIDGet());
+    if (slot != NULL && slot->running) {
+        TaskProfile *p = &slot->profile;
+        uint32_t run = (uint32_t)(slot->run_us + (slot->waiting ? 0 : now - slot->begin_us));
+
+        p->loops++;
+        p->run_avg_us = UpdateAverage(p->run_avg_us, run, p->loops);
+        if (run > p->run_max_us) {
+            p->run_max_us = run;
+        }
+
+        slot->window_busy_us += run;
+        uint64_t window = now - slot->window_start_us;
+        if (window >= (uint64_t)PROFILER_WINDOW_MS * 1000) {
+            p->load_percent = (float)slot->window_busy_us * 100.0f / (float)window;
+            slot->window_start_us = now;
+            slot->window_busy_us = 0;
+        }
+
+        slot->running = false;
+        slot->waiting = false;
+        slot->wake_pending = (wait_ms > 0);
+        slot->expected_wake_us = now + (uint64_t)wait_ms * 1000;
+    }
+    LOS_MuxPost(g_profiler_mutex);
+}
+
+/**
+ * @brief 当前任务循环内开始阻塞等待
+ */
+void Profiler_WaitBegin(void)
+{
+    if (!g_profiler_initialized) {
+        return;
+    }
+
+    uint64_t now = NowUs();
+    LOS_MuxPend(g_profiler_mutex, LOS_WAIT_FOREVER);
+    ProfileSlot *slot = FindSlot(LOS_CurTaskIDGet());
+    if (slot != NULL && slot->running && !slot->waiting) {
+        slot->run_us += now - slot->begin_us;
+        slot->waiting = true;
+    }
+    LOS_MuxPost(g_profiler_mutex);
+}
+
+/**
+ * @brief 当前任务循环内阻塞等待结束
+ */
+void Profiler_WaitEnd(void)
+{
+    if (!g_profiler_initialized) {
+        return;
+    }
+
+    uint64_t now = NowUs();
+    LOS_MuxPend(g_profiler_mutex, LOS_WAIT_FOREVER);
+    ProfileSlot *slot = FindSlot(LOS_CurTaskIDGet());
+    if (slot != NULL && slot->running && slot->waiting) {
+        slot->begin_us = now;
+        slot->waiting = false;
+    }
+    LOS_MuxPost(g_profiler_mutex);
+}
+
+/**
+ * @brief 获取各任务统计信息
+ */
+int Profiler_GetStats(TaskProfile *profiles, int max_count)
+{
+    if (!g_profiler_initialized || profiles == NULL || max_count <= 0) {
+        return 0;
+    }
+
+    LOS_MuxPend(g_profiler_mutex, LOS_WAIT_FOREVER);
+    int count = (g_slot_count < max_count) ? g_slot_count : max_count;
+    for (int i = 0; i < count; i++) {
+        profiles[i] = g_slots[i].profile;
+    }
+    LOS_MuxPost(g_profiler_mutex);
+
+    // 栈水位由内核在任务栈初始化填充值中统计，读取时不持锁
+    for (int i = 0; i < count; i++) {
+        TSK_INFO_S info;
+        if (LOS_TaskInfoGet(profiles[i].task_id, &info) == LOS_OK) {
+            profiles[i].stack_size = info.uwStackSize;
+            profiles[i].stack_peak = info.uwPeakUsed;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief 打印各任务统计信息
+ */
+int Profiler_PrintReport(void)
+{
+    TaskProfile profiles[PROFILER_MAX_TASKS];
+    int count = Profiler_GetStats(profiles, PROFILER_MAX_TASKS);
+    int warnings = 0;
+
+    printf(" 任务统计 (%d个):\n", count);
+    printf("   %-14s %6s %9s %9s %9s %9s %11s\n",
+           "任务", "CPU%", "运行avg", "运行max", "唤醒avg", "唤醒max", "栈峰值");
+    for (int i = 0; i < count; i++) {
+        const TaskProfile *p = &profiles[i];
+        uint32_t stack_percent = (p->stack_size > 0) ? p->stack_peak * 100 / p->stack_size : 0;
+        bool warn = stack_percent >= PROFILER_STACK_WARN_PERCENT;
+
+        printf("   %-14s %6.2f %7uus %7uus %7uus %7uus %5u/%u%s\n",
+               p->name, p->load_percent, p->run_avg_us, p->run_max_us,
+               p->wake_late_avg_us, p->wake_late_max_us, p->stack_peak, p->stack_size,
+               warn ? " !" : "");
+        if (warn) {
+            warnings++;
+        }
+    }
+    return warnings;
+}
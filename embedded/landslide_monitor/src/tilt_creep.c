@@ -0,0 +1,258 @@
+#include "tilt_creep.h"
+#include "kv_store.h"
+#include "los_mux.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+// 单轴检测状态：正负两侧CUSUM
+typedef struct {
+    float sum;                      // 当前块倾角累加
+    float reference;                // 参考倾角 (°)
+    float deviation;                // 最近块均值相对参考的偏差 (°)
+    float cusum[2];                 // 正向/负向累积超限量 (°·小时)
+    uint32_t onset[2];              // 累积量最后一次离开0的块起点 (ms)
+} CreepAxis;
+
+static bool g_creep_initialized = false;
+static uint32_t g_creep_mutex = 0;
+static CreepConfig g_creep_config = {CREEP_DEFAULT_DRIFT, CREEP_DEFAULT_THRESHOLD};
+static CreepAxis g_axes[CREEP_AXES];
+static CreepStatus g_creep_status;
+static uint32_t g_block_start = 0;
+static uint32_t g_block_samples = 0;
+static uint32_t g_ref_blocks = 0;           // 已计入参考倾角的块数
+
+/**
+ * @brief 检查检测参数
+ */
+static bool IsConfigValid(const CreepConfig *config)
+{
+    return isfinite(config->drift) && isfinite(config->threshold) &&
+           config->drift >= 0.0f && config->drift <= 5.0f &&
+           config->threshold > 0.0f && config->threshold <= 100.0f;
+}
+
+/**
+ * @brief 清除累积量和报警，重新建立参考倾角
+ */
+static void ResetDetector(void)
+{
+    memset(g_axes, 0, sizeof(g_axes));
+    memset(&g_creep_status, 0, sizeof(g_creep_status));
+    g_block_samples = 0;
+    g_ref_blocks = 0;
+}
+
+/**
+ * @brief 块结束：更新参考倾角或两侧累积量，并检查报警
+ */
+static void ProcessBlock(uint32_t block_end)
+{
+    float block_h = (float)(block_end - g_block_start) / (3600.0f * 1000.0f);
+    float ref_alpha = 1.0f - expf(-block_h / CREEP_REF_TAU_H);
+    CreepStatus *status = &g_creep_status;
+
+    if (!status->alarm) {
+        status->statistic = 0.0f;
+        status->direction = 0;
+    }
+
+    for (int axis = 0; axis < CREEP_AXES; axis++) {
+        CreepAxis *a = &g_axes[axis];
+        float mean = a->sum / g_block_samples;
+        a->sum = 0.0f;
+
+        if (g_ref_blocks < CREEP_REF_BLOCKS) {
+            a->reference += (mean - a->reference) / (g_ref_blocks + 1);
+            continue;
+        }
+
+        a->deviation = mean - a->reference;
+        for (int side = 0; side < 2; side++) {
+            float excess = (side == 0 ? a->deviation : -a->deviation) - g_creep_config.drift;
+            if (a->cusum[side] <= 0.0f) {
+                a->onset[side] = g_block_start;
+            }
+            a->cusum[side] = fmaxf(a->cusum[side] + excess * block_h, 0.0f);
+
+            float ratio = a->cusum[side] / g_creep_config.threshold;
+            if (!status->alarm && ratio > status->statistic) {
+                status->statistic = ratio;
+                status->axis = (uint8_t)axis;
+                status->direction = (int8_t)(side == 0 ? 1 : -1);
+                status->onset_time = a->onset[side];
+            }
+        }
+
+        // 无变化迹象时参考倾角缓慢跟踪，有累积时冻结
+        if (!status->alarm && a->cusum[0] <= 0.0f && a->cusum[1] <= 0.0f) {
+            a->reference += ref_alpha * a->deviation;
+        }
+    }
+
+    if (g_ref_blocks < CREEP_REF_BLOCKS) {
+        if (++g_ref_blocks == CREEP_REF_BLOCKS) {
+            status->ready = true;
+            printf("Tilt creep reference established: X=%.3f Y=%.3f\n", g_axes[0].reference, g_axes[1].reference);
+        }
+        return;
+    }
+
+    if (status->alarm) {
+        // 报警锁存期间统计量继续随报警方向的累积量增长
+        CreepAxis *a = &g_axes[status->axis];
+        status->statistic = a->cusum[status->direction > 0 ? 0 : 1] / g_creep_config.threshold;
+    } else if (status->statistic >= 1.0f) {
+        status->alarm = true;
+        status->alarm_time = block_end;
+        printf("TILT CREEP ALERT: axis %c %s, deviation %.3f deg, onset %u ms (%.1f h ago)\n",
+               status->axis == 0 ? 'X' : 'Y', status->direction > 0 ? "positive" : "negative",
+               g_axes[status->axis].deviation, status->onset_time,
+               (block_end - status->onset_time) / (3600.0f * 1000.0f));
+    }
+    status->deviation = g_axes[status->axis].deviation;
+}
+
+/**
+ * @brief 初始化倾斜蠕变检测
+ */
+int TiltCreep_Init(void)
+{
+    if (g_creep_initialized) {
+        return 0;
+    }
+
+    if (LOS_MuxCreate(&g_creep_mutex) != LOS_OK) {
+        printf("Failed to create tilt creep mutex\n");
+        return -1;
+    }
+
+    CreepConfig stored;
+    if (KvStore_Get(KV_KEY_TILT_CREEP_CONFIG, &stored, sizeof(stored)) == 0 && IsConfigValid(&stored)) {
+        g_creep_config = stored;
+    } else {
+        g_creep_config.drift = CREEP_DEFAULT_DRIFT;
+        g_creep_config.threshold = CREEP_DEFAULT_THRESHOLD;
+    }
+
+    ResetDetector();
+    g_creep_initialized = true;
+    printf("Tilt creep detector initialized (drift %.3f deg, threshold %.3f deg*h)\n",
+           g_creep_config.drift, g_creep_config.threshold);
+    return 0;
+}
+
+/**
+ * @brief 反初始化倾斜蠕变检测
+ */
+void TiltCreep_Deinit(void)
+{
+    if (!g_creep_initialized) {
+        return;
+    }
+
+    g_creep_initialized = false;
+    LOS_MuxDelete(g_creep_mutex);
+    g_creep_mutex = 0;
+}
+
+/**
+ * @brief 输入一个融合倾角样本
+ */
+int TiltCreep_Update(float angle_x, float angle_y, uint32_t timestamp, CreepStatus *status)
+{
+    if (!g_creep_initialized) {
+        return -1;
+    }
+
+    LOS_MuxPend(g_creep_mutex, LOS_WAIT_FOREVER);
+
+    if (isfinite(angle_x) && isfinite(angle_y)) {
+        if (g_block_samples > 0 && timestamp - g_block_start >= CREEP_BLOCK_MS) {
+            ProcessBlock(timestamp);
+            g_block_samples = 0;
+        }
+        if (g_block_samples == 0) {
+            g_block_start = timestamp;
+        }
+        g_axes[0].sum += angle_x;
+        g_axes[1].sum += angle_y;
+        g_block_samples++;
+    }
+
+    if (status != NULL) {
+        *status = g_creep_status;
+    }
+
+    LOS_MuxPost(g_creep_mutex);
+    return 0;
+}
+
+/**
+ * @brief 解除报警并重新建立参考倾角
+ */
+void TiltCreep_Rearm(void)
+{
+    if (!g_creep_initialized) {
+        return;
+    }
+
+    LOS_MuxPend(g_creep_mutex, LOS_WAIT_FOREVER);
+    if (g_creep_status.alarm) {
+        printf("Tilt creep alarm cleared, re-establishing reference\n");
+    }
+    ResetDetector();
+    LOS_MuxPost(g_creep_mutex);
+}
+
+/**
+ * @brief 获取当前状态
+ */
+int TiltCreep_GetStatus(CreepStatus *status)
+{
+    if (!g_creep_initialized || status == NULL) {
+        return -1;
+    }
+
+    LOS_MuxPend(g_creep_mutex, LOS_WAIT_FOREVER);
+    *status = g_creep_status;
+    LOS_MuxPost(g_creep_mutex);
+    return 0;
+}
+
+/**
+ * @brief 设置检测参数
+ */
+int TiltCreep_SetConfig(const CreepConfig *config)
+{
+    if (!g_creep_initialized || config == NULL || !IsConfigValid(config)) {
+        return -1;
+    }
+
+    LOS_MuxPend(g_creep_mutex, LOS_WAIT_FOREVER);
+    g_creep_config = *config;
+    LOS_MuxPost(g_creep_mutex);
+
+    printf("Tilt creep config: drift %.3f deg, threshold %.3f deg*h\n", config->drift, config->threshold);
+    if (KvStore_Set(KV_KEY_TILT_CREEP_CONFIG, config, sizeof(CreepConfig)) != 0) {
+        printf("Failed to save tilt creep config\n");
+        return -2;
+    }
+    return 0;
+}
+
+/**
+ * @brief 获取检测参数
+ */
+int TiltCreep_GetConfig(CreepConfig *config)
+{
+    if (!g_creep_initialized || config == NULL) {
+        return -1;
+    }
+
+    LOS_MuxPend(g_creep_mutex, LOS_WAIT_FOREVER);
+    *config = g_creep_config;
+    LOS_MuxPost(g_creep_mutex);
+    return 0;
+}
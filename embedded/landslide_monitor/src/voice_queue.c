@@ -0,0 +1,359 @@
+#include "voice_queue.h"
+#include "iot_uart.h"
+#include "los_task.h"
+#include "los_mux.h"
+#include "los_event.h"
+#include <stdio.h>
+#include <string.h>
+
+#define VOICE_EVENT_POST            0x01        // 有新消息入队
+
+// SYN6288命令帧：帧头0xFD、数据区长度（2字节，大端，含命令字和校验字节）、命令字、参数、数据、异或校验
+#define VOICE_FRAME_HEAD            0xFD
+#define VOICE_CMD_SYNTHESIZE        0x01        // 语音合成
+#define VOICE_PARAM_GB2312          0x00        // 无背景音乐，文本GB2312编码（兼容ASCII）
+#define VOICE_TEXT_TAGS             "[v10][t5]" // 音量10、语速5
+#define VOICE_FRAME_MAX             (5 + sizeof(VOICE_TEXT_TAGS) - 1 + VOICE_TEXT_MAX)
+
+// 停止合成命令帧（命令0x02，无参数），其他模块按协议修改
+static const uint8_t g_voice_stop_cmd[] = {0xFD, 0x00, 0x02, 0x02, 0xFD};
+
+// 待播报消息
+typedef struct {
+    char text[VOICE_TEXT_MAX];
+    uint32_t order;                 // 入队顺序（同优先级先入先播）
+    uint8_t priority;
+    bool used;
+} VoiceEntry;
+
+static bool g_voice_queue_initialized = false;
+static uint32_t g_voice_mutex = 0;
+static uint32_t g_voice_task_id = 0;
+static EVENT_CB_S g_voice_event;
+static uint32_t g_voice_uart = 0;
+
+static VoiceEntry g_entries[VOICE_QUEUE_LENGTH];
+static uint32_t g_next_order = 0;
+static VoiceQueueStats g_voice_stats;
+
+// 正在播报的消息（互斥锁保护）
+static char g_current_text[VOICE_TEXT_MAX];
+static uint8_t g_current_priority = VOICE_PRIO_LOW;
+static bool g_accepted = false;             // 已收到模块接收应答
+static bool g_stopping = false;             // 已发送停止命令，等待模块空闲
+static uint32_t g_play_start = 0;
+static uint32_t g_play_limit_ms = 0;        // 本条播报的结束判定时长
+
+/**
+ * @brief 选出优先级最高、同级最早入队的消息
+ * @return 下标, -1: 队列为空
+ */
+static int FindNextEntry(void)
+{
+    int best = -1;
+    for (int i = 0; i < VOICE_QUEUE_LENGTH; i++) {
+        if (!g_entries[i].used) {
+            continue;
+        }
+        if (best < 0 || g_entries[i].priority > g_entries[best].priority ||
+            (g_entries[i].priority == g_entries[best].priority &&
+             (int32_t)(g_entries[i].order - g_entries[best].order) < 0)) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief 组装合成命令帧
+ * @return 帧长度
+ */
+static int BuildSynthesisFrame(uint8_t *frame, const char *text)
+{
+    int text_len = snprintf((char *)&frame[5], VOICE_FRAME_MAX - 5, "%s%s", VOICE_TEXT_TAGS, text);
+    int data_len = text_len + 3;     // 命令字、参数、校验
+
+    frame[0] = VOICE_FRAME_HEAD;
+    frame[1] = (uint8_t)(data_len >> 8);
+    frame[2] = (uint8_t)(data_len & 0xFF);
+    frame[3] = VOICE_CMD_SYNTHESIZE;
+    frame[4] = VOICE_PARAM_GB2312;
+
+    uint8_t checksum = 0;
+    for (int i = 0; i < text_len + 5; i++) {
+        checksum ^= frame[i];
+    }
+    frame[text_len + 5] = checksum;
+    return text_len + 6;
+}
+
+/**
+ * @brief 处理模块回传的状态字节（持锁调用）
+ */
+static void HandleResponse(uint8_t byte)
+{
+    switch (byte) {
+        case VOICE_RESP_ACCEPTED:
+            g_voice_stats.module_responds = true;
+            if (g_voice_stats.busy && !g_stopping) {
+                g_accepted = true;
+                g_play_limit_ms = VOICE_MAX_PLAY_MS;
+            }
+            break;
+        case VOICE_RESP_IDLE:
+            g_voice_stats.module_responds = true;
+            g_voice_stats.busy = false;
+            break;
+        case VOICE_RESP_ERROR:
+            g_voice_stats.module_responds = true;
+            if (g_voice_stats.busy) {
+                printf("Voice module rejected: %s\n", g_current_text);
+                g_voice_stats.busy = false;
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief 检查正在播报的消息是否应按超时结束（持锁调用）
+ */
+static void CheckPlayTimeout(uint32_t now)
+{
+    if (!g_voice_stats.busy) {
+        return;
+    }
+
+    uint32_t elapsed = now - g_play_start;
+    bool lost = g_voice_stats.module_responds && !g_accepted && elapsed >= VOICE_ACK_TIMEOUT_MS;
+    if (lost || elapsed >= g_play_limit_ms) {
+        if (g_voice_stats.module_responds && !g_stopping) {
+            g_voice_stats.timeouts++;
+        }
+        g_voice_stats.busy = false;
+    }
+}
+
+/**
+ * @brief 语音任务：读取模块应答、处理打断、发送下一条消息
+ */
+static void VoiceTask(void *arg)
+{
+    (void)arg;
+    uint8_t rx[16];
+    uint8_t cmd[VOICE_FRAME_MAX];
+
+    while (1) {
+        LOS_EventRead(&g_voice_event, VOICE_EVENT_POST, LOS_WAITMODE_OR | LOS_WAITMODE_CLR, VOICE_POLL_MS);
+        int len = IoTUartRead(g_voice_uart, rx, sizeof(rx));
+        bool stop = false;
+        int cmd_len = 0;
+
+        LOS_MuxPend(g_voice_mutex, LOS_WAIT_FOREVER);
+        for (int i = 0; i < len; i++) {
+            HandleResponse(rx[i]);
+        }
+        uint32_t now = LOS_TickCountGet();
+        CheckPlayTimeout(now);
+
+        int next = FindNextEntry();
+        if (next >= 0 && g_voice_stats.busy && !g_stopping && g_current_priority < VOICE_PRIO_CRITICAL &&
+            g_entries[next].priority == VOICE_PRIO_CRITICAL) {
+            // 危急消息打断正在播报的低优先级消息：先停止，等模块空闲应答后再发送，避免旧消息的应答结束新消息
+            stop = true;
+            g_stopping = true;
+            g_accepted = true;
+            g_play_start = now;
+            g_play_limit_ms = g_voice_stats.module_responds ? VOICE_ACK_TIMEOUT_MS : 0;
+            g_voice_stats.preempted++;
+        }
+
+        if (next >= 0 && !g_voice_stats.busy) {
+            VoiceEntry *entry = &g_entries[next];
+            memcpy(g_current_text, entry->text, sizeof(g_current_text));
+            g_current_priority = entry->priority;
+            entry->used = false;
+            g_voice_stats.pending--;
+
+            uint32_t estimate = strlen(g_current_text) * VOICE_MS_PER_CHAR + VOICE_ACK_TIMEOUT_MS;
+            g_play_limit_ms = (g_voice_stats.module_responds || estimate > VOICE_MAX_PLAY_MS) ?
+                              VOICE_MAX_PLAY_MS : estimate;
+            g_play_start = now;
+            g_accepted = false;
+            g_stopping = false;
+            g_voice_stats.busy = true;
+            g_voice_stats.played++;
+            cmd_len = BuildSynthesisFrame(cmd, g_current_text);
+        }
+        LOS_MuxPost(g_voice_mutex);
+
+        // 串口发送在锁外进行，入队调用不等待串口
+        if (stop) {
+            IoTUartWrite(g_voice_uart, g_voice_stop_cmd, sizeof(g_voice_stop_cmd));
+        }
+        if (cmd_len > 0) {
+            IoTUartWrite(g_voice_uart, cmd, (unsigned int)cmd_len);
+        }
+    }
+}
+
+/**
+ * @brief 初始化语音队列
+ */
+int VoiceQueue_Init(uint32_t uart_bus)
+{
+    if (g_voice_queue_initialized) {
+        return 0;
+    }
+
+    if (LOS_MuxCreate(&g_voice_mutex) != LOS_OK) {
+        printf("Failed to create voice queue mutex\n");
+        return -1;
+    }
+    if (LOS_EventInit(&g_voice_event) != LOS_OK) {
+        printf("Failed to create voice queue event\n");
+        LOS_MuxDelete(g_voice_mutex);
+        g_voice_mutex = 0;
+        return -1;
+    }
+
+    memset(g_entries, 0, sizeof(g_entries));
+    memset(&g_voice_stats, 0, sizeof(g_voice_stats));
+    g_voice_uart = uart_bus;
+    g_voice_queue_initialized = true;
+
+    TSK_INIT_PARAM_S task_param = {0};
+    task_param.pfnTaskEntry = (TSK_ENTRY_FUNC)VoiceTask;
+    task_param.uwStackSize = VOICE_TASK_STACK_SIZE;
+    task_param.pcName = "VoiceTask";
+    task_param.usTaskPrio = VOICE_TASK_PRIO;
+
+    if (LOS_TaskCreate(&g_voice_task_id, &task_param) != LOS_OK) {
+        printf("Failed to create voice task\n");
+        g_voice_queue_initialized = false;
+        LOS_EventDestroy(&g_voice_event);
+        LOS_MuxDelete(g_voice_mutex);
+        g_voice_mutex = 0;
+        return -1;
+    }
+
+    printf("Voice queue initialized (UART %u, %d entries)\n", uart_bus, VOICE_QUEUE_LENGTH);
+    return 0;
+}
+
+/**
+ * @brief 停止语音任务并清空队列
+ */
+void VoiceQueue_Deinit(void)
+{
+    if (!g_voice_queue_initialized) {
+        return;
+    }
+
+    g_voice_queue_initialized = false;
+    if (g_voice_task_id != 0) {
+        LOS_TaskDelete(g_voice_task_id);
+        g_voice_task_id = 0;
+    }
+    LOS_EventDestroy(&g_voice_event);
+    LOS_MuxDelete(g_voice_mutex);
+    g_voice_mutex = 0;
+}
+
+/**
+ * @brief 消息入队
+ */
+int VoiceQueue_Post(const char *text, VoicePriority priority)
+{
+    if (!g_voice_queue_initialized || text == NULL || text[0] == '\0' || priority > VOICE_PRIO_CRITICAL) {
+        return -1;
+    }
+
+    LOS_MuxPend(g_voice_mutex, LOS_WAIT_FOREVER);
+    g_voice_stats.posted++;
+
+    // 与正在播报的相同消息合并（例行状态播报不重复）
+    if (g_voice_stats.busy && !g_stopping && priority <= g_current_priority &&
+        strncmp(g_current_text, text, VOICE_TEXT_MAX - 1) == 0) {
+        g_voice_stats.merged++;
+        LOS_MuxPost(g_voice_mutex);
+        return 0;
+    }
+
+    // 与待播报的相同消息合并，保留较高优先级和原有顺序
+    int slot = -1;
+    for (int i = 0; i < VOICE_QUEUE_LENGTH; i++) {
+        if (g_entries[i].used && strncmp(g_entries[i].text, text, VOICE_TEXT_MAX - 1) == 0) {
+            if (priority > g_entries[i].priority) {
+                g_entries[i].priority = (uint8_t)priority;
+            }
+            g_voice_stats.merged++;
+            LOS_MuxPost(g_voice_mutex);
+            LOS_EventWrite(&g_voice_event, VOICE_EVENT_POST);
+            return 0;
+        }
+        if (!g_entries[i].used && slot < 0) {
+            slot = i;
+        }
+    }
+
+    // 队列满时替换优先级最低、最早入队的消息
+    if (slot < 0) {
+        for (int i = 0; i < VOICE_QUEUE_LENGTH; i++) {
+            if (slot < 0 || g_entries[i].priority < g_entries[slot].priority ||
+                (g_entries[i].priority == g_entries[slot].priority &&
+                 (int32_t)(g_entries[i].order - g_entries[slot].order) < 0)) {
+                slot = i;
+            }
+        }
+        g_voice_stats.dropped++;
+        if (g_entries[slot].priority >= priority) {
+            LOS_MuxPost(g_voice_mutex);
+            return -2;
+        }
+        g_voice_stats.pending--;
+    }
+
+    VoiceEntry *entry = &g_entries[slot];
+    strncpy(entry->text, text, VOICE_TEXT_MAX - 1);
+    entry->text[VOICE_TEXT_MAX - 1] = '\0';
+    entry->priority = (uint8_t)priority;
+    entry->order = g_next_order++;
+    entry->used = true;
+    g_voice_stats.pending++;
+    LOS_MuxPost(g_voice_mutex);
+
+    LOS_EventWrite(&g_voice_event, VOICE_EVENT_POST);
+    return 0;
+}
+
+/**
+ * @brief 语音是否忙
+ */
+bool VoiceQueue_IsBusy(void)
+{
+    if (!g_voice_queue_initialized) {
+        return false;
+    }
+
+    LOS_MuxPend(g_voice_mutex, LOS_WAIT_FOREVER);
+    bool busy = g_voice_stats.busy || g_voice_stats.pending > 0;
+    LOS_MuxPost(g_voice_mutex);
+    return busy;
+}
+
+/**
+ * @brief 获取队列统计信息
+ */
+int VoiceQueue_GetStats(VoiceQueueStats *stats)
+{
+    if (!g_voice_queue_initialized || stats == NULL) {
+        return -1;
+    }
+
+    LOS_MuxPend(g_voice_mutex, LOS_WAIT_FOREVER);
+    *stats = g_voice_stats;
+    LOS_MuxPost(g_voice_mutex);
+    return 0;
+}
@@ -0,0 +1,236 @@
+/**
+ * @brief 多传感器异常检测回放：15Hz合成传感器记录按主循环的方式计算特征送入异常检测，
+ *        在已知时刻注入异常，统计检测延迟；另以无注入的长记录统计误报率
+ *
+ * 正常环境：温度日周期±5°C加天气慢变，湿度随温度反向变化（-1.5%/°C）并叠加天气慢变，
+ * 倾角含温漂0.01°/°C和0.02°噪声，振动为角速度幅值经190ms低通，每小时有5秒阵风。
+ */
+#include "host_stubs.h"
+#include "anomaly_detector.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define REPLAY_SEED                 44
+#define REPLAY_RUNS                 10
+#define REPLAY_SAMPLE_HZ            15          // 同SENSOR_SAMPLE_RATE_HZ
+#define REPLAY_ENV_INTERVAL_MS      500         // 同SENSOR_ENV_INTERVAL_MS
+#define REPLAY_VIB_TAU_MS           190.0       // 同VIBRATION_FILTER_TAU_MS
+#define REPLAY_ONSET_H              48.0        // 注入时刻
+#define REPLAY_INJECT_H             24.0        // 注入后观察时长
+#define REPLAY_NOISE_DAYS           14          // 无注入记录时长
+#define REPLAY_RISK_SCORE           3.0f        // 默认规则集异常分数开始计入风险的分数
+
+// 注入的异常
+typedef enum {
+    INJECT_NONE = 0,
+    INJECT_TILT_STEP,               // 倾角突变0.3°（滑移）
+    INJECT_TILT_RAMP,               // 倾角蠕变0.05°/小时
+    INJECT_HUMIDITY_RAMP,           // 湿度上升2%/小时且与温度无关（渗水）
+    INJECT_VIBRATION,               // 微振动增加0.2°/s
+    INJECT_COMBINED,                // 以上倾角蠕变、湿度上升、振动各取一半幅度同时出现
+    INJECT_COUNT
+} InjectType;
+
+static const char *g_inject_names[INJECT_COUNT] = {
+    "none", "tilt step 0.3deg", "tilt ramp 0.05deg/h", "humidity ramp 2%/h", "vibration +0.2deg/s",
+    "combined half"
+};
+
+// 单次回放结果
+typedef struct {
+    uint32_t normal_blocks;         // 注入前（预热后）评估的块数
+    uint32_t false_blocks;          // 其中分数超过ANOMALY_GATE_SCORE的块数
+    uint32_t risk_blocks;           // 其中分数超过REPLAY_RISK_SCORE的块数
+    uint32_t false_episodes;        // 连续误报块合并为一次
+    float max_normal_score;
+    double latency_min;             // 注入到首个超过ANOMALY_GATE_SCORE的块结束 (分钟)，未检出为-1
+    double risk_latency_min;        // 注入到首个超过REPLAY_RISK_SCORE的块结束 (分钟)，未检出为-1
+} ReplayResult;
+
+/**
+ * @brief 注入异常后的偏移
+ */
+static void Inject(InjectType type, double hours, double *tilt, double *humidity, double *vibration)
+{
+    *tilt = 0.0;
+    *humidity = 0.0;
+    *vibration = 0.0;
+    if (hours < 0.0) {
+        return;
+    }
+    switch (type) {
+        case INJECT_TILT_STEP:
+            *tilt = 0.3;
+            break;
+        case INJECT_TILT_RAMP:
+            *tilt = 0.05 * hours;
+            break;
+        case INJECT_HUMIDITY_RAMP:
+            *humidity = 2.0 * hours;
+            break;
+        case INJECT_VIBRATION:
+            *vibration = 0.2;
+            break;
+        case INJECT_COMBINED:
+            *tilt = 0.025 * hours;
+            *humidity = 1.0 * hours;
+            *vibration = 0.1;
+            break;
+        default:
+            break;
+    }
+}
+
+static void Run(InjectType type, double total_h, ReplayResult *out)
+{
+    HostGaussMarkov temp_weather = {0, 1.0, 6 * 3600};
+    HostGaussMarkov humidity_weather = {0, 3.0, 12 * 3600};
+    const uint32_t step_ms = 1000 / REPLAY_SAMPLE_HZ;
+    const double alpha = 1.0 - exp(-(double)step_ms / REPLAY_VIB_TAU_MS);
+    const double onset_h = (type == INJECT_NONE) ? total_h : REPLAY_ONSET_H;
+    double temperature = 15.0;
+    double humidity = 70.0;
+    double last_humidity = 70.0;
+    double humidity_trend = 0.0;
+    double vibration = 0.3;
+    uint32_t last_env = 0;
+    uint32_t last_block = 0;
+    bool in_false = false;
+
+    memset(out, 0, sizeof(*out));
+    out->max_normal_score = -100.0f;
+    out->latency_min = -1.0;
+    out->risk_latency_min = -1.0;
+    Anomaly_Init();
+
+    for (uint32_t ms = step_ms; ms < (uint32_t)(total_h * 3600000.0); ms += step_ms) {
+        double t_h = ms / 3600000.0;
+        double tilt_offset;
+        double humidity_offset;
+        double vibration_offset;
+        Inject(type, t_h - onset_h, &tilt_offset, &humidity_offset, &vibration_offset);
+
+        // 温湿度按读取间隔更新，天气慢变每秒一步
+        if (ms - last_env >= REPLAY_ENV_INTERVAL_MS) {
+            if (ms / 1000 != last_env / 1000) {
+                Host_GaussMarkovStep(&temp_weather);
+                Host_GaussMarkovStep(&humidity_weather);
+            }
+            double tod = fmod(t_h, 24.0) / 24.0;
+            temperature = 15.0 + 5.0 * sin(2.0 * M_PI * (tod - 0.375)) + temp_weather.value + 0.05 * Host_Gauss();
+            humidity = 70.0 - 1.5 * (temperature - 15.0) + humidity_weather.value + humidity_offset +
+                       0.1 * Host_Gauss();
+            humidity = fmin(humidity, 100.0);
+            humidity_trend = (humidity - last_humidity) * (1000.0 / REPLAY_SAMPLE_HZ) / (ms - last_env);
+            last_humidity = humidity;
+            last_env = ms;
+        }
+
+        double tilt = 3.0 + 0.01 * (temperature - 15.0) + tilt_offset + 0.02 * Host_Gauss();
+        double raw = fabs(0.3 + 0.1 * Host_Gauss()) + vibration_offset;
+        if (fmod(t_h * 3600.0, 3600.0) < 5.0 && Host_Uniform() < 0.5) {
+            raw += 2.0;     // 阵风
+        }
+        vibration = (1.0 - alpha) * vibration + alpha * raw;
+
+        float features[ANOMALY_FEATURES] = {
+            (float)tilt, (float)vibration, (float)humidity, (float)humidity_trend, (float)temperature
+        };
+        AnomalyResult result;
+        AnomalyStats stats;
+        Anomaly_Update(features, ms, &result);
+        Anomaly_GetStats(&stats);
+        if (!result.ready || stats.blocks == last_block) {
+            continue;
+        }
+        last_block = stats.blocks;
+
+        if (t_h < onset_h) {
+            out->normal_blocks++;
+            out->max_normal_score = fmaxf(out->max_normal_score, result.score);
+            out->risk_blocks += result.score > REPLAY_RISK_SCORE;
+            if (result.score > ANOMALY_GATE_SCORE) {
+                out->false_blocks++;
+                out->false_episodes += !in_false;
+            }
+            in_false = result.score > ANOMALY_GATE_SCORE;
+        } else {
+            if (out->latency_min < 0 && result.score > ANOMALY_GATE_SCORE) {
+                out->latency_min = (t_h - onset_h) * 60.0;
+            }
+            if (out->risk_latency_min < 0 && result.score > REPLAY_RISK_SCORE) {
+                out->risk_latency_min = (t_h - onset_h) * 60.0;
+            }
+        }
+    }
+    Anomaly_Deinit();
+}
+
+static int CompareDouble(const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+int main(void)
+{
+    ReplayResult result;
+    uint32_t normal_blocks = 0;
+    uint32_t false_blocks = 0;
+    uint32_t risk_blocks = 0;
+    uint32_t false_episodes = 0;
+    float max_normal = -100.0f;
+
+    // 模块日志输出到stdout，回放结果输出到stderr
+    Host_Seed(REPLAY_SEED);
+    fprintf(stderr, "injection at %.0fh, observed %.0fh, %d runs each; detection latency to first block above score\n",
+            REPLAY_ONSET_H, REPLAY_INJECT_H, REPLAY_RUNS);
+    for (int type = INJECT_TILT_STEP; type < INJECT_COUNT; type++) {
+        double latency[REPLAY_RUNS];
+        double risk_latency[REPLAY_RUNS];
+        int detected = 0;
+        int risk_detected = 0;
+        for (int run = 0; run < REPLAY_RUNS; run++) {
+            Run((InjectType)type, REPLAY_ONSET_H + REPLAY_INJECT_H, &result);
+            if (result.latency_min >= 0) {
+                latency[detected++] = result.latency_min;
+            }
+            if (result.risk_latency_min >= 0) {
+                risk_latency[risk_detected++] = result.risk_latency_min;
+            }
+            normal_blocks += result.normal_blocks;
+            false_blocks += result.false_blocks;
+            risk_blocks += result.risk_blocks;
+            false_episodes += result.false_episodes;
+            max_normal = fmaxf(max_normal, result.max_normal_score);
+        }
+        qsort(latency, detected, sizeof(double), CompareDouble);
+        qsort(risk_latency, risk_detected, sizeof(double), CompareDouble);
+        fprintf(stderr, "  %-22s score>%.0f: %2d/%d median %6.1f max %6.1f min | score>%.0f: %2d/%d median %6.1f "
+                "max %6.1f min\n", g_inject_names[type],
+                ANOMALY_GATE_SCORE, detected, REPLAY_RUNS,
+                detected ? latency[detected / 2] : -1.0, detected ? latency[detected - 1] : -1.0,
+                REPLAY_RISK_SCORE, risk_detected, REPLAY_RUNS,
+                risk_detected ? risk_latency[risk_detected / 2] : -1.0,
+                risk_detected ? risk_latency[risk_detected - 1] : -1.0);
+    }
+
+    // 无注入的长记录
+    Run(INJECT_NONE, REPLAY_NOISE_DAYS * 24.0, &result);
+    normal_blocks += result.normal_blocks;
+    false_blocks += result.false_blocks;
+    risk_blocks += result.risk_blocks;
+    false_episodes += result.false_episodes;
+    max_normal = fmaxf(max_normal, result.max_normal_score);
+
+    double normal_days = normal_blocks * (ANOMALY_BLOCK_MS / 1000.0) / 86400.0;
+    fprintf(stderr, "false positives over %.1f normal days (%u blocks): score > %.1f on %.3f%% of blocks "
+            "(%u episodes, %.2f/day), score > %.1f on %.3f%%, max score %.2f\n",
+            normal_days, normal_blocks, ANOMALY_GATE_SCORE, 100.0 * false_blocks / normal_blocks,
+            false_episodes, false_episodes / normal_days, REPLAY_RISK_SCORE, 100.0 * risk_blocks / normal_blocks,
+            max_normal);
+    return 0;
+}
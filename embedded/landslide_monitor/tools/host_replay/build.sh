@@ -0,0 +1,54 @@
+#!/bin/sh
+# 主机回放程序编译脚本：用主机gcc编译被测模块源码和LiteOS-M替身，结果输出到stderr
+# 用法: ./build.sh [输出目录，缺省为$TMPDIR/host_replay]，编译后运行 <输出目录>/<程序> >/dev/null
+set -e
+
+HERE=$(cd "$(dirname "$0")" && pwd)
+ROOT="$HERE/../.."
+OUT=${1:-"${TMPDIR:-/tmp}/host_replay"}
+CC=${CC:-gcc}
+# gps_deformation.h在未定义size_t宏时自行typedef（板级工具链缺省），主机上以同名宏跳过
+# 回放记录所在目录（程序也可在命令行指定记录文件）
+CFLAGS="-O2 -include stddef.h -Dsize_t=size_t -DHOST_REPLAY_DATA=\"$HERE/data\" -I$HERE -I$HERE/stubs -I$ROOT/include"
+
+mkdir -p "$OUT"
+
+# GPS时段平均回放
+$CC $CFLAGS -o "$OUT/gps_avg_replay" "$HERE/gps_avg_replay.c" "$HERE/host_stubs.c" \
+    "$ROOT/src/gps_deformation.c" "$ROOT/src/gps_averaging.c" "$ROOT/src/gps_enu.c" \
+    "$ROOT/src/gps_trend.c" "$ROOT/src/failure_forecast.c" "$ROOT/src/nmea_parser.c" -lm
+
+# 位置域差分回放
+$CC $CFLAGS -o "$OUT/gps_diff_replay" "$HERE/gps_diff_replay.c" "$HERE/host_stubs.c" \
+    "$ROOT/src/gps_differential.c" "$ROOT/src/gps_deformation.c" "$ROOT/src/gps_averaging.c" \
+    "$ROOT/src/gps_enu.c" "$ROOT/src/gps_trend.c" "$ROOT/src/failure_forecast.c" "$ROOT/src/nmea_parser.c" -lm
+
+# 反速度失稳预测合成数据验证
+$CC $CFLAGS -o "$OUT/forecast_synth" "$HERE/forecast_synth.c" "$HERE/host_stubs.c" \
+    "$ROOT/src/failure_forecast.c" "$ROOT/src/gps_trend.c" -lm
+
+# 风险规则记录回放
+$CC $CFLAGS -o "$OUT/risk_rules_replay" "$HERE/risk_rules_replay.c" "$HERE/host_stubs.c" \
+    "$ROOT/src/risk_rules.c" -lm
+
+# 多传感器异常检测回放
+$CC $CFLAGS -o "$OUT/anomaly_replay" "$HERE/anomaly_replay.c" "$HERE/host_stubs.c" \
+    "$ROOT/src/anomaly_detector.c" -lm
+
+# Flash环形区掉电注入与CRC32吞吐
+$CC $CFLAGS -o "$OUT/storage_powerloss" "$HERE/storage_powerloss.c" "$HERE/host_stubs.c" \
+    "$ROOT/src/data_storage.c" "$ROOT/src/crc32.c" -lm
+
+# NMEA解析核对与耗时
+$CC $CFLAGS -o "$OUT/nmea_bench" "$HERE/nmea_bench.c" "$HERE/host_stubs.c" \
+    "$ROOT/src/nmea_parser.c" -lm
+
+# 倾斜蠕变检测回放
+$CC $CFLAGS -o "$OUT/tilt_creep_replay" "$HERE/tilt_creep_replay.c" "$HERE/host_stubs.c" \
+    "$ROOT/src/tilt_creep.c" -lm
+
+# 站心坐标与ECEF严格转换对照
+$CC $CFLAGS -o "$OUT/enu_check" "$HERE/enu_check.c" "$HERE/host_stubs.c" \
+    "$ROOT/src/gps_enu.c" -lm
+
+echo "Host replay tools built in $OUT"
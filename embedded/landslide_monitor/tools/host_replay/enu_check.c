@@ -0,0 +1,235 @@
+/**
+ * @brief 站心坐标核对：GpsEnu_InitFrame/GpsEnu_FromGeodetic与双精度ECEF→ENU严格转换对照，
+ *        按原点纬度和距原点距离统计最大误差并核对误差上限，再统计每个坐标的投影耗时
+ *
+ * 参考实现：大地坐标转ECEF，差向量按原点纬经度旋转到东北天。被测实现为一阶近似，
+ * 水平误差约 距离²×tan(纬度)/地球半径；天向取椭球高差，与切平面天向相差地球曲率下降 距离²/(2×地球半径)。
+ */
+#include "host_stubs.h"
+#include "gps_enu.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define CHECK_HAS_TSC               1
+#else
+#define CHECK_HAS_TSC               0
+#endif
+
+#define CHECK_SEED                  35
+#define CHECK_FIXES                 20000       // 每个原点每个距离的坐标数
+#define CHECK_BENCH_FIXES           1000000
+#define CHECK_BENCH_REPEATS         20
+#define CHECK_EARTH_RADIUS          6371000.0
+#define CHECK_FLOAT_EPS             1.2e-7      // float相对精度（输出为float）
+
+// 原点
+typedef struct {
+    const char *name;
+    double latitude;
+    double longitude;
+    float altitude;
+} CheckOrigin;
+
+static const CheckOrigin g_origins[] = {
+    {"equator", 0.0, 30.0, 10.0f},
+    {"22.8N 108.4E", 22.8170, 108.3669, 85.0f},
+    {"33.9S 151.2E", -33.8688, 151.2093, 40.0f},
+    {"46.5N 8.0E 2500m", 46.5, 8.0, 2500.0f},
+    {"64.1N 21.9W", 64.1466, -21.9426, -20.0f},
+    {"dateline 52N", 52.0, 179.9995, 300.0f},
+};
+#define CHECK_ORIGINS               ((int)(sizeof(g_origins) / sizeof(g_origins[0])))
+
+static const double g_radii_m[] = {1.0, 10.0, 100.0, 1000.0, 10000.0};
+#define CHECK_RADII                 ((int)(sizeof(g_radii_m) / sizeof(g_radii_m[0])))
+
+/**
+ * @brief 大地坐标转ECEF
+ */
+static void GeodeticToEcef(double latitude, double longitude, double altitude, double ecef[3])
+{
+    double phi = latitude * M_PI / 180.0;
+    double lambda = longitude * M_PI / 180.0;
+    double sin_phi = sin(phi);
+    double n = GPS_ENU_WGS84_A / sqrt(1.0 - GPS_ENU_WGS84_E2 * sin_phi * sin_phi);
+
+    ecef[0] = (n + altitude) * cos(phi) * cos(lambda);
+    ecef[1] = (n + altitude) * cos(phi) * sin(lambda);
+    ecef[2] = (n * (1.0 - GPS_ENU_WGS84_E2) + altitude) * sin_phi;
+}
+
+/**
+ * @brief 双精度参考：ECEF差向量旋转到原点的东北天
+ */
+static void ReferenceEnu(const CheckOrigin *origin, double latitude, double longitude, double altitude,
+                         double enu[3])
+{
+    double a[3];
+    double b[3];
+    double d[3];
+    GeodeticToEcef(origin->latitude, origin->longitude, origin->altitude, a);
+    GeodeticToEcef(latitude, longitude, altitude, b);
+    for (int i = 0; i < 3; i++) {
+        d[i] = b[i] - a[i];
+    }
+
+    double phi = origin->latitude * M_PI / 180.0;
+    double lambda = origin->longitude * M_PI / 180.0;
+    enu[0] = -sin(lambda) * d[0] + cos(lambda) * d[1];
+    enu[1] = -sin(phi) * cos(lambda) * d[0] - sin(phi) * sin(lambda) * d[1] + cos(phi) * d[2];
+    enu[2] = cos(phi) * cos(lambda) * d[0] + cos(phi) * sin(lambda) * d[1] + sin(phi) * d[2];
+}
+
+/**
+ * @brief 水平误差上限：一阶近似误差（按tan(纬度)，赤道附近取1）留50%余量，
+ *        加比例按原点海拔计算带来的 距离×高差/地球半径 和float舍入
+ */
+static double HorizontalBound(double latitude, double distance, double height_diff)
+{
+    double slope = fmax(fabs(tan(latitude * M_PI / 180.0)), 1.0);
+    return (1.5 * distance * slope + 1.1 * fabs(height_diff)) * distance / CHECK_EARTH_RADIUS +
+           4.0 * CHECK_FLOAT_EPS * distance + 1e-6;
+}
+
+/**
+ * @brief 天向误差上限：地球曲率下降留10%余量，加海拔float舍入
+ */
+static double UpBound(float altitude, double distance)
+{
+    return 1.1 * distance * distance / (2.0 * CHECK_EARTH_RADIUS) + 4.0 * CHECK_FLOAT_EPS * (fabs(altitude) +
+           distance) + 1e-6;
+}
+
+/**
+ * @brief 在原点周围按距离随机取坐标对照
+ * @return 超过误差上限的坐标数
+ */
+static int CheckOriginAt(const CheckOrigin *origin)
+{
+    GpsEnuFrame frame;
+    int failures = 0;
+
+    GpsEnu_InitFrame(&frame, origin->latitude, origin->longitude, origin->altitude);
+    fprintf(stderr, "  %s:\n", origin->name);
+    for (int r = 0; r < CHECK_RADII; r++) {
+        double radius = g_radii_m[r];
+        double horizontal_max = 0.0;
+        double up_max = 0.0;
+        int over = 0;
+
+        for (int i = 0; i < CHECK_FIXES; i++) {
+            // 东北向在半径内均匀，天向在±20%半径内，经纬度按球面近似换算（参考与被测用同一坐标）
+            double east = radius * (2.0 * Host_Uniform() - 1.0);
+            double north = radius * (2.0 * Host_Uniform() - 1.0);
+            double latitude = origin->latitude + north / 111000.0;
+            double longitude = origin->longitude + east / (111000.0 * cos(origin->latitude * M_PI / 180.0));
+            float altitude = origin->altitude + (float)(0.2 * radius * (2.0 * Host_Uniform() - 1.0));
+            if (longitude > 180.0) {
+                longitude -= 360.0;
+            }
+
+            double reference[3];
+            GpsEnuVector enu;
+            ReferenceEnu(origin, latitude, longitude, altitude, reference);
+            GpsEnu_FromGeodetic(&frame, latitude, longitude, altitude, &enu);
+
+            double distance = hypot(reference[0], reference[1]);
+            double horizontal = hypot(enu.east - reference[0], enu.north - reference[1]);
+            double up = fabs(enu.up - reference[2]);
+            horizontal_max = fmax(horizontal_max, horizontal);
+            up_max = fmax(up_max, up);
+            over += (horizontal > HorizontalBound(origin->latitude, distance, altitude - origin->altitude) ||
+                     up > UpBound(origin->altitude, distance));
+        }
+
+        double corner = radius * sqrt(2.0);
+        fprintf(stderr, "    radius %6.0fm: max|horizontal err| %.2e m (bound %.2e), "
+                "max|up err| %.2e m (bound %.2e)%s\n", radius, horizontal_max,
+                HorizontalBound(origin->latitude, corner, 0.2 * radius), up_max, UpBound(origin->altitude, corner),
+                over ? "  FAIL" : "");
+        failures += over;
+    }
+    return failures;
+}
+
+static double NowNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/**
+ * @brief 投影耗时：原点约1km内随机坐标，被测实现与参考实现分别统计
+ */
+static void Benchmark(void)
+{
+    const CheckOrigin *origin = &g_origins[1];
+    double *latitudes = malloc(CHECK_BENCH_FIXES * sizeof(double));
+    double *longitudes = malloc(CHECK_BENCH_FIXES * sizeof(double));
+    volatile float sink = 0.0f;
+    volatile double reference_sink = 0.0;
+    GpsEnuFrame frame;
+
+    if (latitudes == NULL || longitudes == NULL) {
+        free(latitudes);
+        free(longitudes);
+        return;
+    }
+    for (int i = 0; i < CHECK_BENCH_FIXES; i++) {
+        latitudes[i] = origin->latitude + 0.01 * (2.0 * Host_Uniform() - 1.0);
+        longitudes[i] = origin->longitude + 0.01 * (2.0 * Host_Uniform() - 1.0);
+    }
+
+    GpsEnu_InitFrame(&frame, origin->latitude, origin->longitude, origin->altitude);
+    double start_ns = NowNs();
+#if CHECK_HAS_TSC
+    uint64_t start_tsc = __rdtsc();
+#endif
+    for (int repeat = 0; repeat < CHECK_BENCH_REPEATS; repeat++) {
+        for (int i = 0; i < CHECK_BENCH_FIXES; i++) {
+            GpsEnuVector enu;
+            GpsEnu_FromGeodetic(&frame, latitudes[i], longitudes[i], origin->altitude, &enu);
+            sink += enu.east + enu.north + enu.up;
+        }
+    }
+#if CHECK_HAS_TSC
+    uint64_t tsc = __rdtsc() - start_tsc;
+#endif
+    double ns = NowNs() - start_ns;
+
+    double reference_start_ns = NowNs();
+    for (int i = 0; i < CHECK_BENCH_FIXES; i++) {
+        double enu[3];
+        ReferenceEnu(origin, latitudes[i], longitudes[i], origin->altitude, enu);
+        reference_sink += enu[0] + enu[1] + enu[2];
+    }
+    double reference_ns = NowNs() - reference_start_ns;
+
+    double fixes = (double)CHECK_BENCH_FIXES * CHECK_BENCH_REPEATS;
+    fprintf(stderr, "GpsEnu_FromGeodetic: %.2f ns/fix (%.1f Mfix/s)", ns / fixes, fixes / ns * 1000.0);
+#if CHECK_HAS_TSC
+    fprintf(stderr, ", %.1f TSC cycles/fix", tsc / fixes);
+#endif
+    fprintf(stderr, "; double ECEF reference %.1f ns/fix\n", reference_ns / CHECK_BENCH_FIXES);
+
+    free(latitudes);
+    free(longitudes);
+}
+
+int main(void)
+{
+    int failures = 0;
+
+    Host_Seed(CHECK_SEED);
+    fprintf(stderr, "%d fixes per origin and radius, errors against double ECEF->ENU\n", CHECK_FIXES);
+    for (int o = 0; o < CHECK_ORIGINS; o++) {
+        failures += CheckOriginAt(&g_origins[o]);
+    }
+    fprintf(stderr, "fixes over bound: %d\n", failures);
+    Benchmark();
+    return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,241 @@
+/**
+ * @brief GPS时段平均回放：24小时1Hz静态站合成记录经NMEA解析器送入形变模块，
+ *        统计各平均时段的坐标误差、静止期间的位移误报，以及同一定位结果重复输入时的输出
+ *
+ * 合成误差：三轴一阶高斯-马尔可夫过程（相关时间120秒，σ 1.0/1.0/1.8米）+白噪声（0.3/0.3/0.5米），
+ * 每秒0.2%概率出现10~40秒多路径突发（偏差σ 4/4/8米，HDOP升至2.5）；16小时后东向3厘米/小时蠕变。
+ */
+#include "host_stubs.h"
+#include "gps_deformation.h"
+#include "nmea_parser.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define REPLAY_SEED                 34
+#define REPLAY_SECONDS              (24 * 3600)
+#define REPLAY_CREEP_START_S        (16 * 3600)
+#define REPLAY_CREEP_M_PER_H        0.03
+#define REPLAY_FALSE_ALARM_M        0.5f        // 静止期间水平位移超过该值计为误报
+#define REPLAY_ORIGIN_LAT           22.8170
+#define REPLAY_ORIGIN_LON           108.3669
+#define REPLAY_ORIGIN_ALT           85.0
+#define EARTH_RADIUS_M              6378137.0
+
+// 回放统计
+typedef struct {
+    float errors[REPLAY_SECONDS];   // 水平误差（原始历元或时段坐标）
+    int error_count;
+    float static_disp[REPLAY_SECONDS];
+    int static_count;
+    int false_alarms;
+    int duplicates;                 // 重复输入被拒绝的次数
+    DeformationStats stats;
+} ReplayResult;
+
+static float g_truth_east[REPLAY_SECONDS];
+static ReplayResult g_result;
+
+static int CompareFloat(const void *a, const void *b)
+{
+    float x = *(const float *)a;
+    float y = *(const float *)b;
+    return (x > y) - (x < y);
+}
+
+static float Percentile(float *values, int count, double p)
+{
+    if (count == 0) {
+        return 0.0f;
+    }
+    qsort(values, count, sizeof(float), CompareFloat);
+    return values[(int)(p * (count - 1))];
+}
+
+static void ToOffset(double latitude, double longitude, double *east, double *north)
+{
+    *north = (latitude - REPLAY_ORIGIN_LAT) * M_PI / 180.0 * EARTH_RADIUS_M;
+    *east = (longitude - REPLAY_ORIGIN_LON) * M_PI / 180.0 * EARTH_RADIUS_M * cos(REPLAY_ORIGIN_LAT * M_PI / 180.0);
+}
+
+/**
+ * @brief 生成一个历元的GGA和GSA语句
+ */
+static int GenerateEpoch(char *out, size_t size, uint32_t t)
+{
+    static HostGaussMarkov gm[3] = {{0, 1.0, 120}, {0, 1.0, 120}, {0, 1.8, 120}};
+    static int burst = 0;
+    static double bias[3];
+    const double white[3] = {0.3, 0.3, 0.5};
+    double offset[3];
+
+    if (t == 0) {
+        Host_Seed(REPLAY_SEED);
+        burst = 0;
+        for (int i = 0; i < 3; i++) {
+            gm[i].value = 0;
+        }
+    }
+    if (burst == 0 && Host_Uniform() < 0.002) {
+        burst = 10 + (int)(Host_Uniform() * 31);
+        bias[0] = 4.0 * Host_Gauss();
+        bias[1] = 4.0 * Host_Gauss();
+        bias[2] = 8.0 * Host_Gauss();
+    }
+    for (int i = 0; i < 3; i++) {
+        offset[i] = Host_GaussMarkovStep(&gm[i]) + white[i] * Host_Gauss() + (burst > 0 ? bias[i] : 0.0);
+    }
+    float hdop = (burst > 0) ? 2.5f : 1.0f;
+    if (burst > 0) {
+        burst--;
+    }
+
+    double creep = 0.0;
+    if (t > REPLAY_CREEP_START_S) {
+        creep = (t - REPLAY_CREEP_START_S) / 3600.0 * REPLAY_CREEP_M_PER_H;
+    }
+    g_truth_east[t] = (float)creep;
+    offset[0] += creep;
+
+    double latitude = REPLAY_ORIGIN_LAT + offset[1] / EARTH_RADIUS_M * 180.0 / M_PI;
+    double longitude = REPLAY_ORIGIN_LON +
+                       offset[0] / (EARTH_RADIUS_M * cos(REPLAY_ORIGIN_LAT * M_PI / 180.0)) * 180.0 / M_PI;
+    int len = Host_FormatGga(out, size, t % 86400, latitude, longitude, (float)(REPLAY_ORIGIN_ALT + offset[2]),
+                             hdop, 14);
+
+    char body[80];
+    unsigned char checksum = 0;
+    snprintf(body, sizeof(body), "GNGSA,A,3,01,02,03,04,05,06,07,,,,,,%.2f,%.2f,%.2f,1",
+             hdop * 1.6f, hdop, hdop * 1.3f);
+    for (const char *p = body; *p != '\0'; p++) {
+        checksum ^= (unsigned char)*p;
+    }
+    len += snprintf(out + len, size - len, "$%s*%02X\r\n", body, checksum);
+    return len;
+}
+
+/**
+ * @brief 回放一次
+ * @param period_ms 平均时段，0表示统计原始历元误差
+ * @param repeats 每个定位结果输入次数（主循环在两次GPS更新之间会重复读取同一结果）
+ */
+static void Run(uint32_t period_ms, int repeats)
+{
+    NmeaParser parser;
+    char text[256];
+    uint16_t pdop = 0;
+    uint32_t last_end = 0;
+
+    memset(&g_result, 0, sizeof(g_result));
+    Nmea_Init(&parser);
+    GPS_Deformation_Reset();
+    if (period_ms > 0) {
+        GPS_Deformation_SetAveragingPeriod(period_ms);
+    }
+
+    for (uint32_t t = 0; t < REPLAY_SECONDS; t++) {
+        int len = GenerateEpoch(text, sizeof(text), t);
+        GPSData gps = {0};
+        bool have_fix = false;
+
+        for (int i = 0; i < len; i++) {
+            NmeaType type = Nmea_Feed(&parser, text[i]);
+            if (type == NMEA_TYPE_GSA) {
+                pdop = parser.gsa.pdop;
+            } else if (type == NMEA_TYPE_GGA) {
+                have_fix = true;
+            }
+        }
+        if (!have_fix) {
+            continue;
+        }
+
+        gps.latitude = parser.gga.latitude / 1e7;
+        gps.longitude = parser.gga.longitude / 1e7;
+        gps.altitude = parser.gga.altitude / 100.0f;
+        gps.accuracy = parser.gga.hdop / 100.0f * 4.0f;
+        gps.pdop = pdop / 100.0f;
+        gps.fix_quality = parser.gga.quality;
+        gps.fix_type = 3;
+        gps.satellites_used = parser.gga.satellites;
+        gps.valid = true;
+        gps.last_update_time = t * 1000;
+        g_host_tick = t * 1000;
+
+        if (period_ms == 0) {
+            double east;
+            double north;
+            ToOffset(gps.latitude, gps.longitude, &east, &north);
+            g_result.errors[g_result.error_count++] = (float)hypot(east - g_truth_east[t], north);
+            continue;
+        }
+
+        for (int r = 0; r < repeats; r++) {
+            if (GPS_Deformation_AddPosition(&gps) == -2 && r > 0) {
+                g_result.duplicates++;
+            }
+        }
+
+        GpsAvgSolution solution;
+        if (GPS_Deformation_GetLastSolution(&solution) != 0 || solution.end_time == last_end) {
+            continue;
+        }
+        last_end = solution.end_time;
+
+        double east;
+        double north;
+        ToOffset(solution.latitude, solution.longitude, &east, &north);
+        g_result.errors[g_result.error_count++] =
+            (float)hypot(east - g_truth_east[solution.end_time / 1000], north);
+
+        GPSDeformationAnalysis analysis;
+        if (solution.end_time / 1000 < REPLAY_CREEP_START_S && GPS_Deformation_GetAnalysis(&analysis) == 0 &&
+            analysis.analysis_valid) {
+            float disp = analysis.displacement.horizontal_distance;
+            g_result.static_disp[g_result.static_count++] = disp;
+            if (disp > REPLAY_FALSE_ALARM_M) {
+                g_result.false_alarms++;
+            }
+        }
+    }
+    GPS_Deformation_GetStats(&g_result.stats);
+}
+
+int main(void)
+{
+    const uint32_t periods_min[] = {5, 15, 30, 60};
+
+    // 形变模块日志输出到stdout，回放结果输出到stderr
+    GPS_Deformation_Init();
+
+    Run(0, 1);
+    fprintf(stderr, "raw epochs   n=%5d  horizontal error p50 %.2fm p95 %.2fm\n", g_result.error_count,
+            Percentile(g_result.errors, g_result.error_count, 0.50),
+            Percentile(g_result.errors, g_result.error_count, 0.95));
+
+    for (size_t i = 0; i < sizeof(periods_min) / sizeof(periods_min[0]); i++) {
+        Run(periods_min[i] * 60000, 1);
+        int static_count = g_result.static_count;
+        fprintf(stderr, "avg %2u min   n=%5d  horizontal error p50 %.2fm p95 %.2fm | static displacement p95 %.2fm, "
+                "> %.1fm %d/%d | outliers %u\n",
+                periods_min[i], g_result.error_count,
+                Percentile(g_result.errors, g_result.error_count, 0.50),
+                Percentile(g_result.errors, g_result.error_count, 0.95),
+                Percentile(g_result.static_disp, static_count, 0.95),
+                REPLAY_FALSE_ALARM_M, g_result.false_alarms, static_count, g_result.stats.outlier_epochs);
+    }
+
+    // 每个定位结果输入3次：时段坐标应与单次输入完全相同
+    Run(30 * 60000, 1);
+    uint32_t single_solutions = g_result.stats.solutions;
+    float single_p95 = Percentile(g_result.errors, g_result.error_count, 0.95);
+    Run(30 * 60000, 3);
+    float repeat_p95 = Percentile(g_result.errors, g_result.error_count, 0.95);
+    fprintf(stderr, "repeat x3    30 min solutions %u (single %u), p95 %.2fm (single %.2fm), rejected repeats %d\n",
+            g_result.stats.solutions, single_solutions, repeat_p95, single_p95, g_result.duplicates);
+
+    fprintf(stderr, "sizeof(GpsAverager) = %zu bytes\n", sizeof(GpsAverager));
+    GPS_Deformation_Deinit();
+    return 0;
+}
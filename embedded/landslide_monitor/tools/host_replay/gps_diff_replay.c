@@ -0,0 +1,158 @@
+/**
+ * @brief 位置域差分回放：参考站GGA数据流与本站历元同时合成，经差分模块和形变模块处理，
+ *        比较单点与差分的30分钟时段坐标离散度，并验证参考站中断时单点/差分坐标不混用
+ *
+ * 合成误差：两站共同误差为一阶高斯-马尔可夫过程（相关时间1200秒，σ 1.5/1.5/3.0米），
+ * 各站独立误差（相关时间300秒，σ 0.3/0.3/0.6米）和白噪声（0.1/0.1/0.2米）；本站在参考站以北2公里，静止不动。
+ */
+#include "host_stubs.h"
+#include "gps_deformation.h"
+#include "gps_differential.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#define REPLAY_SEED                 40
+#define REPLAY_SECONDS              (48 * 3600)
+#define REPLAY_UTC_BASE             799977600u  // 2025-05-08 00:00:00，2000-01-01起秒数
+#define REPLAY_LINK_LAG_S           3           // 参考站数据链路延迟
+#define REPLAY_OUTAGE_START_S       (30 * 3600)
+#define REPLAY_OUTAGE_S             (90 * 60)   // 参考站中断时长（超过GPS_DIFF_REF_TIMEOUT_MS和一个平均时段）
+#define REPLAY_SETTLE_S             (2 * 3600)  // 位移统计跳过基准建立初期
+#define REF_LAT                     30.0
+#define REF_LON                     110.0
+#define REF_ALT                     200.0
+#define ROVER_NORTH_M               2000.0
+#define ROVER_ALT                   150.0
+#define METERS_PER_DEG_LAT          111320.0
+
+// 回放场景
+typedef enum {
+    SCENARIO_ABSOLUTE = 0,          // 不输入参考站数据（单点定位）
+    SCENARIO_DIFFERENTIAL,          // 参考站连续
+    SCENARIO_OUTAGE                 // 参考站中途中断
+} Scenario;
+
+static const char *g_scenario_names[] = {"absolute", "differential", "reference outage"};
+
+// 参考站语句延迟队列
+static char g_pending[REPLAY_LINK_LAG_S + 1][128];
+static int g_pending_len[REPLAY_LINK_LAG_S + 1];
+
+static void Run(Scenario scenario)
+{
+    HostGaussMarkov common[3] = {{0, 1.5, 1200}, {0, 1.5, 1200}, {0, 3.0, 1200}};
+    HostGaussMarkov reference[3] = {{0, 0.3, 300}, {0, 0.3, 300}, {0, 0.6, 300}};
+    HostGaussMarkov rover[3] = {{0, 0.3, 300}, {0, 0.3, 300}, {0, 0.6, 300}};
+    const double white[3] = {0.1, 0.1, 0.2};
+    const double meters_per_deg_lon = METERS_PER_DEG_LAT * cos(REF_LAT * M_PI / 180.0);
+    double sum[3] = {0};
+    double sum_sq[3] = {0};
+    int sessions = 0;
+    int pending = 0;
+    uint32_t last_end = 0;
+    float max_displacement = 0;
+
+    Host_Seed(REPLAY_SEED);
+    GPS_Deformation_Init();
+    GpsDiff_Init();
+    GpsDiff_SetReferencePosition(REF_LAT, REF_LON, (float)REF_ALT);
+
+    GpsEnuFrame frame;
+    GpsEnu_InitFrame(&frame, REF_LAT + ROVER_NORTH_M / METERS_PER_DEG_LAT, REF_LON, ROVER_ALT);
+
+    for (uint32_t t = 0; t < REPLAY_SECONDS; t++) {
+        double error[3];
+        double ref_offset[3];
+        double rover_offset[3];
+        for (int i = 0; i < 3; i++) {
+            error[i] = Host_GaussMarkovStep(&common[i]);
+            ref_offset[i] = error[i] + Host_GaussMarkovStep(&reference[i]) + white[i] * Host_Gauss();
+            rover_offset[i] = error[i] + Host_GaussMarkovStep(&rover[i]) + white[i] * Host_Gauss();
+        }
+        g_host_tick = t * 1000 + 100;
+
+        // 参考站语句经链路延迟后输入
+        bool outage = scenario == SCENARIO_OUTAGE && t >= REPLAY_OUTAGE_START_S &&
+                      t < REPLAY_OUTAGE_START_S + REPLAY_OUTAGE_S;
+        if (scenario != SCENARIO_ABSOLUTE && !outage) {
+            g_pending_len[pending] = Host_FormatGga(g_pending[pending], sizeof(g_pending[0]), t % 86400,
+                                                    REF_LAT + ref_offset[1] / METERS_PER_DEG_LAT,
+                                                    REF_LON + ref_offset[0] / meters_per_deg_lon,
+                                                    (float)(REF_ALT + ref_offset[2]), 0.9f, 9);
+            pending++;
+        }
+        if (pending > REPLAY_LINK_LAG_S) {
+            GpsDiff_FeedReference(g_pending[0], (uint32_t)g_pending_len[0]);
+            memmove(g_pending, g_pending + 1, sizeof(g_pending[0]) * (pending - 1));
+            memmove(g_pending_len, g_pending_len + 1, sizeof(g_pending_len[0]) * (pending - 1));
+            pending--;
+        }
+
+        GPSData gps = {0};
+        gps.latitude = REF_LAT + (ROVER_NORTH_M + rover_offset[1]) / METERS_PER_DEG_LAT;
+        gps.longitude = REF_LON + rover_offset[0] / meters_per_deg_lon;
+        gps.altitude = (float)(ROVER_ALT + rover_offset[2]);
+        gps.accuracy = 0.9f * 4.0f;
+        gps.fix_quality = 1;
+        gps.fix_type = 3;
+        gps.satellites_used = 9;
+        gps.valid = true;
+        gps.last_update_time = g_host_tick;
+        gps.utc_seconds = REPLAY_UTC_BASE + t;
+        GpsDiff_AddRover(&gps);
+
+        GPSData output;
+        while (GpsDiff_GetCorrected(&output) == 0) {
+            GPS_Deformation_AddPosition(&output);
+        }
+
+        GpsAvgSolution solution;
+        if (GPS_Deformation_GetLastSolution(&solution) != 0 || solution.end_time == last_end) {
+            continue;
+        }
+        last_end = solution.end_time;
+
+        GpsEnuVector enu;
+        GpsEnu_FromGeodetic(&frame, solution.latitude, solution.longitude, solution.altitude, &enu);
+        const float values[3] = {enu.east, enu.north, enu.up};
+        for (int i = 0; i < 3; i++) {
+            sum[i] += values[i];
+            sum_sq[i] += values[i] * values[i];
+        }
+        sessions++;
+
+        GPSDeformationAnalysis analysis;
+        if (t >= REPLAY_SETTLE_S && GPS_Deformation_GetAnalysis(&analysis) == 0 && analysis.analysis_valid &&
+            analysis.displacement.horizontal_distance > max_displacement) {
+            max_displacement = analysis.displacement.horizontal_distance;
+        }
+    }
+
+    GpsDiffStats diff_stats;
+    DeformationStats deform_stats;
+    GpsDiff_GetStats(&diff_stats);
+    GPS_Deformation_GetStats(&deform_stats);
+    GpsDiff_Deinit();
+    GPS_Deformation_Deinit();
+
+    double std[3];
+    for (int i = 0; i < 3; i++) {
+        double mean = sum[i] / sessions;
+        std[i] = sqrt(sum_sq[i] / sessions - mean * mean);
+    }
+    fprintf(stderr, "%-17s %d sessions, 30-min solution std E %.3f N %.3f U %.3f m, max horizontal displacement "
+            "%.3f m\n", g_scenario_names[scenario], sessions, std[0], std[1], std[2], max_displacement);
+    fprintf(stderr, "%-17s corrected %u unmatched %u passthrough %u | mode changes %u, skipped sessions %u\n", "",
+            diff_stats.corrected, diff_stats.unmatched, diff_stats.passthrough,
+            deform_stats.mode_changes, deform_stats.mode_skipped);
+}
+
+int main(void)
+{
+    // 模块日志输出到stdout，回放结果输出到stderr
+    Run(SCENARIO_ABSOLUTE);
+    Run(SCENARIO_DIFFERENTIAL);
+    Run(SCENARIO_OUTAGE);
+    return 0;
+}
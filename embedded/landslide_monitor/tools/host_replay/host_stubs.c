@@ -0,0 +1,121 @@
+#include "host_stubs.h"
+#include "los_mux.h"
+#include "kv_store.h"
+#include <stdio.h>
+#include <math.h>
+
+uint32_t g_host_tick = 0;
+static uint64_t g_rng_state = 0x9E3779B97F4A7C15ull;
+
+UINT64 LOS_TickCountGet(void)
+{
+    return g_host_tick;
+}
+
+UINT32 LOS_MuxCreate(UINT32 *mux)
+{
+    *mux = 1;
+    return LOS_OK;
+}
+
+UINT32 LOS_MuxDelete(UINT32 mux)
+{
+    (void)mux;
+    return LOS_OK;
+}
+
+UINT32 LOS_MuxPend(UINT32 mux, UINT32 timeout)
+{
+    (void)mux;
+    (void)timeout;
+    return LOS_OK;
+}
+
+UINT32 LOS_MuxPost(UINT32 mux)
+{
+    (void)mux;
+    return LOS_OK;
+}
+
+// Flash不保存任何内容：每次回放都从空白状态开始
+int KvStore_Get(uint16_t key, void *value, uint16_t size)
+{
+    (void)key;
+    (void)value;
+    (void)size;
+    return -1;
+}
+
+int KvStore_Set(uint16_t key, const void *value, uint16_t size)
+{
+    (void)key;
+    (void)value;
+    (void)size;
+    return 0;
+}
+
+int KvStore_Delete(uint16_t key)
+{
+    (void)key;
+    return 0;
+}
+
+void Host_Seed(uint64_t seed)
+{
+    g_rng_state = seed * 0x9E3779B97F4A7C15ull + 1;
+}
+
+double Host_Uniform(void)
+{
+    // xorshift64*
+    g_rng_state ^= g_rng_state >> 12;
+    g_rng_state ^= g_rng_state << 25;
+    g_rng_state ^= g_rng_state >> 27;
+    return (double)((g_rng_state * 0x2545F4914F6CDD1Dull) >> 11) / 9007199254740992.0;
+}
+
+double Host_Gauss(void)
+{
+    double u = Host_Uniform();
+    double v = Host_Uniform();
+    if (u < 1e-300) {
+        u = 1e-300;
+    }
+    return sqrt(-2.0 * log(u)) * cos(2.0 * M_PI * v);
+}
+
+double Host_GaussMarkovStep(HostGaussMarkov *process)
+{
+    double a = exp(-1.0 / process->tau_s);
+    process->value = a * process->value + process->sigma * sqrt(1.0 - a * a) * Host_Gauss();
+    return process->value;
+}
+
+/**
+ * @brief 度转换为NMEA的度分格式
+ */
+static void FormatDegrees(char *out, size_t size, double degrees, int degree_digits)
+{
+    double value = fabs(degrees);
+    int whole = (int)value;
+    snprintf(out, size, "%0*d%09.6f", degree_digits, whole, (value - whole) * 60.0);
+}
+
+int Host_FormatGga(char *out, size_t size, uint32_t tod_s, double latitude, double longitude, float altitude,
+                   float hdop, int satellites)
+{
+    char lat[20];
+    char lon[20];
+    char body[128];
+    unsigned char checksum = 0;
+
+    FormatDegrees(lat, sizeof(lat), latitude, 2);
+    FormatDegrees(lon, sizeof(lon), longitude, 3);
+    snprintf(body, sizeof(body), "GNGGA,%02u%02u%02u.00,%s,%c,%s,%c,1,%02d,%.2f,%.2f,M,0.0,M,,",
+             tod_s / 3600, tod_s / 60 % 60, tod_s % 60, lat, latitude < 0 ? 'S' : 'N',
+             lon, longitude < 0 ? 'W' : 'E', satellites, hdop, altitude);
+    for (const char *p = body; *p != '\0'; p++) {
+        checksum ^= (unsigned char)*p;
+    }
+    return snprintf(out, size, "$%s*%02X\r\n", body, checksum);
+}
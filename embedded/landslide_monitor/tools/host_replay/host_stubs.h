@@ -0,0 +1,43 @@
+#ifndef HOST_STUBS_H
+#define HOST_STUBS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// 模拟系统tick (ms)，由回放程序推进
+extern uint32_t g_host_tick;
+
+/**
+ * @brief 设置随机数种子（自带生成器，结果不随C库变化）
+ */
+void Host_Seed(uint64_t seed);
+
+/**
+ * @brief 标准正态随机数
+ */
+double Host_Gauss(void);
+
+/**
+ * @brief [0,1)均匀随机数
+ */
+double Host_Uniform(void);
+
+/**
+ * @brief 一阶高斯-马尔可夫过程（相关时间tau_s，稳态标准差sigma，每秒一步）
+ */
+typedef struct {
+    double value;
+    double sigma;
+    double tau_s;
+} HostGaussMarkov;
+
+double Host_GaussMarkovStep(HostGaussMarkov *process);
+
+/**
+ * @brief 生成带校验和的GGA语句
+ * @param tod_s 当日UTC秒
+ */
+int Host_FormatGga(char *out, size_t size, uint32_t tod_s, double latitude, double longitude, float altitude,
+                   float hdop, int satellites);
+
+#endif // HOST_STUBS_H
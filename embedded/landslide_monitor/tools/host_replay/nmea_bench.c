@@ -0,0 +1,290 @@
+/**
+ * @brief NMEA解析核对与耗时：按记录（data/nmea_corpus.nmea）逐字节送入解析器，核对每条校验通过语句的字段、
+ *        解析统计（校验和错误、格式错误），再重复解析整个记录统计每条语句的周期数
+ *
+ * 记录包含各类型有效语句（南纬/西经、负海拔、空字段、非数字字段、小写校验和、超过7位小数），
+ * 以及校验和错误、行中截断（遇CR/LF或下一个'$'）、校验和只有一位或含非十六进制字符、超长语句、
+ * 语句外的杂散字节和未处理的语句类型。期望值按NMEA格式独立计算，不取自被测代码。
+ */
+#include "host_stubs.h"
+#include "nmea_parser.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAS_TSC               1
+#else
+#define BENCH_HAS_TSC               0
+#endif
+
+#define BENCH_CORPUS_FILE           HOST_REPLAY_DATA "/nmea_corpus.nmea"
+#define BENCH_CORPUS_MAX            8192
+#define BENCH_REPEATS               20000
+#define BENCH_SENTENCES             27          // 校验通过的语句数（含未处理类型）
+#define BENCH_CHECKSUM_ERRORS       3
+#define BENCH_FORMAT_ERRORS         6
+
+// 一条校验通过语句的期望结果（按记录中的顺序）
+typedef struct {
+    NmeaType type;
+    union {
+        NmeaGga gga;
+        NmeaRmc rmc;
+        NmeaGsa gsa;
+        NmeaGsv gsv;
+        NmeaVtg vtg;
+    };
+} Expected;
+
+static const Expected g_expected[BENCH_SENTENCES] = {
+    {NMEA_TYPE_GGA, .gga = {45319000, 481173000, 115166667, 54540, 90, 1, 8,
+                            NMEA_GGA_HAS_TIME | NMEA_GGA_HAS_POSITION | NMEA_GGA_HAS_ALTITUDE | NMEA_GGA_HAS_HDOP}},
+    {NMEA_TYPE_GGA, .gga = {1000, 228170010, 1083669000, 8490, 80, 2, 12,
+                            NMEA_GGA_HAS_TIME | NMEA_GGA_HAS_POSITION | NMEA_GGA_HAS_ALTITUDE | NMEA_GGA_HAS_HDOP}},
+    {NMEA_TYPE_GGA, .gga = {86399999, -338583333, -1512133333, -1235, 55, 4, 20,
+                            NMEA_GGA_HAS_TIME | NMEA_GGA_HAS_POSITION | NMEA_GGA_HAS_ALTITUDE | NMEA_GGA_HAS_HDOP}},
+    // 未定位：位置、海拔为空
+    {NMEA_TYPE_GGA, .gga = {10000, 0, 0, 0, 9999, 0, 0, NMEA_GGA_HAS_TIME | NMEA_GGA_HAS_HDOP}},
+    {NMEA_TYPE_GGA, .gga = {0, 228170010, 1083669000, 8500, 150, 1, 5,
+                            NMEA_GGA_HAS_POSITION | NMEA_GGA_HAS_ALTITUDE | NMEA_GGA_HAS_HDOP}},
+    // 缺少纬度半球
+    {NMEA_TYPE_GGA, .gga = {30600000, 0, 1083669000, 8500, 150, 1, 5,
+                            NMEA_GGA_HAS_TIME | NMEA_GGA_HAS_LONGITUDE | NMEA_GGA_HAS_ALTITUDE | NMEA_GGA_HAS_HDOP}},
+    // 分的小数部分超过7位，截断后换算
+    {NMEA_TYPE_GGA, .gga = {30600500, 228170010, 1083669002, 8503, 62, 5, 14,
+                            NMEA_GGA_HAS_TIME | NMEA_GGA_HAS_POSITION | NMEA_GGA_HAS_ALTITUDE | NMEA_GGA_HAS_HDOP}},
+    // 时间字段含非数字字符
+    {NMEA_TYPE_GGA, .gga = {0, 481173000, 115166667, 54540, 90, 1, 8,
+                            NMEA_GGA_HAS_POSITION | NMEA_GGA_HAS_ALTITUDE | NMEA_GGA_HAS_HDOP}},
+    {NMEA_TYPE_RMC, .rmc = {30959000, 472852395, 85652537, 2, 7752, 9, 12, 2002, 'A', 'A',
+                            NMEA_RMC_HAS_TIME | NMEA_RMC_HAS_DATE | NMEA_RMC_HAS_POSITION | NMEA_RMC_HAS_SPEED |
+                            NMEA_RMC_HAS_COURSE}},
+    {NMEA_TYPE_RMC, .rmc = {30960000, 0, 0, 0, 0, 9, 12, 2002, 'V', 'N', NMEA_RMC_HAS_TIME | NMEA_RMC_HAS_DATE}},
+    // NMEA 2.x：无模式字段
+    {NMEA_TYPE_RMC, .rmc = {82486000, 492741667, -1231853333, 257, 5470, 19, 11, 2094, 'A', 0,
+                            NMEA_RMC_HAS_TIME | NMEA_RMC_HAS_DATE | NMEA_RMC_HAS_POSITION | NMEA_RMC_HAS_SPEED |
+                            NMEA_RMC_HAS_COURSE}},
+    // 小写校验和
+    {NMEA_TYPE_RMC, .rmc = {82488000, 492741667, -1231853333, 257, 5470, 19, 11, 2094, 'A', 'D',
+                            NMEA_RMC_HAS_TIME | NMEA_RMC_HAS_DATE | NMEA_RMC_HAS_POSITION | NMEA_RMC_HAS_SPEED |
+                            NMEA_RMC_HAS_COURSE}},
+    // 缺少纬度半球，航向为空
+    {NMEA_TYPE_RMC, .rmc = {82488000, 0, 0, 6350, 0, 19, 11, 2094, 'A', 'A',
+                            NMEA_RMC_HAS_TIME | NMEA_RMC_HAS_DATE | NMEA_RMC_HAS_SPEED}},
+    {NMEA_TYPE_GSA, .gsa = {{80, 71, 73, 79, 69}, 183, 109, 147, 5, 3, NMEA_SYSTEM_GLONASS, 'A'}},
+    {NMEA_TYPE_GSA, .gsa = {{0}, 0, 0, 0, 0, 1, NMEA_SYSTEM_GPS, 'A'}},
+    // GN语句无系统ID，按PRN判断
+    {NMEA_TYPE_GSA, .gsa = {{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12}, 120, 80, 90, 12, 3, NMEA_SYSTEM_GPS, 'A'}},
+    {NMEA_TYPE_GSA, .gsa = {{0}, 250, 140, 210, 0, 3, NMEA_SYSTEM_BEIDOU, 'A'}},
+    {NMEA_TYPE_GSV, .gsv = {{{10, 137, 63, 17}, {7, 98, 61, 15}, {5, 290, 59, 20}, {8, 157, 54, 30}},
+                            4, 3, 1, 11, NMEA_SYSTEM_GPS, 0}},
+    // 末条语句只有2颗卫星，载噪比为空
+    {NMEA_TYPE_GSV, .gsv = {{{22, 67, 42, 0}, {13, 300, 7, 0}}, 2, 3, 3, 11, NMEA_SYSTEM_GPS, 0}},
+    {NMEA_TYPE_GSV, .gsv = {{{11, 120, 45, 38}, {12, 200, 30, 35}}, 2, 1, 1, 2, NMEA_SYSTEM_BEIDOU, 1}},
+    {NMEA_TYPE_GSV, .gsv = {{{0}}, 0, 1, 1, 0, NMEA_SYSTEM_GLONASS, 0}},
+    {NMEA_TYPE_VTG, .vtg = {2, 7752, true, true, 'A'}},
+    {NMEA_TYPE_VTG, .vtg = {0, 0, false, false, 'N'}},
+    {NMEA_TYPE_VTG, .vtg = {2833, 5470, true, true, 'D'}},
+    {NMEA_TYPE_UNKNOWN},            // ZDA
+    {NMEA_TYPE_UNKNOWN},            // TXT
+    {NMEA_TYPE_GGA, .gga = {30602000, 228170012, 1083669002, 8510, 70, 1, 16,
+                            NMEA_GGA_HAS_TIME | NMEA_GGA_HAS_POSITION | NMEA_GGA_HAS_ALTITUDE | NMEA_GGA_HAS_HDOP}},
+};
+
+/**
+ * @brief 核对一条语句的结果（只比较存在标志置位的字段）
+ * @return 不一致的字段数
+ */
+static int CheckSentence(const NmeaParser *parser, const Expected *expected)
+{
+    int errors = 0;
+#define BENCH_CHECK(cond, field, got, want)                                                            \
+    if ((cond) && (got) != (want)) {                                                                   \
+        fprintf(stderr, "    %s: got %lld expected %lld\n", field, (long long)(got), (long long)(want)); \
+        errors++;                                                                                      \
+    }
+    switch (expected->type) {
+        case NMEA_TYPE_GGA: {
+            const NmeaGga *got = &parser->gga;
+            const NmeaGga *want = &expected->gga;
+            BENCH_CHECK(true, "present", got->present, want->present);
+            BENCH_CHECK(want->present & NMEA_GGA_HAS_TIME, "utc_time_ms", got->utc_time_ms, want->utc_time_ms);
+            BENCH_CHECK(want->present & NMEA_GGA_HAS_LATITUDE, "latitude", got->latitude, want->latitude);
+            BENCH_CHECK(want->present & NMEA_GGA_HAS_LONGITUDE, "longitude", got->longitude, want->longitude);
+            BENCH_CHECK(want->present & NMEA_GGA_HAS_ALTITUDE, "altitude", got->altitude, want->altitude);
+            BENCH_CHECK(want->present & NMEA_GGA_HAS_HDOP, "hdop", got->hdop, want->hdop);
+            BENCH_CHECK(true, "quality", got->quality, want->quality);
+            BENCH_CHECK(true, "satellites", got->satellites, want->satellites);
+            break;
+        }
+        case NMEA_TYPE_RMC: {
+            const NmeaRmc *got = &parser->rmc;
+            const NmeaRmc *want = &expected->rmc;
+            BENCH_CHECK(true, "present", got->present, want->present);
+            BENCH_CHECK(want->present & NMEA_RMC_HAS_TIME, "utc_time_ms", got->utc_time_ms, want->utc_time_ms);
+            BENCH_CHECK(want->present & NMEA_RMC_HAS_POSITION, "latitude", got->latitude, want->latitude);
+            BENCH_CHECK(want->present & NMEA_RMC_HAS_POSITION, "longitude", got->longitude, want->longitude);
+            BENCH_CHECK(want->present & NMEA_RMC_HAS_SPEED, "speed", got->speed, want->speed);
+            BENCH_CHECK(want->present & NMEA_RMC_HAS_COURSE, "course", got->course, want->course);
+            BENCH_CHECK(want->present & NMEA_RMC_HAS_DATE, "day", got->day, want->day);
+            BENCH_CHECK(want->present & NMEA_RMC_HAS_DATE, "month", got->month, want->month);
+            BENCH_CHECK(want->present & NMEA_RMC_HAS_DATE, "year", got->year, want->year);
+            BENCH_CHECK(true, "status", got->status, want->status);
+            BENCH_CHECK(true, "mode", got->mode, want->mode);
+            break;
+        }
+        case NMEA_TYPE_GSA: {
+            const NmeaGsa *got = &parser->gsa;
+            const NmeaGsa *want = &expected->gsa;
+            BENCH_CHECK(true, "used_count", got->used_count, want->used_count);
+            for (int i = 0; i < want->used_count && i < NMEA_GSA_MAX_SATELLITES; i++) {
+                BENCH_CHECK(true, "prn", got->prn[i], want->prn[i]);
+            }
+            BENCH_CHECK(true, "pdop", got->pdop, want->pdop);
+            BENCH_CHECK(true, "hdop", got->hdop, want->hdop);
+            BENCH_CHECK(true, "vdop", got->vdop, want->vdop);
+            BENCH_CHECK(true, "fix_type", got->fix_type, want->fix_type);
+            BENCH_CHECK(true, "system", got->system, want->system);
+            BENCH_CHECK(true, "mode", got->mode, want->mode);
+            break;
+        }
+        case NMEA_TYPE_GSV: {
+            const NmeaGsv *got = &parser->gsv;
+            const NmeaGsv *want = &expected->gsv;
+            BENCH_CHECK(true, "count", got->count, want->count);
+            for (int i = 0; i < want->count && i < NMEA_GSV_SATS_PER_MSG; i++) {
+                BENCH_CHECK(true, "prn", got->sats[i].prn, want->sats[i].prn);
+                BENCH_CHECK(true, "azimuth", got->sats[i].azimuth, want->sats[i].azimuth);
+                BENCH_CHECK(true, "elevation", got->sats[i].elevation, want->sats[i].elevation);
+                BENCH_CHECK(true, "cn0", got->sats[i].cn0, want->sats[i].cn0);
+            }
+            BENCH_CHECK(true, "total_messages", got->total_messages, want->total_messages);
+            BENCH_CHECK(true, "message_number", got->message_number, want->message_number);
+            BENCH_CHECK(true, "in_view", got->in_view, want->in_view);
+            BENCH_CHECK(true, "system", got->system, want->system);
+            BENCH_CHECK(true, "signal_id", got->signal_id, want->signal_id);
+            break;
+        }
+        case NMEA_TYPE_VTG: {
+            const NmeaVtg *got = &parser->vtg;
+            const NmeaVtg *want = &expected->vtg;
+            BENCH_CHECK(true, "has_speed", got->has_speed, want->has_speed);
+            BENCH_CHECK(true, "has_course", got->has_course, want->has_course);
+            BENCH_CHECK(want->has_speed, "speed", got->speed, want->speed);
+            BENCH_CHECK(want->has_course, "course", got->course, want->course);
+            BENCH_CHECK(true, "mode", got->mode, want->mode);
+            break;
+        }
+        default:
+            break;
+    }
+#undef BENCH_CHECK
+    return errors;
+}
+
+/**
+ * @brief 逐字节解析记录，核对每条校验通过的语句
+ * @return 不一致项数
+ */
+static int CheckCorpus(const char *corpus, size_t length)
+{
+    NmeaParser parser;
+    int index = 0;
+    int errors = 0;
+
+    Nmea_Init(&parser);
+    for (size_t i = 0; i < length; i++) {
+        uint32_t before = parser.stats.sentences;
+        NmeaType type = Nmea_Feed(&parser, corpus[i]);
+        if (parser.stats.sentences == before) {
+            continue;
+        }
+        if (index >= BENCH_SENTENCES) {
+            fprintf(stderr, "  unexpected sentence at byte %zu\n", i);
+            errors++;
+            continue;
+        }
+        const Expected *expected = &g_expected[index];
+        int field_errors = (type != expected->type) ? 1 : CheckSentence(&parser, expected);
+        if (field_errors != 0) {
+            fprintf(stderr, "  sentence %d (type %d, expected %d) ending at byte %zu: %d mismatches\n",
+                    index + 1, type, expected->type, i, field_errors);
+            errors += field_errors;
+        }
+        index++;
+    }
+
+    fprintf(stderr, "%d sentences accepted (expected %d), checksum errors %u (expected %d), "
+            "format errors %u (expected %d)\n", index, BENCH_SENTENCES,
+            parser.stats.checksum_errors, BENCH_CHECKSUM_ERRORS, parser.stats.format_errors, BENCH_FORMAT_ERRORS);
+    errors += (index != BENCH_SENTENCES) + (parser.stats.sentences != BENCH_SENTENCES) +
+              (parser.stats.checksum_errors != BENCH_CHECKSUM_ERRORS) +
+              (parser.stats.format_errors != BENCH_FORMAT_ERRORS);
+    return errors;
+}
+
+static double NowNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/**
+ * @brief 重复解析整个记录，按起始'$'计的语句数（含出错语句）统计耗时
+ */
+static void Benchmark(const char *corpus, size_t length)
+{
+    NmeaParser parser;
+    uint32_t starts = 0;
+    volatile uint32_t sink = 0;
+
+    for (size_t i = 0; i < length; i++) {
+        starts += (corpus[i] == '$');
+    }
+
+    Nmea_Init(&parser);
+    double start_ns = NowNs();
+#if BENCH_HAS_TSC
+    uint64_t start_tsc = __rdtsc();
+#endif
+    for (int repeat = 0; repeat < BENCH_REPEATS; repeat++) {
+        for (size_t i = 0; i < length; i++) {
+            sink += Nmea_Feed(&parser, corpus[i]);
+        }
+    }
+#if BENCH_HAS_TSC
+    uint64_t tsc = __rdtsc() - start_tsc;
+#endif
+    double ns = NowNs() - start_ns;
+
+    double sentences = (double)starts * BENCH_REPEATS;
+    double bytes = (double)length * BENCH_REPEATS;
+    fprintf(stderr, "%u sentence starts, %zu bytes per pass, %d passes: %.1f ns/sentence, %.2f ns/byte",
+            starts, length, BENCH_REPEATS, ns / sentences, ns / bytes);
+#if BENCH_HAS_TSC
+    fprintf(stderr, ", %.0f TSC cycles/sentence, %.2f cycles/byte", tsc / sentences, tsc / bytes);
+#endif
+    fprintf(stderr, "\n");
+    (void)sink;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *path = (argc > 1) ? argv[1] : BENCH_CORPUS_FILE;
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        fprintf(stderr, "cannot open %s\n", path);
+        return 1;
+    }
+    static char corpus[BENCH_CORPUS_MAX];
+    size_t length = fread(corpus, 1, sizeof(corpus), file);
+    fclose(file);
+
+    int errors = CheckCorpus(corpus, length);
+    fprintf(stderr, "field/statistics mismatches: %d\n", errors);
+    Benchmark(corpus, length);
+    return (errors == 0) ? 0 : 1;
+}
@@ -0,0 +1,131 @@
+/**
+ * @brief 风险规则回放：按记录（data/risk_trace.csv）逐行用默认规则集评估，核对期望等级，
+ *        记录中含传感器故障产生的NaN/±inf输入，同时核对RiskRules_EvaluateSet与生效规则评估结果一致
+ *
+ * 记录格式：time_s、各RiskInput输入（顺序同RiskRules_GetInputName）、期望等级；#开头为注释，首个非注释行为表头。
+ * 非有限值写作nan/inf/-inf。期望等级由默认折线的双精度独立实现给出，不取自被测代码。
+ */
+#include "host_stubs.h"
+#include "risk_rules.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define REPLAY_TRACE_FILE           HOST_REPLAY_DATA "/risk_trace.csv"
+#define REPLAY_LINE_MAX             512
+#define REPLAY_LEVELS               (RISK_RULE_CUTOFFS + 1)
+
+static const char *g_level_names[REPLAY_LEVELS] = {"safe", "low", "medium", "high", "critical"};
+
+/**
+ * @brief 解析一行记录
+ * @return 0: 成功, -1: 格式错误
+ */
+static int ParseLine(char *line, uint32_t *time_s, float inputs[RISK_INPUT_COUNT], int *expected)
+{
+    char *end;
+    *time_s = (uint32_t)strtoul(line, &end, 10);
+    for (int i = 0; i < RISK_INPUT_COUNT; i++) {
+        if (*end != ',') {
+            return -1;
+        }
+        inputs[i] = strtof(end + 1, &end);      // strtof识别nan/inf/-inf
+    }
+    if (*end != ',') {
+        return -1;
+    }
+    *expected = (int)strtol(end + 1, &end, 10);
+    return (*expected >= 0 && *expected < REPLAY_LEVELS) ? 0 : -1;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *path = (argc > 1) ? argv[1] : REPLAY_TRACE_FILE;
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        fprintf(stderr, "cannot open %s\n", path);
+        return 1;
+    }
+
+    RiskRuleSet set;
+    RiskRules_GetDefault(&set);
+    RiskRules_Init();
+
+    char line[REPLAY_LINE_MAX];
+    bool header = true;
+    int rows = 0;
+    int nonfinite_rows = 0;
+    int mismatches = 0;
+    int nonfinite_mismatches = 0;
+    int set_differences = 0;
+    int confusion[REPLAY_LEVELS][REPLAY_LEVELS] = {{0}};
+
+    while (fgets(line, sizeof(line), file) != NULL) {
+        if (line[0] == '#' || line[0] == '\n') {
+            continue;
+        }
+        if (header) {
+            header = false;
+            continue;
+        }
+
+        uint32_t time_s;
+        float inputs[RISK_INPUT_COUNT];
+        int expected;
+        if (ParseLine(line, &time_s, inputs, &expected) != 0) {
+            fprintf(stderr, "bad line: %s", line);
+            fclose(file);
+            return 1;
+        }
+
+        bool nonfinite = false;
+        for (int i = 0; i < RISK_INPUT_COUNT; i++) {
+            nonfinite |= !isfinite(inputs[i]);
+        }
+
+        RiskRuleResult result;
+        RiskRuleResult active;
+        if (RiskRules_EvaluateSet(&set, inputs, &result) != 0 || RiskRules_Evaluate(inputs, &active) != 0) {
+            fprintf(stderr, "evaluation failed at t=%u\n", time_s);
+            fclose(file);
+            return 1;
+        }
+        if (memcmp(result.factors, active.factors, sizeof(result.factors)) != 0 || result.score != active.score ||
+            result.level != active.level) {
+            set_differences++;
+        }
+
+        rows++;
+        nonfinite_rows += nonfinite;
+        confusion[expected][result.level]++;
+        if (result.level != expected) {
+            mismatches++;
+            nonfinite_mismatches += nonfinite;
+            if (mismatches <= 10) {
+                fprintf(stderr, "  t=%u expected %s got %s (score %.6f)%s\n", time_s, g_level_names[expected],
+                        g_level_names[result.level], result.score, nonfinite ? " [non-finite input]" : "");
+            }
+        }
+    }
+    fclose(file);
+    RiskRules_Deinit();
+
+    fprintf(stderr, "%d rows (%d with NaN/inf inputs): %d level mismatches (%d on non-finite rows), "
+            "EvaluateSet/Evaluate differences %d\n",
+            rows, nonfinite_rows, mismatches, nonfinite_mismatches, set_differences);
+    fprintf(stderr, "expected \\ got ");
+    for (int j = 0; j < REPLAY_LEVELS; j++) {
+        fprintf(stderr, "%9s", g_level_names[j]);
+    }
+    fprintf(stderr, "\n");
+    for (int i = 0; i < REPLAY_LEVELS; i++) {
+        fprintf(stderr, "%-14s", g_level_names[i]);
+        for (int j = 0; j < REPLAY_LEVELS; j++) {
+            fprintf(stderr, "%9d", confusion[i][j]);
+        }
+        fprintf(stderr, "\n");
+    }
+
+    return (rows > 0 && mismatches == 0 && set_differences == 0) ? 0 : 1;
+}
@@ -0,0 +1,396 @@
+/**
+ * @brief Flash环形区掉电注入：用NOR Flash模型替代IoTFlash接口，在任意字节处切断编程/擦除，
+ *        重启后重新扫描，核对读出的记录没有残缺、已完成的记录没有丢失、写指针恢复后可继续追加；
+ *        另测CRC32吞吐
+ *
+ * Flash模型：写入只能把位从1清为0，擦除把整扇区置0xFF；掉电时当前字节只完成随机一部分位，
+ * 之后的写入/擦除全部失败，直到"重启"。记录载荷自带编号，内容由编号生成，读出后可逐字节核对。
+ */
+#include "host_stubs.h"
+#include "data_storage.h"
+#include "crc32.h"
+#include "iot_flash.h"
+#include "iot_errno.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define FLASH_MODEL_BASE            STORAGE_FLASH_BASE_ADDR
+#define FLASH_MODEL_SECTORS         4
+#define FLASH_MODEL_SIZE            (FLASH_MODEL_SECTORS * STORAGE_SECTOR_SIZE)
+#define REPLAY_SEED                 29
+#define REPLAY_TRIALS               20000       // 每种记录布局的掉电次数
+#define REPLAY_PAYLOAD_MAX          1024
+#define CRC_BENCH_BYTES             (64u * 1024u * 1024u)
+
+// 掉电发生时正在进行的操作
+typedef enum {
+    CUT_ERASE = 0,
+    CUT_PAYLOAD,
+    CUT_HEADER,
+    CUT_FLAGS,
+    CUT_TYPES
+} CutType;
+
+static const char *g_cut_names[CUT_TYPES] = {"erase", "payload", "header", "flags"};
+
+// 记录布局
+typedef struct {
+    uint16_t payload_size;
+    uint16_t sectors;
+} RingLayout;
+
+// 单种布局的统计
+typedef struct {
+    uint32_t cuts[CUT_TYPES];
+    uint32_t inflight_kept;         // 掉电时正在写入的记录重启后完整可读
+    uint32_t inflight_dropped;      // 掉电时正在写入的记录重启后不可读
+    uint32_t torn;                  // 读出成功但内容残缺的记录（应为0）
+    uint32_t lost;                  // 已完成但重启后读不到的记录（应为0）
+    uint32_t order_errors;          // 读出顺序与写入顺序不一致（应为0）
+    uint32_t resume_errors;         // 重启后继续追加的记录读不到（应为0）
+    uint64_t init_read_bytes;       // 重启扫描读取的Flash字节数
+    uint32_t inits;
+} LayoutStats;
+
+static uint8_t g_flash[FLASH_MODEL_SIZE];
+static int32_t g_cut_budget = -1;   // 掉电前还能编程/擦除的字节数，<0不掉电
+static bool g_power_lost = false;
+static CutType g_cut_type;
+static uint64_t g_read_bytes = 0;
+static uint16_t g_payload_size;
+
+// ========== Flash模型 ==========
+
+unsigned int IoTFlashInit(void)
+{
+    return IOT_SUCCESS;
+}
+
+unsigned int IoTFlashDeinit(void)
+{
+    return IOT_SUCCESS;
+}
+
+unsigned int IoTFlashRead(unsigned int flashOffset, unsigned int size, unsigned char *ramData)
+{
+    if (flashOffset < FLASH_MODEL_BASE || flashOffset - FLASH_MODEL_BASE + size > FLASH_MODEL_SIZE) {
+        return IOT_FAILURE;
+    }
+    memcpy(ramData, &g_flash[flashOffset - FLASH_MODEL_BASE], size);
+    g_read_bytes += size;
+    return IOT_SUCCESS;
+}
+
+/**
+ * @brief 消耗一个字节的编程/擦除预算
+ * @return true: 该字节处掉电
+ */
+static bool ConsumeBudget(CutType type)
+{
+    if (g_cut_budget < 0) {
+        return false;
+    }
+    if (g_cut_budget == 0) {
+        g_power_lost = true;
+        g_cut_type = type;
+        return true;
+    }
+    g_cut_budget--;
+    return false;
+}
+
+unsigned int IoTFlashWrite(unsigned int flashOffset, unsigned int size, const unsigned char *ramData,
+                           unsigned char doErase)
+{
+    (void)doErase;
+    if (g_power_lost || flashOffset < FLASH_MODEL_BASE ||
+        flashOffset - FLASH_MODEL_BASE + size > FLASH_MODEL_SIZE) {
+        return IOT_FAILURE;
+    }
+
+    CutType type = (size == sizeof(StorageRingHeader)) ? CUT_HEADER :
+                   (size == g_payload_size) ? CUT_PAYLOAD : CUT_FLAGS;
+    uint8_t *cell = &g_flash[flashOffset - FLASH_MODEL_BASE];
+    for (unsigned int i = 0; i < size; i++) {
+        if (ConsumeBudget(type)) {
+            cell[i] &= ramData[i] | (uint8_t)(Host_Uniform() * 256.0);    // 只清除了一部分位
+            return IOT_FAILURE;
+        }
+        cell[i] &= ramData[i];
+    }
+    return IOT_SUCCESS;
+}
+
+unsigned int IoTFlashErase(unsigned int flashOffset, unsigned int size)
+{
+    if (g_power_lost || flashOffset < FLASH_MODEL_BASE ||
+        flashOffset - FLASH_MODEL_BASE + size > FLASH_MODEL_SIZE) {
+        return IOT_FAILURE;
+    }
+
+    uint8_t *cell = &g_flash[flashOffset - FLASH_MODEL_BASE];
+    for (unsigned int i = 0; i < size; i++) {
+        if (ConsumeBudget(CUT_ERASE)) {
+            cell[i] |= (uint8_t)(Host_Uniform() * 256.0);                   // 只置位了一部分位
+            return IOT_FAILURE;
+        }
+        cell[i] = 0xFF;
+    }
+    return IOT_SUCCESS;
+}
+
+// ========== 记录生成与核对 ==========
+
+/**
+ * @brief 由编号生成载荷（前4字节为编号）
+ */
+static void MakePayload(uint32_t id, uint8_t *payload, uint16_t size)
+{
+    uint32_t x = id * 2654435761u + 1u;
+    memcpy(payload, &id, sizeof(id));
+    for (uint16_t i = sizeof(id); i < size; i++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        payload[i] = (uint8_t)x;
+    }
+}
+
+/**
+ * @brief 模拟重启：恢复供电并重新扫描环形区
+ */
+static void Reboot(const RingLayout *layout, StorageRing *ring, LayoutStats *stats)
+{
+    g_power_lost = false;
+    g_cut_budget = -1;
+    g_read_bytes = 0;
+    DataStorage_RingInit(ring, FLASH_MODEL_BASE, layout->sectors, layout->payload_size);
+    stats->init_read_bytes += g_read_bytes;
+    stats->inits++;
+}
+
+/**
+ * @brief 按时间顺序读出全部记录并核对
+ * @param committed 已完成写入的最大编号
+ * @param inflight 掉电时正在写入的编号，0表示无
+ * @param first_required 该编号及之后的已完成记录必须全部可读
+ * @return 读出的最大编号
+ */
+static uint32_t VerifyRing(const StorageRing *ring, uint32_t committed, uint32_t inflight,
+                           uint32_t first_required, LayoutStats *stats, uint32_t *lost)
+{
+    uint8_t payload[REPLAY_PAYLOAD_MAX];
+    uint8_t expected[REPLAY_PAYLOAD_MAX];
+    uint32_t last_id = 0;
+    uint32_t next_required = first_required;
+
+    *lost = 0;
+    for (uint32_t i = 0; i < DataStorage_RingCount(ring); i++) {
+        if (DataStorage_RingRead(ring, i, payload, ring->payload_size) != 0) {
+            continue;
+        }
+        uint32_t id;
+        memcpy(&id, payload, sizeof(id));
+        MakePayload(id, expected, ring->payload_size);
+        if (id == 0 || (id > committed && id != inflight) ||
+            memcmp(payload, expected, ring->payload_size) != 0) {
+            stats->torn++;
+            continue;
+        }
+        if (id <= last_id) {
+            stats->order_errors++;
+        }
+        last_id = id;
+
+        // 编号之间缺少的已完成记录计为丢失（首条之前的属于被覆盖的旧扇区）
+        if (id >= next_required) {
+            *lost += id - next_required;
+            next_required = id + 1;
+        }
+    }
+    if (next_required <= committed) {
+        *lost += committed - next_required + 1;
+    }
+
+    // 最新记录须为最后完成的记录或掉电时恰好写完的记录
+    if (DataStorage_RingReadLatest(ring, payload, ring->payload_size) == 0) {
+        uint32_t id;
+        memcpy(&id, payload, sizeof(id));
+        if (id != last_id) {
+            stats->order_errors++;
+        }
+    } else if (committed > 0) {
+        (*lost)++;
+    }
+    return last_id;
+}
+
+/**
+ * @brief 一次掉电试验：写入若干记录后在随机字节处掉电，重启核对，再继续追加并重启核对
+ */
+static void RunTrial(const RingLayout *layout, LayoutStats *stats)
+{
+    StorageRing ring;
+    uint8_t payload[REPLAY_PAYLOAD_MAX];
+    uint32_t next_id = 1;
+    uint32_t committed = 0;
+    uint32_t inflight = 0;
+
+    memset(g_flash, 0xFF, sizeof(g_flash));
+    g_payload_size = layout->payload_size;
+    Reboot(layout, &ring, stats);
+
+    // 掉电前的历史：最多写满约3圈，期间随机清除记录标志（模拟上传确认）
+    uint32_t history = (uint32_t)(Host_Uniform() * 3.0 * ring.total_slots);
+    for (uint32_t i = 0; i < history; i++) {
+        MakePayload(next_id, payload, layout->payload_size);
+        if (DataStorage_RingAppend(&ring, payload, layout->payload_size) == 0) {
+            committed = next_id;
+        }
+        next_id++;
+        if (Host_Uniform() < 0.2) {
+            DataStorage_RingClearFlags(&ring, (uint32_t)(Host_Uniform() * DataStorage_RingCount(&ring)), 0x1);
+        }
+    }
+
+    // 在一个槽位加一次扇区擦除的字节范围内随机选择掉电位置，持续写入直到掉电
+    g_cut_budget = (int32_t)(Host_Uniform() * (ring.slot_size + STORAGE_SECTOR_SIZE));
+    while (!g_power_lost) {
+        if (Host_Uniform() < 0.2 && DataStorage_RingCount(&ring) > 0) {
+            DataStorage_RingClearFlags(&ring, (uint32_t)(Host_Uniform() * DataStorage_RingCount(&ring)), 0x2);
+            continue;
+        }
+        MakePayload(next_id, payload, layout->payload_size);
+        if (DataStorage_RingAppend(&ring, payload, layout->payload_size) == 0) {
+            committed = next_id;
+        } else {
+            inflight = next_id;
+        }
+        next_id++;
+    }
+    stats->cuts[g_cut_type]++;
+
+    // 重启：保证保留的槽数为除正在擦除的扇区外的全部槽位，其中最后一个槽位可能是掉电残缺的记录
+    uint32_t capacity = ring.total_slots - ring.slots_per_sector;
+    uint32_t kept = (inflight != 0) ? capacity - 1 : capacity;
+    uint32_t first_required = (committed > kept) ? committed - kept + 1 : 1;
+    uint32_t lost;
+    Reboot(layout, &ring, stats);
+    uint32_t last_id = VerifyRing(&ring, committed, inflight, first_required, stats, &lost);
+    stats->lost += lost;
+    if (inflight != 0) {
+        if (last_id == inflight) {
+            stats->inflight_kept++;
+            committed = inflight;
+        } else {
+            stats->inflight_dropped++;
+        }
+    }
+
+    // 继续追加保证保留的槽数（至少跨过一次扇区擦除），再次重启后必须全部可读
+    uint32_t resume_first = next_id;
+    for (uint32_t i = 0; i < capacity; i++) {
+        MakePayload(next_id, payload, layout->payload_size);
+        if (DataStorage_RingAppend(&ring, payload, layout->payload_size) == 0) {
+            committed = next_id;
+        }
+        next_id++;
+    }
+    Reboot(layout, &ring, stats);
+    VerifyRing(&ring, committed, 0, resume_first, stats, &lost);
+    stats->resume_errors += lost;
+}
+
+// ========== CRC32吞吐 ==========
+
+/**
+ * @brief 逐位计算CRC32（对照实现）
+ */
+static uint32_t Crc32Bitwise(const uint8_t *data, size_t size)
+{
+    uint32_t crc = 0xFFFFFFFFu;
+    while (size-- > 0) {
+        crc ^= *data++;
+        for (int k = 0; k < 8; k++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
+
+/**
+ * @brief 按给定块长测吞吐 (MB/s)
+ */
+static double CrcThroughput(uint32_t (*crc)(const uint8_t *, size_t), const uint8_t *data, size_t block,
+                            size_t total)
+{
+    volatile uint32_t sink = 0;
+    clock_t start = clock();
+    for (size_t done = 0; done < total; done += block) {
+        sink += crc(data, block);
+    }
+    double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    (void)sink;
+    return total / seconds / 1e6;
+}
+
+static uint32_t Crc32Table(const uint8_t *data, size_t size)
+{
+    return Crc32_Calculate(data, size);
+}
+
+static void RunCrcBench(void)
+{
+    static uint8_t data[STORAGE_SECTOR_SIZE];
+    const size_t blocks[] = {20, 96, 1000, STORAGE_SECTOR_SIZE};
+    int mismatches = 0;
+
+    for (size_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t)(Host_Uniform() * 256.0);
+    }
+    for (size_t len = 0; len <= sizeof(data); len += 7) {
+        mismatches += Crc32_Calculate(data, len) != Crc32Bitwise(data, len);
+    }
+
+    fprintf(stderr, "CRC32 self test %s, table vs bitwise mismatches %d\n",
+            Crc32_SelfTest() == 0 ? "passed" : "FAILED", mismatches);
+    for (size_t i = 0; i < sizeof(blocks) / sizeof(blocks[0]); i++) {
+        double table = CrcThroughput(Crc32Table, data, blocks[i], CRC_BENCH_BYTES);
+        double bitwise = CrcThroughput(Crc32Bitwise, data, blocks[i], CRC_BENCH_BYTES / 16);
+        fprintf(stderr, "  %4zu-byte blocks: slicing-by-4 %7.0f MB/s, bitwise %5.0f MB/s (host)\n",
+                blocks[i], table, bitwise);
+    }
+}
+
+int main(void)
+{
+    const RingLayout layouts[] = {{20, 2}, {96, 4}, {1000, 3}};
+    int failures = 0;
+
+    // 模块日志输出到stdout，回放结果输出到stderr
+    Host_Seed(REPLAY_SEED);
+    DataStorage_Init();
+    for (size_t l = 0; l < sizeof(layouts) / sizeof(layouts[0]); l++) {
+        LayoutStats stats;
+        memset(&stats, 0, sizeof(stats));
+        for (int t = 0; t < REPLAY_TRIALS; t++) {
+            RunTrial(&layouts[l], &stats);
+        }
+
+        fprintf(stderr, "payload %4u B x %u sectors, %d power cuts (", layouts[l].payload_size,
+                layouts[l].sectors, REPLAY_TRIALS);
+        for (int c = 0; c < CUT_TYPES; c++) {
+            fprintf(stderr, "%s%s %u", c ? ", " : "", g_cut_names[c], stats.cuts[c]);
+        }
+        fprintf(stderr, ")\n  torn %u, lost %u, order errors %u, resume errors %u | in-flight record kept %u, "
+                "dropped %u | scan reads %.0f bytes/boot\n", stats.torn, stats.lost, stats.order_errors,
+                stats.resume_errors, stats.inflight_kept, stats.inflight_dropped,
+                (double)stats.init_read_bytes / stats.inits);
+        failures += stats.torn + stats.lost + stats.order_errors + stats.resume_errors;
+    }
+    DataStorage_Deinit();
+
+    RunCrcBench();
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,7 @@
+#ifndef HOST_IOT_ERRNO_H
+#define HOST_IOT_ERRNO_H
+
+#define IOT_SUCCESS                 0
+#define IOT_FAILURE                 (-1)
+
+#endif // HOST_IOT_ERRNO_H
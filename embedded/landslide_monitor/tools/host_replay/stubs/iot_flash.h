@@ -0,0 +1,12 @@
+#ifndef HOST_IOT_FLASH_H
+#define HOST_IOT_FLASH_H
+
+// 主机回放用的Flash接口替身（接口同OpenHarmony iot_flash.h，由回放程序提供Flash模型）
+unsigned int IoTFlashRead(unsigned int flashOffset, unsigned int size, unsigned char *ramData);
+unsigned int IoTFlashWrite(unsigned int flashOffset, unsigned int size, const unsigned char *ramData,
+                           unsigned char doErase);
+unsigned int IoTFlashErase(unsigned int flashOffset, unsigned int size);
+unsigned int IoTFlashInit(void);
+unsigned int IoTFlashDeinit(void);
+
+#endif // HOST_IOT_FLASH_H
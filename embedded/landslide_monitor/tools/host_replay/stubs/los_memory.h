@@ -0,0 +1,6 @@
+#ifndef HOST_LOS_MEMORY_H
+#define HOST_LOS_MEMORY_H
+
+#include "los_task.h"
+
+#endif // HOST_LOS_MEMORY_H
@@ -0,0 +1,11 @@
+#ifndef HOST_LOS_MUX_H
+#define HOST_LOS_MUX_H
+
+#include "los_task.h"
+
+UINT32 LOS_MuxCreate(UINT32 *mux);
+UINT32 LOS_MuxDelete(UINT32 mux);
+UINT32 LOS_MuxPend(UINT32 mux, UINT32 timeout);
+UINT32 LOS_MuxPost(UINT32 mux);
+
+#endif // HOST_LOS_MUX_H
@@ -0,0 +1,15 @@
+#ifndef HOST_LOS_TASK_H
+#define HOST_LOS_TASK_H
+
+#include <stdint.h>
+
+// 主机回放用的LiteOS-M最小替身（只覆盖被测模块用到的类型和接口）
+typedef unsigned int UINT32;
+typedef unsigned long long UINT64;
+
+#define LOS_OK                      0
+#define LOS_WAIT_FOREVER            0xFFFFFFFF
+
+UINT64 LOS_TickCountGet(void);
+
+#endif // HOST_LOS_TASK_H
@@ -0,0 +1,161 @@
+/**
+ * @brief 倾斜蠕变检测回放：15Hz合成倾角在已知时刻注入线性蠕变，核对CUSUM报警延迟落在理论范围内、
+ *        起始时刻估计和注入前无报警；另以只含噪声和日周期温漂的长记录核对无报警
+ *
+ * 倾角 = 初始倾角 + 蠕变 + 日周期温漂（幅值REPLAY_THERMAL_DEG）+ 单样本噪声（σ REPLAY_NOISE_DEG）。
+ * 偏差 d(t) = r·t 时累积量为 r·(t - drift/r)²/2，报警延迟 drift/r + sqrt(2·threshold/r)；
+ * 温漂和参考跟踪使偏差另有 ±REPLAY_OFFSET_DEG 以内的偏移，延迟范围按偏移上下限计算，再加分块量化余量。
+ */
+#include "host_stubs.h"
+#include "tilt_creep.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#define REPLAY_SEED                 46
+#define REPLAY_RUNS                 10
+#define REPLAY_SAMPLE_HZ            15          // 同SENSOR_SAMPLE_RATE_HZ
+#define REPLAY_NOISE_DEG            0.02        // 单样本倾角噪声
+#define REPLAY_THERMAL_DEG          0.004       // 日周期温漂幅值（小于允许偏差）
+#define REPLAY_OFFSET_DEG           (2.0 * REPLAY_THERMAL_DEG + 0.002)  // 温漂相对参考的最大偏移加块均值噪声
+#define REPLAY_ONSET_MIN_H          24.0        // 注入时刻在 [24, 48) 小时内随机
+#define REPLAY_ONSET_SPAN_H         24.0
+#define REPLAY_MARGIN_H             (2.0 * CREEP_BLOCK_MS / 3600000.0)  // 分块量化余量
+#define REPLAY_NOISE_DAYS           14
+
+// 蠕变注入（各轴分量）
+typedef struct {
+    const char *name;
+    double rate_x;                  // X轴倾角速率 (°/小时)
+    double rate_y;                  // Y轴倾角速率 (°/小时)
+} CreepCase;
+
+static const CreepCase g_cases[] = {
+    {"X +0.01deg/h", 0.01, 0.0},
+    {"X +0.02deg/h", 0.02, 0.0},
+    {"Y -0.05deg/h", 0.0, -0.05},
+    {"X +0.2deg/h", 0.2, 0.0},
+    {"XY 0.03/0.04deg/h", 0.03, 0.04},
+};
+#define REPLAY_CASES                ((int)(sizeof(g_cases) / sizeof(g_cases[0])))
+
+// 单次回放结果
+typedef struct {
+    uint32_t early_alarms;          // 注入前的报警次数（报警后重新建立参考继续回放）
+    double delay_h;                 // 注入到报警的时长，未报警为-1
+    double onset_error_h;           // 估计起始时刻减注入时刻
+    uint8_t axis;                   // 报警轴
+    int8_t direction;               // 报警方向
+} ReplayResult;
+
+/**
+ * @brief 报警延迟理论值：偏差 r·t + offset 的累积量达到报警阈值的时刻
+ */
+static double TheoryDelay(double rate, double offset)
+{
+    CreepConfig config;
+    TiltCreep_GetConfig(&config);
+    double start = fmax((config.drift - offset) / rate, 0.0);
+    return start + sqrt(2.0 * config.threshold / rate);
+}
+
+static void Run(double rate_x, double rate_y, double onset_h, double total_h, ReplayResult *out)
+{
+    const uint32_t step_ms = 1000 / REPLAY_SAMPLE_HZ;
+    const double phase = 24.0 * Host_Uniform();
+    CreepStatus status;
+
+    memset(out, 0, sizeof(*out));
+    out->delay_h = -1.0;
+    TiltCreep_Rearm();
+
+    for (uint32_t ms = step_ms; ms < (uint32_t)(total_h * 3600000.0); ms += step_ms) {
+        double t_h = ms / 3600000.0;
+        double creep_h = fmax(t_h - onset_h, 0.0);
+        double thermal = REPLAY_THERMAL_DEG * sin(2.0 * M_PI * (t_h + phase) / 24.0);
+        float x = (float)(1.5 + rate_x * creep_h + thermal + REPLAY_NOISE_DEG * Host_Gauss());
+        float y = (float)(-0.7 + rate_y * creep_h + 0.5 * thermal + REPLAY_NOISE_DEG * Host_Gauss());
+        TiltCreep_Update(x, y, ms, &status);
+        if (!status.alarm) {
+            continue;
+        }
+        if (status.alarm_time / 3600000.0 < onset_h) {
+            out->early_alarms++;
+            TiltCreep_Rearm();
+            continue;
+        }
+        out->delay_h = status.alarm_time / 3600000.0 - onset_h;
+        out->onset_error_h = status.onset_time / 3600000.0 - onset_h;
+        out->axis = status.axis;
+        out->direction = status.direction;
+        return;
+    }
+}
+
+int main(void)
+{
+    int failures = 0;
+    ReplayResult result;
+
+    // 模块日志输出到stdout，回放结果输出到stderr
+    Host_Seed(REPLAY_SEED);
+    if (TiltCreep_Init() != 0) {
+        fprintf(stderr, "TiltCreep_Init failed\n");
+        return 1;
+    }
+    CreepConfig config;
+    TiltCreep_GetConfig(&config);
+    fprintf(stderr, "drift %.3f deg, threshold %.3f deg*h, noise %.3f deg/sample, diurnal %.3f deg, %d runs each\n",
+            config.drift, config.threshold, REPLAY_NOISE_DEG, REPLAY_THERMAL_DEG, REPLAY_RUNS);
+
+    for (int c = 0; c < REPLAY_CASES; c++) {
+        const CreepCase *creep = &g_cases[c];
+        // 报警由变化更快的轴触发
+        bool use_x = fabs(creep->rate_x) >= fabs(creep->rate_y);
+        double rate = fabs(use_x ? creep->rate_x : creep->rate_y);
+        double low = TheoryDelay(rate, REPLAY_OFFSET_DEG);
+        double high = TheoryDelay(rate, -REPLAY_OFFSET_DEG) + REPLAY_MARGIN_H;
+        double delay_min = 1e9;
+        double delay_max = -1.0;
+        double onset_error_max = 0.0;
+        int detected = 0;
+        int out_of_range = 0;
+        int wrong_axis = 0;
+        uint32_t early_alarms = 0;
+
+        for (int run = 0; run < REPLAY_RUNS; run++) {
+            double onset_h = REPLAY_ONSET_MIN_H + REPLAY_ONSET_SPAN_H * Host_Uniform();
+            Run(creep->rate_x, creep->rate_y, onset_h, onset_h + 2.0 * high + 1.0, &result);
+            early_alarms += result.early_alarms;
+            if (result.delay_h < 0) {
+                continue;
+            }
+            detected++;
+            delay_min = fmin(delay_min, result.delay_h);
+            delay_max = fmax(delay_max, result.delay_h);
+            onset_error_max = fmax(onset_error_max, fabs(result.onset_error_h));
+            out_of_range += (result.delay_h < low || result.delay_h > high);
+            int8_t direction = ((use_x ? creep->rate_x : creep->rate_y) > 0) ? 1 : -1;
+            wrong_axis += (result.axis != (use_x ? 0 : 1) || result.direction != direction);
+        }
+
+        bool pass = (detected == REPLAY_RUNS && out_of_range == 0 && wrong_axis == 0 && early_alarms == 0);
+        failures += !pass;
+        fprintf(stderr, "  %-18s detected %2d/%d, delay %5.2f~%5.2f h (expected %5.2f~%5.2f h), "
+                "max|onset err| %4.2f h, wrong axis/direction %d, alarms before onset %u  %s\n",
+                creep->name, detected, REPLAY_RUNS, detected ? delay_min : -1.0, delay_max, low, high,
+                onset_error_max, wrong_axis, early_alarms, pass ? "ok" : "FAIL");
+    }
+
+    // 只含噪声和日周期温漂
+    Run(0.0, 0.0, REPLAY_NOISE_DAYS * 24.0, REPLAY_NOISE_DAYS * 24.0, &result);
+    CreepStatus status;
+    TiltCreep_GetStatus(&status);
+    bool pass = (result.early_alarms == 0 && status.ready);
+    failures += !pass;
+    fprintf(stderr, "  noise only %d days: alarms %u, final statistic %.3f  %s\n",
+            REPLAY_NOISE_DAYS, result.early_alarms, status.statistic, pass ? "ok" : "FAIL");
+
+    TiltCreep_Deinit();
+    return (failures == 0) ? 0 : 1;
+}